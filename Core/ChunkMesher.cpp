@@ -0,0 +1,254 @@
+#include "Engine/Core/ChunkMesher.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Math/Vec2.hpp"
+
+//----------------------------------------------------------------------------------------------
+// The chunk is copied into a block array padded by one on every side, so face culling and AO sampling along the
+// chunk border read neighbors the same way as interior blocks and the callback is called once per border block.
+//
+namespace
+{
+	constexpr unsigned int FACE_PRESENT_BIT = 1u << 16;
+
+	Vec3 const AXIS_DIRECTIONS[3] = { Vec3(1.f, 0.f, 0.f), Vec3(0.f, 1.f, 0.f), Vec3(0.f, 0.f, 1.f) };
+
+	int GetAmbientOcclusionLevel(bool side1, bool side2, bool corner)
+	{
+		if (side1 && side2)
+		{
+			return 0;
+		}
+		return 3 - ((int)side1 + (int)side2 + (int)corner);
+	}
+
+	Rgba8 GetShadedColor(Rgba8 const& tint, float brightness)
+	{
+		return Rgba8((unsigned char)((float)tint.r * brightness + 0.5f), (unsigned char)((float)tint.g * brightness + 0.5f),
+			(unsigned char)((float)tint.b * brightness + 0.5f), tint.a);
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+ChunkBlockAppearance::ChunkBlockAppearance()
+{
+	for (int faceIndex = 0; faceIndex < (int)ChunkFace::COUNT; ++faceIndex)
+	{
+		m_faceUVs[faceIndex] = AABB2(0.f, 0.f, 1.f, 1.f);
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+ChunkMeshStats BuildChunkMesh(ChunkMeshInput const& input, std::vector<Vertex_PCUTBN>& outVerts, std::vector<unsigned int>& outIndexes)
+{
+	ChunkMeshStats stats;
+	int const dims[3] = { input.m_dimensions.x, input.m_dimensions.y, input.m_dimensions.z };
+	GUARANTEE_OR_DIE(input.m_blocks != nullptr && dims[0] > 0 && dims[1] > 0 && dims[2] > 0, "BuildChunkMesh needs a block array and positive dimensions");
+
+	// Opacity and appearance per block type; types past the end of the table get the default appearance
+	ChunkBlockAppearance const defaultAppearance;
+	ChunkBlockAppearance const* appearances[256];
+	bool isOpaque[256];
+	int numAppearances = input.m_appearances != nullptr ? (int)input.m_appearances->size() : 0;
+	for (int blockType = 0; blockType < 256; ++blockType)
+	{
+		appearances[blockType] = blockType < numAppearances ? &(*input.m_appearances)[blockType] : &defaultAppearance;
+		isOpaque[blockType] = blockType != CHUNK_BLOCK_AIR && appearances[blockType]->m_isOpaque;
+	}
+
+	// Padded copy: interior straight from the chunk, one-block border from the neighbor callback
+	int const paddedDims[3] = { dims[0] + 2, dims[1] + 2, dims[2] + 2 };
+	int const strides[3] = { 1, paddedDims[0], paddedDims[0] * paddedDims[1] };
+	std::vector<ChunkBlockType> padded((size_t)strides[2] * paddedDims[2], CHUNK_BLOCK_AIR);
+	for (int z = -1; z <= dims[2]; ++z)
+	{
+		for (int y = -1; y <= dims[1]; ++y)
+		{
+			ChunkBlockType* paddedRow = &padded[(size_t)(y + 1) * strides[1] + (size_t)(z + 1) * strides[2]];
+			bool isRowInside = y >= 0 && y < dims[1] && z >= 0 && z < dims[2];
+			if (isRowInside)
+			{
+				ChunkBlockType const* row = input.m_blocks + (size_t)y * dims[0] + (size_t)z * dims[0] * dims[1];
+				for (int x = 0; x < dims[0]; ++x)
+				{
+					paddedRow[x + 1] = row[x];
+				}
+			}
+			if (!input.m_getNeighborBlock)
+			{
+				continue;
+			}
+			if (isRowInside)
+			{
+				paddedRow[0] = input.m_getNeighborBlock(IntVec3(-1, y, z));
+				paddedRow[dims[0] + 1] = input.m_getNeighborBlock(IntVec3(dims[0], y, z));
+				continue;
+			}
+			for (int x = -1; x <= dims[0]; ++x)
+			{
+				paddedRow[x + 1] = input.m_getNeighborBlock(IntVec3(x, y, z));
+			}
+		}
+	}
+
+	std::vector<unsigned int> mask;
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		int const axisU = (axis + 1) % 3;
+		int const axisV = (axis + 2) % 3;
+		int const dimU = dims[axisU];
+		int const dimV = dims[axisV];
+		int const strideU = strides[axisU];
+		int const strideV = strides[axisV];
+		mask.resize((size_t)dimU * dimV);
+
+		for (int sign = 1; sign >= -1; sign -= 2)
+		{
+			int const faceIndex = axis * 2 + (sign > 0 ? 0 : 1);
+			int const frontOffset = sign * strides[axis];
+			Vec3 const normal = AXIS_DIRECTIONS[axis] * (float)sign;
+			Vec3 const tangent = sign > 0 ? AXIS_DIRECTIONS[axisU] : AXIS_DIRECTIONS[axisV];
+			Vec3 const bitangent = sign > 0 ? AXIS_DIRECTIONS[axisV] : AXIS_DIRECTIONS[axisU];
+
+			for (int slice = 0; slice < dims[axis]; ++slice)
+			{
+				// Mask of visible faces in this slice, keyed by block type and the AO at the (u,v) corners (-,-) (+,-) (+,+) (-,+)
+				int const sliceIndex = 1 + strides[1] + strides[2] + slice * strides[axis];
+				for (int v = 0; v < dimV; ++v)
+				{
+					for (int u = 0; u < dimU; ++u)
+					{
+						int paddedIndex = sliceIndex + u * strideU + v * strideV;
+						ChunkBlockType block = padded[paddedIndex];
+						ChunkBlockType front = padded[paddedIndex + frontOffset];
+						unsigned int& key = mask[(size_t)v * dimU + u];
+						if (block == CHUNK_BLOCK_AIR || isOpaque[front] || front == block)
+						{
+							key = 0;
+							continue;
+						}
+
+						ChunkBlockType const* frontBlock = &padded[paddedIndex + frontOffset];
+						bool sideUNeg = isOpaque[frontBlock[-strideU]];
+						bool sideUPos = isOpaque[frontBlock[strideU]];
+						bool sideVNeg = isOpaque[frontBlock[-strideV]];
+						bool sideVPos = isOpaque[frontBlock[strideV]];
+						int ao0 = GetAmbientOcclusionLevel(sideUNeg, sideVNeg, isOpaque[frontBlock[-strideU - strideV]]);
+						int ao1 = GetAmbientOcclusionLevel(sideUPos, sideVNeg, isOpaque[frontBlock[strideU - strideV]]);
+						int ao2 = GetAmbientOcclusionLevel(sideUPos, sideVPos, isOpaque[frontBlock[strideU + strideV]]);
+						int ao3 = GetAmbientOcclusionLevel(sideUNeg, sideVPos, isOpaque[frontBlock[-strideU + strideV]]);
+						key = FACE_PRESENT_BIT | block | (ao0 << 8) | (ao1 << 10) | (ao2 << 12) | (ao3 << 14);
+						++stats.m_numVisibleFaces;
+					}
+				}
+
+				// Greedy merge: grow each face along u, then grow the whole run along v while every row matches
+				for (int v = 0; v < dimV; ++v)
+				{
+					for (int u = 0; u < dimU; )
+					{
+						unsigned int key = mask[(size_t)v * dimU + u];
+						if (key == 0)
+						{
+							++u;
+							continue;
+						}
+
+						int width = 1;
+						int height = 1;
+						if (input.m_mergeFaces)
+						{
+							while (u + width < dimU && mask[(size_t)v * dimU + u + width] == key)
+							{
+								++width;
+							}
+							for (; v + height < dimV; ++height)
+							{
+								unsigned int const* row = &mask[(size_t)(v + height) * dimU + u];
+								int rowU = 0;
+								while (rowU < width && row[rowU] == key)
+								{
+									++rowU;
+								}
+								if (rowU < width)
+								{
+									break;
+								}
+							}
+						}
+						for (int clearV = v; clearV < v + height; ++clearV)
+						{
+							for (int clearU = u; clearU < u + width; ++clearU)
+							{
+								mask[(size_t)clearV * dimU + clearU] = 0;
+							}
+						}
+
+						ChunkBlockAppearance const& appearance = *appearances[key & 0xFF];
+						AABB2 const& faceUVs = appearance.m_faceUVs[faceIndex];
+						Vec2 uvSize = faceUVs.m_maxs - faceUVs.m_mins;
+						int const aoLevels[4] = { (int)(key >> 8) & 3, (int)(key >> 10) & 3, (int)(key >> 12) & 3, (int)(key >> 14) & 3 };
+						float const cornerU[4] = { 0.f, (float)width, (float)width, 0.f };
+						float const cornerV[4] = { 0.f, 0.f, (float)height, (float)height };
+
+						// Corners go counter-clockwise seen from outside; the negative face walks them in reverse
+						static int const POSITIVE_ORDER[4] = { 0, 1, 2, 3 };
+						static int const NEGATIVE_ORDER[4] = { 0, 3, 2, 1 };
+						int const* cornerOrder = sign > 0 ? POSITIVE_ORDER : NEGATIVE_ORDER;
+
+						unsigned int firstVertIndex = (unsigned int)outVerts.size();
+						int emittedAO[4];
+						for (int vertNum = 0; vertNum < 4; ++vertNum)
+						{
+							int corner = cornerOrder[vertNum];
+							float position[3];
+							position[axis] = (float)(slice + (sign > 0 ? 1 : 0));
+							position[axisU] = (float)u + cornerU[corner];
+							position[axisV] = (float)v + cornerV[corner];
+							Vec3 worldPos = input.m_worldOrigin + Vec3(position[0], position[1], position[2]);
+
+							float texU = sign > 0 ? cornerU[corner] : cornerV[corner];
+							float texV = sign > 0 ? cornerV[corner] : cornerU[corner];
+							Vec2 uv(faceUVs.m_mins.x + uvSize.x * texU, faceUVs.m_mins.y + uvSize.y * texV);
+
+							emittedAO[vertNum] = aoLevels[corner];
+							Rgba8 color = GetShadedColor(appearance.m_tint, input.m_aoBrightness[aoLevels[corner]]);
+							outVerts.push_back(Vertex_PCUTBN(worldPos, color, uv, tangent, bitangent, normal));
+						}
+
+						// Split along the brighter diagonal so a single dark corner does not bleed across the whole quad
+						if (emittedAO[0] + emittedAO[2] >= emittedAO[1] + emittedAO[3])
+						{
+							unsigned int const quadIndexes[6] = { 0, 1, 2, 0, 2, 3 };
+							for (unsigned int quadIndex : quadIndexes)
+							{
+								outIndexes.push_back(firstVertIndex + quadIndex);
+							}
+						}
+						else
+						{
+							unsigned int const quadIndexes[6] = { 1, 2, 3, 1, 3, 0 };
+							for (unsigned int quadIndex : quadIndexes)
+							{
+								outIndexes.push_back(firstVertIndex + quadIndex);
+							}
+						}
+						++stats.m_numQuads;
+						u += width;
+					}
+				}
+			}
+		}
+	}
+	return stats;
+}
+
+//----------------------------------------------------------------------------------------------
+ChunkMeshJob::ChunkMeshJob(ChunkMeshInput const& input)
+	: m_input(input)
+{
+}
+
+void ChunkMeshJob::Execute()
+{
+	m_stats = BuildChunkMesh(m_input, m_vertexes, m_indexes);
+}
\ No newline at end of file
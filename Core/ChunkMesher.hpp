@@ -0,0 +1,87 @@
+#pragma once
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Core/JobWorker.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/IntVec3.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include <functional>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------
+// Greedy mesher for dense voxel chunks. Block (x,y,z) covers [x,x+1) x [y,y+1) x [z,z+1) in chunk-local space and
+// lives at m_blocks[x + y*dimX + z*dimX*dimY]. Each visible face is shaded with 0fps-style per-vertex ambient
+// occlusion, then coplanar faces with the same block type and the same four AO values are merged into one quad.
+// Quads are emitted as 4 verts + 6 indexes, wound counter-clockwise seen from outside, with the split diagonal
+// chosen from the AO values so occlusion gradients stay symmetric.
+//
+// UVs run from the face's m_faceUVs mins and advance one UV-box size per block, so an unmerged face covers exactly
+// its UV box while a WxH merged quad spans WxH boxes; sample merged chunks with a wrapping sampler (or wrap inside
+// the atlas tile in the shader). Vertex color is the block tint darkened by the AO level.
+//
+// BuildChunkMesh touches no shared state, so any number of chunks can be meshed at once from worker threads as
+// long as the neighbor callback is read-only.
+//
+typedef unsigned char ChunkBlockType;
+constexpr ChunkBlockType CHUNK_BLOCK_AIR = 0;
+
+// Returns the block at chunk-local coords outside the chunk (any of x/y/z may be -1 or dim); only called for the
+// one-block border around the chunk. Return CHUNK_BLOCK_AIR for unloaded neighbors.
+typedef std::function<ChunkBlockType(IntVec3 const& localCoords)> GetNeighborBlockCallback;
+
+enum class ChunkFace
+{
+	POS_X,
+	NEG_X,
+	POS_Y,
+	NEG_Y,
+	POS_Z,
+	NEG_Z,
+	COUNT
+};
+
+struct ChunkBlockAppearance
+{
+	ChunkBlockAppearance();	// opaque, white, every face 0..1
+
+	bool	m_isOpaque = true;
+	Rgba8	m_tint = Rgba8::WHITE;
+	AABB2	m_faceUVs[(int)ChunkFace::COUNT];
+};
+
+struct ChunkMeshInput
+{
+	ChunkBlockType const*						m_blocks = nullptr;
+	IntVec3										m_dimensions = IntVec3(16, 16, 128);
+	Vec3										m_worldOrigin;
+	std::vector<ChunkBlockAppearance> const*	m_appearances = nullptr;	// indexed by block type; types past the end are opaque and untinted
+	GetNeighborBlockCallback					m_getNeighborBlock;			// null treats everything outside the chunk as air
+	bool										m_mergeFaces = true;
+	float										m_aoBrightness[4] = { 0.45f, 0.65f, 0.85f, 1.f };	// by number of unoccluded neighbors, 0 = fully occluded
+};
+
+struct ChunkMeshStats
+{
+	int m_numVisibleFaces = 0;
+	int m_numQuads = 0;
+};
+
+// Appends to outVerts / outIndexes; indexes are relative to the vertexes already in outVerts
+ChunkMeshStats BuildChunkMesh(ChunkMeshInput const& input, std::vector<Vertex_PCUTBN>& outVerts, std::vector<unsigned int>& outIndexes);
+
+//----------------------------------------------------------------------------------------------
+// Meshes one chunk on a JobSystem worker. The block array, appearance table and callback referenced by m_input must
+// stay alive and unmodified until the job has completed.
+//
+class ChunkMeshJob : public Job
+{
+public:
+	explicit ChunkMeshJob(ChunkMeshInput const& input);
+	virtual void Execute() override;
+
+public:
+	ChunkMeshInput				m_input;
+	std::vector<Vertex_PCUTBN>	m_vertexes;
+	std::vector<unsigned int>	m_indexes;
+	ChunkMeshStats				m_stats;
+};
\ No newline at end of file
@@ -0,0 +1,416 @@
+#include "Engine/Core/ChunkScheduler.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/Frustum.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include <algorithm>
+#include <cmath>
+
+//----------------------------------------------------------------------------------------------
+// Runs the generation or meshing callback of one chunk on a worker
+class ChunkSchedulerJob : public Job
+{
+public:
+	ChunkSchedulerJob(ChunkWorkCallback const& callback, IntVec3 const& chunkCoords, ChunkState runningState)
+		: m_callback(callback)
+		, m_chunkCoords(chunkCoords)
+		, m_runningState(runningState)
+	{
+	}
+
+	virtual void Execute() override
+	{
+		m_callback(m_chunkCoords);
+	}
+
+public:
+	ChunkWorkCallback const&	m_callback;
+	IntVec3						m_chunkCoords;
+	ChunkState					m_runningState;
+};
+
+namespace
+{
+	// The tracked set is only rescanned once the camera has moved this far, in chunks
+	constexpr float CHUNK_RESCAN_DISTANCE = 0.25f;
+}
+
+//----------------------------------------------------------------------------------------------
+ChunkScheduler::ChunkScheduler(ChunkSchedulerConfig const& config)
+	: m_config(config)
+{
+	GUARANTEE_OR_DIE(m_config.m_deactivationRadius >= m_config.m_activationRadius, "ChunkScheduler deactivation radius is less than the activation radius");
+	GUARANTEE_OR_DIE(m_config.m_generateChunk && m_config.m_meshChunk && m_config.m_uploadChunk && m_config.m_deactivateChunk, "ChunkScheduler is missing a callback");
+}
+
+ChunkScheduler::~ChunkScheduler()
+{
+	if (m_config.m_jobSystem != nullptr && !m_jobsInFlight.empty())
+	{
+		m_config.m_jobSystem->WaitUntilJobsCompleted(m_jobsInFlight);
+	}
+	for (Job* job : m_jobsInFlight)
+	{
+		delete job;
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+void ChunkScheduler::Update(Vec3 const& cameraPosition, Frustum const* frustum)
+{
+	m_lastFrameStats = ChunkSchedulerStats();
+	RetrieveCompletedJobs();
+
+	Vec2 cameraInChunks(cameraPosition.x / m_config.m_chunkWorldSize.x, cameraPosition.y / m_config.m_chunkWorldSize.y);
+	if (!m_hasScanned || GetDistanceSquared2D(cameraInChunks, m_lastScanPosition) >= CHUNK_RESCAN_DISTANCE * CHUNK_RESCAN_DISTANCE)
+	{
+		UpdateTrackedChunks(cameraPosition);
+		m_hasScanned = true;
+		m_lastScanPosition = cameraInChunks;
+	}
+
+	// Bucket the chunks waiting on each stage; chunks left behind before their generation started are simply dropped
+	m_generationCandidates.clear();
+	m_meshCandidates.clear();
+	m_uploadCandidates.clear();
+	m_deactivationCandidates.clear();
+	for (auto chunkIter = m_chunks.begin(); chunkIter != m_chunks.end(); )
+	{
+		IntVec3 const& chunkCoords = chunkIter->first;
+		ScheduledChunk const& chunk = chunkIter->second;
+		if (chunk.m_isOutOfRange)
+		{
+			if (chunk.m_state == ChunkState::WAITING_FOR_GENERATION)
+			{
+				chunkIter = m_chunks.erase(chunkIter);
+				continue;
+			}
+			if (chunk.m_state != ChunkState::GENERATING && chunk.m_state != ChunkState::MESHING)
+			{
+				m_deactivationCandidates.push_back({ -GetChunkXYDistance(chunkCoords, cameraPosition), chunkCoords });
+			}
+		}
+		else if (chunk.m_state == ChunkState::WAITING_FOR_GENERATION)
+		{
+			m_generationCandidates.push_back({ GetChunkPriority(chunkCoords, cameraPosition, frustum), chunkCoords });
+		}
+		else if (chunk.m_state == ChunkState::WAITING_FOR_MESH)
+		{
+			m_meshCandidates.push_back({ GetChunkPriority(chunkCoords, cameraPosition, frustum), chunkCoords });
+		}
+		else if (chunk.m_state == ChunkState::WAITING_FOR_UPLOAD)
+		{
+			m_uploadCandidates.push_back({ GetChunkPriority(chunkCoords, cameraPosition, frustum), chunkCoords });
+		}
+		++chunkIter;
+	}
+
+	// Farthest first; a chunk whose neighbor is being meshed is kept until the mesh job is done reading it
+	int numDeactivations = 0;
+	std::make_heap(m_deactivationCandidates.begin(), m_deactivationCandidates.end(), IsLowerPriority);
+	while (!m_deactivationCandidates.empty() && numDeactivations < m_config.m_maxDeactivationsPerFrame)
+	{
+		std::pop_heap(m_deactivationCandidates.begin(), m_deactivationCandidates.end(), IsLowerPriority);
+		IntVec3 chunkCoords = m_deactivationCandidates.back().m_chunkCoords;
+		m_deactivationCandidates.pop_back();
+		if (IsAnyNeighborInState(chunkCoords, ChunkState::MESHING, ChunkState::MESHING))
+		{
+			continue;
+		}
+		m_config.m_deactivateChunk(chunkCoords);
+		m_chunks.erase(chunkCoords);
+		++numDeactivations;
+	}
+	m_lastFrameStats.m_numDeactivations = numDeactivations;
+
+	// Uploads stop once either budget is reached, but the first one always goes through so a large mesh cannot stall
+	std::make_heap(m_uploadCandidates.begin(), m_uploadCandidates.end(), IsLowerPriority);
+	while (!m_uploadCandidates.empty() && m_lastFrameStats.m_numUploads < m_config.m_maxUploadsPerFrame)
+	{
+		if (m_lastFrameStats.m_numUploads > 0 && m_lastFrameStats.m_numUploadBytes >= m_config.m_maxUploadBytesPerFrame)
+		{
+			break;
+		}
+		std::pop_heap(m_uploadCandidates.begin(), m_uploadCandidates.end(), IsLowerPriority);
+		IntVec3 chunkCoords = m_uploadCandidates.back().m_chunkCoords;
+		m_uploadCandidates.pop_back();
+		ScheduledChunk& chunk = m_chunks[chunkCoords];
+		m_lastFrameStats.m_numUploadBytes += m_config.m_uploadChunk(chunkCoords);
+		++m_lastFrameStats.m_numUploads;
+		chunk.m_hasUploadedMesh = true;
+		chunk.m_state = chunk.m_needsRemesh ? ChunkState::WAITING_FOR_MESH : ChunkState::ACTIVE;
+		chunk.m_needsRemesh = false;
+	}
+
+	// Meshing goes before generation so that a chunk starting to mesh this frame holds back its neighbors' generation
+	int meshBudget = std::min(m_config.m_maxMeshJobsPerFrame, m_config.m_maxMeshJobsInFlight - m_numMeshJobsInFlight);
+	m_lastFrameStats.m_numMeshJobsStarted = ServeCandidates(m_meshCandidates, ChunkState::MESHING, meshBudget);
+	int generationBudget = std::min(m_config.m_maxGenerationJobsPerFrame, m_config.m_maxGenerationJobsInFlight - m_numGenerationJobsInFlight);
+	m_lastFrameStats.m_numGenerationJobsStarted = ServeCandidates(m_generationCandidates, ChunkState::GENERATING, generationBudget);
+
+	m_lastFrameStats.m_numGenerationJobsInFlight = m_numGenerationJobsInFlight;
+	m_lastFrameStats.m_numMeshJobsInFlight = m_numMeshJobsInFlight;
+	m_lastFrameStats.m_numChunksTracked = (int)m_chunks.size();
+	for (auto const& chunkEntry : m_chunks)
+	{
+		if (chunkEntry.second.m_hasUploadedMesh)
+		{
+			++m_lastFrameStats.m_numChunksActive;
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+void ChunkScheduler::DeactivateAllChunks()
+{
+	if (m_config.m_jobSystem != nullptr && !m_jobsInFlight.empty())
+	{
+		m_config.m_jobSystem->WaitUntilJobsCompleted(m_jobsInFlight);
+	}
+	for (Job* job : m_jobsInFlight)
+	{
+		delete job;
+	}
+	m_jobsInFlight.clear();
+	m_numGenerationJobsInFlight = 0;
+	m_numMeshJobsInFlight = 0;
+
+	// Every job has finished, so anything past WAITING_FOR_GENERATION has been generated
+	for (auto const& chunkEntry : m_chunks)
+	{
+		if (chunkEntry.second.m_state != ChunkState::WAITING_FOR_GENERATION)
+		{
+			m_config.m_deactivateChunk(chunkEntry.first);
+		}
+	}
+	m_chunks.clear();
+	m_hasScanned = false;
+}
+
+//----------------------------------------------------------------------------------------------
+void ChunkScheduler::MarkChunkDirty(IntVec3 const& chunkCoords)
+{
+	auto found = m_chunks.find(chunkCoords);
+	if (found == m_chunks.end())
+	{
+		return;
+	}
+	ScheduledChunk& chunk = found->second;
+	if (chunk.m_state == ChunkState::ACTIVE)
+	{
+		chunk.m_state = ChunkState::WAITING_FOR_MESH;
+	}
+	else if (chunk.m_state == ChunkState::MESHING || chunk.m_state == ChunkState::WAITING_FOR_UPLOAD)
+	{
+		chunk.m_needsRemesh = true;
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+ChunkState ChunkScheduler::GetChunkState(IntVec3 const& chunkCoords) const
+{
+	auto found = m_chunks.find(chunkCoords);
+	return found == m_chunks.end() ? ChunkState::NOT_TRACKED : found->second.m_state;
+}
+
+bool ChunkScheduler::IsChunkActive(IntVec3 const& chunkCoords) const
+{
+	auto found = m_chunks.find(chunkCoords);
+	return found != m_chunks.end() && found->second.m_hasUploadedMesh;
+}
+
+IntVec3 ChunkScheduler::GetChunkCoordsForWorldPosition(Vec3 const& worldPosition) const
+{
+	return IntVec3((int)floorf(worldPosition.x / m_config.m_chunkWorldSize.x),
+		(int)floorf(worldPosition.y / m_config.m_chunkWorldSize.y),
+		(int)floorf(worldPosition.z / m_config.m_chunkWorldSize.z));
+}
+
+//----------------------------------------------------------------------------------------------
+void ChunkScheduler::UpdateTrackedChunks(Vec3 const& cameraPosition)
+{
+	// Between the two radii a chunk keeps whatever it was: that band is the hysteresis
+	for (auto& chunkEntry : m_chunks)
+	{
+		float distance = GetChunkXYDistance(chunkEntry.first, cameraPosition);
+		if (distance > m_config.m_deactivationRadius)
+		{
+			chunkEntry.second.m_isOutOfRange = true;
+		}
+		else if (distance <= m_config.m_activationRadius)
+		{
+			chunkEntry.second.m_isOutOfRange = false;
+		}
+	}
+
+	float cameraX = cameraPosition.x / m_config.m_chunkWorldSize.x;
+	float cameraY = cameraPosition.y / m_config.m_chunkWorldSize.y;
+	float radius = m_config.m_activationRadius;
+	int minX = (int)floorf(cameraX - radius);
+	int maxX = (int)floorf(cameraX + radius);
+	int minY = (int)floorf(cameraY - radius);
+	int maxY = (int)floorf(cameraY + radius);
+	for (int chunkY = minY; chunkY <= maxY; ++chunkY)
+	{
+		for (int chunkX = minX; chunkX <= maxX; ++chunkX)
+		{
+			if (GetChunkXYDistance(IntVec3(chunkX, chunkY, 0), cameraPosition) > radius)
+			{
+				continue;
+			}
+			for (int chunkZ = m_config.m_chunkZRange.m_min; chunkZ <= m_config.m_chunkZRange.m_max; ++chunkZ)
+			{
+				m_chunks.emplace(IntVec3(chunkX, chunkY, chunkZ), ScheduledChunk());
+			}
+		}
+	}
+}
+
+void ChunkScheduler::RetrieveCompletedJobs()
+{
+	if (m_config.m_jobSystem == nullptr)
+	{
+		return;
+	}
+	m_completedJobs.clear();
+	m_config.m_jobSystem->RetrieveCompletedJobsFrom(m_jobsInFlight, m_completedJobs);
+	for (Job* job : m_completedJobs)
+	{
+		ChunkSchedulerJob* chunkJob = (ChunkSchedulerJob*)job;
+		if (chunkJob->m_runningState == ChunkState::GENERATING)
+		{
+			--m_numGenerationJobsInFlight;
+		}
+		else
+		{
+			--m_numMeshJobsInFlight;
+		}
+		OnStageCompleted(chunkJob->m_chunkCoords, chunkJob->m_runningState);
+		delete chunkJob;
+	}
+	m_completedJobs.clear();
+}
+
+void ChunkScheduler::OnStageCompleted(IntVec3 const& chunkCoords, ChunkState completedState)
+{
+	auto found = m_chunks.find(chunkCoords);
+	GUARANTEE_OR_DIE(found != m_chunks.end(), "ChunkScheduler lost a chunk with work in flight");
+	if (completedState == ChunkState::MESHING)
+	{
+		found->second.m_state = ChunkState::WAITING_FOR_UPLOAD;
+		return;
+	}
+
+	// New blocks next door change which border faces are hidden, so neighbors meshed without them mesh again
+	found->second.m_state = ChunkState::WAITING_FOR_MESH;
+	for (int offsetZ = -1; offsetZ <= 1; ++offsetZ)
+	{
+		for (int offsetY = -1; offsetY <= 1; ++offsetY)
+		{
+			for (int offsetX = -1; offsetX <= 1; ++offsetX)
+			{
+				if (offsetX == 0 && offsetY == 0 && offsetZ == 0)
+				{
+					continue;
+				}
+				MarkChunkDirty(chunkCoords + IntVec3(offsetX, offsetY, offsetZ));
+			}
+		}
+	}
+}
+
+void ChunkScheduler::StartStage(IntVec3 const& chunkCoords, ScheduledChunk& chunk, ChunkState runningState)
+{
+	chunk.m_state = runningState;
+	ChunkWorkCallback const& callback = runningState == ChunkState::GENERATING ? m_config.m_generateChunk : m_config.m_meshChunk;
+	if (m_config.m_jobSystem == nullptr)
+	{
+		callback(chunkCoords);
+		OnStageCompleted(chunkCoords, runningState);
+		return;
+	}
+
+	if (runningState == ChunkState::GENERATING)
+	{
+		++m_numGenerationJobsInFlight;
+	}
+	else
+	{
+		++m_numMeshJobsInFlight;
+	}
+	ChunkSchedulerJob* job = new ChunkSchedulerJob(callback, chunkCoords, runningState);
+	m_jobsInFlight.push_back(job);
+	m_config.m_jobSystem->QueueJob(job);
+}
+
+int ChunkScheduler::ServeCandidates(std::vector<Candidate>& candidates, ChunkState runningState, int budget)
+{
+	int numStarted = 0;
+	std::make_heap(candidates.begin(), candidates.end(), IsLowerPriority);
+	while (!candidates.empty() && numStarted < budget)
+	{
+		std::pop_heap(candidates.begin(), candidates.end(), IsLowerPriority);
+		IntVec3 chunkCoords = candidates.back().m_chunkCoords;
+		candidates.pop_back();
+		bool isBlocked = runningState == ChunkState::GENERATING
+			? IsAnyNeighborInState(chunkCoords, ChunkState::MESHING, ChunkState::MESHING)
+			: IsAnyNeighborInState(chunkCoords, ChunkState::WAITING_FOR_GENERATION, ChunkState::GENERATING);
+		if (isBlocked)
+		{
+			continue;
+		}
+		StartStage(chunkCoords, m_chunks[chunkCoords], runningState);
+		++numStarted;
+	}
+	return numStarted;
+}
+
+//----------------------------------------------------------------------------------------------
+bool ChunkScheduler::IsAnyNeighborInState(IntVec3 const& chunkCoords, ChunkState minState, ChunkState maxState) const
+{
+	for (int offsetZ = -1; offsetZ <= 1; ++offsetZ)
+	{
+		for (int offsetY = -1; offsetY <= 1; ++offsetY)
+		{
+			for (int offsetX = -1; offsetX <= 1; ++offsetX)
+			{
+				if (offsetX == 0 && offsetY == 0 && offsetZ == 0)
+				{
+					continue;
+				}
+				auto found = m_chunks.find(chunkCoords + IntVec3(offsetX, offsetY, offsetZ));
+				if (found != m_chunks.end() && found->second.m_state >= minState && found->second.m_state <= maxState)
+				{
+					return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
+float ChunkScheduler::GetChunkXYDistance(IntVec3 const& chunkCoords, Vec3 const& cameraPosition) const
+{
+	Vec2 chunkCenter((float)chunkCoords.x + 0.5f, (float)chunkCoords.y + 0.5f);
+	Vec2 cameraInChunks(cameraPosition.x / m_config.m_chunkWorldSize.x, cameraPosition.y / m_config.m_chunkWorldSize.y);
+	return GetDistance2D(chunkCenter, cameraInChunks);
+}
+
+float ChunkScheduler::GetChunkPriority(IntVec3 const& chunkCoords, Vec3 const& cameraPosition, Frustum const* frustum) const
+{
+	Vec3 const& size = m_config.m_chunkWorldSize;
+	Vec3 mins((float)chunkCoords.x * size.x, (float)chunkCoords.y * size.y, (float)chunkCoords.z * size.z);
+	Vec3 maxs = mins + size;
+	float priority = GetDistanceSquared3D((mins + maxs) * 0.5f, cameraPosition);
+	if (frustum != nullptr && !frustum->IsAABBVisible(AABB3(mins, maxs)))
+	{
+		priority *= m_config.m_offscreenPriorityScale * m_config.m_offscreenPriorityScale;
+	}
+	return priority;
+}
+
+bool ChunkScheduler::IsLowerPriority(Candidate const& a, Candidate const& b)
+{
+	return a.m_priority > b.m_priority;
+}
\ No newline at end of file
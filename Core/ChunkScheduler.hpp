@@ -0,0 +1,141 @@
+#pragma once
+#include "Engine/Math/IntRange.hpp"
+#include "Engine/Math/IntVec3.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include <functional>
+#include <map>
+#include <vector>
+
+class Job;
+class JobSystem;
+struct Frustum;
+
+//----------------------------------------------------------------------------------------------
+// Decides which chunks around the camera are live and paces the work of bringing them up and tearing them down.
+//
+// A chunk goes WAITING_FOR_GENERATION -> GENERATING -> WAITING_FOR_MESH -> MESHING -> WAITING_FOR_UPLOAD -> ACTIVE.
+// Chunk columns within m_activationRadius (XY distance in chunks from the camera) are tracked; they are only
+// deactivated once they fall beyond m_deactivationRadius, so a camera idling at the boundary does not thrash.
+// Every frame the waiting chunks of each stage are served closest first, with chunks outside the view frustum
+// treated as m_offscreenPriorityScale times farther away, and each stage stops at its per-frame budget.
+//
+// Generation and meshing run through the JobSystem; uploads and deactivations run on the main thread inside Update.
+// The callbacks own all chunk data, the scheduler only tracks coordinates. Two rules keep worker callbacks race-free:
+// a chunk is not generated or deactivated while any of its 26 neighbors is meshing, and a chunk is not meshed while
+// any tracked neighbor has not finished generating. A chunk is remeshed when a neighbor finishes generating after it.
+//
+typedef std::function<void(IntVec3 const& chunkCoords)>		ChunkWorkCallback;
+typedef std::function<size_t(IntVec3 const& chunkCoords)>	ChunkUploadCallback;		// returns the bytes uploaded
+
+enum class ChunkState
+{
+	NOT_TRACKED,
+	WAITING_FOR_GENERATION,
+	GENERATING,
+	WAITING_FOR_MESH,
+	MESHING,
+	WAITING_FOR_UPLOAD,
+	ACTIVE,
+	COUNT
+};
+
+struct ChunkSchedulerConfig
+{
+	JobSystem*			m_jobSystem = nullptr;				// null runs generation and meshing inline, still within budgets
+	Vec3				m_chunkWorldSize = Vec3(16.f, 16.f, 128.f);
+	IntRange			m_chunkZRange = IntRange(0, 0);		// chunk z coords tracked in every column
+	float				m_activationRadius = 12.f;			// in chunks
+	float				m_deactivationRadius = 14.f;		// in chunks, must not be less than m_activationRadius
+	float				m_offscreenPriorityScale = 4.f;
+
+	int					m_maxGenerationJobsPerFrame = 4;
+	int					m_maxGenerationJobsInFlight = 16;
+	int					m_maxMeshJobsPerFrame = 4;
+	int					m_maxMeshJobsInFlight = 16;
+	int					m_maxUploadsPerFrame = 4;
+	size_t				m_maxUploadBytesPerFrame = 4 * 1024 * 1024;	// at least one upload per frame always goes through
+	int					m_maxDeactivationsPerFrame = 8;
+
+	ChunkWorkCallback	m_generateChunk;		// worker thread
+	ChunkWorkCallback	m_meshChunk;			// worker thread; may read the blocks of generated neighbors
+	ChunkUploadCallback	m_uploadChunk;			// main thread
+	ChunkWorkCallback	m_deactivateChunk;		// main thread; called for every chunk whose generation completed
+};
+
+struct ChunkSchedulerStats
+{
+	int		m_numGenerationJobsStarted = 0;
+	int		m_numMeshJobsStarted = 0;
+	int		m_numUploads = 0;
+	size_t	m_numUploadBytes = 0;
+	int		m_numDeactivations = 0;
+	int		m_numGenerationJobsInFlight = 0;
+	int		m_numMeshJobsInFlight = 0;
+	int		m_numChunksTracked = 0;
+	int		m_numChunksActive = 0;		// chunks with a mesh on the GPU
+};
+
+class ChunkScheduler
+{
+public:
+	explicit ChunkScheduler(ChunkSchedulerConfig const& config);
+	~ChunkScheduler();		// waits for jobs in flight; calls no callbacks
+	ChunkScheduler(ChunkScheduler const& copy) = delete;
+	ChunkScheduler& operator=(ChunkScheduler const& copy) = delete;
+
+	// Once per frame on the main thread; frustum may be null to rank by distance only
+	void						Update(Vec3 const& cameraPosition, Frustum const* frustum);
+
+	// Waits for jobs in flight, then deactivates every generated chunk and forgets all chunks
+	void						DeactivateAllChunks();
+
+	// Queue a remesh after the chunk's blocks (or light) changed; ignored for chunks not generated yet. Edit blocks
+	// only while neither the chunk nor a neighbor is GENERATING or MESHING.
+	void						MarkChunkDirty(IntVec3 const& chunkCoords);
+
+	ChunkState					GetChunkState(IntVec3 const& chunkCoords) const;
+	bool						IsChunkActive(IntVec3 const& chunkCoords) const;	// has a mesh on the GPU, possibly being remeshed
+	ChunkSchedulerStats const&	GetLastFrameStats() const						{ return m_lastFrameStats; }
+	IntVec3						GetChunkCoordsForWorldPosition(Vec3 const& worldPosition) const;
+
+private:
+	struct ScheduledChunk
+	{
+		ChunkState	m_state = ChunkState::WAITING_FOR_GENERATION;
+		bool		m_needsRemesh = false;
+		bool		m_isOutOfRange = false;
+		bool		m_hasUploadedMesh = false;
+	};
+
+	struct Candidate
+	{
+		float		m_priority = 0.f;		// lower goes first
+		IntVec3		m_chunkCoords;
+	};
+
+	void			UpdateTrackedChunks(Vec3 const& cameraPosition);
+	void			RetrieveCompletedJobs();
+	void			OnStageCompleted(IntVec3 const& chunkCoords, ChunkState completedState);
+	void			StartStage(IntVec3 const& chunkCoords, ScheduledChunk& chunk, ChunkState runningState);
+	bool			IsAnyNeighborInState(IntVec3 const& chunkCoords, ChunkState minState, ChunkState maxState) const;
+	float			GetChunkXYDistance(IntVec3 const& chunkCoords, Vec3 const& cameraPosition) const;
+	float			GetChunkPriority(IntVec3 const& chunkCoords, Vec3 const& cameraPosition, Frustum const* frustum) const;
+	int				ServeCandidates(std::vector<Candidate>& candidates, ChunkState runningState, int budget);
+	static bool		IsLowerPriority(Candidate const& a, Candidate const& b);
+
+private:
+	ChunkSchedulerConfig					m_config;
+	std::map<IntVec3, ScheduledChunk>		m_chunks;
+	std::vector<Job*>						m_jobsInFlight;
+	std::vector<Job*>						m_completedJobs;
+	int										m_numGenerationJobsInFlight = 0;
+	int										m_numMeshJobsInFlight = 0;
+	bool									m_hasScanned = false;
+	Vec2									m_lastScanPosition;	// in chunks
+	ChunkSchedulerStats						m_lastFrameStats;
+	std::vector<Candidate>					m_generationCandidates;
+	std::vector<Candidate>					m_meshCandidates;
+	std::vector<Candidate>					m_uploadCandidates;
+	std::vector<Candidate>					m_deactivationCandidates;
+};
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/EngineSelfTests.hpp"
 #include "Engine/Core/Time.hpp"
 #include "Engine/Core/VertexUtils.hpp"
 #include "Engine/Input/InputSystem.hpp"
@@ -30,6 +31,8 @@ void DevConsole::Startup()
 	g_theEventSystem->SubscribeEventCallbackFunction("KeyPressed", DevConsole::Event_KeyPressed);
 	g_theEventSystem->SubscribeEventCallbackFunction("CharInput", DevConsole::Event_CharInput);
 	g_theEventSystem->SubscribeEventCallbackFunction("help", Command_Help);
+	g_theEventSystem->SubscribeEventCallbackFunction("selftest", Command_SelfTest);
+	g_theEventSystem->SubscribeEventCallbackFunction("selfbench", Command_SelfBench);
 	//g_theEventSystem->SubscribeEventCallbackFunction("clear", Command_Clear);
 	g_theConsole->AddLine(DevConsole::INFO_MAJOR, "help - Get help menu");
 }
@@ -353,6 +356,30 @@ bool DevConsole::Command_Help(EventArgs& args)
 	return true;
 }
 
+bool DevConsole::Command_SelfTest(EventArgs& args)
+{
+	UNUSED(args);
+	std::vector<std::string> reportLines;
+	bool allPassed = RunEngineSelfTests(reportLines);
+	for (std::string const& line : reportLines)
+	{
+		g_theConsole->AddLine(allPassed ? INFO_MINOR : ERROR_COLOR, line);
+	}
+	return true;
+}
+
+bool DevConsole::Command_SelfBench(EventArgs& args)
+{
+	UNUSED(args);
+	std::vector<std::string> reportLines;
+	RunEngineBenchmarks(reportLines);
+	for (std::string const& line : reportLines)
+	{
+		g_theConsole->AddLine(INFO_MINOR, line);
+	}
+	return true;
+}
+
 
 
 
@@ -68,6 +68,12 @@ public:
 	// Display all currently registered commands in the event system.
 	static bool Command_Help(EventArgs& args);
 
+	// Run the engine self-checks (see EngineSelfTests.hpp) and print their results.
+	static bool Command_SelfTest(EventArgs& args);
+
+	// Run the engine micro-benchmarks (see EngineSelfTests.hpp) and print their results.
+	static bool Command_SelfBench(EventArgs& args);
+
 public:
 	void Render_OpenFull( AABB2 const& bounds, Renderer& renderer, BitmapFont& font, float fontAspect=1.f) const;
 
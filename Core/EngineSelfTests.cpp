@@ -0,0 +1,1609 @@
+#include "Engine/Core/EngineSelfTests.hpp"
+#include "Engine/Core/ChunkMesher.hpp"
+#include "Engine/Core/HeatMaps.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Core/TilePathCache.hpp"
+#include "Engine/Core/TilePathfinding.hpp"
+#include "Engine/Core/VoxelLightEngine.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/AABB3Tree.hpp"
+#include "Engine/Math/CatmullRomSpline.hpp"
+#include "Engine/Math/CatmullRomSpline3D.hpp"
+#include "Engine/Math/CubicBezierCurve2D.hpp"
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/FastTrig.hpp"
+#include "Engine/Math/Frustum.hpp"
+#include "Engine/Math/OverlapBatch3D.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Math/RawNoise.hpp"
+#include "Engine/Math/RawNoiseGrid.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <queue>
+
+//----------------------------------------------------------------------------------------------
+namespace
+{
+	constexpr double REFERENCE_UNREACHED = 1e30;
+
+	// Wall tiles are impassable; the rest cost 1, or 1..maxCost when maxCost > 1
+	TileHeatMap MakeRandomCostMap(IntVec2 const& dims, float wallChance, int maxCost, RandomNumberGenerator& rng)
+	{
+		TileHeatMap costs(dims);
+		for (int tileIndex = 0; tileIndex < dims.x * dims.y; ++tileIndex)
+		{
+			bool isWall = rng.RollRandomFloatZeroToOne() < wallChance;
+			costs.GetValues()[tileIndex] = isWall ? TILE_COST_IMPASSABLE : (maxCost > 1 ? (float)rng.RollRandomIntInRange(1, maxCost) : 1.f);
+		}
+		return costs;
+	}
+
+	bool IsDiagonalStepAllowed(TileHeatMap const& costs, IntVec2 const& from, IntVec2 const& step, TilePathSettings const& settings)
+	{
+		return settings.m_allowDiagonals && (settings.m_allowCornerCutting
+			|| (IsTilePassable(costs.GetValue(IntVec2(from.x + step.x, from.y)), settings) && IsTilePassable(costs.GetValue(IntVec2(from.x, from.y + step.y)), settings)));
+	}
+
+	// Textbook Dijkstra in doubles with std::priority_queue, the reference the pathfinding code must agree with
+	std::vector<double> ComputeReferenceDistances(TileHeatMap const& costs, IntVec2 const& source, TilePathSettings const& settings)
+	{
+		constexpr double SQRT_2 = 1.4142135623730951;
+		IntVec2 const offsets[8] = { IntVec2(1, 0), IntVec2(-1, 0), IntVec2(0, 1), IntVec2(0, -1), IntVec2(1, 1), IntVec2(-1, 1), IntVec2(1, -1), IntVec2(-1, -1) };
+		IntVec2 dims = costs.GetDimensions();
+		std::vector<double> distances(dims.x * dims.y, REFERENCE_UNREACHED);
+		if (!IsTilePassable(costs.GetValue(source), settings))
+		{
+			return distances;
+		}
+
+		typedef std::pair<double, int> QueuedTile;
+		std::priority_queue<QueuedTile, std::vector<QueuedTile>, std::greater<QueuedTile>> queue;
+		distances[source.x + source.y * dims.x] = 0.0;
+		queue.push(QueuedTile(0.0, source.x + source.y * dims.x));
+		while (!queue.empty())
+		{
+			QueuedTile queued = queue.top();
+			queue.pop();
+			if (queued.first > distances[queued.second])
+			{
+				continue;
+			}
+			IntVec2 tileCoords(queued.second % dims.x, queued.second / dims.x);
+			for (int offsetIndex = 0; offsetIndex < (settings.m_allowDiagonals ? 8 : 4); ++offsetIndex)
+			{
+				IntVec2 neighbor = tileCoords + offsets[offsetIndex];
+				bool isDiagonal = offsetIndex >= 4;
+				if (!costs.IsInBounds(neighbor) || !IsTilePassable(costs.GetValue(neighbor), settings)
+					|| (isDiagonal && !IsDiagonalStepAllowed(costs, tileCoords, offsets[offsetIndex], settings)))
+				{
+					continue;
+				}
+				double distance = queued.first + (double)costs.GetValue(neighbor) * (isDiagonal ? SQRT_2 : 1.0);
+				int neighborIndex = neighbor.x + neighbor.y * dims.x;
+				if (distance < distances[neighborIndex])
+				{
+					distances[neighborIndex] = distance;
+					queue.push(QueuedTile(distance, neighborIndex));
+				}
+			}
+		}
+		return distances;
+	}
+
+	// The path's cost if it runs start..goal through passable tiles in legal steps, otherwise -1
+	double GetWalkedPathCost(TileHeatMap const& costs, std::vector<IntVec2> const& path, IntVec2 const& start, IntVec2 const& goal, TilePathSettings const& settings)
+	{
+		if (path.empty() || path.front() != start || path.back() != goal)
+		{
+			return -1.0;
+		}
+		double cost = 0.0;
+		for (size_t stepIndex = 1; stepIndex < path.size(); ++stepIndex)
+		{
+			IntVec2 step = path[stepIndex] - path[stepIndex - 1];
+			bool isDiagonal = step.x != 0 && step.y != 0;
+			if (abs(step.x) > 1 || abs(step.y) > 1 || step == IntVec2(0, 0) || !IsTilePassable(costs.GetValue(path[stepIndex]), settings)
+				|| (isDiagonal && !IsDiagonalStepAllowed(costs, path[stepIndex - 1], step, settings)))
+			{
+				return -1.0;
+			}
+			cost += (double)costs.GetValue(path[stepIndex]) * (isDiagonal ? 1.4142135623730951 : 1.0);
+		}
+		return cost;
+	}
+
+	bool IsNearReference(double value, double reference)
+	{
+		return fabs(value - reference) <= 1e-3 * (1.0 + reference);
+	}
+
+	// 41 sections zig-zagging along +x, one of them zero-length (two coincident points)
+	std::vector<Vec2> MakeTestSplinePoints(RandomNumberGenerator& rng)
+	{
+		std::vector<Vec2> points;
+		for (int pointIndex = 0; pointIndex < 40; ++pointIndex)
+		{
+			points.push_back(Vec2((float)(pointIndex * 10 + rng.RollRandomIntLessThan(15)), (float)rng.RollRandomIntLessThan(200)));
+		}
+		points.push_back(points.back());
+		points.push_back(Vec2(500.f, 50.f));
+		return points;
+	}
+
+	// Dense chord walk in doubles over a composite cubic Bezier (3 * numSegments + 1 control points), the reference
+	// the arc-length tables must agree with
+	class ReferenceChordWalk
+	{
+	public:
+		ReferenceChordWalk(std::vector<Vec2> const& bezierControlPoints, int chordsPerSegment)
+		{
+			m_xs.push_back(bezierControlPoints[0].x);
+			m_ys.push_back(bezierControlPoints[0].y);
+			m_cumulativeLengths.push_back(0.0);
+			for (size_t firstPoint = 0; firstPoint + 3 < bezierControlPoints.size(); firstPoint += 3)
+			{
+				Vec2 const* controls = &bezierControlPoints[firstPoint];
+				for (int chordIndex = 1; chordIndex <= chordsPerSegment; ++chordIndex)
+				{
+					double t = (double)chordIndex / (double)chordsPerSegment;
+					double u = 1.0 - t;
+					double weights[4] = { u * u * u, 3.0 * u * u * t, 3.0 * u * t * t, t * t * t };
+					double x = 0.0;
+					double y = 0.0;
+					for (int controlIndex = 0; controlIndex < 4; ++controlIndex)
+					{
+						x += weights[controlIndex] * (double)controls[controlIndex].x;
+						y += weights[controlIndex] * (double)controls[controlIndex].y;
+					}
+					m_cumulativeLengths.push_back(m_cumulativeLengths.back() + sqrt((x - m_xs.back()) * (x - m_xs.back()) + (y - m_ys.back()) * (y - m_ys.back())));
+					m_xs.push_back(x);
+					m_ys.push_back(y);
+				}
+			}
+		}
+
+		double GetLength() const		{ return m_cumulativeLengths.back(); }
+
+		// Distance from the chord walk's point at distanceAlongCurve to position
+		double GetDistanceFromPointAt(double distanceAlongCurve, Vec2 const& position) const
+		{
+			size_t chordEnd = std::lower_bound(m_cumulativeLengths.begin() + 1, m_cumulativeLengths.end() - 1, distanceAlongCurve) - m_cumulativeLengths.begin();
+			double chordLength = m_cumulativeLengths[chordEnd] - m_cumulativeLengths[chordEnd - 1];
+			double fraction = chordLength > 0.0 ? (distanceAlongCurve - m_cumulativeLengths[chordEnd - 1]) / chordLength : 0.0;
+			double x = m_xs[chordEnd - 1] + (m_xs[chordEnd] - m_xs[chordEnd - 1]) * fraction;
+			double y = m_ys[chordEnd - 1] + (m_ys[chordEnd] - m_ys[chordEnd - 1]) * fraction;
+			return sqrt((x - (double)position.x) * (x - (double)position.x) + (y - (double)position.y) * (y - (double)position.y));
+		}
+
+	private:
+		std::vector<double>	m_xs;
+		std::vector<double>	m_ys;
+		std::vector<double>	m_cumulativeLengths;
+	};
+
+	std::vector<Vec2> GetBezierControlPoints(CatmullRomSpline const& spline)
+	{
+		std::vector<Vec2> controlPoints;
+		controlPoints.push_back(spline.m_positions[0]);
+		for (size_t pointIndex = 1; pointIndex < spline.m_positions.size(); ++pointIndex)
+		{
+			controlPoints.push_back(spline.m_positions[pointIndex - 1] + spline.m_velocities[pointIndex - 1] / 3.f);
+			controlPoints.push_back(spline.m_positions[pointIndex] - spline.m_velocities[pointIndex] / 3.f);
+			controlPoints.push_back(spline.m_positions[pointIndex]);
+		}
+		return controlPoints;
+	}
+
+	// Boxes with half-sizes 0.2 to 2 scattered over 400 x 400 x 100 around the origin, as an AABB3 list, an AABB3SoA
+	// and the spheres that bound them
+	void MakeCullingBoxes(int numBoxes, RandomNumberGenerator& rng, std::vector<AABB3>& out_boxes, AABB3SoA& out_boxSoA, SphereSoA& out_boundingSpheres)
+	{
+		for (int boxIndex = 0; boxIndex < numBoxes; ++boxIndex)
+		{
+			Vec3 center(rng.RollRandomFloatInRange(-200.f, 200.f), rng.RollRandomFloatInRange(-200.f, 200.f), rng.RollRandomFloatInRange(-50.f, 50.f));
+			float halfSize = rng.RollRandomFloatInRange(0.2f, 2.f);
+			AABB3 box(center - Vec3(halfSize, halfSize, halfSize), center + Vec3(halfSize, halfSize, halfSize));
+			out_boxes.push_back(box);
+			out_boxSoA.Add(box);
+			out_boundingSpheres.Add(center, halfSize * 1.7320508f);
+		}
+	}
+
+	// Camera::GetFrustum's matrices for a 60 degree, 16:9 perspective camera with a far plane at 100
+	Frustum MakeTestFrustum(Vec3 const& position, EulerAngles const& orientation)
+	{
+		Mat44 viewProjection = Mat44::CreatePerspectiveProjection(60.f, 16.f / 9.f, 0.1f, 100.f);
+		viewProjection.Append(Mat44(Vec3(0.f, 0.f, 1.f), Vec3(-1.f, 0.f, 0.f), Vec3(0.f, 1.f, 0.f), Vec3(0.f, 0.f, 0.f)));
+		Mat44 cameraToWorld = orientation.GetAsMatrix_XFwd_YLeft_ZUp();
+		cameraToWorld.SetTranslation3D(position);
+		viewProjection.Append(cameraToWorld.GetOrthonormalInverse());
+		return Frustum(viewProjection);
+	}
+
+	// Indices listed in visibleIndices but not flagged in isVisible, flagged but not listed, or listed twice
+	int CountVisibleSetDifferences(std::vector<char> const& isVisible, std::vector<int> const& visibleIndices)
+	{
+		std::vector<int> timesListed(isVisible.size(), 0);
+		for (int index : visibleIndices)
+		{
+			++timesListed[index];
+		}
+		int numDifferences = 0;
+		for (size_t index = 0; index < isVisible.size(); ++index)
+		{
+			numDifferences += timesListed[index] != (isVisible[index] ? 1 : 0) ? 1 : 0;
+		}
+		return numDifferences;
+	}
+
+	// Terrain-like chunk: a rolling height field of stone (1), dirt (2) and grass (3) over see-through water (4), with
+	// 3% of the stone hollowed out
+	void MakeTestChunkBlocks(IntVec3 const& dimensions, int chunkX, int chunkY, RandomNumberGenerator& rng, std::vector<ChunkBlockType>& out_blocks)
+	{
+		out_blocks.assign((size_t)dimensions.x * dimensions.y * dimensions.z, CHUNK_BLOCK_AIR);
+		int seaLevel = dimensions.z / 2 - 2;
+		for (int y = 0; y < dimensions.y; ++y)
+		{
+			for (int x = 0; x < dimensions.x; ++x)
+			{
+				float worldX = (float)(chunkX * dimensions.x + x);
+				float worldY = (float)(chunkY * dimensions.y + y);
+				int height = dimensions.z / 2 + (int)(8.f * sinf(worldX * 0.11f) + 6.f * cosf(worldY * 0.13f) + 3.f * sinf((worldX + worldY) * 0.31f));
+				for (int z = 0; z < dimensions.z; ++z)
+				{
+					ChunkBlockType blockType = CHUNK_BLOCK_AIR;
+					if (z < height - 4)
+					{
+						blockType = rng.RollRandomIntLessThan(100) < 3 ? CHUNK_BLOCK_AIR : 1;
+					}
+					else if (z < height - 1)
+					{
+						blockType = 2;
+					}
+					else if (z < height)
+					{
+						blockType = 3;
+					}
+					else if (z < seaLevel)
+					{
+						blockType = 4;
+					}
+					out_blocks[(size_t)x + (size_t)y * dimensions.x + (size_t)z * dimensions.x * dimensions.y] = blockType;
+				}
+			}
+		}
+	}
+
+	std::vector<ChunkBlockAppearance> MakeTestBlockAppearances()
+	{
+		std::vector<ChunkBlockAppearance> appearances(5);
+		appearances[3].m_tint = Rgba8(100, 200, 100, 255);
+		appearances[4].m_isOpaque = false;
+		return appearances;
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+bool RunEngineSelfTests(std::vector<std::string>& out_reportLines)
+{
+	bool allPassed = true;
+	allPassed &= TestFastTrigErrorBounds(out_reportLines);
+	allPassed &= TestArcLengthTableMatchesReference(out_reportLines);
+	allPassed &= TestFrustumCullingPathsAgree(out_reportLines);
+	allPassed &= TestChunkMeshCoversVisibleFaces(out_reportLines);
+	allPassed &= TestRandomBatchesMatchSingleRolls(out_reportLines);
+	allPassed &= TestSplineSamplesMatchScalarSections(out_reportLines);
+	allPassed &= TestRawNoiseGridMatchesScalar(out_reportLines);
+	allPassed &= TestPathfindingMatchesDijkstra(out_reportLines);
+	allPassed &= TestDistanceFieldRepairMatchesRegeneration(out_reportLines);
+	allPassed &= TestVoxelLightMatchesFullRelight(out_reportLines);
+	allPassed &= TestHeatMapOpsMatchScalarRules(out_reportLines);
+	return allPassed;
+}
+
+//----------------------------------------------------------------------------------------------
+void RunEngineBenchmarks(std::vector<std::string>& out_reportLines)
+{
+	BenchmarkLineOfSight(out_reportLines);
+	BenchmarkArcLengthQueries(out_reportLines);
+	BenchmarkFrustumCulling(out_reportLines);
+	BenchmarkChunkMeshing(out_reportLines);
+	BenchmarkTilePathfinding(out_reportLines);
+}
+
+//----------------------------------------------------------------------------------------------
+// Checks the bounds documented in FastTrig.hpp against double-precision libm: sin/cos over a sweep of +-36000
+// degrees, atan2 over random points at several magnitudes, and the array (SIMD) versions bit-equal to the scalar ones.
+//
+bool TestFastTrigErrorBounds(std::vector<std::string>& out_reportLines)
+{
+	constexpr double DEGREES_TO_RADIANS = 3.14159265358979323846 / 180.0;
+	constexpr double RADIANS_TO_DEGREES = 180.0 / 3.14159265358979323846;
+	constexpr float MAX_SIN_COS_ERROR = 1e-7f;
+	constexpr double MAX_ATAN2_ERROR_DEGREES = 3e-5;
+	constexpr int NUM_ANGLES = 200003;
+	constexpr int NUM_POINTS = 100000;
+
+	std::vector<float> degrees(NUM_ANGLES);
+	for (int angleIndex = 0; angleIndex < NUM_ANGLES; ++angleIndex)
+	{
+		degrees[angleIndex] = -36000.f + 72000.f * (float)angleIndex / (float)(NUM_ANGLES - 1);
+	}
+	std::vector<float> arraySines(NUM_ANGLES);
+	std::vector<float> arrayCosines(NUM_ANGLES);
+	FastSinCosDegreesArray(degrees.data(), NUM_ANGLES, arraySines.data(), arrayCosines.data());
+
+	double maxSinCosError = 0.0;
+	int numSinCosArrayMismatches = 0;
+	for (int angleIndex = 0; angleIndex < NUM_ANGLES; ++angleIndex)
+	{
+		float sine;
+		float cosine;
+		FastSinCosDegrees(degrees[angleIndex], sine, cosine);
+		double radians = (double)degrees[angleIndex] * DEGREES_TO_RADIANS;
+		double error = fabs((double)sine - sin(radians));
+		error = fabs((double)cosine - cos(radians)) > error ? fabs((double)cosine - cos(radians)) : error;
+		maxSinCosError = error > maxSinCosError ? error : maxSinCosError;
+		if (memcmp(&sine, &arraySines[angleIndex], sizeof(float)) != 0 || memcmp(&cosine, &arrayCosines[angleIndex], sizeof(float)) != 0)
+		{
+			++numSinCosArrayMismatches;
+		}
+	}
+
+	RandomNumberGenerator rng(30);
+	std::vector<float> ys(NUM_POINTS);
+	std::vector<float> xs(NUM_POINTS);
+	for (int pointIndex = 0; pointIndex < NUM_POINTS; ++pointIndex)
+	{
+		float magnitude = powf(10.f, (float)(pointIndex % 7) - 3.f);
+		ys[pointIndex] = rng.RollRandomFloatInRange(-magnitude, magnitude);
+		xs[pointIndex] = rng.RollRandomFloatInRange(-magnitude, magnitude);
+	}
+	std::vector<float> arrayAngles(NUM_POINTS);
+	FastAtan2DegreesArray(ys.data(), xs.data(), NUM_POINTS, arrayAngles.data());
+
+	double maxAtan2Error = 0.0;
+	int numAtan2ArrayMismatches = 0;
+	for (int pointIndex = 0; pointIndex < NUM_POINTS; ++pointIndex)
+	{
+		float angle = FastAtan2Degrees(ys[pointIndex], xs[pointIndex]);
+		double error = fabs((double)angle - atan2((double)ys[pointIndex], (double)xs[pointIndex]) * RADIANS_TO_DEGREES);
+		if (error > 180.0)
+		{
+			error = 360.0 - error;	// +-180 are the same direction
+		}
+		maxAtan2Error = error > maxAtan2Error ? error : maxAtan2Error;
+		if (memcmp(&angle, &arrayAngles[pointIndex], sizeof(float)) != 0)
+		{
+			++numAtan2ArrayMismatches;
+		}
+	}
+
+	bool passed = maxSinCosError <= (double)MAX_SIN_COS_ERROR && maxAtan2Error <= MAX_ATAN2_ERROR_DEGREES
+		&& numSinCosArrayMismatches == 0 && numAtan2ArrayMismatches == 0;
+	out_reportLines.push_back(Stringf("%s FastTrig: sin/cos max error %.2e (bound %.0e), atan2 max error %.2e deg (bound %.0e); %d + %d array results differ from scalar",
+		passed ? "PASS" : "FAIL", maxSinCosError, (double)MAX_SIN_COS_ERROR, maxAtan2Error, MAX_ATAN2_ERROR_DEGREES,
+		numSinCosArrayMismatches, numAtan2ArrayMismatches));
+	return passed;
+}
+
+//----------------------------------------------------------------------------------------------
+// CatmullRomSpline's arc-length table on a 41-section spline with a zero-length section, and a CubicBezierCurve2D's,
+// against a double-precision chord walk 4096 chords per section: total length, and the point at 2000 distances along
+// the spline. EvaluateAtApproximateDistances must equal single queries bit for bit, for shuffled, sorted and
+// out-of-range distances.
+//
+bool TestArcLengthTableMatchesReference(std::vector<std::string>& out_reportLines)
+{
+	constexpr int NUM_CHORDS_PER_SEGMENT = 4096;
+	constexpr int NUM_POINT_SAMPLES = 2000;
+	constexpr int NUM_BATCH_DISTANCES = 4096;
+	constexpr double MAX_LENGTH_ERROR = 1e-3;
+	constexpr double MAX_POINT_ERROR = 2e-3;
+
+	RandomNumberGenerator rng(43);
+	CatmullRomSpline spline(MakeTestSplinePoints(rng));
+	ReferenceChordWalk splineReference(GetBezierControlPoints(spline), NUM_CHORDS_PER_SEGMENT);
+	double splineLengthError = fabs((double)spline.GetApproximateLength() - splineReference.GetLength());
+	double maxPointError = 0.0;
+	for (int sampleIndex = 0; sampleIndex <= NUM_POINT_SAMPLES; ++sampleIndex)
+	{
+		float distance = (float)(splineReference.GetLength() * (double)sampleIndex / (double)NUM_POINT_SAMPLES);
+		double error = splineReference.GetDistanceFromPointAt((double)distance, spline.EvaluateAtApproximateDistance(distance));
+		maxPointError = error > maxPointError ? error : maxPointError;
+	}
+
+	CubicBezierCurve2D bezier(Vec2(0.f, 0.f), Vec2(10.f, 40.f), Vec2(60.f, -30.f), Vec2(80.f, 10.f));
+	bezier.BuildArcLengthTable();
+	std::vector<Vec2> bezierControlPoints{ bezier.m_startPos, bezier.m_guidePos1, bezier.m_guidePos2, bezier.m_endPos };
+	double bezierLengthError = fabs((double)bezier.GetApproximateLength() - ReferenceChordWalk(bezierControlPoints, NUM_CHORDS_PER_SEGMENT).GetLength());
+
+	// Shuffled, then sorted; the first and last few fall off the ends of the curve
+	float length = spline.GetApproximateLength();
+	std::vector<float> distances(NUM_BATCH_DISTANCES);
+	std::vector<Vec2> batchPositions(NUM_BATCH_DISTANCES);
+	int numBatchMismatches = 0;
+	for (int order = 0; order < 2; ++order)
+	{
+		for (int distanceIndex = 0; distanceIndex < NUM_BATCH_DISTANCES; ++distanceIndex)
+		{
+			int rank = order == 0 ? (distanceIndex * 7919) % NUM_BATCH_DISTANCES : distanceIndex;
+			distances[distanceIndex] = length * ((float)rank / (float)(NUM_BATCH_DISTANCES - 8) - 0.001f);
+		}
+		spline.EvaluateAtApproximateDistances(distances.data(), batchPositions.data(), NUM_BATCH_DISTANCES);
+		for (int distanceIndex = 0; distanceIndex < NUM_BATCH_DISTANCES; ++distanceIndex)
+		{
+			Vec2 single = spline.EvaluateAtApproximateDistance(distances[distanceIndex]);
+			numBatchMismatches += memcmp(&single, &batchPositions[distanceIndex], sizeof(Vec2)) != 0 ? 1 : 0;
+		}
+	}
+
+	bool passed = splineLengthError <= MAX_LENGTH_ERROR && bezierLengthError <= MAX_LENGTH_ERROR && maxPointError <= MAX_POINT_ERROR && numBatchMismatches == 0;
+	out_reportLines.push_back(Stringf("%s Arc-length tables: spline length error %.1e, Bezier %.1e (bound %.0e), max point error %.1e (bound %.0e); %d of %d batch results differ from single queries",
+		passed ? "PASS" : "FAIL", splineLengthError, bezierLengthError, MAX_LENGTH_ERROR, maxPointError, MAX_POINT_ERROR, numBatchMismatches, 2 * NUM_BATCH_DISTANCES));
+	return passed;
+}
+
+//----------------------------------------------------------------------------------------------
+// Frustum::CullAABBs and CullAABBTree must return exactly the boxes the scalar IsAABBVisible accepts, and CullSpheres
+// exactly the spheres IsSphereVisible accepts: 20000 boxes seen from 8 orientations.
+//
+bool TestFrustumCullingPathsAgree(std::vector<std::string>& out_reportLines)
+{
+	constexpr int NUM_BOXES = 20000;
+	constexpr int NUM_VIEWS = 8;
+
+	RandomNumberGenerator rng(29);
+	std::vector<AABB3> boxes;
+	AABB3SoA boxSoA;
+	SphereSoA boundingSpheres;
+	MakeCullingBoxes(NUM_BOXES, rng, boxes, boxSoA, boundingSpheres);
+	AABB3Tree tree;
+	tree.Build(boxes);
+
+	int numBoxMismatches = 0;
+	int numSphereMismatches = 0;
+	int numVisibleBoxes = 0;
+	std::vector<char> isVisible(NUM_BOXES);
+	std::vector<int> visibleIndices;
+	for (int viewIndex = 0; viewIndex < NUM_VIEWS; ++viewIndex)
+	{
+		Frustum frustum = MakeTestFrustum(Vec3(10.f * (float)viewIndex, -5.f * (float)viewIndex, 3.f), EulerAngles(45.f * (float)viewIndex, -30.f + 8.f * (float)viewIndex, 0.f));
+		for (int boxIndex = 0; boxIndex < NUM_BOXES; ++boxIndex)
+		{
+			isVisible[boxIndex] = frustum.IsAABBVisible(boxes[boxIndex]) ? 1 : 0;
+			numVisibleBoxes += isVisible[boxIndex];
+		}
+		frustum.CullAABBs(boxSoA, visibleIndices);
+		numBoxMismatches += CountVisibleSetDifferences(isVisible, visibleIndices);
+		frustum.CullAABBTree(tree, visibleIndices);
+		numBoxMismatches += CountVisibleSetDifferences(isVisible, visibleIndices);
+
+		for (int sphereIndex = 0; sphereIndex < NUM_BOXES; ++sphereIndex)
+		{
+			Vec3 center(boundingSpheres.m_centerX[sphereIndex], boundingSpheres.m_centerY[sphereIndex], boundingSpheres.m_centerZ[sphereIndex]);
+			isVisible[sphereIndex] = frustum.IsSphereVisible(center, boundingSpheres.m_radius[sphereIndex]) ? 1 : 0;
+		}
+		frustum.CullSpheres(boundingSpheres, visibleIndices);
+		numSphereMismatches += CountVisibleSetDifferences(isVisible, visibleIndices);
+	}
+
+	bool passed = numBoxMismatches == 0 && numSphereMismatches == 0;
+	out_reportLines.push_back(Stringf("%s Frustum culling: %d box and %d sphere indices differ from the scalar tests (%d boxes over %d views, %d visible)",
+		passed ? "PASS" : "FAIL", numBoxMismatches, numSphereMismatches, NUM_BOXES, NUM_VIEWS, numVisibleBoxes));
+	return passed;
+}
+
+//----------------------------------------------------------------------------------------------
+// BuildChunkMesh on a 16x16x128 terrain chunk, per face and greedily merged, with everything outside the chunk air and
+// with stone neighbors below z = 60. For each of the six face directions the quads' area must equal the number of
+// faces a brute-force pass finds visible (block not air, block in front neither opaque nor the same type). Every
+// triangle must wind counter-clockwise around its vertex normal, with tangent x bitangent = normal.
+//
+bool TestChunkMeshCoversVisibleFaces(std::vector<std::string>& out_reportLines)
+{
+	IntVec3 const dimensions(16, 16, 128);
+	int const faceOffsets[(int)ChunkFace::COUNT][3] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+
+	RandomNumberGenerator rng(35);
+	std::vector<ChunkBlockType> blocks;
+	MakeTestChunkBlocks(dimensions, 0, 0, rng, blocks);
+	std::vector<ChunkBlockAppearance> appearances = MakeTestBlockAppearances();
+	GetNeighborBlockCallback getStoneBelowNeighbor = [](IntVec3 const& localCoords)
+		{
+			return localCoords.z < 60 ? (ChunkBlockType)1 : CHUNK_BLOCK_AIR;
+		};
+
+	int numAreaMismatches = 0;
+	int numFaceCountMismatches = 0;
+	int numBadWindings = 0;
+	int numBadTangentFrames = 0;
+	int numVisibleFaces = 0;
+	int numMergedQuads = 0;
+	std::vector<Vertex_PCUTBN> verts;
+	std::vector<unsigned int> indexes;
+	for (int neighborMode = 0; neighborMode < 2; ++neighborMode)
+	{
+		GetNeighborBlockCallback getNeighborBlock = neighborMode == 0 ? GetNeighborBlockCallback() : getStoneBelowNeighbor;
+		auto getBlock = [&](int x, int y, int z)
+			{
+				if (x >= 0 && x < dimensions.x && y >= 0 && y < dimensions.y && z >= 0 && z < dimensions.z)
+				{
+					return blocks[(size_t)x + (size_t)y * dimensions.x + (size_t)z * dimensions.x * dimensions.y];
+				}
+				return getNeighborBlock ? getNeighborBlock(IntVec3(x, y, z)) : CHUNK_BLOCK_AIR;
+			};
+
+		int expectedFaces[(int)ChunkFace::COUNT] = {};
+		int numExpectedFaces = 0;
+		for (int z = 0; z < dimensions.z; ++z)
+		{
+			for (int y = 0; y < dimensions.y; ++y)
+			{
+				for (int x = 0; x < dimensions.x; ++x)
+				{
+					ChunkBlockType block = getBlock(x, y, z);
+					for (int face = 0; face < (int)ChunkFace::COUNT && block != CHUNK_BLOCK_AIR; ++face)
+					{
+						ChunkBlockType front = getBlock(x + faceOffsets[face][0], y + faceOffsets[face][1], z + faceOffsets[face][2]);
+						bool isFrontOpaque = front != CHUNK_BLOCK_AIR && (front >= (ChunkBlockType)appearances.size() || appearances[front].m_isOpaque);
+						if (!isFrontOpaque && front != block)
+						{
+							++expectedFaces[face];
+							++numExpectedFaces;
+						}
+					}
+				}
+			}
+		}
+
+		for (int mergeMode = 0; mergeMode < 2; ++mergeMode)
+		{
+			ChunkMeshInput input;
+			input.m_blocks = blocks.data();
+			input.m_dimensions = dimensions;
+			input.m_appearances = &appearances;
+			input.m_getNeighborBlock = getNeighborBlock;
+			input.m_mergeFaces = mergeMode == 1;
+			verts.clear();
+			indexes.clear();
+			ChunkMeshStats stats = BuildChunkMesh(input, verts, indexes);
+			numFaceCountMismatches += stats.m_numVisibleFaces != numExpectedFaces ? 1 : 0;
+			numFaceCountMismatches += !input.m_mergeFaces && stats.m_numQuads != numExpectedFaces ? 1 : 0;
+			numVisibleFaces += input.m_mergeFaces ? numExpectedFaces : 0;
+			numMergedQuads += input.m_mergeFaces ? stats.m_numQuads : 0;
+
+			double areaByFace[(int)ChunkFace::COUNT] = {};
+			for (size_t firstIndex = 0; firstIndex + 2 < indexes.size(); firstIndex += 3)
+			{
+				Vertex_PCUTBN const& vertA = verts[indexes[firstIndex]];
+				Vec3 edgeCross = CrossProduct3D(verts[indexes[firstIndex + 1]].m_position - vertA.m_position, verts[indexes[firstIndex + 2]].m_position - vertA.m_position);
+				numBadWindings += DotProduct3D(edgeCross, vertA.m_normal) <= 0.f ? 1 : 0;
+				numBadTangentFrames += DotProduct3D(CrossProduct3D(vertA.m_tangent, vertA.m_bitangent), vertA.m_normal) < 0.99f ? 1 : 0;
+
+				Vec3 const& normal = vertA.m_normal;
+				int axis = fabsf(normal.x) > 0.5f ? 0 : (fabsf(normal.y) > 0.5f ? 1 : 2);
+				float normalAlongAxis = axis == 0 ? normal.x : (axis == 1 ? normal.y : normal.z);
+				areaByFace[axis * 2 + (normalAlongAxis > 0.f ? 0 : 1)] += 0.5 * (double)edgeCross.GetLength();
+			}
+			for (int face = 0; face < (int)ChunkFace::COUNT; ++face)
+			{
+				numAreaMismatches += fabs(areaByFace[face] - (double)expectedFaces[face]) > 0.01 ? 1 : 0;
+			}
+		}
+	}
+
+	bool passed = numAreaMismatches == 0 && numFaceCountMismatches == 0 && numBadWindings == 0 && numBadTangentFrames == 0;
+	out_reportLines.push_back(Stringf("%s Chunk mesher: %d of 24 face-direction areas and %d face counts wrong (%d visible faces in %d merged quads); %d triangles wound against their normal, %d with a wrong tangent frame",
+		passed ? "PASS" : "FAIL", numAreaMismatches, numFaceCountMismatches, numVisibleFaces, numMergedQuads, numBadWindings, numBadTangentFrames));
+	return passed;
+}
+
+//----------------------------------------------------------------------------------------------
+// RandomNumberGenerator's batch rolls against the same number of single rolls, bit for bit, and the position they
+// leave behind: counts that do and do not fill whole SIMD steps, starting positions that cross 2^32, and integer
+// ranges whose Lemire rejection fires often (3 * 2^30 values) or never (the full 32-bit range). The roll after
+// position 2^32 - 1 must be roll 0, and Jump(n) must land on the batch's roll n.
+//
+bool TestRandomBatchesMatchSingleRolls(std::vector<std::string>& out_reportLines)
+{
+	constexpr int MAX_COUNT = 1000;
+	int const counts[] = { 1, 3, 4, 7, 8, 9, 16, 37, MAX_COUNT };
+	unsigned int const startPositions[] = { 0u, 12345u, 0xFFFFFFF0u, 0xFFFFFFFDu };
+	int const intRanges[][2] = { { 0, 9 }, { -5, 5 }, { 0, 0x7FFFFFFF }, { INT_MIN, 0x3FFFFFFF }, { INT_MIN, INT_MAX } };
+
+	int numMismatches = 0;
+	int numCompared = 0;
+	auto compareBits = [&](void const* batchValue, void const* singleValue, size_t size)
+		{
+			numMismatches += memcmp(batchValue, singleValue, size) != 0 ? 1 : 0;
+			++numCompared;
+		};
+	auto comparePositions = [&](RandomNumberGenerator const& batchRng, RandomNumberGenerator const& singleRng)
+		{
+			numMismatches += batchRng.GetPosition() != singleRng.GetPosition() ? 1 : 0;
+			++numCompared;
+		};
+
+	std::vector<unsigned int> uints(MAX_COUNT);
+	std::vector<float> floats(MAX_COUNT);
+	std::vector<int> ints(MAX_COUNT);
+	for (unsigned int seed = 0; seed < 3; ++seed)
+	{
+		for (unsigned int startPosition : startPositions)
+		{
+			for (int count : counts)
+			{
+				RandomNumberGenerator batchRng(seed * 0x9E3779B9u, startPosition);
+				RandomNumberGenerator singleRng = batchRng;
+				batchRng.RollRandomUints(uints.data(), count);
+				for (int index = 0; index < count; ++index)
+				{
+					unsigned int single = singleRng.RollRandomUint();
+					compareBits(&uints[index], &single, sizeof(single));
+				}
+				comparePositions(batchRng, singleRng);
+
+				batchRng.RollRandomFloatsZeroToOne(floats.data(), count);
+				for (int index = 0; index < count; ++index)
+				{
+					float single = singleRng.RollRandomFloatZeroToOne();
+					compareBits(&floats[index], &single, sizeof(single));
+				}
+				batchRng.RollRandomFloatsInRange(floats.data(), count, -3.5f, 12.25f);
+				for (int index = 0; index < count; ++index)
+				{
+					float single = singleRng.RollRandomFloatInRange(-3.5f, 12.25f);
+					compareBits(&floats[index], &single, sizeof(single));
+				}
+				for (int const* intRange : intRanges)
+				{
+					batchRng.RollRandomIntsInRange(ints.data(), count, intRange[0], intRange[1]);
+					for (int index = 0; index < count; ++index)
+					{
+						int single = singleRng.RollRandomIntInRange(intRange[0], intRange[1]);
+						compareBits(&ints[index], &single, sizeof(single));
+					}
+				}
+				comparePositions(batchRng, singleRng);
+
+				RandomNumberGenerator jumpedRng(seed * 0x9E3779B9u, startPosition);
+				jumpedRng.Jump((unsigned int)count - 1);
+				unsigned int jumped = jumpedRng.RollRandomUint();
+				compareBits(&uints[count - 1], &jumped, sizeof(jumped));
+			}
+		}
+
+		// 32 rolls from 2^32 - 16: the last 16 are the cycle starting over at position 0
+		RandomNumberGenerator wrappingRng(seed * 0x9E3779B9u, 0xFFFFFFF0u);
+		wrappingRng.RollRandomUints(uints.data(), 32);
+		RandomNumberGenerator restartedRng(seed * 0x9E3779B9u);
+		for (int index = 16; index < 32; ++index)
+		{
+			unsigned int restarted = restartedRng.RollRandomUint();
+			compareBits(&uints[index], &restarted, sizeof(restarted));
+		}
+		comparePositions(wrappingRng, restartedRng);
+	}
+
+	bool passed = numMismatches == 0;
+	out_reportLines.push_back(Stringf("%s RandomNumberGenerator: %d of %d batch rolls, positions and wrapped rolls differ from single rolls",
+		passed ? "PASS" : "FAIL", numMismatches, numCompared));
+	return passed;
+}
+
+//----------------------------------------------------------------------------------------------
+// CatmullRomSpline3D::EvaluateUniformSamples against each section's scalar Evaluate / EvaluateVelocity at the same
+// parametric, bit for bit, with and without velocities: splines of 0 to 41 sections (one zero-length) and sample counts
+// that fill whole SIMD steps, leave scalar tails or are narrower than one step. Nothing past
+// GetNumUniformSamples may be written. Bit identity assumes the compiler does not fuse the scalar Horner steps into FMAs
+// (MSVC 2022's /fp:precise does not; GCC and Clang need -ffp-contract=off once FMA is enabled).
+//
+bool TestSplineSamplesMatchScalarSections(std::vector<std::string>& out_reportLines)
+{
+	int const pointCounts[] = { 1, 2, 7, 42 };
+	int const samplesPerSectionCounts[] = { 1, 3, 4, 8, 9, 16, 17, 33 };
+
+	RandomNumberGenerator rng(44);
+	int numMismatches = 0;
+	int numCompared = 0;
+	int numOverruns = 0;
+	std::vector<Vec3> positions;
+	std::vector<Vec3> velocities;
+	std::vector<Vec3> positionsOnly;
+	for (int numPoints : pointCounts)
+	{
+		std::vector<Vec3> points;
+		for (int pointIndex = 0; pointIndex < numPoints; ++pointIndex)
+		{
+			points.push_back(Vec3(rng.RollRandomFloatInRange(-50.f, 50.f), rng.RollRandomFloatInRange(-50.f, 50.f), rng.RollRandomFloatInRange(0.f, 20.f)));
+		}
+		if (numPoints > 10)
+		{
+			points[5] = points[4];
+		}
+		CatmullRomSpline3D spline(points);
+		std::vector<CubicPolynomial3D> const& sections = spline.GetSections();
+
+		for (int samplesPerSection : samplesPerSectionCounts)
+		{
+			// One sentinel past the end of each output
+			int numSamples = spline.GetNumUniformSamples(samplesPerSection);
+			Vec3 const sentinel(-12345.f, -12345.f, -12345.f);
+			positions.assign(numSamples + 1, sentinel);
+			velocities.assign(numSamples + 1, sentinel);
+			positionsOnly.assign(numSamples + 1, sentinel);
+			spline.EvaluateUniformSamples(samplesPerSection, positions.data(), velocities.data());
+			spline.EvaluateUniformSamples(samplesPerSection, positionsOnly.data());
+			numOverruns += memcmp(&positions[numSamples], &sentinel, sizeof(Vec3)) != 0 ? 1 : 0;
+			numOverruns += memcmp(&velocities[numSamples], &sentinel, sizeof(Vec3)) != 0 ? 1 : 0;
+			numOverruns += memcmp(&positionsOnly[numSamples], &sentinel, sizeof(Vec3)) != 0 ? 1 : 0;
+
+			float step = 1.f / (float)samplesPerSection;
+			for (int sampleIndex = 0; sampleIndex < numSamples; ++sampleIndex)
+			{
+				// The last sample is the end of the last section rather than the start of one past it
+				int sectionIndex = sampleIndex / samplesPerSection;
+				float t = step * (float)(sampleIndex % samplesPerSection);
+				if (sectionIndex == (int)sections.size())
+				{
+					sectionIndex -= 1;
+					t = 1.f;
+				}
+				Vec3 position = sections[sectionIndex].Evaluate(t);
+				Vec3 velocity = sections[sectionIndex].EvaluateVelocity(t);
+				numMismatches += memcmp(&positions[sampleIndex], &position, sizeof(Vec3)) != 0 ? 1 : 0;
+				numMismatches += memcmp(&velocities[sampleIndex], &velocity, sizeof(Vec3)) != 0 ? 1 : 0;
+				numMismatches += memcmp(&positionsOnly[sampleIndex], &position, sizeof(Vec3)) != 0 ? 1 : 0;
+				numCompared += 3;
+			}
+		}
+	}
+
+	bool passed = numMismatches == 0 && numOverruns == 0;
+	out_reportLines.push_back(Stringf("%s CatmullRomSpline3D samples: %d of %d positions and velocities differ from scalar section evaluation, %d writes past the end",
+		passed ? "PASS" : "FAIL", numMismatches, numCompared, numOverruns));
+	return passed;
+}
+
+//----------------------------------------------------------------------------------------------
+// FillNoiseGrid2D/3D against Get2d/3dNoiseZeroToOne / NegOneToOne cell by cell, bit for bit: a chunk, widths that do and
+// do not fill whole SIMD steps (including narrower than one), and start indices that are negative or wrap the hash math.
+//
+bool TestRawNoiseGridMatchesScalar(std::vector<std::string>& out_reportLines)
+{
+	constexpr unsigned int SEED = 42;
+	IntVec3 const gridDims[] = { IntVec3(16, 16, 128), IntVec3(64, 3, 2), IntVec3(37, 29, 5), IntVec3(12, 5, 7), IntVec3(3, 4, 9), IntVec3(1, 1, 1) };
+	IntVec3 const firstIndexes[] = { IntVec3(0, 0, 0), IntVec3(-100, -7, -3), IntVec3(2147483000, -2147483000, 12345) };
+
+	int numCellsChecked = 0;
+	int numMismatches = 0;
+	std::vector<float> values;
+	for (IntVec3 const& dims : gridDims)
+	{
+		for (IntVec3 const& firstIndex : firstIndexes)
+		{
+			for (NoiseGridRange range : { NoiseGridRange::ZERO_TO_ONE, NoiseGridRange::NEG_ONE_TO_ONE })
+			{
+				bool isZeroToOne = range == NoiseGridRange::ZERO_TO_ONE;
+				values.assign(dims.x * dims.y, 0.f);
+				FillNoiseGrid2D(values.data(), IntVec2(dims.x, dims.y), IntVec2(firstIndex.x, firstIndex.y), SEED, range);
+				for (int cellIndex = 0; cellIndex < dims.x * dims.y; ++cellIndex)
+				{
+					int indexX = firstIndex.x + cellIndex % dims.x;
+					int indexY = firstIndex.y + cellIndex / dims.x;
+					float expected = isZeroToOne ? Get2dNoiseZeroToOne(indexX, indexY, SEED) : Get2dNoiseNegOneToOne(indexX, indexY, SEED);
+					numMismatches += memcmp(&expected, &values[cellIndex], sizeof(float)) != 0 ? 1 : 0;
+				}
+				numCellsChecked += dims.x * dims.y;
+
+				values.assign(dims.x * dims.y * dims.z, 0.f);
+				FillNoiseGrid3D(values.data(), dims, firstIndex, SEED, range);
+				for (int cellIndex = 0; cellIndex < dims.x * dims.y * dims.z; ++cellIndex)
+				{
+					int indexX = firstIndex.x + cellIndex % dims.x;
+					int indexY = firstIndex.y + (cellIndex / dims.x) % dims.y;
+					int indexZ = firstIndex.z + cellIndex / (dims.x * dims.y);
+					float expected = isZeroToOne ? Get3dNoiseZeroToOne(indexX, indexY, indexZ, SEED) : Get3dNoiseNegOneToOne(indexX, indexY, indexZ, SEED);
+					numMismatches += memcmp(&expected, &values[cellIndex], sizeof(float)) != 0 ? 1 : 0;
+				}
+				numCellsChecked += dims.x * dims.y * dims.z;
+			}
+		}
+	}
+
+	bool passed = numMismatches == 0;
+	out_reportLines.push_back(Stringf("%s RawNoiseGrid: %d of %d cells differ from the scalar noise functions", passed ? "PASS" : "FAIL", numMismatches, numCellsChecked));
+	return passed;
+}
+
+//----------------------------------------------------------------------------------------------
+// GenerateDistanceField, TilePathfinder::FindPath / FindPathJPS and TileFlowField on 300 random maps against a
+// double-precision Dijkstra: field values and path costs within 1e-3 relative, paths walkable under the settings, and
+// flow from every seventh reached tile descending to the source. Maps mix wall densities with uniform costs, costs 1-4
+// and costs up to 20000 (which push the field onto its binary heap); half allow diagonals, and JPS runs on the uniform
+// diagonal ones.
+//
+bool TestPathfindingMatchesDijkstra(std::vector<std::string>& out_reportLines)
+{
+	constexpr int NUM_MAPS = 300;
+	constexpr int FLOW_TILE_STRIDE = 7;
+
+	RandomNumberGenerator rng(45);
+	TilePathfinder pathfinder;
+	TileFlowField flowField;
+	std::vector<IntVec2> path;
+	int numFieldMismatches = 0;
+	int numAStarMismatches = 0;
+	int numJPSMismatches = 0;
+	int numJPSMaps = 0;
+	int numFlowMismatches = 0;
+	for (int mapIndex = 0; mapIndex < NUM_MAPS; ++mapIndex)
+	{
+		IntVec2 dims(rng.RollRandomIntInRange(5, 64), rng.RollRandomIntInRange(5, 64));
+		bool isUniform = mapIndex % 3 == 0;
+		int maxCost = isUniform ? 1 : (mapIndex % 5 == 1 ? 20000 : 4);
+		TileHeatMap costs = MakeRandomCostMap(dims, 0.1f + 0.1f * (float)(mapIndex % 4), maxCost, rng);
+		TilePathSettings settings;
+		settings.m_allowDiagonals = mapIndex % 2 == 0;
+		IntVec2 start(rng.RollRandomIntLessThan(dims.x), rng.RollRandomIntLessThan(dims.y));
+		IntVec2 goal(rng.RollRandomIntLessThan(dims.x), rng.RollRandomIntLessThan(dims.y));
+		costs.SetValue(start, 1.f);
+		std::vector<double> reference = ComputeReferenceDistances(costs, start, settings);
+
+		TileHeatMap field(dims);
+		GenerateDistanceField(field, costs, std::vector<IntVec2>{ start }, settings);
+		for (int tileIndex = 0; tileIndex < dims.x * dims.y; ++tileIndex)
+		{
+			float distance = field.GetValues()[tileIndex];
+			bool isMatch = reference[tileIndex] >= REFERENCE_UNREACHED ? distance == TILE_DISTANCE_UNREACHED : IsNearReference(distance, reference[tileIndex]);
+			if (!isMatch)
+			{
+				++numFieldMismatches;
+				break;
+			}
+		}
+
+		double goalDistance = reference[goal.x + goal.y * dims.x];
+		bool isGoalReachable = goalDistance < REFERENCE_UNREACHED;
+		bool didFind = pathfinder.FindPath(costs, start, goal, path, settings);
+		if (didFind != isGoalReachable || (didFind && (!IsNearReference(GetWalkedPathCost(costs, path, start, goal, settings), goalDistance)
+			|| !IsNearReference(pathfinder.GetLastPathCost(), goalDistance))))
+		{
+			++numAStarMismatches;
+		}
+		if (isUniform && settings.m_allowDiagonals)
+		{
+			++numJPSMaps;
+			didFind = pathfinder.FindPathJPS(costs, start, goal, path, settings);
+			if (didFind != isGoalReachable || (didFind && !IsNearReference(GetWalkedPathCost(costs, path, start, goal, settings), goalDistance)))
+			{
+				++numJPSMismatches;
+			}
+		}
+
+		flowField.Generate(field, costs, settings);
+		for (int tileIndex = 0; tileIndex < dims.x * dims.y; tileIndex += FLOW_TILE_STRIDE)
+		{
+			IntVec2 tileCoords(tileIndex % dims.x, tileIndex / dims.x);
+			if (field.GetValue(tileCoords) >= TILE_DISTANCE_UNREACHED)
+			{
+				continue;
+			}
+			while (tileCoords != start && flowField.HasDirection(tileCoords))
+			{
+				IntVec2 next = tileCoords + flowField.GetStepDirection(tileCoords);
+				if (field.GetValue(next) >= field.GetValue(tileCoords))
+				{
+					break;
+				}
+				tileCoords = next;
+			}
+			if (tileCoords != start)
+			{
+				++numFlowMismatches;
+				break;
+			}
+		}
+	}
+
+	bool passed = numFieldMismatches == 0 && numAStarMismatches == 0 && numJPSMismatches == 0 && numFlowMismatches == 0;
+	out_reportLines.push_back(Stringf("%s Pathfinding vs Dijkstra: of %d maps, %d fields, %d A* paths and %d flow fields disagree; %d of %d JPS paths",
+		passed ? "PASS" : "FAIL", NUM_MAPS, numFieldMismatches, numAStarMismatches, numFlowMismatches, numJPSMismatches, numJPSMaps));
+	return passed;
+}
+
+//----------------------------------------------------------------------------------------------
+// TileDistanceFieldRepairer after random edits against GenerateDistanceField from scratch, tile for tile, under 4- and
+// 8-connectivity, with and without corner cutting and with a finite m_maxDistance. Edits open and close walls and
+// change costs, one tile or several at a time, on maps with one to three sources.
+//
+bool TestDistanceFieldRepairMatchesRegeneration(std::vector<std::string>& out_reportLines)
+{
+	constexpr int NUM_MAPS_PER_SETTINGS = 8;
+	constexpr int NUM_EDITS_PER_MAP = 30;
+	constexpr float WALL_CHANCE = 0.25f;
+
+	TilePathSettings settingsList[5];
+	settingsList[0].m_allowDiagonals = false;
+	settingsList[1].m_allowDiagonals = true;
+	settingsList[1].m_allowCornerCutting = false;
+	settingsList[2].m_allowDiagonals = true;
+	settingsList[2].m_allowCornerCutting = true;
+	settingsList[3].m_allowDiagonals = false;
+	settingsList[3].m_maxDistance = 12.f;
+	settingsList[4].m_allowDiagonals = true;
+	settingsList[4].m_maxDistance = 12.f;
+
+	RandomNumberGenerator rng(46);
+	auto RollTileCost = [&rng](bool isUniform)
+		{
+			if (rng.RollRandomFloatZeroToOne() < WALL_CHANCE)
+			{
+				return TILE_COST_IMPASSABLE;
+			}
+			return isUniform ? 1.f : 1.f + 0.5f * (float)rng.RollRandomIntInRange(0, 3);
+		};
+
+	int numRepairsChecked = 0;
+	int numMismatchedRepairs = 0;
+	TileDistanceFieldRepairer repairer;
+	for (TilePathSettings const& settings : settingsList)
+	{
+		for (int mapIndex = 0; mapIndex < NUM_MAPS_PER_SETTINGS; ++mapIndex)
+		{
+			IntVec2 dims(rng.RollRandomIntInRange(8, 48), rng.RollRandomIntInRange(8, 48));
+			bool isUniform = mapIndex % 2 == 0;
+			TileHeatMap costs(dims);
+			for (int tileIndex = 0; tileIndex < dims.x * dims.y; ++tileIndex)
+			{
+				costs.GetValues()[tileIndex] = RollTileCost(isUniform);
+			}
+			std::vector<IntVec2> sources;
+			for (int sourceIndex = rng.RollRandomIntInRange(1, 3); sourceIndex > 0; --sourceIndex)
+			{
+				sources.push_back(IntVec2(rng.RollRandomIntLessThan(dims.x), rng.RollRandomIntLessThan(dims.y)));
+			}
+
+			TileHeatMap repaired(dims);
+			TileHeatMap regenerated(dims);
+			GenerateDistanceField(repaired, costs, sources, settings);
+			for (int editIndex = 0; editIndex < NUM_EDITS_PER_MAP; ++editIndex)
+			{
+				std::vector<IntVec2> changedTiles;
+				for (int numEdited = editIndex % 5 == 0 ? rng.RollRandomIntInRange(2, 6) : 1; numEdited > 0; --numEdited)
+				{
+					IntVec2 tileCoords(rng.RollRandomIntLessThan(dims.x), rng.RollRandomIntLessThan(dims.y));
+					costs.SetValue(tileCoords, RollTileCost(isUniform));
+					changedTiles.push_back(tileCoords);
+				}
+				repairer.RepairDistanceField(repaired, costs, sources, changedTiles, settings);
+				GenerateDistanceField(regenerated, costs, sources, settings);
+
+				++numRepairsChecked;
+				if (memcmp(repaired.GetValues(), regenerated.GetValues(), dims.x * dims.y * sizeof(float)) != 0)
+				{
+					++numMismatchedRepairs;
+					GenerateDistanceField(repaired, costs, sources, settings);	// so one bad repair is not counted again
+				}
+			}
+		}
+	}
+
+	bool passed = numMismatchedRepairs == 0;
+	out_reportLines.push_back(Stringf("%s Distance field repair: %d of %d repairs differ from a full regeneration", passed ? "PASS" : "FAIL", numMismatchedRepairs, numRepairsChecked));
+	return passed;
+}
+
+//----------------------------------------------------------------------------------------------
+// VoxelLightEngine after random block edits against a new engine that relights every chunk from scratch, cell for
+// cell, once propagating inline and once with a JobSystem. Regions of 2x2 chunks over a 3x3x2 world put removal and
+// addition floods from different regions in the same passes; edits place and dig opaque blocks, glass and both kinds
+// of emitter, so sky and block light both get removed and re-seeded across chunk and region borders.
+//
+bool TestVoxelLightMatchesFullRelight(std::vector<std::string>& out_reportLines)
+{
+	constexpr ChunkBlockType STONE = 1;
+	constexpr ChunkBlockType GLASS = 2;
+	constexpr ChunkBlockType LANTERN = 3;	// transparent emitter
+	constexpr ChunkBlockType GLOWSTONE = 4;	// opaque emitter
+	constexpr int NUM_EDITS = 200;
+	constexpr int EDITS_PER_CHECK = 5;
+	constexpr int NUM_JOB_WORKERS = 3;
+	IntVec3 const chunkDims(8, 8, 16);
+	IntVec3 const worldSizeInChunks(3, 3, 2);
+	IntVec3 const worldDims(chunkDims.x * worldSizeInChunks.x, chunkDims.y * worldSizeInChunks.y, chunkDims.z * worldSizeInChunks.z);
+
+	VoxelLightEngineConfig config;
+	config.m_chunkDimensions = chunkDims;
+	config.m_regionSizeInChunks = IntVec3(2, 2, 1);
+	config.m_blockDefs.resize(5);
+	config.m_blockDefs[CHUNK_BLOCK_AIR].m_isOpaque = false;
+	config.m_blockDefs[GLASS].m_isOpaque = false;
+	config.m_blockDefs[LANTERN].m_isOpaque = false;
+	config.m_blockDefs[LANTERN].m_emission = 14;
+	config.m_blockDefs[GLOWSTONE].m_emission = MAX_VOXEL_LIGHT_LEVEL;
+	ChunkBlockType const editBlocks[] = { CHUNK_BLOCK_AIR, CHUNK_BLOCK_AIR, STONE, STONE, GLASS, LANTERN, GLOWSTONE };
+
+	JobSystemConfig jobSystemConfig;
+	jobSystemConfig.m_numWorkerThreads = NUM_JOB_WORKERS;
+	JobSystem jobSystem(jobSystemConfig);
+	jobSystem.Startup();
+
+	RandomNumberGenerator rng(37);
+	int numChecks[2] = {};
+	int numMismatchedChecks[2] = {};
+	for (int useJobs = 0; useJobs < 2; ++useJobs)
+	{
+		// Hills with caves and a few lanterns and glowstones
+		std::vector<VoxelChunk> chunks;
+		chunks.reserve(worldSizeInChunks.x * worldSizeInChunks.y * worldSizeInChunks.z);
+		for (int chunkZ = 0; chunkZ < worldSizeInChunks.z; ++chunkZ)
+		{
+			for (int chunkY = 0; chunkY < worldSizeInChunks.y; ++chunkY)
+			{
+				for (int chunkX = 0; chunkX < worldSizeInChunks.x; ++chunkX)
+				{
+					chunks.emplace_back(IntVec3(chunkX, chunkY, chunkZ), chunkDims);
+				}
+			}
+		}
+		auto GetChunkAt = [&](IntVec3 const& worldCoords) -> VoxelChunk&
+			{
+				IntVec3 chunkCoords(worldCoords.x / chunkDims.x, worldCoords.y / chunkDims.y, worldCoords.z / chunkDims.z);
+				return chunks[chunkCoords.x + chunkCoords.y * worldSizeInChunks.x + chunkCoords.z * worldSizeInChunks.x * worldSizeInChunks.y];
+			};
+		auto SetWorldBlock = [&](IntVec3 const& worldCoords, ChunkBlockType blockType)
+			{
+				IntVec3 localCoords(worldCoords.x % chunkDims.x, worldCoords.y % chunkDims.y, worldCoords.z % chunkDims.z);
+				GetChunkAt(worldCoords).SetBlock(localCoords, blockType);
+			};
+		// Ground crosses the chunk layers' boundary at z = 16, so the lower layer is covered by the upper one
+		std::vector<int> groundHeights((worldDims.x / 4) * (worldDims.y / 4));
+		for (int& groundHeight : groundHeights)
+		{
+			groundHeight = rng.RollRandomIntInRange(12, 20);
+		}
+		for (int y = 0; y < worldDims.y; ++y)
+		{
+			for (int x = 0; x < worldDims.x; ++x)
+			{
+				int groundHeight = groundHeights[x / 4 + (y / 4) * (worldDims.x / 4)];
+				for (int z = 0; z < worldDims.z; ++z)
+				{
+					ChunkBlockType blockType = z < groundHeight ? STONE : CHUNK_BLOCK_AIR;
+					float roll = rng.RollRandomFloatZeroToOne();
+					if (blockType == STONE && roll < 0.25f)
+					{
+						blockType = CHUNK_BLOCK_AIR;
+					}
+					else if (roll > 0.995f)
+					{
+						blockType = blockType == STONE ? GLOWSTONE : LANTERN;
+					}
+					SetWorldBlock(IntVec3(x, y, z), blockType);
+				}
+			}
+		}
+
+		JobSystem* jobSystemToUse = useJobs != 0 ? &jobSystem : nullptr;
+		VoxelLightEngine incremental(config);
+		for (VoxelChunk const& chunk : chunks)
+		{
+			incremental.AddChunk(&chunk);
+		}
+		incremental.PropagateLight(jobSystemToUse);
+
+		// Check 0 is the initial light, with the chunks added bottom-up so each layer gets covered after it was queued
+		for (int editIndex = 0; editIndex <= NUM_EDITS; ++editIndex)
+		{
+			if (editIndex > 0)
+			{
+				IntVec3 worldCoords(rng.RollRandomIntLessThan(worldDims.x), rng.RollRandomIntLessThan(worldDims.y), rng.RollRandomIntLessThan(worldDims.z));
+				SetWorldBlock(worldCoords, editBlocks[rng.RollRandomIntLessThan((int)(sizeof(editBlocks) / sizeof(editBlocks[0])))]);
+				incremental.OnBlockChanged(worldCoords);
+				incremental.PropagateLight(jobSystemToUse);
+			}
+			if (editIndex % EDITS_PER_CHECK != 0)
+			{
+				continue;
+			}
+
+			// Added top-down, so no layer is ever lit by open sky and then covered
+			VoxelLightEngine relit(config);
+			for (int chunkIndex = (int)chunks.size() - 1; chunkIndex >= 0; --chunkIndex)
+			{
+				relit.AddChunk(&chunks[chunkIndex]);
+			}
+			relit.PropagateLight();
+			++numChecks[useJobs];
+			for (VoxelChunk const& chunk : chunks)
+			{
+				if (memcmp(incremental.GetChunkLightLevels(chunk.GetChunkCoords()), relit.GetChunkLightLevels(chunk.GetChunkCoords()), chunk.GetNumBlocks()) != 0)
+				{
+					++numMismatchedChecks[useJobs];
+					break;
+				}
+			}
+		}
+	}
+	jobSystem.ShutDown();
+
+	bool passed = numMismatchedChecks[0] == 0 && numMismatchedChecks[1] == 0;
+	out_reportLines.push_back(Stringf("%s Voxel light: %d of %d checks differ from a full relight inline, %d of %d with %d job workers",
+		passed ? "PASS" : "FAIL", numMismatchedChecks[0], numChecks[0], numMismatchedChecks[1], numChecks[1], NUM_JOB_WORKERS));
+	return passed;
+}
+
+//----------------------------------------------------------------------------------------------
+// HeatMapPlane's bulk ops on planes 7, 16, 37, 64 and 101 tiles wide, with NaN tiles landing in both the SIMD chunks and
+// the scalar tails, against one per-tile rule: the compare-and-pick the intrinsics do (a < b ? a : b, a > b ? a : b).
+// Dilate is checked against that rule applied in the filter's own order; GetValueRange must skip NaN tiles.
+//
+bool TestHeatMapOpsMatchScalarRules(std::vector<std::string>& out_reportLines)
+{
+	constexpr int PLANE_HEIGHT = 5;
+	constexpr int DILATE_RADIUS = 2;
+	constexpr int NUM_OPS = 5;
+	int const planeWidths[] = { 7, 16, 37, 64, 101 };
+	float const nan = std::numeric_limits<float>::quiet_NaN();
+	auto PickMin = [](float a, float b) { return a < b ? a : b; };
+	auto PickMax = [](float a, float b) { return a > b ? a : b; };
+	auto IsSameTile = [](float a, float b) { return (a != a && b != b) || memcmp(&a, &b, sizeof(float)) == 0; };
+
+	int numTilesChecked = 0;
+	int numMismatches = 0;
+	int numBadRanges = 0;
+	for (int width : planeWidths)
+	{
+		IntVec2 dims(width, PLANE_HEIGHT);
+		int numTiles = dims.x * dims.y;
+		std::vector<float> base(numTiles);
+		std::vector<float> other(numTiles);
+		FloatRange expectedRange(FLT_MAX, -FLT_MAX);
+		for (int tileIndex = 0; tileIndex < numTiles; ++tileIndex)
+		{
+			base[tileIndex] = tileIndex % 5 == 2 ? nan : (float)(tileIndex % 11) - 5.f;
+			other[tileIndex] = tileIndex % 7 == 3 ? nan : (float)(tileIndex % 9) - 4.f;
+			if (base[tileIndex] == base[tileIndex])
+			{
+				expectedRange.m_min = PickMin(base[tileIndex], expectedRange.m_min);
+				expectedRange.m_max = PickMax(base[tileIndex], expectedRange.m_max);
+			}
+		}
+
+		// Dilate's reference: rows first, then columns, each starting from its first tile (or the -FLT_MAX pad)
+		std::vector<float> rowMaxes(numTiles);
+		std::vector<float> dilated(numTiles);
+		for (int y = 0; y < dims.y; ++y)
+		{
+			for (int x = 0; x < dims.x; ++x)
+			{
+				float result = -FLT_MAX;
+				for (int sourceX = x - DILATE_RADIUS; sourceX <= x + DILATE_RADIUS; ++sourceX)
+				{
+					float next = sourceX >= 0 && sourceX < dims.x ? base[sourceX + y * dims.x] : -FLT_MAX;
+					result = sourceX == x - DILATE_RADIUS ? next : PickMax(result, next);
+				}
+				rowMaxes[x + y * dims.x] = result;
+			}
+		}
+		for (int y = 0; y < dims.y; ++y)
+		{
+			int firstY = y - DILATE_RADIUS > 0 ? y - DILATE_RADIUS : 0;
+			int lastY = y + DILATE_RADIUS < dims.y - 1 ? y + DILATE_RADIUS : dims.y - 1;
+			for (int x = 0; x < dims.x; ++x)
+			{
+				float result = rowMaxes[x + firstY * dims.x];
+				for (int sourceY = firstY + 1; sourceY <= lastY; ++sourceY)
+				{
+					result = PickMax(result, rowMaxes[x + sourceY * dims.x]);
+				}
+				dilated[x + y * dims.x] = result;
+			}
+		}
+
+		std::vector<float> values;
+		for (int opIndex = 0; opIndex < NUM_OPS; ++opIndex)
+		{
+			values = base;
+			HeatMapPlane plane(values.data(), dims);
+			HeatMapPlane otherPlane(other.data(), dims);
+			switch (opIndex)
+			{
+			case 0:		plane.Threshold(0.f, -1.f, 1.f);	break;
+			case 1:		plane.ClampAll(-2.f, 2.f);			break;
+			case 2:		plane.MinWith(otherPlane);			break;
+			case 3:		plane.MaxWith(otherPlane);			break;
+			default:	plane.Dilate(DILATE_RADIUS);		break;
+			}
+			for (int tileIndex = 0; tileIndex < numTiles; ++tileIndex)
+			{
+				float value = base[tileIndex];
+				float expected;
+				switch (opIndex)
+				{
+				case 0:		expected = value < 0.f ? -1.f : 1.f;						break;
+				case 1:		expected = PickMin(PickMax(value, -2.f), 2.f);				break;
+				case 2:		expected = PickMin(value, other[tileIndex]);				break;
+				case 3:		expected = PickMax(value, other[tileIndex]);				break;
+				default:	expected = dilated[tileIndex];								break;
+				}
+				numMismatches += IsSameTile(expected, values[tileIndex]) ? 0 : 1;
+			}
+			numTilesChecked += numTiles;
+		}
+
+		FloatRange range = HeatMapPlane(base.data(), dims).GetValueRange();
+		numBadRanges += range == expectedRange ? 0 : 1;
+	}
+
+	bool passed = numMismatches == 0 && numBadRanges == 0;
+	out_reportLines.push_back(Stringf("%s HeatMapPlane NaN handling: %d of %d tiles differ from the per-tile rule; %d value ranges wrong",
+		passed ? "PASS" : "FAIL", numMismatches, numTilesChecked, numBadRanges));
+	return passed;
+}
+
+//----------------------------------------------------------------------------------------------
+// 64 boxes and 64 spheres scattered through a 100m cube, 4096 random 100m rays. "Full" is what line-of-sight callers
+// did before the hit-only queries: build a RaycastResult3D per primitive and stop at the first m_didImpact. The
+// blocked counts differ because RaycastVsAABB3D misses rays that start inside a box and RaycastVsSphere3D tests only
+// in XY; the hit-only queries agree with a brute-force march along the ray.
+//
+void BenchmarkLineOfSight(std::vector<std::string>& out_reportLines)
+{
+	constexpr int NUM_PRIMITIVES = 64;
+	constexpr int NUM_RAYS = 4096;
+	constexpr int NUM_PASSES = 20;
+	constexpr float RAY_LENGTH = 100.f;
+
+	RandomNumberGenerator rng(27);
+	std::vector<AABB3> boxes;
+	std::vector<Vec3> sphereCenters;
+	std::vector<float> sphereRadii;
+	for (int primitiveIndex = 0; primitiveIndex < NUM_PRIMITIVES; ++primitiveIndex)
+	{
+		Vec3 mins(rng.RollRandomFloatInRange(-50.f, 50.f), rng.RollRandomFloatInRange(-50.f, 50.f), rng.RollRandomFloatInRange(-50.f, 50.f));
+		Vec3 size(rng.RollRandomFloatInRange(1.f, 6.f), rng.RollRandomFloatInRange(1.f, 6.f), rng.RollRandomFloatInRange(1.f, 6.f));
+		boxes.push_back(AABB3(mins.x, mins.y, mins.z, mins.x + size.x, mins.y + size.y, mins.z + size.z));
+		sphereCenters.push_back(Vec3(rng.RollRandomFloatInRange(-50.f, 50.f), rng.RollRandomFloatInRange(-50.f, 50.f), rng.RollRandomFloatInRange(-50.f, 50.f)));
+		sphereRadii.push_back(rng.RollRandomFloatInRange(0.5f, 3.f));
+	}
+	std::vector<Vec3> rayStarts;
+	std::vector<Vec3> rayNormals;
+	for (int rayIndex = 0; rayIndex < NUM_RAYS; ++rayIndex)
+	{
+		rayStarts.push_back(Vec3(rng.RollRandomFloatInRange(-50.f, 50.f), rng.RollRandomFloatInRange(-50.f, 50.f), rng.RollRandomFloatInRange(-50.f, 50.f)));
+		Vec3 direction(rng.RollRandomFloatInRange(-1.f, 1.f), rng.RollRandomFloatInRange(-1.f, 1.f), rng.RollRandomFloatInRange(-1.f, 1.f));
+		rayNormals.push_back(direction.GetNormalized());
+	}
+
+	int numBoxHitsFull = 0;
+	int numBoxHitsAny = 0;
+	int numSphereHitsFull = 0;
+	int numSphereHitsAny = 0;
+	double boxSecondsFull = 0.0;
+	double boxSecondsAny = 0.0;
+	double sphereSecondsFull = 0.0;
+	double sphereSecondsAny = 0.0;
+	for (int passIndex = 0; passIndex < NUM_PASSES; ++passIndex)
+	{
+		double startTime = GetCurrentTimeSeconds();
+		for (int rayIndex = 0; rayIndex < NUM_RAYS; ++rayIndex)
+		{
+			for (int boxIndex = 0; boxIndex < NUM_PRIMITIVES; ++boxIndex)
+			{
+				RaycastResult3D result = RaycastVsAABB3D(rayStarts[rayIndex], rayNormals[rayIndex], RAY_LENGTH, boxes[boxIndex]);
+				if (result.m_didImpact)
+				{
+					++numBoxHitsFull;
+					break;
+				}
+			}
+		}
+		double midTime = GetCurrentTimeSeconds();
+		for (int rayIndex = 0; rayIndex < NUM_RAYS; ++rayIndex)
+		{
+			numBoxHitsAny += IsRayOccludedByAABBs3D(rayStarts[rayIndex], rayNormals[rayIndex], RAY_LENGTH, boxes.data(), NUM_PRIMITIVES) ? 1 : 0;
+		}
+		double endTime = GetCurrentTimeSeconds();
+		boxSecondsFull += midTime - startTime;
+		boxSecondsAny += endTime - midTime;
+
+		startTime = GetCurrentTimeSeconds();
+		for (int rayIndex = 0; rayIndex < NUM_RAYS; ++rayIndex)
+		{
+			for (int sphereIndex = 0; sphereIndex < NUM_PRIMITIVES; ++sphereIndex)
+			{
+				RaycastResult3D result = RaycastVsSphere3D(rayStarts[rayIndex], rayNormals[rayIndex], RAY_LENGTH, sphereCenters[sphereIndex], sphereRadii[sphereIndex]);
+				if (result.m_didImpact)
+				{
+					++numSphereHitsFull;
+					break;
+				}
+			}
+		}
+		midTime = GetCurrentTimeSeconds();
+		for (int rayIndex = 0; rayIndex < NUM_RAYS; ++rayIndex)
+		{
+			numSphereHitsAny += IsRayOccludedBySpheres3D(rayStarts[rayIndex], rayNormals[rayIndex], RAY_LENGTH, sphereCenters.data(), sphereRadii.data(), NUM_PRIMITIVES) ? 1 : 0;
+		}
+		endTime = GetCurrentTimeSeconds();
+		sphereSecondsFull += midTime - startTime;
+		sphereSecondsAny += endTime - midTime;
+	}
+
+	double numRaysCast = (double)NUM_RAYS * (double)NUM_PASSES;
+	out_reportLines.push_back(Stringf("Line of sight vs %d AABB3s: full results %.0f ns/ray, any-hit %.0f ns/ray (%.1fx); %d vs %d rays blocked",
+		NUM_PRIMITIVES, boxSecondsFull * 1e9 / numRaysCast, boxSecondsAny * 1e9 / numRaysCast, boxSecondsFull / boxSecondsAny,
+		numBoxHitsFull / NUM_PASSES, numBoxHitsAny / NUM_PASSES));
+	out_reportLines.push_back(Stringf("Line of sight vs %d spheres: full results %.0f ns/ray, any-hit %.0f ns/ray (%.1fx); %d vs %d rays blocked",
+		NUM_PRIMITIVES, sphereSecondsFull * 1e9 / numRaysCast, sphereSecondsAny * 1e9 / numRaysCast, sphereSecondsFull / sphereSecondsAny,
+		numSphereHitsFull / NUM_PASSES, numSphereHitsAny / NUM_PASSES));
+}
+//----------------------------------------------------------------------------------------------
+// The self-test's 41-section spline with 10000 distances along it, as for 10000 entities walking it. "Resample" is
+// the path every query took before the table (still taken for any subdivision count but the table's, here 65), which
+// walks the whole spline per query; the table answers single queries in shuffled order and a sorted batch.
+//
+void BenchmarkArcLengthQueries(std::vector<std::string>& out_reportLines)
+{
+	constexpr int NUM_DISTANCES = 10000;
+	constexpr int RESAMPLE_STRIDE = 100;
+	constexpr int NUM_PASSES = 20;
+	constexpr int NUM_REBUILDS = 100;
+
+	RandomNumberGenerator rng(43);
+	std::vector<Vec2> points = MakeTestSplinePoints(rng);
+	CatmullRomSpline spline(points);
+	float length = spline.GetApproximateLength();
+	std::vector<float> distances(NUM_DISTANCES);
+	for (int distanceIndex = 0; distanceIndex < NUM_DISTANCES; ++distanceIndex)
+	{
+		distances[distanceIndex] = length * (float)distanceIndex / (float)NUM_DISTANCES;
+	}
+	std::vector<Vec2> positions(NUM_DISTANCES);
+	float checksum = 0.f;
+
+	double startTime = GetCurrentTimeSeconds();
+	for (int distanceIndex = 0; distanceIndex < NUM_DISTANCES; distanceIndex += RESAMPLE_STRIDE)
+	{
+		checksum += spline.EvaluateAtApproximateDistance(distances[distanceIndex], CatmullRomSpline::ARC_LENGTH_TABLE_SUBDIVISIONS + 1).x;
+	}
+	double resampleSeconds = (GetCurrentTimeSeconds() - startTime) / (double)(NUM_DISTANCES / RESAMPLE_STRIDE);
+	startTime = GetCurrentTimeSeconds();
+	for (int passIndex = 0; passIndex < NUM_PASSES; ++passIndex)
+	{
+		for (int distanceIndex = 0; distanceIndex < NUM_DISTANCES; ++distanceIndex)
+		{
+			checksum += spline.EvaluateAtApproximateDistance(distances[(distanceIndex * 7919) % NUM_DISTANCES]).x;
+		}
+	}
+	double tableSeconds = (GetCurrentTimeSeconds() - startTime) / (double)(NUM_PASSES * NUM_DISTANCES);
+	startTime = GetCurrentTimeSeconds();
+	for (int passIndex = 0; passIndex < NUM_PASSES; ++passIndex)
+	{
+		spline.EvaluateAtApproximateDistances(distances.data(), positions.data(), NUM_DISTANCES);
+		checksum += positions[passIndex].x;
+	}
+	double batchSeconds = (GetCurrentTimeSeconds() - startTime) / (double)(NUM_PASSES * NUM_DISTANCES);
+	startTime = GetCurrentTimeSeconds();
+	for (int rebuildIndex = 0; rebuildIndex < NUM_REBUILDS; ++rebuildIndex)
+	{
+		spline.SetPositions(points);
+	}
+	double rebuildSeconds = (GetCurrentTimeSeconds() - startTime) / (double)NUM_REBUILDS;
+
+	out_reportLines.push_back(Stringf("Spline distance queries, %d sections: resample %.1f us, table %.3f us, sorted batch %.3f us per query; SetPositions with table %.1f us (checksum %.0f)",
+		(int)points.size() - 1, resampleSeconds * 1e6, tableSeconds * 1e6, batchSeconds * 1e6, rebuildSeconds * 1e6, checksum));
+}
+
+//----------------------------------------------------------------------------------------------
+// 100k boxes with about 5% visible, culled by a scalar IsAABBVisible loop, CullAABBs over the SoA and CullAABBTree.
+// The three visible sets are compared once before timing.
+//
+void BenchmarkFrustumCulling(std::vector<std::string>& out_reportLines)
+{
+	constexpr int NUM_BOXES = 100000;
+	constexpr int NUM_FRAMES = 100;
+
+	RandomNumberGenerator rng(29);
+	std::vector<AABB3> boxes;
+	AABB3SoA boxSoA;
+	SphereSoA boundingSpheres;
+	MakeCullingBoxes(NUM_BOXES, rng, boxes, boxSoA, boundingSpheres);
+	double startTime = GetCurrentTimeSeconds();
+	AABB3Tree tree;
+	tree.Build(boxes);
+	double buildSeconds = GetCurrentTimeSeconds() - startTime;
+	Frustum frustum = MakeTestFrustum(Vec3(1.f, 2.f, 3.f), EulerAngles(30.f, 10.f, 0.f));
+
+	std::vector<char> isVisible(NUM_BOXES);
+	for (int boxIndex = 0; boxIndex < NUM_BOXES; ++boxIndex)
+	{
+		isVisible[boxIndex] = frustum.IsAABBVisible(boxes[boxIndex]) ? 1 : 0;
+	}
+	std::vector<int> visibleIndices;
+	frustum.CullAABBs(boxSoA, visibleIndices);
+	int numDifferences = CountVisibleSetDifferences(isVisible, visibleIndices);
+	frustum.CullAABBTree(tree, visibleIndices);
+	numDifferences += CountVisibleSetDifferences(isVisible, visibleIndices);
+	int numVisible = (int)visibleIndices.size();
+
+	startTime = GetCurrentTimeSeconds();
+	for (int frameIndex = 0; frameIndex < NUM_FRAMES; ++frameIndex)
+	{
+		visibleIndices.clear();
+		for (int boxIndex = 0; boxIndex < NUM_BOXES; ++boxIndex)
+		{
+			if (frustum.IsAABBVisible(boxes[boxIndex]))
+			{
+				visibleIndices.push_back(boxIndex);
+			}
+		}
+	}
+	double scalarSeconds = (GetCurrentTimeSeconds() - startTime) / (double)NUM_FRAMES;
+	startTime = GetCurrentTimeSeconds();
+	for (int frameIndex = 0; frameIndex < NUM_FRAMES; ++frameIndex)
+	{
+		frustum.CullAABBs(boxSoA, visibleIndices);
+	}
+	double soaSeconds = (GetCurrentTimeSeconds() - startTime) / (double)NUM_FRAMES;
+	startTime = GetCurrentTimeSeconds();
+	for (int frameIndex = 0; frameIndex < NUM_FRAMES; ++frameIndex)
+	{
+		frustum.CullAABBTree(tree, visibleIndices);
+	}
+	double treeSeconds = (GetCurrentTimeSeconds() - startTime) / (double)NUM_FRAMES;
+
+	out_reportLines.push_back(Stringf("Frustum culling, %d boxes, %d visible: scalar %.3f ms, CullAABBs %.3f ms, CullAABBTree %.3f ms (build %.1f ms); visible sets %s",
+		NUM_BOXES, numVisible, scalarSeconds * 1000.0, soaSeconds * 1000.0, treeSeconds * 1000.0, buildSeconds * 1000.0,
+		numDifferences == 0 ? "identical" : Stringf("differ at %d indices", numDifferences).c_str()));
+}
+
+//----------------------------------------------------------------------------------------------
+// 16 terrain-like 16x16x128 chunks meshed on one thread, one quad per face and greedily merged
+//
+void BenchmarkChunkMeshing(std::vector<std::string>& out_reportLines)
+{
+	constexpr int NUM_CHUNKS = 16;
+	constexpr int NUM_PASSES = 3;
+	IntVec3 const dimensions(16, 16, 128);
+
+	RandomNumberGenerator rng(35);
+	std::vector<std::vector<ChunkBlockType>> chunks(NUM_CHUNKS);
+	for (int chunkIndex = 0; chunkIndex < NUM_CHUNKS; ++chunkIndex)
+	{
+		MakeTestChunkBlocks(dimensions, chunkIndex % 4, chunkIndex / 4, rng, chunks[chunkIndex]);
+	}
+	std::vector<ChunkBlockAppearance> appearances = MakeTestBlockAppearances();
+
+	std::string reportLine = "Chunk meshing, 16x16x128, per chunk:";
+	std::vector<Vertex_PCUTBN> verts;
+	std::vector<unsigned int> indexes;
+	for (int mergeMode = 0; mergeMode < 2; ++mergeMode)
+	{
+		size_t numVerts = 0;
+		size_t numIndexes = 0;
+		double startTime = GetCurrentTimeSeconds();
+		for (int passIndex = 0; passIndex < NUM_PASSES; ++passIndex)
+		{
+			numVerts = 0;
+			numIndexes = 0;
+			for (int chunkIndex = 0; chunkIndex < NUM_CHUNKS; ++chunkIndex)
+			{
+				ChunkMeshInput input;
+				input.m_blocks = chunks[chunkIndex].data();
+				input.m_dimensions = dimensions;
+				input.m_appearances = &appearances;
+				input.m_mergeFaces = mergeMode == 1;
+				verts.clear();
+				indexes.clear();
+				BuildChunkMesh(input, verts, indexes);
+				numVerts += verts.size();
+				numIndexes += indexes.size();
+			}
+		}
+		double secondsPerChunk = (GetCurrentTimeSeconds() - startTime) / (double)(NUM_PASSES * NUM_CHUNKS);
+		reportLine += Stringf(" %s %.2f ms, %d verts + %d indexes (%d KB)%s", mergeMode == 1 ? "greedy" : "per-face", secondsPerChunk * 1000.0,
+			(int)(numVerts / NUM_CHUNKS), (int)(numIndexes / NUM_CHUNKS), (int)((numVerts * sizeof(Vertex_PCUTBN) + numIndexes * sizeof(unsigned int)) / NUM_CHUNKS / 1024),
+			mergeMode == 1 ? "" : ";");
+	}
+	out_reportLines.push_back(reportLine);
+}
+//----------------------------------------------------------------------------------------------
+// 512x512 maps, corner to corner: open with uniform costs, 20% walls with uniform costs, and 20% walls with costs 1-4.
+// The field runs on its bucketed queue; "heap" is the same map with one 100000-cost tile, which pushes it onto the
+// binary heap fallback, and "plain pq" is the double-precision std::priority_queue Dijkstra games wrote before. JPS
+// needs uniform costs, so it is skipped on the third map. Node counts are what each search expanded.
+//
+void BenchmarkTilePathfinding(std::vector<std::string>& out_reportLines)
+{
+	constexpr int NUM_PASSES = 3;
+	constexpr int NUM_CACHED_LOOKUPS = 1000;
+	IntVec2 const dims(512, 512);
+	IntVec2 const start(2, 2);
+	IntVec2 const goal(509, 509);
+	char const* mapNames[3] = { "open, uniform", "20% walls, uniform", "20% walls, cost 1-4" };
+
+	RandomNumberGenerator rng(512);
+	TilePathfinder pathfinder;
+	TileFlowField flowField;
+	std::vector<IntVec2> path;
+	for (int mapIndex = 0; mapIndex < 3; ++mapIndex)
+	{
+		TileHeatMap costs = MakeRandomCostMap(dims, mapIndex == 0 ? 0.f : 0.2f, mapIndex == 2 ? 4 : 1, rng);
+		costs.SetValue(start, 1.f);
+		costs.SetValue(goal, 1.f);
+		TileHeatMap heapCosts = costs;
+		heapCosts.SetValue(IntVec2(300, 300), 100000.f);
+		TilePathSettings settings;
+		TileHeatMap field(dims);
+		std::vector<IntVec2> sources{ goal };
+
+		double startTime = GetCurrentTimeSeconds();
+		for (int passIndex = 0; passIndex < NUM_PASSES; ++passIndex)
+		{
+			GenerateDistanceField(field, heapCosts, sources, settings);
+		}
+		double heapSeconds = (GetCurrentTimeSeconds() - startTime) / NUM_PASSES;
+		startTime = GetCurrentTimeSeconds();
+		for (int passIndex = 0; passIndex < NUM_PASSES; ++passIndex)
+		{
+			ComputeReferenceDistances(costs, goal, settings);
+		}
+		double plainSeconds = (GetCurrentTimeSeconds() - startTime) / NUM_PASSES;
+		startTime = GetCurrentTimeSeconds();
+		for (int passIndex = 0; passIndex < NUM_PASSES; ++passIndex)
+		{
+			GenerateDistanceField(field, costs, sources, settings);
+		}
+		double fieldSeconds = (GetCurrentTimeSeconds() - startTime) / NUM_PASSES;
+		startTime = GetCurrentTimeSeconds();
+		for (int passIndex = 0; passIndex < NUM_PASSES; ++passIndex)
+		{
+			flowField.Generate(field, costs, settings);
+		}
+		double flowSeconds = (GetCurrentTimeSeconds() - startTime) / NUM_PASSES;
+
+		startTime = GetCurrentTimeSeconds();
+		for (int passIndex = 0; passIndex < NUM_PASSES; ++passIndex)
+		{
+			pathfinder.FindPath(costs, start, goal, path, settings);
+		}
+		double aStarSeconds = (GetCurrentTimeSeconds() - startTime) / NUM_PASSES;
+		int numAStarNodes = pathfinder.GetNumNodesExpanded();
+		std::string jpsText = "JPS n/a";
+		if (mapIndex < 2)
+		{
+			startTime = GetCurrentTimeSeconds();
+			for (int passIndex = 0; passIndex < NUM_PASSES; ++passIndex)
+			{
+				pathfinder.FindPathJPS(costs, start, goal, path, settings);
+			}
+			double jpsSeconds = (GetCurrentTimeSeconds() - startTime) / NUM_PASSES;
+			jpsText = Stringf("JPS %.2f ms (%d nodes)", jpsSeconds * 1000.0, pathfinder.GetNumNodesExpanded());
+		}
+
+		TilePathCache cache(costs, settings);
+		cache.FindPath(start, goal, path);
+		startTime = GetCurrentTimeSeconds();
+		for (int lookupIndex = 0; lookupIndex < NUM_CACHED_LOOKUPS; ++lookupIndex)
+		{
+			cache.FindPath(start, goal, path);
+		}
+		double cachedSeconds = (GetCurrentTimeSeconds() - startTime) / NUM_CACHED_LOOKUPS;
+
+		out_reportLines.push_back(Stringf("Paths 512x512 %s: field %.2f ms (heap %.2f, plain pq %.2f), flow %.2f ms; A* %.2f ms (%d nodes), %s; cached path %.2f us",
+			mapNames[mapIndex], fieldSeconds * 1000.0, heapSeconds * 1000.0, plainSeconds * 1000.0, flowSeconds * 1000.0,
+			aStarSeconds * 1000.0, numAStarNodes, jpsText.c_str(), cachedSeconds * 1e6));
+	}
+}
\ No newline at end of file
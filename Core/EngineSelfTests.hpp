@@ -0,0 +1,32 @@
+#pragma once
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------
+// Self-checks and micro-benchmarks for the engine's fast paths. Nothing here needs a window or a GPU, so they run from
+// the dev console ("selftest", "selfbench") and in headless ENGINE_NULL_RENDERER builds. Each one appends one readable
+// line per case to out_reportLines.
+//
+// Self-checks compare a fast path against the reference code it must match and return false on a mismatch.
+bool RunEngineSelfTests(std::vector<std::string>& out_reportLines);
+
+bool TestFastTrigErrorBounds(std::vector<std::string>& out_reportLines);
+bool TestArcLengthTableMatchesReference(std::vector<std::string>& out_reportLines);
+bool TestFrustumCullingPathsAgree(std::vector<std::string>& out_reportLines);
+bool TestChunkMeshCoversVisibleFaces(std::vector<std::string>& out_reportLines);
+bool TestRandomBatchesMatchSingleRolls(std::vector<std::string>& out_reportLines);
+bool TestSplineSamplesMatchScalarSections(std::vector<std::string>& out_reportLines);
+bool TestRawNoiseGridMatchesScalar(std::vector<std::string>& out_reportLines);
+bool TestPathfindingMatchesDijkstra(std::vector<std::string>& out_reportLines);
+bool TestDistanceFieldRepairMatchesRegeneration(std::vector<std::string>& out_reportLines);
+bool TestVoxelLightMatchesFullRelight(std::vector<std::string>& out_reportLines);
+bool TestHeatMapOpsMatchScalarRules(std::vector<std::string>& out_reportLines);
+
+// Benchmarks time a fast path against the slower code its callers used before.
+void RunEngineBenchmarks(std::vector<std::string>& out_reportLines);
+
+void BenchmarkLineOfSight(std::vector<std::string>& out_reportLines);
+void BenchmarkArcLengthQueries(std::vector<std::string>& out_reportLines);
+void BenchmarkFrustumCulling(std::vector<std::string>& out_reportLines);
+void BenchmarkChunkMeshing(std::vector<std::string>& out_reportLines);
+void BenchmarkTilePathfinding(std::vector<std::string>& out_reportLines);
\ No newline at end of file
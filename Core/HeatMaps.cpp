@@ -1,44 +1,91 @@
 #include "Engine/Core/HeatMaps.hpp"
 #include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Core/VertexWriter.hpp"
 #include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Math/SimdMath.hpp"
+#include <algorithm>
+#include <cfloat>
 
-TileHeatMap::TileHeatMap(IntVec2 const& dimensions)
-	: m_dimensions(dimensions)
+//----------------------------------------------------------------------------------------------
+HeatMapColorLUT::HeatMapColorLUT(FloatRange const& valueRange, Rgba8 const& lowColor, Rgba8 const& highColor, float specialValue, Rgba8 const& specialColor)
+	: m_valueRange(valueRange)
+	, m_specialValue(specialValue)
+	, m_specialColor(specialColor)
 {
-	m_values.resize(m_dimensions.x * m_dimensions.y);
-	for (int i = 0; i < m_values.size(); ++i)
+	// A flat range colors everything low, as RangeMapClamped does
+	float rangeLength = valueRange.m_max - valueRange.m_min;
+	m_entriesPerUnit = rangeLength != 0.f ? (float)(HEAT_MAP_COLOR_LUT_SIZE - 1) / rangeLength : 0.f;
+	for (int entry = 0; entry < HEAT_MAP_COLOR_LUT_SIZE; ++entry)
 	{
-		m_values[i] = 0.f;
+		m_colors[entry] = m_colors[entry].RgbaInterpolate(lowColor, highColor, (float)entry / (float)(HEAT_MAP_COLOR_LUT_SIZE - 1));
 	}
 }
 
-void TileHeatMap::SetAllValues(float newValue)
+void HeatMapColorLUT::GetColorsForValues(float const* values, int numValues, Rgba8* out_colors) const
 {
-	for (int i = 0; i < m_values.size(); ++i)
+	for (int valueIndex = 0; valueIndex < numValues; ++valueIndex)
+	{
+		out_colors[valueIndex] = GetColorForValue(values[valueIndex]);
+	}
+}
+
+bool HeatMapColorLUT::operator==(HeatMapColorLUT const& compare) const
+{
+	if (m_valueRange.m_min != compare.m_valueRange.m_min || m_valueRange.m_max != compare.m_valueRange.m_max || m_specialValue != compare.m_specialValue || !m_specialColor.Equals(compare.m_specialColor))
+	{
+		return false;
+	}
+	for (int entry = 0; entry < HEAT_MAP_COLOR_LUT_SIZE; ++entry)
 	{
-		m_values[i] = newValue;
+		if (!m_colors[entry].Equals(compare.m_colors[entry]))
+		{
+			return false;
+		}
 	}
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------
+TileHeatMap::TileHeatMap(IntVec2 const& dimensions)
+	: m_dimensions(dimensions)
+{
+	m_values.resize(m_dimensions.x * m_dimensions.y, 0.f);
+}
+
+void TileHeatMap::SetAllValues(float newValue)
+{
+	GetPlane().Fill(newValue);
 }
 
 float TileHeatMap::GetValue(IntVec2 const& tileCoords) const
 {
+	ASSERT_RECOVERABLE(IsInBounds(tileCoords), "TileHeatMap::GetValue coords are off the map");
 	int index = Clamp(GetIndexFromCoordinates(tileCoords), 0, m_dimensions.x * m_dimensions.y -1);
 	return m_values[index];
 }
 
 void TileHeatMap::SetValue(IntVec2 const& tileCoords, float newValue)
 {
+	ASSERT_RECOVERABLE(IsInBounds(tileCoords), "TileHeatMap::SetValue coords are off the map");
 	int index = Clamp(GetIndexFromCoordinates(tileCoords), 0, m_dimensions.x * m_dimensions.y - 1);
 	m_values[index] = newValue;
 }
 
 void TileHeatMap::AddValue(IntVec2 const& tileCoords, float valueToAdd)
 {
+	ASSERT_RECOVERABLE(IsInBounds(tileCoords), "TileHeatMap::AddValue coords are off the map");
 	int index = Clamp(GetIndexFromCoordinates(tileCoords), 0, m_dimensions.x * m_dimensions.y - 1);
 	m_values[index] += valueToAdd;
 }
 
 void TileHeatMap::AddVertsForDebugDraw(std::vector<Vertex_PCU>& verts, AABB2 bounds, FloatRange valueRange, Rgba8 lowColor, Rgba8 highColor, float specialValue, Rgba8 specialColor)
+{
+	VertexWriter writer(verts, GetNumVertsForDebugDraw());
+	AddVertsForDebugDraw(writer, bounds, valueRange, lowColor, highColor, specialValue, specialColor);
+}
+
+void TileHeatMap::AddVertsForDebugDraw(VertexWriter& writer, AABB2 const& bounds, FloatRange const& valueRange, Rgba8 const& lowColor, Rgba8 const& highColor, float specialValue, Rgba8 const& specialColor) const
 {
 	float tileWidth = (bounds.m_maxs.x - bounds.m_mins.x) / (float)m_dimensions.x;
 	float tileHeight = (bounds.m_maxs.y - bounds.m_mins.y) / (float)m_dimensions.y;
@@ -49,7 +96,7 @@ void TileHeatMap::AddVertsForDebugDraw(std::vector<Vertex_PCU>& verts, AABB2 bou
 			Vec2 maxs =  mins + Vec2(tileWidth, tileHeight);
 			AABB2 tileAABB(mins, maxs);
 
-			float tileValue = GetValue(IntVec2(x, y));
+			float tileValue = m_values[x + y * m_dimensions.x];
 			Rgba8 tileColor;
 
 			if (tileValue == specialValue) {
@@ -59,17 +106,365 @@ void TileHeatMap::AddVertsForDebugDraw(std::vector<Vertex_PCU>& verts, AABB2 bou
 				float normalizedValue = RangeMapClamped(tileValue, valueRange.m_min, valueRange.m_max, 0.0f, 1.0f);
 				tileColor = tileColor.RgbaInterpolate(lowColor, highColor, normalizedValue);
 			} 
-			AddVertsForAABB2D(verts, tileAABB, tileColor);
+			AddVertsForAABB2D(writer, tileAABB, tileColor);
 		}
 	}
 }
 
-IntVec2 TileHeatMap::GetDimensions()
+void TileHeatMap::AddVertsForDebugDraw(VertexWriter& writer, AABB2 const& bounds, HeatMapColorLUT const& colors) const
+{
+	float tileWidth = (bounds.m_maxs.x - bounds.m_mins.x) / (float)m_dimensions.x;
+	float tileHeight = (bounds.m_maxs.y - bounds.m_mins.y) / (float)m_dimensions.y;
+	Vertex_PCU* out = writer.Allocate(GetNumVertsForDebugDraw());
+	for (int y = 0; y < m_dimensions.y; ++y)
+	{
+		float minY = tileHeight * (float)y + bounds.m_mins.y;
+		float maxY = minY + tileHeight;
+		float const* rowValues = GetRow(y);
+		for (int x = 0; x < m_dimensions.x; ++x)
+		{
+			float minX = tileWidth * (float)x + bounds.m_mins.x;
+			float maxX = minX + tileWidth;
+			Rgba8 tileColor = colors.GetColorForValue(rowValues[x]);
+
+			// Same corners, winding and uvs as AddVertsForAABB2D
+			out[0] = Vertex_PCU(Vec3(minX, minY, 0.f), tileColor, Vec2(0.f, 0.f));
+			out[1] = Vertex_PCU(Vec3(maxX, minY, 0.f), tileColor, Vec2(1.f, 0.f));
+			out[2] = Vertex_PCU(Vec3(maxX, maxY, 0.f), tileColor, Vec2(1.f, 1.f));
+			out[3] = out[0];
+			out[4] = out[2];
+			out[5] = Vertex_PCU(Vec3(minX, maxY, 0.f), tileColor, Vec2(0.f, 1.f));
+			out += 6;
+		}
+	}
+}
+
+int TileHeatMap::GetNumVertsForDebugDraw() const
+{
+	return m_dimensions.x * m_dimensions.y * GetNumVertsForAABB2D();
+}
+
+IntVec2 TileHeatMap::GetDimensions() const
 {
 	return m_dimensions;
 }
 
+bool TileHeatMap::IsInBounds(IntVec2 const& tileCoords) const
+{
+	return tileCoords.x >= 0 && tileCoords.y >= 0 && tileCoords.x < m_dimensions.x && tileCoords.y < m_dimensions.y;
+}
+
 int TileHeatMap::GetIndexFromCoordinates(IntVec2 const& tileCoords) const
 {
 	return tileCoords.x + m_dimensions.x * tileCoords.y;
 }
+
+
+//----------------------------------------------------------------------------------------------
+namespace
+{
+	// Runs simdOp over SIMD_WIDTH-wide chunks of [0, count) and scalarOp over the tail
+	template <typename SimdOp, typename ScalarOp>
+	void ForEachChunk(int count, SimdOp const& simdOp, ScalarOp const& scalarOp)
+	{
+		int index = 0;
+		for (; index + SIMD_WIDTH <= count; index += SIMD_WIDTH)
+		{
+			simdOp(index);
+		}
+		for (; index < count; ++index)
+		{
+			scalarOp(index);
+		}
+	}
+
+	// Horizontal pass of a box filter: each tile of the row becomes the sum (or max) of the 2r+1 tiles around it.
+	// paddedRow holds the original row with radius pad values each side, so every lane reads the same way.
+	template <bool IS_MAX>
+	void FilterRowHorizontally(float* row, int width, int radius, float* paddedRow, float padValue, float const* inverseCounts)
+	{
+		std::fill(paddedRow, paddedRow + radius, padValue);
+		std::copy(row, row + width, paddedRow + radius);
+		std::fill(paddedRow + radius + width, paddedRow + width + 2 * radius, padValue);
+
+		ForEachChunk(width,
+			[&](int x)
+			{
+				SimdFloat result = SimdLoad(paddedRow + x);
+				for (int offset = 1; offset <= 2 * radius; ++offset)
+				{
+					result = IS_MAX ? SimdMax(result, SimdLoad(paddedRow + x + offset)) : SimdAdd(result, SimdLoad(paddedRow + x + offset));
+				}
+				SimdStore(row + x, IS_MAX ? result : SimdMul(result, SimdLoad(inverseCounts + x)));
+			},
+			[&](int x)
+			{
+				// Max as compare-and-pick in SimdMax's operand order, so a NaN tile dilates the same in the tail
+				float result = paddedRow[x];
+				for (int offset = 1; offset <= 2 * radius; ++offset)
+				{
+					float next = paddedRow[x + offset];
+					result = IS_MAX ? (result > next ? result : next) : result + next;
+				}
+				row[x] = IS_MAX ? result : result * inverseCounts[x];
+			});
+	}
+
+	// Separable (2r+1)^2 box sum or max. The vertical pass keeps the original rows it still needs in a ring of
+	// radius + 1 rows, so the filter runs in place with O(width * radius) scratch.
+	template <bool IS_MAX>
+	void FilterPlane(float* values, IntVec2 const& dims, int radius)
+	{
+		if (radius <= 0 || dims.x <= 0 || dims.y <= 0)
+		{
+			return;
+		}
+		float padValue = IS_MAX ? -FLT_MAX : 0.f;
+		std::vector<float> inverseCounts(dims.x);
+		for (int x = 0; x < dims.x; ++x)
+		{
+			inverseCounts[x] = 1.f / (float)(std::min(x + radius, dims.x - 1) - std::max(x - radius, 0) + 1);
+		}
+
+		std::vector<float> paddedRow(dims.x + 2 * radius);
+		for (int y = 0; y < dims.y; ++y)
+		{
+			FilterRowHorizontally<IS_MAX>(values + y * dims.x, dims.x, radius, paddedRow.data(), padValue, inverseCounts.data());
+		}
+
+		int ringSize = radius + 1;
+		std::vector<float> ringRows(ringSize * dims.x);
+		for (int y = 0; y < dims.y; ++y)
+		{
+			float* row = values + y * dims.x;
+			std::copy(row, row + dims.x, ringRows.data() + (y % ringSize) * dims.x);
+
+			int firstY = std::max(y - radius, 0);
+			int lastY = std::min(y + radius, dims.y - 1);
+			float inverseCount = 1.f / (float)(lastY - firstY + 1);
+			auto getOriginalRow = [&](int sourceY) -> float const*
+			{
+				return sourceY <= y ? ringRows.data() + (sourceY % ringSize) * dims.x : values + sourceY * dims.x;
+			};
+
+			ForEachChunk(dims.x,
+				[&](int x)
+				{
+					SimdFloat result = SimdLoad(getOriginalRow(firstY) + x);
+					for (int sourceY = firstY + 1; sourceY <= lastY; ++sourceY)
+					{
+						result = IS_MAX ? SimdMax(result, SimdLoad(getOriginalRow(sourceY) + x)) : SimdAdd(result, SimdLoad(getOriginalRow(sourceY) + x));
+					}
+					SimdStore(row + x, IS_MAX ? result : SimdMul(result, SimdSplat(inverseCount)));
+				},
+				[&](int x)
+				{
+					float result = getOriginalRow(firstY)[x];
+					for (int sourceY = firstY + 1; sourceY <= lastY; ++sourceY)
+					{
+						float next = getOriginalRow(sourceY)[x];
+						result = IS_MAX ? (result > next ? result : next) : result + next;
+					}
+					row[x] = IS_MAX ? result : result * inverseCount;
+				});
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+void HeatMapPlane::Fill(float value)
+{
+	SimdFloat simdValue = SimdSplat(value);
+	ForEachChunk(GetNumTiles(),
+		[&](int index) { SimdStore(m_values + index, simdValue); },
+		[&](int index) { m_values[index] = value; });
+}
+
+void HeatMapPlane::AddToAll(float valueToAdd)
+{
+	SimdFloat simdValue = SimdSplat(valueToAdd);
+	ForEachChunk(GetNumTiles(),
+		[&](int index) { SimdStore(m_values + index, SimdAdd(SimdLoad(m_values + index), simdValue)); },
+		[&](int index) { m_values[index] += valueToAdd; });
+}
+
+void HeatMapPlane::MultiplyAll(float scale)
+{
+	SimdFloat simdScale = SimdSplat(scale);
+	ForEachChunk(GetNumTiles(),
+		[&](int index) { SimdStore(m_values + index, SimdMul(SimdLoad(m_values + index), simdScale)); },
+		[&](int index) { m_values[index] *= scale; });
+}
+
+void HeatMapPlane::ClampAll(float minValue, float maxValue)
+{
+	SimdFloat simdMin = SimdSplat(minValue);
+	SimdFloat simdMax = SimdSplat(maxValue);
+	ForEachChunk(GetNumTiles(),
+		[&](int index) { SimdStore(m_values + index, SimdMin(SimdMax(SimdLoad(m_values + index), simdMin), simdMax)); },
+		[&](int index)
+		{
+			// Operand order as in SimdMax/SimdMin, which return the second operand when either is NaN
+			float raised = m_values[index] > minValue ? m_values[index] : minValue;
+			m_values[index] = raised < maxValue ? raised : maxValue;
+		});
+}
+
+void HeatMapPlane::AddScaled(HeatMapPlane const& other, float scale)
+{
+	GUARANTEE_OR_DIE(other.m_dimensions == m_dimensions, "HeatMapPlane::AddScaled needs planes of the same dimensions");
+	float const* otherValues = other.m_values;
+	SimdFloat simdScale = SimdSplat(scale);
+	ForEachChunk(GetNumTiles(),
+		[&](int index) { SimdStore(m_values + index, SimdAdd(SimdLoad(m_values + index), SimdMul(SimdLoad(otherValues + index), simdScale))); },
+		[&](int index) { m_values[index] += otherValues[index] * scale; });
+}
+
+void HeatMapPlane::MinWith(HeatMapPlane const& other)
+{
+	GUARANTEE_OR_DIE(other.m_dimensions == m_dimensions, "HeatMapPlane::MinWith needs planes of the same dimensions");
+	float const* otherValues = other.m_values;
+	ForEachChunk(GetNumTiles(),
+		[&](int index) { SimdStore(m_values + index, SimdMin(SimdLoad(m_values + index), SimdLoad(otherValues + index))); },
+		[&](int index) { m_values[index] = m_values[index] < otherValues[index] ? m_values[index] : otherValues[index]; });
+}
+
+void HeatMapPlane::MaxWith(HeatMapPlane const& other)
+{
+	GUARANTEE_OR_DIE(other.m_dimensions == m_dimensions, "HeatMapPlane::MaxWith needs planes of the same dimensions");
+	float const* otherValues = other.m_values;
+	ForEachChunk(GetNumTiles(),
+		[&](int index) { SimdStore(m_values + index, SimdMax(SimdLoad(m_values + index), SimdLoad(otherValues + index))); },
+		[&](int index) { m_values[index] = m_values[index] > otherValues[index] ? m_values[index] : otherValues[index]; });
+}
+
+void HeatMapPlane::Threshold(float threshold, float belowValue, float atOrAboveValue)
+{
+	SimdFloat simdThreshold = SimdSplat(threshold);
+	SimdFloat simdBelow = SimdSplat(belowValue);
+	SimdFloat simdAtOrAbove = SimdSplat(atOrAboveValue);
+	ForEachChunk(GetNumTiles(),
+		[&](int index)
+		{
+			SimdFloat values = SimdLoad(m_values + index);
+			// Everything not below, NaN included, takes atOrAboveValue, as in the scalar tail
+			SimdFloat isBelow = SimdLess(values, simdThreshold);
+			SimdStore(m_values + index, SimdSelect(isBelow, simdBelow, simdAtOrAbove));
+		},
+		[&](int index) { m_values[index] = m_values[index] < threshold ? belowValue : atOrAboveValue; });
+}
+
+FloatRange HeatMapPlane::GetValueRange() const
+{
+	int numTiles = GetNumTiles();
+	if (numTiles <= 0)
+	{
+		return FloatRange(0.f, 0.f);
+	}
+
+	SimdFloat simdMin = SimdSplat(m_values[0]);
+	SimdFloat simdMax = simdMin;
+	float minValue = m_values[0];
+	float maxValue = m_values[0];
+	ForEachChunk(numTiles,
+		[&](int index)
+		{
+			SimdFloat values = SimdLoad(m_values + index);
+			simdMin = SimdMin(values, simdMin);		// NaN tiles are skipped, as std::min/max skip them below
+			simdMax = SimdMax(values, simdMax);
+		},
+		[&](int index)
+		{
+			minValue = std::min(minValue, m_values[index]);
+			maxValue = std::max(maxValue, m_values[index]);
+		});
+
+	float laneMins[SIMD_WIDTH];
+	float laneMaxs[SIMD_WIDTH];
+	SimdStore(laneMins, simdMin);
+	SimdStore(laneMaxs, simdMax);
+	for (int lane = 0; lane < SIMD_WIDTH; ++lane)
+	{
+		minValue = std::min(minValue, laneMins[lane]);
+		maxValue = std::max(maxValue, laneMaxs[lane]);
+	}
+	return FloatRange(minValue, maxValue);
+}
+
+void HeatMapPlane::Normalize(FloatRange const& newRange)
+{
+	FloatRange currentRange = GetValueRange();
+	float currentSize = currentRange.m_max - currentRange.m_min;
+	if (currentSize <= 0.f)
+	{
+		Fill(newRange.m_min);
+		return;
+	}
+	float scale = (newRange.m_max - newRange.m_min) / currentSize;
+	float offset = newRange.m_min - currentRange.m_min * scale;
+	SimdFloat simdScale = SimdSplat(scale);
+	SimdFloat simdOffset = SimdSplat(offset);
+	ForEachChunk(GetNumTiles(),
+		[&](int index) { SimdStore(m_values + index, SimdAdd(SimdMul(SimdLoad(m_values + index), simdScale), simdOffset)); },
+		[&](int index) { m_values[index] = m_values[index] * scale + offset; });
+}
+
+void HeatMapPlane::BoxBlur(int radius)
+{
+	FilterPlane<false>(m_values, m_dimensions, radius);
+}
+
+void HeatMapPlane::Dilate(int radius)
+{
+	FilterPlane<true>(m_values, m_dimensions, radius);
+}
+
+//----------------------------------------------------------------------------------------------
+TileHeatMapLayers::TileHeatMapLayers(IntVec2 const& dimensions, int numLayers)
+	: m_dimensions(dimensions)
+	, m_numLayers(numLayers)
+{
+	m_values.resize(m_dimensions.x * m_dimensions.y * m_numLayers, 0.f);
+}
+
+HeatMapPlane TileHeatMapLayers::GetLayer(int layerIndex)
+{
+	ASSERT_OR_DIE(layerIndex >= 0 && layerIndex < m_numLayers, "TileHeatMapLayers::GetLayer index out of range");
+	return HeatMapPlane(m_values.data() + layerIndex * GetNumTilesPerLayer(), m_dimensions);
+}
+
+float TileHeatMapLayers::GetValueUnchecked(int layerIndex, IntVec2 const& tileCoords) const
+{
+	return m_values[layerIndex * GetNumTilesPerLayer() + tileCoords.x + tileCoords.y * m_dimensions.x];
+}
+
+void TileHeatMapLayers::SetValueUnchecked(int layerIndex, IntVec2 const& tileCoords, float newValue)
+{
+	m_values[layerIndex * GetNumTilesPerLayer() + tileCoords.x + tileCoords.y * m_dimensions.x] = newValue;
+}
+
+void TileHeatMapLayers::BlendLayers(HeatMapPlane out_blend, float const* layerWeights) const
+{
+	GUARANTEE_OR_DIE(out_blend.GetDimensions() == m_dimensions, "TileHeatMapLayers::BlendLayers needs an output of the layer dimensions");
+	float* blendValues = out_blend.begin();
+	float const* layerValues = m_values.data();
+	if (m_numLayers <= 0)
+	{
+		out_blend.Fill(0.f);
+		return;
+	}
+
+	SimdFloat firstWeight = SimdSplat(layerWeights[0]);
+	ForEachChunk(GetNumTilesPerLayer(),
+		[&](int index) { SimdStore(blendValues + index, SimdMul(SimdLoad(layerValues + index), firstWeight)); },
+		[&](int index) { blendValues[index] = layerValues[index] * layerWeights[0]; });
+	for (int layerIndex = 1; layerIndex < m_numLayers; ++layerIndex)
+	{
+		layerValues += GetNumTilesPerLayer();
+		float weight = layerWeights[layerIndex];
+		SimdFloat simdWeight = SimdSplat(weight);
+		ForEachChunk(GetNumTilesPerLayer(),
+			[&](int index) { SimdStore(blendValues + index, SimdAdd(SimdLoad(blendValues + index), SimdMul(SimdLoad(layerValues + index), simdWeight))); },
+			[&](int index) { blendValues[index] += layerValues[index] * weight; });
+	}
+}
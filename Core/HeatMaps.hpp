@@ -2,8 +2,90 @@
 #include "Engine/Math/IntVec2.hpp"
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Math/FloatRange.hpp"
+#include "Engine/Core/Rgba8.hpp"
 #include <vector>
 
+class VertexWriter;
+
+//----------------------------------------------------------------------------------------------
+// Precomputed low..high color ramp for heat map drawing: coloring a tile is a scale, a clamp and a table lookup
+// instead of RangeMapClamped plus RgbaInterpolate. With HEAT_MAP_COLOR_LUT_SIZE entries the colors stay within one
+// step per channel of the exact interpolation. Tiles equal to the special value get the special color.
+//
+constexpr int HEAT_MAP_COLOR_LUT_SIZE = 256;
+
+class HeatMapColorLUT
+{
+public:
+	HeatMapColorLUT() = default;
+	HeatMapColorLUT(FloatRange const& valueRange, Rgba8 const& lowColor, Rgba8 const& highColor, float specialValue, Rgba8 const& specialColor);
+
+	Rgba8	GetColorForValue(float value) const;
+	void	GetColorsForValues(float const* values, int numValues, Rgba8* out_colors) const;
+
+	bool	operator==(HeatMapColorLUT const& compare) const;
+	bool	operator!=(HeatMapColorLUT const& compare) const	{ return !(*this == compare); }
+
+private:
+	FloatRange	m_valueRange;
+	float		m_entriesPerUnit = 0.f;
+	float		m_specialValue = 0.f;
+	Rgba8		m_specialColor;
+	Rgba8		m_colors[HEAT_MAP_COLOR_LUT_SIZE];
+};
+
+inline Rgba8 HeatMapColorLUT::GetColorForValue(float value) const
+{
+	if (value == m_specialValue)
+	{
+		return m_specialColor;
+	}
+	// Compared so that NaN lands on the low color
+	float entry = (value - m_valueRange.m_min) * m_entriesPerUnit + 0.5f;
+	int index = entry > 0.f ? (entry < (float)(HEAT_MAP_COLOR_LUT_SIZE - 1) ? (int)entry : HEAT_MAP_COLOR_LUT_SIZE - 1) : 0;
+	return m_colors[index];
+}
+
+//----------------------------------------------------------------------------------------------
+// Non-owning view of one grid of floats, x fastest: a whole TileHeatMap or one layer of a TileHeatMapLayers. Copy it
+// freely; it stays valid as long as its storage does. Accessors do no bounds checks, and the bulk operations run
+// SIMD_WIDTH tiles per step. Blur and dilate work in place with a few rows of scratch, and tiles past the edges do
+// not count.
+//
+class HeatMapPlane
+{
+public:
+	HeatMapPlane(float* values, IntVec2 const& dimensions) : m_values(values), m_dimensions(dimensions) {}
+
+	IntVec2	GetDimensions() const							{ return m_dimensions; }
+	int		GetNumTiles() const								{ return m_dimensions.x * m_dimensions.y; }
+	float*	GetRow(int y) const								{ return m_values + y * m_dimensions.x; }
+	float*	begin() const									{ return m_values; }
+	float*	end() const										{ return m_values + GetNumTiles(); }
+	float	GetValueUnchecked(int x, int y) const			{ return m_values[x + y * m_dimensions.x]; }
+	void	SetValueUnchecked(int x, int y, float value)	{ m_values[x + y * m_dimensions.x] = value; }
+
+	void	Fill(float value);
+	void	AddToAll(float valueToAdd);
+	void	MultiplyAll(float scale);
+	void	ClampAll(float minValue, float maxValue);
+	void	AddScaled(HeatMapPlane const& other, float scale);		// this += other * scale; same dimensions
+	void	MinWith(HeatMapPlane const& other);
+	void	MaxWith(HeatMapPlane const& other);
+	void	Threshold(float threshold, float belowValue, float atOrAboveValue);
+
+	FloatRange	GetValueRange() const;
+	void		Normalize(FloatRange const& newRange = FloatRange(0.f, 1.f));	// current min..max onto newRange; flat maps get newRange.m_min
+
+	void	BoxBlur(int radius = 1);		// average of the (2 * radius + 1)^2 square around each tile
+	void	Dilate(int radius = 1);			// maximum of the same square
+
+private:
+	float*	m_values = nullptr;
+	IntVec2	m_dimensions;
+};
+
+//----------------------------------------------------------------------------------------------
 class TileHeatMap {
 public:
 	TileHeatMap(IntVec2 const& dimensions);
@@ -13,10 +95,52 @@ public:
 	void	SetValue(IntVec2 const& tileCoords, float newValue);
 	void	AddValue(IntVec2 const& tileCoords, float valueToAdd);
 	void	AddVertsForDebugDraw( std::vector<Vertex_PCU>& verts, AABB2 bounds, FloatRange valueRange, Rgba8 lowColor, Rgba8 highColor, float specialValue, Rgba8 specialColor );
-	IntVec2 GetDimensions();
+	void	AddVertsForDebugDraw( VertexWriter& writer, AABB2 const& bounds, FloatRange const& valueRange, Rgba8 const& lowColor, Rgba8 const& highColor, float specialValue, Rgba8 const& specialColor ) const;
+	// Same layout, colored through the table; TileHeatMapRenderer keeps the result between frames instead
+	void	AddVertsForDebugDraw( VertexWriter& writer, AABB2 const& bounds, HeatMapColorLUT const& colors ) const;
+	int		GetNumVertsForDebugDraw() const;
+	IntVec2 GetDimensions() const;
+	bool	IsInBounds(IntVec2 const& tileCoords) const;
+
+	// Unchecked fast paths; GetValue/SetValue/AddValue assert on coords off the map
+	float	GetValueUnchecked(IntVec2 const& tileCoords) const				{ return m_values[tileCoords.x + tileCoords.y * m_dimensions.x]; }
+	void	SetValueUnchecked(IntVec2 const& tileCoords, float newValue)	{ m_values[tileCoords.x + tileCoords.y * m_dimensions.x] = newValue; }
+	float*			GetRow(int y)				{ return m_values.data() + y * m_dimensions.x; }
+	float const*	GetRow(int y) const			{ return m_values.data() + y * m_dimensions.x; }
+	HeatMapPlane	GetPlane()					{ return HeatMapPlane(m_values.data(), m_dimensions); }
+
+	// Row-major (x fastest) storage for tools that walk every tile, like the pathfinding in TilePathfinding.hpp
+	float*			GetValues()				{ return m_values.data(); }
+	float const*	GetValues() const		{ return m_values.data(); }
+	int				GetNumTiles() const		{ return (int)m_values.size(); }
 
 private:
 	IntVec2 m_dimensions;
 	std::vector<float> m_values;
 	int GetIndexFromCoordinates(IntVec2 const& tileCoords) const;
+};
+
+//----------------------------------------------------------------------------------------------
+// Several same-sized heat maps (threat, resources, visibility, ...) stored as contiguous planes one after another,
+// so each layer is one SIMD-friendly run and a weighted blend of all of them is a single pass per layer.
+//
+class TileHeatMapLayers
+{
+public:
+	TileHeatMapLayers(IntVec2 const& dimensions, int numLayers);
+
+	IntVec2			GetDimensions() const		{ return m_dimensions; }
+	int				GetNumLayers() const		{ return m_numLayers; }
+	int				GetNumTilesPerLayer() const	{ return m_dimensions.x * m_dimensions.y; }
+	HeatMapPlane	GetLayer(int layerIndex);
+	float			GetValueUnchecked(int layerIndex, IntVec2 const& tileCoords) const;
+	void			SetValueUnchecked(int layerIndex, IntVec2 const& tileCoords, float newValue);
+
+	// out_blend = sum of layer * layerWeights[layer]; it must have these dimensions
+	void			BlendLayers(HeatMapPlane out_blend, float const* layerWeights) const;
+
+private:
+	IntVec2				m_dimensions;
+	int					m_numLayers = 0;
+	std::vector<float>	m_values;		// layer 0 tiles, then layer 1 tiles, ...
 };
\ No newline at end of file
@@ -0,0 +1,177 @@
+#include "Engine/Core/JobSystem.hpp"
+#include <algorithm>
+
+JobSystem::JobSystem(JobSystemConfig config)
+	: m_config(config)
+{
+}
+
+JobSystem::~JobSystem()
+{
+}
+
+void JobSystem::Startup()
+{
+	int numWorkers = m_config.m_numWorkerThreads;
+	if (numWorkers <= 0)
+	{
+		numWorkers = std::max(1, (int)std::thread::hardware_concurrency() - 1);
+	}
+	for (int workerIndex = 0; workerIndex < numWorkers; ++workerIndex)
+	{
+		m_workerThreads.push_back(new JobWorker(this, workerIndex));
+	}
+}
+
+void JobSystem::BeginFrame()
+{
+}
+
+void JobSystem::EndFrame()
+{
+}
+
+void JobSystem::ShutDown()
+{
+	m_isQuitting = true;
+	for (JobWorker* worker : m_workerThreads)
+	{
+		delete worker;
+	}
+	m_workerThreads.clear();
+
+	// Queued jobs belong to whoever queued them, so they are only forgotten here, never deleted
+	m_jobsToDoListMutex.lock();
+	m_jobsToDoList.clear();
+	m_jobsToDoListMutex.unlock();
+
+	m_completedJobsMutex.lock();
+	m_completedJobs.clear();
+	m_completedJobsMutex.unlock();
+}
+
+Job* JobSystem::RetrieveJobToExecute()
+{
+	Job* job = nullptr;
+	m_jobsToDoListMutex.lock();
+	if (!m_jobsToDoList.empty())
+	{
+		job = m_jobsToDoList.front();
+		m_jobsToDoList.pop_front();
+	}
+	m_jobsToDoListMutex.unlock();
+	return job;
+}
+
+Job* JobSystem::RetrieveCompletedJobs()
+{
+	Job* job = nullptr;
+	m_completedJobsMutex.lock();
+	if (!m_completedJobs.empty())
+	{
+		job = m_completedJobs.front();
+		m_completedJobs.pop_front();
+	}
+	m_completedJobsMutex.unlock();
+	return job;
+}
+
+void JobSystem::MoveToCompletedJobs(Job* job)
+{
+	m_completedJobsMutex.lock();
+	m_completedJobs.push_back(job);
+	m_completedJobsMutex.unlock();
+}
+
+void JobSystem::MoveToExecutingJobs(Job* job)
+{
+	m_retrievedJobsMutex.lock();
+	m_retrievedJobs.push_back(job);
+	m_retrievedJobsMutex.unlock();
+}
+
+void JobSystem::RemoveFromExecutingJobs(Job* job)
+{
+	m_retrievedJobsMutex.lock();
+	auto found = std::find(m_retrievedJobs.begin(), m_retrievedJobs.end(), job);
+	if (found != m_retrievedJobs.end())
+	{
+		m_retrievedJobs.erase(found);
+	}
+	m_retrievedJobsMutex.unlock();
+}
+
+void JobSystem::QueueJob(Job* jobToQueue)
+{
+	m_jobsToDoListMutex.lock();
+	m_jobsToDoList.push_back(jobToQueue);
+	m_jobsToDoListMutex.unlock();
+}
+
+void JobSystem::WaitUntilJobsCompleted(std::vector<Job*> const& jobsToWaitFor)
+{
+	std::vector<Job*> remainingJobs = jobsToWaitFor;
+	while (!remainingJobs.empty())
+	{
+		m_completedJobsMutex.lock();
+		for (int jobIndex = (int)remainingJobs.size() - 1; jobIndex >= 0; --jobIndex)
+		{
+			auto found = std::find(m_completedJobs.begin(), m_completedJobs.end(), remainingJobs[jobIndex]);
+			if (found != m_completedJobs.end())
+			{
+				m_completedJobs.erase(found);
+				remainingJobs.erase(remainingJobs.begin() + jobIndex);
+			}
+		}
+		m_completedJobsMutex.unlock();
+
+		if (remainingJobs.empty())
+		{
+			break;
+		}
+
+		Job* jobToExecute = RetrieveJobToExecute();
+		if (jobToExecute != nullptr)
+		{
+			MoveToExecutingJobs(jobToExecute);
+			jobToExecute->Execute();
+			RemoveFromExecutingJobs(jobToExecute);
+			MoveToCompletedJobs(jobToExecute);
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void JobSystem::RetrieveCompletedJobsFrom(std::vector<Job*>& inOutJobsInFlight, std::vector<Job*>& outCompletedJobs)
+{
+	if (inOutJobsInFlight.empty())
+	{
+		return;
+	}
+	m_completedJobsMutex.lock();
+	for (int jobIndex = (int)inOutJobsInFlight.size() - 1; jobIndex >= 0; --jobIndex)
+	{
+		auto found = std::find(m_completedJobs.begin(), m_completedJobs.end(), inOutJobsInFlight[jobIndex]);
+		if (found != m_completedJobs.end())
+		{
+			m_completedJobs.erase(found);
+			outCompletedJobs.push_back(inOutJobsInFlight[jobIndex]);
+			inOutJobsInFlight[jobIndex] = inOutJobsInFlight.back();
+			inOutJobsInFlight.pop_back();
+		}
+	}
+	m_completedJobsMutex.unlock();
+}
+
+JobSystemConfig JobSystem::GetConfig()
+{
+	return m_config;
+}
+
+bool JobSystem::IsQuitting() const
+{
+	return m_isQuitting;
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include <queue>
 #include <mutex>
+#include <atomic>
+#include <vector>
 #include "Engine/Core/JobWorker.hpp"
 
 
@@ -25,7 +27,15 @@ public:
 	void MoveToCompletedJobs(Job* job);
 	void MoveToExecutingJobs(Job* job);
 	void RemoveFromExecutingJobs(Job* job);
-	void QueueJob(Job* jobToQueue);
+	void QueueJob(Job* jobToQueue);		// the caller keeps ownership; ShutDown drops unfinished and unretrieved jobs without deleting them
+
+	// Blocks until every job in the list has completed and removes them from the completed list.
+	// The calling thread helps out by executing queued jobs while it waits.
+	void WaitUntilJobsCompleted(std::vector<Job*> const& jobsToWaitFor);
+
+	// Non-blocking: moves every job of inOutJobsInFlight that has completed into outCompletedJobs (appended) and
+	// removes it from both inOutJobsInFlight and the completed list; jobs still queued or executing stay in flight
+	void RetrieveCompletedJobsFrom(std::vector<Job*>& inOutJobsInFlight, std::vector<Job*>& outCompletedJobs);
 
 	JobSystemConfig GetConfig();
 	bool IsQuitting() const;
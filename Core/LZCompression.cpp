@@ -0,0 +1,164 @@
+#include "Engine/Core/LZCompression.hpp"
+#include <cstring>
+
+namespace
+{
+	constexpr int		LZ_MIN_MATCH = 4;
+	constexpr size_t	LZ_MAX_OFFSET = 0xFFFF;
+	constexpr size_t	LZ_LAST_LITERALS = 5;		// the final bytes are always literals, as in LZ4
+	constexpr size_t	LZ_MATCH_SEARCH_LIMIT = 12;	// no match starts in the last 12 bytes
+	constexpr int		LZ_HASH_BITS = 12;
+
+	uint32_t ReadUInt32(uint8_t const* bytes)
+	{
+		uint32_t value;
+		memcpy(&value, bytes, sizeof(value));
+		return value;
+	}
+
+	uint32_t HashSequence(uint32_t sequence)
+	{
+		return (sequence * 2654435761u) >> (32 - LZ_HASH_BITS);
+	}
+
+	void AppendLength(std::vector<uint8_t>& out, size_t length)
+	{
+		while (length >= 255)
+		{
+			out.push_back(255);
+			length -= 255;
+		}
+		out.push_back((uint8_t)length);
+	}
+
+	void AppendSequence(std::vector<uint8_t>& out, uint8_t const* literals, size_t numLiterals, size_t matchOffset, size_t matchLength)
+	{
+		size_t matchCode = matchLength > 0 ? matchLength - LZ_MIN_MATCH : 0;
+		uint8_t token = (uint8_t)(((numLiterals < 15 ? numLiterals : 15) << 4) | (matchCode < 15 ? matchCode : 15));
+		out.push_back(token);
+		if (numLiterals >= 15)
+		{
+			AppendLength(out, numLiterals - 15);
+		}
+		out.insert(out.end(), literals, literals + numLiterals);
+		if (matchLength == 0)
+		{
+			return;
+		}
+		out.push_back((uint8_t)(matchOffset & 0xFF));
+		out.push_back((uint8_t)(matchOffset >> 8));
+		if (matchCode >= 15)
+		{
+			AppendLength(out, matchCode - 15);
+		}
+	}
+
+	bool ReadLength(uint8_t const*& src, uint8_t const* srcEnd, size_t& inOutLength)
+	{
+		uint8_t extra = 255;
+		while (extra == 255)
+		{
+			if (src >= srcEnd)
+			{
+				return false;
+			}
+			extra = *src++;
+			inOutLength += extra;
+		}
+		return true;
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+size_t GetMaxLZCompressedSize(size_t srcSize)
+{
+	return srcSize + srcSize / 255 + 16;
+}
+
+void CompressLZ(uint8_t const* src, size_t srcSize, std::vector<uint8_t>& outCompressed)
+{
+	outCompressed.reserve(outCompressed.size() + GetMaxLZCompressedSize(srcSize));
+	size_t literalStart = 0;
+	if (srcSize > LZ_MATCH_SEARCH_LIMIT)
+	{
+		uint32_t hashTable[1 << LZ_HASH_BITS];
+		memset(hashTable, 0xFF, sizeof(hashTable));
+		size_t const matchSearchEnd = srcSize - LZ_MATCH_SEARCH_LIMIT;
+		size_t const matchEnd = srcSize - LZ_LAST_LITERALS;
+		size_t pos = 0;
+		while (pos < matchSearchEnd)
+		{
+			uint32_t sequence = ReadUInt32(src + pos);
+			uint32_t& slot = hashTable[HashSequence(sequence)];
+			size_t candidate = slot;
+			slot = (uint32_t)pos;
+			if (candidate == 0xFFFFFFFFu || pos - candidate > LZ_MAX_OFFSET || ReadUInt32(src + candidate) != sequence)
+			{
+				++pos;
+				continue;
+			}
+
+			size_t matchLength = LZ_MIN_MATCH;
+			while (pos + matchLength < matchEnd && src[candidate + matchLength] == src[pos + matchLength])
+			{
+				++matchLength;
+			}
+			AppendSequence(outCompressed, src + literalStart, pos - literalStart, pos - candidate, matchLength);
+			pos += matchLength;
+			literalStart = pos;
+		}
+	}
+	AppendSequence(outCompressed, src + literalStart, srcSize - literalStart, 0, 0);
+}
+
+bool DecompressLZ(uint8_t const* src, size_t srcSize, uint8_t* dst, size_t dstSize)
+{
+	uint8_t const* srcEnd = src + srcSize;
+	size_t dstPos = 0;
+	while (src < srcEnd)
+	{
+		uint8_t token = *src++;
+		size_t numLiterals = token >> 4;
+		if (numLiterals == 15 && !ReadLength(src, srcEnd, numLiterals))
+		{
+			return false;
+		}
+		if (numLiterals > (size_t)(srcEnd - src) || numLiterals > dstSize - dstPos)
+		{
+			return false;
+		}
+		memcpy(dst + dstPos, src, numLiterals);
+		src += numLiterals;
+		dstPos += numLiterals;
+		if (src == srcEnd)
+		{
+			break;
+		}
+
+		if (srcEnd - src < 2)
+		{
+			return false;
+		}
+		size_t offset = (size_t)src[0] | ((size_t)src[1] << 8);
+		src += 2;
+		size_t matchLength = token & 0x0F;
+		if (matchLength == 15 && !ReadLength(src, srcEnd, matchLength))
+		{
+			return false;
+		}
+		matchLength += LZ_MIN_MATCH;
+		if (offset == 0 || offset > dstPos || matchLength > dstSize - dstPos)
+		{
+			return false;
+		}
+		// Byte by byte: the match may overlap the bytes it is producing
+		uint8_t* out = dst + dstPos;
+		uint8_t const* match = out - offset;
+		for (size_t byteIndex = 0; byteIndex < matchLength; ++byteIndex)
+		{
+			out[byteIndex] = match[byteIndex];
+		}
+		dstPos += matchLength;
+	}
+	return dstPos == dstSize;
+}
\ No newline at end of file
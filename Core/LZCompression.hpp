@@ -0,0 +1,18 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------
+// Small LZ4-style block codec: a stream of sequences, each a token byte (literal count << 4 | match length - 4),
+// extra length bytes of 255 when a nibble saturates, the literals, then a 2-byte little-endian match offset.
+// The last sequence carries literals only. Single pass, 4-byte hash matching, no entropy stage: it trades ratio for
+// speed, which suits chunk data that is already run-length encoded. Thread-safe; no shared state.
+//
+size_t	GetMaxLZCompressedSize(size_t srcSize);
+
+// Appends the compressed form of src to outCompressed; src must not point into outCompressed
+void	CompressLZ(uint8_t const* src, size_t srcSize, std::vector<uint8_t>& outCompressed);
+
+// Decodes exactly dstSize bytes into dst; returns false on malformed or truncated input without writing past dst
+bool	DecompressLZ(uint8_t const* src, size_t srcSize, uint8_t* dst, size_t dstSize);
\ No newline at end of file
@@ -0,0 +1,542 @@
+#include "Engine/Core/RegionFile.hpp"
+#include "Engine/Core/VoxelChunk.hpp"
+#include "Engine/Core/LZCompression.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include <cstring>
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <share.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	constexpr uint8_t	REGION_FILE_MAGIC[4] = { 'R', 'G', 'N', 'F' };
+	constexpr uint16_t	REGION_FILE_VERSION = 1;
+	constexpr size_t	REGION_FILE_HEADER_SIZE = 16;
+	constexpr size_t	REGION_FILE_SLOT_SIZE = 12;
+
+	void WriteUInt16(uint8_t* bytes, uint32_t value)
+	{
+		bytes[0] = (uint8_t)(value & 0xFF);
+		bytes[1] = (uint8_t)((value >> 8) & 0xFF);
+	}
+
+	void WriteUInt32(uint8_t* bytes, uint32_t value)
+	{
+		WriteUInt16(bytes, value & 0xFFFF);
+		WriteUInt16(bytes + 2, value >> 16);
+	}
+
+	uint32_t ReadUInt16(uint8_t const* bytes)
+	{
+		return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8);
+	}
+
+	uint32_t ReadUInt32(uint8_t const* bytes)
+	{
+		return ReadUInt16(bytes) | (ReadUInt16(bytes + 2) << 16);
+	}
+
+	int FloorDivide(int numerator, int denominator)
+	{
+		int quotient = numerator / denominator;
+		return (numerator % denominator != 0 && (numerator < 0) != (denominator < 0)) ? quotient - 1 : quotient;
+	}
+
+	// The file stays shareable so the read-only mapping can coexist with appends
+	FILE* OpenSharedFile(std::string const& filePath, char const* mode)
+	{
+#if defined(_WIN32)
+		return _fsopen(filePath.c_str(), mode, _SH_DENYNO);
+#else
+		return fopen(filePath.c_str(), mode);
+#endif
+	}
+
+	// Slot offsets go up to 4 GB, past what fseek/ftell's long can hold on Windows
+	bool SeekFile(FILE* file, uint64_t offset, int origin)
+	{
+#if defined(_WIN32)
+		return _fseeki64(file, (__int64)offset, origin) == 0;
+#else
+		return fseeko(file, (off_t)offset, origin) == 0;
+#endif
+	}
+
+	uint64_t TellFile(FILE* file)
+	{
+#if defined(_WIN32)
+		return (uint64_t)_ftelli64(file);
+#else
+		return (uint64_t)ftello(file);
+#endif
+	}
+
+	// Atomically puts replacementPath in place of filePath; on failure filePath still holds the old file
+	bool MoveFileOver(std::string const& replacementPath, std::string const& filePath)
+	{
+#if defined(_WIN32)
+		return MoveFileExA(replacementPath.c_str(), filePath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+		return rename(replacementPath.c_str(), filePath.c_str()) == 0;
+#endif
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+// Read-only mapping of the whole file as it was when the view was created
+//
+class RegionFileView
+{
+public:
+	explicit RegionFileView(std::string const& filePath);
+	~RegionFileView();
+	RegionFileView(RegionFileView const& copy) = delete;
+	RegionFileView& operator=(RegionFileView const& copy) = delete;
+
+	uint8_t const*	GetData() const		{ return m_data; }
+	size_t			GetSize() const		{ return m_size; }
+
+private:
+	uint8_t const*	m_data = nullptr;
+	size_t			m_size = 0;
+#if defined(_WIN32)
+	HANDLE			m_fileHandle = INVALID_HANDLE_VALUE;
+	HANDLE			m_mappingHandle = nullptr;
+#endif
+};
+
+#if defined(_WIN32)
+RegionFileView::RegionFileView(std::string const& filePath)
+{
+	m_fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	LARGE_INTEGER fileSize = {};
+	if (m_fileHandle == INVALID_HANDLE_VALUE || !GetFileSizeEx(m_fileHandle, &fileSize) || fileSize.QuadPart == 0)
+	{
+		return;
+	}
+	m_mappingHandle = CreateFileMappingA(m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (m_mappingHandle == nullptr)
+	{
+		return;
+	}
+	m_data = (uint8_t const*)MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	m_size = m_data != nullptr ? (size_t)fileSize.QuadPart : 0;
+}
+
+RegionFileView::~RegionFileView()
+{
+	if (m_data != nullptr)
+	{
+		UnmapViewOfFile(m_data);
+	}
+	if (m_mappingHandle != nullptr)
+	{
+		CloseHandle(m_mappingHandle);
+	}
+	if (m_fileHandle != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(m_fileHandle);
+	}
+}
+#else
+RegionFileView::RegionFileView(std::string const& filePath)
+{
+	int fileDescriptor = open(filePath.c_str(), O_RDONLY);
+	if (fileDescriptor < 0)
+	{
+		return;
+	}
+	struct stat fileStats;
+	if (fstat(fileDescriptor, &fileStats) == 0 && fileStats.st_size > 0)
+	{
+		void* mapped = mmap(nullptr, (size_t)fileStats.st_size, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+		if (mapped != MAP_FAILED)
+		{
+			m_data = (uint8_t const*)mapped;
+			m_size = (size_t)fileStats.st_size;
+		}
+	}
+	close(fileDescriptor);
+}
+
+RegionFileView::~RegionFileView()
+{
+	if (m_data != nullptr)
+	{
+		munmap((void*)m_data, m_size);
+	}
+}
+#endif
+
+//----------------------------------------------------------------------------------------------
+void RegionFileLoadJob::Execute()
+{
+	m_didLoad = false;
+	if (m_view != nullptr && m_chunk != nullptr && (size_t)m_offset + m_compressedSize <= m_view->GetSize()
+		&& m_uncompressedSize <= VoxelChunk::GetMaxRLESize(m_chunk->GetDimensions()))
+	{
+		thread_local std::vector<uint8_t> s_rleBytes;
+		s_rleBytes.resize(m_uncompressedSize);
+		if (DecompressLZ(m_view->GetData() + m_offset, m_compressedSize, s_rleBytes.data(), m_uncompressedSize))
+		{
+			m_didLoad = m_chunk->DeserializeRLE(s_rleBytes.data(), s_rleBytes.size());
+		}
+	}
+	// Done with the mapping; let the main thread remap or compact
+	m_view.reset();
+}
+
+//----------------------------------------------------------------------------------------------
+RegionFile::RegionFile(std::string const& filePath, IntVec3 const& regionCoords, IntVec3 const& regionSizeInChunks, IntVec3 const& chunkDimensions)
+	: m_filePath(filePath)
+	, m_regionCoords(regionCoords)
+	, m_regionSizeInChunks(regionSizeInChunks)
+	, m_maxUncompressedSize(VoxelChunk::GetMaxRLESize(chunkDimensions))
+{
+	GUARANTEE_OR_DIE(regionSizeInChunks.x > 0 && regionSizeInChunks.y > 0 && regionSizeInChunks.z > 0
+		&& regionSizeInChunks.x <= 0xFFFF && regionSizeInChunks.y <= 0xFFFF && regionSizeInChunks.z <= 0xFFFF, "RegionFile region size out of range");
+	m_slots.resize((size_t)regionSizeInChunks.x * regionSizeInChunks.y * regionSizeInChunks.z);
+}
+
+RegionFile::~RegionFile()
+{
+	Close();
+}
+
+bool RegionFile::Open()
+{
+	if (IsOpen())
+	{
+		return true;
+	}
+
+	m_file = OpenSharedFile(m_filePath, "r+b");
+	if (m_file == nullptr)
+	{
+		m_file = OpenSharedFile(m_filePath, "w+b");
+		if (m_file == nullptr)
+		{
+			return false;
+		}
+		m_slots.assign(m_slots.size(), SlotEntry());
+		m_deadBytes = 0;
+		m_fileSize = GetDataStart();
+		if (!WriteHeaderAndTable(m_file, m_slots))
+		{
+			Close();
+			return false;
+		}
+		return true;
+	}
+
+	std::vector<uint8_t> headerAndTable(GetDataStart());
+	bool isValid = fread(headerAndTable.data(), 1, headerAndTable.size(), m_file) == headerAndTable.size()
+		&& memcmp(headerAndTable.data(), REGION_FILE_MAGIC, sizeof(REGION_FILE_MAGIC)) == 0
+		&& ReadUInt16(&headerAndTable[4]) == REGION_FILE_VERSION
+		&& (int)ReadUInt16(&headerAndTable[6]) == m_regionSizeInChunks.x
+		&& (int)ReadUInt16(&headerAndTable[8]) == m_regionSizeInChunks.y
+		&& (int)ReadUInt16(&headerAndTable[10]) == m_regionSizeInChunks.z;
+	isValid = isValid && SeekFile(m_file, 0, SEEK_END);
+	m_fileSize = (size_t)TellFile(m_file);
+
+	size_t liveBytes = 0;
+	for (size_t slotIndex = 0; isValid && slotIndex < m_slots.size(); ++slotIndex)
+	{
+		uint8_t const* slotBytes = &headerAndTable[REGION_FILE_HEADER_SIZE + slotIndex * REGION_FILE_SLOT_SIZE];
+		SlotEntry& slot = m_slots[slotIndex];
+		slot.m_offset = ReadUInt32(slotBytes);
+		slot.m_compressedSize = ReadUInt32(slotBytes + 4);
+		slot.m_uncompressedSize = ReadUInt32(slotBytes + 8);
+		isValid = slot.m_compressedSize == 0 || (slot.m_offset >= GetDataStart() && (size_t)slot.m_offset + slot.m_compressedSize <= m_fileSize
+			&& slot.m_uncompressedSize <= m_maxUncompressedSize);
+		liveBytes += slot.m_compressedSize;
+	}
+	if (!isValid)
+	{
+		Close();
+		return false;
+	}
+	m_deadBytes = m_fileSize - GetDataStart() - liveBytes;
+	return true;
+}
+
+void RegionFile::Close()
+{
+	m_view.reset();
+	if (m_file != nullptr)
+	{
+		fclose(m_file);
+		m_file = nullptr;
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+IntVec3 RegionFile::GetRegionCoordsForChunkCoords(IntVec3 const& chunkCoords, IntVec3 const& regionSizeInChunks)
+{
+	return IntVec3(FloorDivide(chunkCoords.x, regionSizeInChunks.x), FloorDivide(chunkCoords.y, regionSizeInChunks.y), FloorDivide(chunkCoords.z, regionSizeInChunks.z));
+}
+
+bool RegionFile::ContainsChunkCoords(IntVec3 const& chunkCoords) const
+{
+	return GetRegionCoordsForChunkCoords(chunkCoords, m_regionSizeInChunks) == m_regionCoords;
+}
+
+bool RegionFile::HasChunk(IntVec3 const& chunkCoords) const
+{
+	int slotIndex = GetSlotIndex(chunkCoords);
+	return slotIndex >= 0 && m_slots[slotIndex].m_compressedSize > 0;
+}
+
+//----------------------------------------------------------------------------------------------
+bool RegionFile::WriteChunk(VoxelChunk const& chunk)
+{
+	std::vector<VoxelChunk const*> chunks;
+	chunks.push_back(&chunk);
+	return WriteChunks(chunks);
+}
+
+bool RegionFile::WriteChunks(std::vector<VoxelChunk const*> const& chunks)
+{
+	if (!IsOpen())
+	{
+		return false;
+	}
+	bool didWriteAll = true;
+	std::vector<uint8_t> rleScratch;
+	std::vector<uint8_t> blobScratch;
+	for (VoxelChunk const* chunk : chunks)
+	{
+		didWriteAll = AppendChunkBlob(*chunk, rleScratch, blobScratch) && didWriteAll;
+	}
+	didWriteAll = WriteHeaderAndTable(m_file, m_slots) && didWriteAll;
+	return didWriteAll;
+}
+
+bool RegionFile::ReadChunk(VoxelChunk& outChunk)
+{
+	RegionFileLoadJob* job = CreateLoadJob(&outChunk);
+	if (job == nullptr)
+	{
+		return false;
+	}
+	job->Execute();
+	bool didLoad = job->m_didLoad;
+	delete job;
+	return didLoad;
+}
+
+RegionFileLoadJob* RegionFile::CreateLoadJob(VoxelChunk* outChunk)
+{
+	int slotIndex = outChunk != nullptr ? GetSlotIndex(outChunk->GetChunkCoords()) : -1;
+	if (slotIndex < 0 || m_slots[slotIndex].m_compressedSize == 0)
+	{
+		return nullptr;
+	}
+	std::shared_ptr<RegionFileView const> view = GetCurrentView();
+	if (view == nullptr)
+	{
+		return nullptr;
+	}
+
+	RegionFileLoadJob* job = new RegionFileLoadJob();
+	job->m_chunk = outChunk;
+	job->m_view = view;
+	job->m_offset = m_slots[slotIndex].m_offset;
+	job->m_compressedSize = m_slots[slotIndex].m_compressedSize;
+	job->m_uncompressedSize = m_slots[slotIndex].m_uncompressedSize;
+	return job;
+}
+
+//----------------------------------------------------------------------------------------------
+bool RegionFile::Compact()
+{
+	if (!IsOpen())
+	{
+		return false;
+	}
+	if (m_deadBytes == 0)
+	{
+		return true;
+	}
+	if (HasViewsInUse())
+	{
+		return false;
+	}
+	std::shared_ptr<RegionFileView const> view = GetCurrentView();
+	if (view == nullptr)
+	{
+		return false;
+	}
+
+	// Write the packed copy next to the original, then swap it in
+	std::string compactPath = m_filePath + ".compact";
+	FILE* compactFile = OpenSharedFile(compactPath, "wb");
+	if (compactFile == nullptr)
+	{
+		return false;
+	}
+	std::vector<SlotEntry> packedSlots = m_slots;
+	uint32_t nextOffset = (uint32_t)GetDataStart();
+	for (SlotEntry& slot : packedSlots)
+	{
+		if (slot.m_compressedSize > 0)
+		{
+			slot.m_offset = nextOffset;
+			nextOffset += slot.m_compressedSize;
+		}
+	}
+	bool didWrite = WriteHeaderAndTable(compactFile, packedSlots);
+	for (size_t slotIndex = 0; didWrite && slotIndex < m_slots.size(); ++slotIndex)
+	{
+		SlotEntry const& slot = m_slots[slotIndex];
+		if (slot.m_compressedSize > 0)
+		{
+			didWrite = SeekFile(compactFile, packedSlots[slotIndex].m_offset, SEEK_SET)
+				&& fwrite(view->GetData() + slot.m_offset, 1, slot.m_compressedSize, compactFile) == slot.m_compressedSize;
+		}
+	}
+	didWrite = fclose(compactFile) == 0 && didWrite;
+	if (!didWrite)
+	{
+		remove(compactPath.c_str());
+		return false;
+	}
+
+	// Replace in one step so a failure never leaves neither file; if it fails, carry on with the original
+	view.reset();
+	Close();
+	bool didReplace = MoveFileOver(compactPath, m_filePath);
+	if (!didReplace)
+	{
+		remove(compactPath.c_str());
+	}
+	return Open() && didReplace;
+}
+
+bool RegionFile::CompactIfWasteful(float maxDeadFraction)
+{
+	size_t dataBytes = m_fileSize > GetDataStart() ? m_fileSize - GetDataStart() : 0;
+	if (dataBytes == 0 || (float)m_deadBytes <= maxDeadFraction * (float)dataBytes)
+	{
+		return true;
+	}
+	return Compact();
+}
+
+//----------------------------------------------------------------------------------------------
+int RegionFile::GetSlotIndex(IntVec3 const& chunkCoords) const
+{
+	if (!ContainsChunkCoords(chunkCoords))
+	{
+		return -1;
+	}
+	IntVec3 local = chunkCoords - m_regionCoords * m_regionSizeInChunks;
+	return local.x + local.y * m_regionSizeInChunks.x + local.z * m_regionSizeInChunks.x * m_regionSizeInChunks.y;
+}
+
+size_t RegionFile::GetDataStart() const
+{
+	return REGION_FILE_HEADER_SIZE + m_slots.size() * REGION_FILE_SLOT_SIZE;
+}
+
+bool RegionFile::AppendChunkBlob(VoxelChunk const& chunk, std::vector<uint8_t>& rleScratch, std::vector<uint8_t>& blobScratch)
+{
+	int slotIndex = GetSlotIndex(chunk.GetChunkCoords());
+	if (slotIndex < 0)
+	{
+		return false;
+	}
+
+	rleScratch.clear();
+	chunk.SerializeRLE(rleScratch);
+	size_t rleSize = rleScratch.size();
+	blobScratch.clear();
+	CompressLZ(rleScratch.data(), rleSize, blobScratch);
+	uint8_t const* blob = blobScratch.data();
+	size_t blobSize = blobScratch.size();
+	if (m_fileSize + blobSize > 0xFFFFFFFFu)
+	{
+		return false;
+	}
+
+	if (!SeekFile(m_file, m_fileSize, SEEK_SET) || fwrite(blob, 1, blobSize, m_file) != blobSize)
+	{
+		return false;
+	}
+
+	SlotEntry& slot = m_slots[slotIndex];
+	m_deadBytes += slot.m_compressedSize;
+	slot.m_offset = (uint32_t)m_fileSize;
+	slot.m_compressedSize = (uint32_t)blobSize;
+	slot.m_uncompressedSize = (uint32_t)rleSize;
+	m_fileSize += blobSize;
+
+	// The file grew; jobs keep the old mapping, new loads get a fresh one
+	m_view.reset();
+	return true;
+}
+
+bool RegionFile::WriteHeaderAndTable(FILE* file, std::vector<SlotEntry> const& slots) const
+{
+	std::vector<uint8_t> bytes(REGION_FILE_HEADER_SIZE + slots.size() * REGION_FILE_SLOT_SIZE, 0);
+	memcpy(bytes.data(), REGION_FILE_MAGIC, sizeof(REGION_FILE_MAGIC));
+	WriteUInt16(&bytes[4], REGION_FILE_VERSION);
+	WriteUInt16(&bytes[6], (uint32_t)m_regionSizeInChunks.x);
+	WriteUInt16(&bytes[8], (uint32_t)m_regionSizeInChunks.y);
+	WriteUInt16(&bytes[10], (uint32_t)m_regionSizeInChunks.z);
+	for (size_t slotIndex = 0; slotIndex < slots.size(); ++slotIndex)
+	{
+		uint8_t* slotBytes = &bytes[REGION_FILE_HEADER_SIZE + slotIndex * REGION_FILE_SLOT_SIZE];
+		WriteUInt32(slotBytes, slots[slotIndex].m_offset);
+		WriteUInt32(slotBytes + 4, slots[slotIndex].m_compressedSize);
+		WriteUInt32(slotBytes + 8, slots[slotIndex].m_uncompressedSize);
+	}
+	bool didWrite = SeekFile(file, 0, SEEK_SET) && fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+	return fflush(file) == 0 && didWrite;
+}
+
+std::shared_ptr<RegionFileView const> RegionFile::GetCurrentView()
+{
+	if (m_view == nullptr)
+	{
+		std::shared_ptr<RegionFileView> view = std::make_shared<RegionFileView>(m_filePath);
+		if (view->GetData() == nullptr || view->GetSize() < m_fileSize)
+		{
+			return nullptr;
+		}
+		m_view = view;
+		for (size_t viewIndex = 0; viewIndex < m_issuedViews.size(); )
+		{
+			if (m_issuedViews[viewIndex].expired())
+			{
+				m_issuedViews[viewIndex] = m_issuedViews.back();
+				m_issuedViews.pop_back();
+				continue;
+			}
+			++viewIndex;
+		}
+		m_issuedViews.push_back(m_view);
+	}
+	return m_view;
+}
+
+// True while a load job still holds any mapping of the file (the current one or one from before a write)
+bool RegionFile::HasViewsInUse() const
+{
+	for (std::weak_ptr<RegionFileView const> const& issuedView : m_issuedViews)
+	{
+		long useCount = issuedView.use_count();
+		if (useCount > (issuedView.lock() == m_view && m_view != nullptr ? 1 : 0))
+		{
+			return true;
+		}
+	}
+	return false;
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#pragma once
+#include "Engine/Core/JobWorker.hpp"
+#include "Engine/Math/IntVec3.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+class VoxelChunk;
+class RegionFileView;
+
+//----------------------------------------------------------------------------------------------
+// One file holding every chunk of a region of m_regionSizeInChunks chunks (32x32x1 by default).
+//
+// Layout (little-endian): 16-byte header ('R','G','N','F', version, region size), an offset table with one
+// (offset, compressed size, uncompressed size) entry per chunk slot, then the chunk blobs. A blob is the chunk's
+// VoxelChunk::SerializeRLE bytes compressed with CompressLZ.
+//
+// Writes append the new blob and rewrite the table once per WriteChunks call, so saving many chunks costs a few
+// large writes instead of one file per chunk; the blob a chunk replaces becomes dead space until Compact.
+// Reads go through a read-only memory mapping of the file: load jobs decompress straight from the mapped bytes into
+// the destination VoxelChunk on a worker thread. Each job keeps the mapping it was created from alive, so writes and
+// remaps on the main thread never pull memory out from under a load in flight.
+//
+// RegionFile itself is main-thread only; only RegionFileLoadJob::Execute runs on workers.
+//
+class RegionFileLoadJob : public Job
+{
+	friend class RegionFile;
+
+public:
+	virtual void Execute() override;
+
+public:
+	VoxelChunk*		m_chunk = nullptr;		// destination, owned by the caller
+	bool			m_didLoad = false;		// false if the stored blob was corrupt or did not fit the chunk
+
+private:
+	std::shared_ptr<RegionFileView const>	m_view;
+	uint32_t								m_offset = 0;
+	uint32_t								m_compressedSize = 0;
+	uint32_t								m_uncompressedSize = 0;
+};
+
+class RegionFile
+{
+public:
+	RegionFile(std::string const& filePath, IntVec3 const& regionCoords, IntVec3 const& regionSizeInChunks = IntVec3(32, 32, 1),
+		IntVec3 const& chunkDimensions = IntVec3(16, 16, 128));
+	~RegionFile();
+	RegionFile(RegionFile const& copy) = delete;
+	RegionFile& operator=(RegionFile const& copy) = delete;
+
+	// Opens the file, creating an empty region if it does not exist; false if it exists but is not a matching region file
+	// or a slot's table entry is out of range (past the end of the file, or larger than a chunk's RLE stream can be)
+	bool				Open();
+	void				Close();
+	bool				IsOpen() const				{ return m_file != nullptr; }
+
+	static IntVec3		GetRegionCoordsForChunkCoords(IntVec3 const& chunkCoords, IntVec3 const& regionSizeInChunks);
+	bool				ContainsChunkCoords(IntVec3 const& chunkCoords) const;
+	bool				HasChunk(IntVec3 const& chunkCoords) const;
+
+	bool				WriteChunk(VoxelChunk const& chunk);
+	bool				WriteChunks(std::vector<VoxelChunk const*> const& chunks);
+
+	// Synchronous load into outChunk (whose chunk coords pick the slot)
+	bool				ReadChunk(VoxelChunk& outChunk);
+
+	// Async load: returns null if the chunk is not stored. Queue the job on a JobSystem, collect it when completed,
+	// check m_didLoad and delete it. outChunk must stay alive and untouched until then.
+	RegionFileLoadJob*	CreateLoadJob(VoxelChunk* outChunk);
+
+	size_t				GetFileSize() const			{ return m_fileSize; }
+	size_t				GetDeadBytes() const		{ return m_deadBytes; }
+
+	// Rewrites the file with only live blobs and swaps the copy in with one atomic replace. Fails (leaving the file as
+	// it was) while load jobs still hold the mapping or if the copy cannot be written or swapped in.
+	bool				Compact();
+	bool				CompactIfWasteful(float maxDeadFraction = 0.5f);
+
+private:
+	struct SlotEntry
+	{
+		uint32_t m_offset = 0;
+		uint32_t m_compressedSize = 0;
+		uint32_t m_uncompressedSize = 0;
+	};
+
+	int					GetSlotIndex(IntVec3 const& chunkCoords) const;
+	size_t				GetDataStart() const;
+	bool				AppendChunkBlob(VoxelChunk const& chunk, std::vector<uint8_t>& rleScratch, std::vector<uint8_t>& blobScratch);
+	bool				WriteHeaderAndTable(FILE* file, std::vector<SlotEntry> const& slots) const;
+	bool				HasViewsInUse() const;
+	std::shared_ptr<RegionFileView const> GetCurrentView();
+
+private:
+	std::string								m_filePath;
+	IntVec3									m_regionCoords;
+	IntVec3									m_regionSizeInChunks;
+	size_t									m_maxUncompressedSize = 0;	// largest RLE stream a chunk can produce
+	FILE*									m_file = nullptr;
+	size_t									m_fileSize = 0;
+	size_t									m_deadBytes = 0;
+	std::vector<SlotEntry>					m_slots;
+	std::shared_ptr<RegionFileView const>	m_view;			// null when the file has grown since it was mapped
+	std::vector<std::weak_ptr<RegionFileView const>> m_issuedViews;
+};
\ No newline at end of file
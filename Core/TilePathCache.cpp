@@ -0,0 +1,204 @@
+#include "Engine/Core/TilePathCache.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+#include <utility>
+
+//----------------------------------------------------------------------------------------------
+TilePathCache::TilePathCache(TileHeatMap const& costs, TilePathSettings const& settings, int maxCachedFields, int maxCachedPaths)
+	: m_costs(costs)
+	, m_settings(settings)
+	, m_maxCachedFields(std::max(1, maxCachedFields))
+	, m_maxCachedPaths(std::max(1, maxCachedPaths))
+{
+}
+
+int TilePathCache::GetTileIndex(IntVec2 const& tileCoords) const
+{
+	IntVec2 dims = m_costs.GetDimensions();
+	if (tileCoords.x < 0 || tileCoords.y < 0 || tileCoords.x >= dims.x || tileCoords.y >= dims.y)
+	{
+		return -1;
+	}
+	return tileCoords.x + tileCoords.y * dims.x;
+}
+
+//----------------------------------------------------------------------------------------------
+TilePathCache::CachedField& TilePathCache::GetOrGenerateField(IntVec2 const& goal)
+{
+	int goalIndex = GetTileIndex(goal);
+	GUARANTEE_OR_DIE(goalIndex >= 0, "TilePathCache field goal is off the map");
+
+	auto found = m_fields.find(goalIndex);
+	if (found == m_fields.end())
+	{
+		if ((int)m_fields.size() >= m_maxCachedFields)
+		{
+			auto leastRecent = m_fields.begin();
+			for (auto field = m_fields.begin(); field != m_fields.end(); ++field)
+			{
+				if (field->second.m_lastUsed < leastRecent->second.m_lastUsed)
+				{
+					leastRecent = field;
+				}
+			}
+			m_fields.erase(leastRecent);
+		}
+		found = m_fields.emplace(std::piecewise_construct, std::forward_as_tuple(goalIndex), std::forward_as_tuple(m_costs.GetDimensions())).first;
+		GenerateDistanceField(found->second.m_distances, m_costs, std::vector<IntVec2>{ goal }, m_settings);
+	}
+	found->second.m_lastUsed = ++m_useCounter;
+	return found->second;
+}
+
+TileHeatMap const& TilePathCache::GetDistanceField(IntVec2 const& goal)
+{
+	return GetOrGenerateField(goal).m_distances;
+}
+
+TileFlowField const& TilePathCache::GetFlowField(IntVec2 const& goal)
+{
+	CachedField& field = GetOrGenerateField(goal);
+	if (!field.m_hasFlowField)
+	{
+		field.m_flowField.Generate(field.m_distances, m_costs, m_settings);
+		field.m_hasFlowField = true;
+	}
+	return field.m_flowField;
+}
+
+//----------------------------------------------------------------------------------------------
+bool TilePathCache::FindPath(IntVec2 const& start, IntVec2 const& goal, std::vector<IntVec2>& out_path)
+{
+	int startIndex = GetTileIndex(start);
+	int goalIndex = GetTileIndex(goal);
+	if (startIndex < 0 || goalIndex < 0)
+	{
+		out_path.clear();
+		return false;
+	}
+
+	long long key = (long long)startIndex * (long long)m_costs.GetNumTiles() + (long long)goalIndex;
+	auto found = m_paths.find(key);
+	if (found == m_paths.end())
+	{
+		if ((int)m_paths.size() >= m_maxCachedPaths)
+		{
+			auto leastRecent = m_paths.begin();
+			for (auto path = m_paths.begin(); path != m_paths.end(); ++path)
+			{
+				if (path->second.m_lastUsed < leastRecent->second.m_lastUsed)
+				{
+					leastRecent = path;
+				}
+			}
+			m_paths.erase(leastRecent);
+		}
+		CachedPath& path = m_paths[key];
+		path.m_isReachable = m_pathfinder.FindPath(m_costs, start, goal, path.m_tiles, m_settings);
+		path.m_sortedTileIndexes.reserve(path.m_tiles.size());
+		for (IntVec2 const& tileCoords : path.m_tiles)
+		{
+			path.m_sortedTileIndexes.push_back(GetTileIndex(tileCoords));
+		}
+		std::sort(path.m_sortedTileIndexes.begin(), path.m_sortedTileIndexes.end());
+		found = m_paths.find(key);
+	}
+	found->second.m_lastUsed = ++m_useCounter;
+	out_path = found->second.m_tiles;
+	return found->second.m_isReachable;
+}
+
+//----------------------------------------------------------------------------------------------
+bool TilePathCache::IsFieldAffectedByTile(CachedField const& field, IntVec2 const& tileCoords) const
+{
+	// Tiles neither reached nor next to a reached tile cannot change any distance, whatever their new cost
+	IntVec2 dims = m_costs.GetDimensions();
+	float const* distances = field.m_distances.GetValues();
+	for (int y = std::max(0, tileCoords.y - 1); y <= std::min(dims.y - 1, tileCoords.y + 1); ++y)
+	{
+		for (int x = std::max(0, tileCoords.x - 1); x <= std::min(dims.x - 1, tileCoords.x + 1); ++x)
+		{
+			if (distances[x + y * dims.x] < TILE_DISTANCE_UNREACHED)
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void TilePathCache::NotifyTilesChanged(std::vector<IntVec2> const& changedTiles)
+{
+	std::vector<int> changedIndexes;
+	changedIndexes.reserve(changedTiles.size());
+	for (IntVec2 const& tileCoords : changedTiles)
+	{
+		int tileIndex = GetTileIndex(tileCoords);
+		if (tileIndex >= 0)
+		{
+			changedIndexes.push_back(tileIndex);
+		}
+	}
+	if (changedIndexes.empty())
+	{
+		return;
+	}
+	std::sort(changedIndexes.begin(), changedIndexes.end());
+
+	IntVec2 dims = m_costs.GetDimensions();
+	for (auto& keyAndField : m_fields)
+	{
+		CachedField& field = keyAndField.second;
+		bool isAffected = false;
+		for (size_t changed = 0; changed < changedTiles.size() && !isAffected; ++changed)
+		{
+			isAffected = GetTileIndex(changedTiles[changed]) >= 0 && IsFieldAffectedByTile(field, changedTiles[changed]);
+		}
+		if (!isAffected)
+		{
+			continue;
+		}
+
+		IntVec2 goal(keyAndField.first % dims.x, keyAndField.first / dims.x);
+		m_fieldRepairer.RepairDistanceField(field.m_distances, m_costs, std::vector<IntVec2>{ goal }, changedTiles, m_settings);
+		if (field.m_hasFlowField)
+		{
+			field.m_flowField.UpdateTiles(field.m_distances, m_costs, m_fieldRepairer.GetChangedTiles(), m_settings);
+			field.m_flowField.UpdateTiles(field.m_distances, m_costs, changedTiles, m_settings);
+		}
+	}
+
+	// Without corner cutting a diagonal step is only legal while both tiles beside it are passable, so a wall
+	// appearing there breaks the path without touching any of its tiles
+	bool checkDiagonalSides = m_settings.m_allowDiagonals && !m_settings.m_allowCornerCutting;
+	for (auto path = m_paths.begin(); path != m_paths.end();)
+	{
+		bool isAffected = !path->second.m_isReachable;
+		std::vector<int> const& pathIndexes = path->second.m_sortedTileIndexes;
+		for (size_t changed = 0; changed < changedIndexes.size() && !isAffected; ++changed)
+		{
+			isAffected = std::binary_search(pathIndexes.begin(), pathIndexes.end(), changedIndexes[changed]);
+		}
+
+		std::vector<IntVec2> const& pathTiles = path->second.m_tiles;
+		for (size_t step = 1; checkDiagonalSides && step < pathTiles.size() && !isAffected; ++step)
+		{
+			IntVec2 const& from = pathTiles[step - 1];
+			IntVec2 const& to = pathTiles[step];
+			if (from.x != to.x && from.y != to.y)
+			{
+				isAffected = std::binary_search(changedIndexes.begin(), changedIndexes.end(), GetTileIndex(IntVec2(to.x, from.y)))
+					|| std::binary_search(changedIndexes.begin(), changedIndexes.end(), GetTileIndex(IntVec2(from.x, to.y)));
+			}
+		}
+		path = isAffected ? m_paths.erase(path) : std::next(path);
+	}
+}
+
+void TilePathCache::Clear()
+{
+	m_fields.clear();
+	m_paths.clear();
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+#include "Engine/Core/HeatMaps.hpp"
+#include "Engine/Core/TilePathfinding.hpp"
+#include <unordered_map>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------
+// Keeps distance fields, flow fields and A* paths over one cost map between frames, so agents sharing a goal share a
+// single field and repeated queries cost a lookup. Results are built on first request.
+//
+// After editing the cost map, pass the edited tiles to NotifyTilesChanged; only what those tiles can affect is touched.
+// A field whose reached region includes or borders a changed tile (a wall may have opened) is repaired in place by a
+// TileDistanceFieldRepairer, along with the flow directions around the tiles it rewrote. A path goes when it crosses
+// a changed tile or, with diagonals on and corner cutting off, steps diagonally past one; "no path" answers go on any
+// change. Every other path stays walkable and is kept, even if a tile elsewhere got cheaper and it is no longer the
+// shortest.
+//
+// Fields are keyed by their single goal tile and evicted least recently used past maxCachedFields; returned
+// references stay valid until the next call that can generate, evict or invalidate.
+//
+class TilePathCache
+{
+public:
+	explicit TilePathCache(TileHeatMap const& costs, TilePathSettings const& settings = TilePathSettings(), int maxCachedFields = 8, int maxCachedPaths = 256);
+	TilePathCache(TilePathCache const& copy) = delete;
+	TilePathCache& operator=(TilePathCache const& copy) = delete;
+
+	TileHeatMap const&		GetDistanceField(IntVec2 const& goal);
+	TileFlowField const&	GetFlowField(IntVec2 const& goal);
+	bool					FindPath(IntVec2 const& start, IntVec2 const& goal, std::vector<IntVec2>& out_path);
+
+	void	NotifyTilesChanged(std::vector<IntVec2> const& changedTiles);
+	void	Clear();
+
+	int		GetNumCachedFields() const		{ return (int)m_fields.size(); }
+	int		GetNumCachedPaths() const		{ return (int)m_paths.size(); }
+
+private:
+	struct CachedField
+	{
+		explicit CachedField(IntVec2 const& dimensions) : m_distances(dimensions) {}
+
+		TileHeatMap		m_distances;
+		TileFlowField	m_flowField;
+		bool			m_hasFlowField = false;
+		unsigned int	m_lastUsed = 0;
+	};
+
+	struct CachedPath
+	{
+		std::vector<IntVec2>	m_tiles;
+		std::vector<int>		m_sortedTileIndexes;
+		bool					m_isReachable = false;
+		unsigned int			m_lastUsed = 0;
+	};
+
+	CachedField&	GetOrGenerateField(IntVec2 const& goal);
+	bool			IsFieldAffectedByTile(CachedField const& field, IntVec2 const& tileCoords) const;
+	int				GetTileIndex(IntVec2 const& tileCoords) const;
+
+private:
+	TileHeatMap const&							m_costs;
+	TilePathSettings							m_settings;
+	TilePathfinder								m_pathfinder;
+	TileDistanceFieldRepairer					m_fieldRepairer;
+	std::unordered_map<int, CachedField>		m_fields;		// by goal tile index
+	std::unordered_map<long long, CachedPath>	m_paths;		// by start tile index * numTiles + goal tile index
+	int											m_maxCachedFields = 8;
+	int											m_maxCachedPaths = 256;
+	unsigned int								m_useCounter = 0;
+};
\ No newline at end of file
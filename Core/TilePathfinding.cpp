@@ -0,0 +1,865 @@
+#include "Engine/Core/TilePathfinding.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/HeatMaps.hpp"
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+
+namespace
+{
+	constexpr float SQRT_2 = 1.41421356f;
+	constexpr int MAX_DISTANCE_FIELD_BUCKETS = 4096;
+	constexpr uint8_t NO_DIRECTION = 0xFF;
+
+	// Orthogonal neighbors first; diagonal k (4..7) is only walkable past orthogonals DIAGONAL_SIDES[k - 4]
+	constexpr int NEIGHBOR_OFFSET_X[8] = { 1, -1, 0, 0, 1, -1, 1, -1 };
+	constexpr int NEIGHBOR_OFFSET_Y[8] = { 0, 0, 1, -1, 1, 1, -1, -1 };
+	constexpr int DIAGONAL_SIDES[4][2] = { { 0, 2 }, { 1, 2 }, { 0, 3 }, { 1, 3 } };
+
+	struct TileGrid
+	{
+		float const*	m_costs = nullptr;
+		int				m_width = 0;
+		int				m_height = 0;
+		float			m_impassableCost = TILE_COST_IMPASSABLE;
+
+		bool IsPassable(int x, int y) const
+		{
+			if (x < 0 || y < 0 || x >= m_width || y >= m_height)
+			{
+				return false;
+			}
+			float cost = m_costs[x + y * m_width];
+			return cost >= 0.f && cost < m_impassableCost;
+		}
+	};
+
+	int GetSign(int value)
+	{
+		return (value > 0) - (value < 0);
+	}
+
+	float GetOctileDistance(int deltaX, int deltaY)
+	{
+		deltaX = abs(deltaX);
+		deltaY = abs(deltaY);
+		return (float)std::max(deltaX, deltaY) + (SQRT_2 - 1.f) * (float)std::min(deltaX, deltaY);
+	}
+
+	// Straight or diagonal run from (x,y) stepping (dirX,dirY) until it reaches the goal or a tile with a forced
+	// neighbor (one only reachable optimally through this tile); -1 if it runs into a wall first. Diagonal runs
+	// also stop where a straight run along either component would find a jump point.
+	int Jump(TileGrid const& grid, int x, int y, int dirX, int dirY, int goalX, int goalY)
+	{
+		for (;;)
+		{
+			if (!grid.IsPassable(x, y))
+			{
+				return -1;
+			}
+			if (x == goalX && y == goalY)
+			{
+				return x + y * grid.m_width;
+			}
+
+			if (dirX != 0 && dirY != 0)
+			{
+				if (Jump(grid, x + dirX, y, dirX, 0, goalX, goalY) >= 0 || Jump(grid, x, y + dirY, 0, dirY, goalX, goalY) >= 0)
+				{
+					return x + y * grid.m_width;
+				}
+				if (!grid.IsPassable(x + dirX, y) || !grid.IsPassable(x, y + dirY))
+				{
+					return -1;
+				}
+			}
+			else if (dirX != 0)
+			{
+				if ((grid.IsPassable(x, y - 1) && !grid.IsPassable(x - dirX, y - 1)) || (grid.IsPassable(x, y + 1) && !grid.IsPassable(x - dirX, y + 1)))
+				{
+					return x + y * grid.m_width;
+				}
+			}
+			else
+			{
+				if ((grid.IsPassable(x - 1, y) && !grid.IsPassable(x - 1, y - dirY)) || (grid.IsPassable(x + 1, y) && !grid.IsPassable(x + 1, y - dirY)))
+				{
+					return x + y * grid.m_width;
+				}
+			}
+			x += dirX;
+			y += dirY;
+		}
+	}
+
+	// Directions worth jumping in from (x,y) when arriving along (dirX,dirY); all of them at the start node
+	int GetPrunedDirections(TileGrid const& grid, int x, int y, int dirX, int dirY, IntVec2* out_directions)
+	{
+		int numDirections = 0;
+		if (dirX == 0 && dirY == 0)
+		{
+			for (int neighbor = 0; neighbor < 8; ++neighbor)
+			{
+				int stepX = NEIGHBOR_OFFSET_X[neighbor];
+				int stepY = NEIGHBOR_OFFSET_Y[neighbor];
+				if (stepX != 0 && stepY != 0 && (!grid.IsPassable(x + stepX, y) || !grid.IsPassable(x, y + stepY)))
+				{
+					continue;
+				}
+				out_directions[numDirections++] = IntVec2(stepX, stepY);
+			}
+			return numDirections;
+		}
+
+		if (dirX != 0 && dirY != 0)
+		{
+			bool isSideXPassable = grid.IsPassable(x + dirX, y);
+			bool isSideYPassable = grid.IsPassable(x, y + dirY);
+			if (isSideYPassable)
+			{
+				out_directions[numDirections++] = IntVec2(0, dirY);
+			}
+			if (isSideXPassable)
+			{
+				out_directions[numDirections++] = IntVec2(dirX, 0);
+			}
+			if (isSideXPassable && isSideYPassable)
+			{
+				out_directions[numDirections++] = IntVec2(dirX, dirY);
+			}
+			return numDirections;
+		}
+
+		// Straight: keep going, turn to either side, or cut diagonally forward past an open side
+		int sideX = dirY != 0 ? 1 : 0;
+		int sideY = dirX != 0 ? 1 : 0;
+		bool isAheadPassable = grid.IsPassable(x + dirX, y + dirY);
+		bool isSidePassable = grid.IsPassable(x + sideX, y + sideY);
+		bool isOtherSidePassable = grid.IsPassable(x - sideX, y - sideY);
+		if (isAheadPassable)
+		{
+			out_directions[numDirections++] = IntVec2(dirX, dirY);
+			if (isSidePassable)
+			{
+				out_directions[numDirections++] = IntVec2(dirX + sideX, dirY + sideY);
+			}
+			if (isOtherSidePassable)
+			{
+				out_directions[numDirections++] = IntVec2(dirX - sideX, dirY - sideY);
+			}
+		}
+		if (isSidePassable)
+		{
+			out_directions[numDirections++] = IntVec2(sideX, sideY);
+		}
+		if (isOtherSidePassable)
+		{
+			out_directions[numDirections++] = IntVec2(-sideX, -sideY);
+		}
+		return numDirections;
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+bool IsTilePassable(float tileCost, TilePathSettings const& settings)
+{
+	return tileCost >= 0.f && tileCost < settings.m_impassableCost;
+}
+
+//----------------------------------------------------------------------------------------------
+void GenerateDistanceField(TileHeatMap& out_distances, TileHeatMap const& costs, std::vector<IntVec2> const& sources, TilePathSettings const& settings)
+{
+	IntVec2 dims = costs.GetDimensions();
+	IntVec2 outDims = out_distances.GetDimensions();
+	GUARANTEE_OR_DIE(outDims.x == dims.x && outDims.y == dims.y, "GenerateDistanceField needs a distance map the size of the cost map");
+
+	out_distances.SetAllValues(TILE_DISTANCE_UNREACHED);
+	float* distances = out_distances.GetValues();
+	float const* tileCosts = costs.GetValues();
+	int numTiles = costs.GetNumTiles();
+	int numNeighbors = settings.m_allowDiagonals ? 8 : 4;
+
+	// Bucket width is the cheapest step: anything relaxed from bucket k lands in bucket k+1 or later, so nothing in
+	// a bucket can still improve another entry of the same bucket
+	float minCost = TILE_COST_IMPASSABLE;
+	float maxCost = 0.f;
+	for (int tileIndex = 0; tileIndex < numTiles; ++tileIndex)
+	{
+		float cost = tileCosts[tileIndex];
+		if (IsTilePassable(cost, settings))
+		{
+			minCost = std::min(minCost, cost);
+			maxCost = std::max(maxCost, cost);
+		}
+	}
+	float maxStepCost = settings.m_allowDiagonals ? maxCost * SQRT_2 : maxCost;
+	bool useBuckets = minCost > 0.f && maxStepCost / minCost < (float)(MAX_DISTANCE_FIELD_BUCKETS - 2);
+	int numBuckets = useBuckets ? (int)(maxStepCost / minCost) + 2 : 1;
+	float inverseBucketWidth = useBuckets ? 1.f / minCost : 0.f;
+
+	std::vector<std::vector<int>> buckets(numBuckets);
+	std::vector<int> tileBuckets;
+	typedef std::pair<float, int> HeapEntry;
+	std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::greater<HeapEntry>> heap;
+	if (useBuckets)
+	{
+		tileBuckets.resize(numTiles, -1);
+	}
+	int numQueued = 0;
+
+	for (IntVec2 const& source : sources)
+	{
+		if (source.x < 0 || source.y < 0 || source.x >= dims.x || source.y >= dims.y)
+		{
+			continue;
+		}
+		int sourceIndex = source.x + source.y * dims.x;
+		if (!IsTilePassable(tileCosts[sourceIndex], settings) || distances[sourceIndex] == 0.f)
+		{
+			continue;
+		}
+		distances[sourceIndex] = 0.f;
+		if (useBuckets)
+		{
+			tileBuckets[sourceIndex] = 0;
+			buckets[0].push_back(sourceIndex);
+			++numQueued;
+		}
+		else
+		{
+			heap.push(HeapEntry(0.f, sourceIndex));
+		}
+	}
+
+	auto relaxNeighbors = [&](int tileIndex, int tileBucket, auto&& queueTile)
+	{
+		int x = tileIndex % dims.x;
+		int y = tileIndex / dims.x;
+		float distance = distances[tileIndex];
+		for (int neighbor = 0; neighbor < numNeighbors; ++neighbor)
+		{
+			int neighborX = x + NEIGHBOR_OFFSET_X[neighbor];
+			int neighborY = y + NEIGHBOR_OFFSET_Y[neighbor];
+			if (neighborX < 0 || neighborY < 0 || neighborX >= dims.x || neighborY >= dims.y)
+			{
+				continue;
+			}
+			int neighborIndex = neighborX + neighborY * dims.x;
+			float cost = tileCosts[neighborIndex];
+			if (!IsTilePassable(cost, settings))
+			{
+				continue;
+			}
+			if (neighbor >= 4)
+			{
+				if (!settings.m_allowCornerCutting)
+				{
+					int const* sides = DIAGONAL_SIDES[neighbor - 4];
+					if (!IsTilePassable(tileCosts[x + NEIGHBOR_OFFSET_X[sides[0]] + y * dims.x], settings) ||
+						!IsTilePassable(tileCosts[x + (y + NEIGHBOR_OFFSET_Y[sides[1]]) * dims.x], settings))
+					{
+						continue;
+					}
+				}
+				cost *= SQRT_2;
+			}
+			float newDistance = distance + cost;
+			if (newDistance < distances[neighborIndex] && newDistance <= settings.m_maxDistance)
+			{
+				distances[neighborIndex] = newDistance;
+				queueTile(neighborIndex, newDistance, tileBucket);
+			}
+		}
+	};
+
+	if (useBuckets)
+	{
+		// Buckets are reused round-robin: live entries never span more than numBuckets - 1 buckets past the current one
+		auto queueTile = [&](int tileIndex, float distance, int fromBucket)
+		{
+			float bucketPosition = distance * inverseBucketWidth;
+			int lastBucket = fromBucket + numBuckets - 1;
+			int bucket = bucketPosition >= (float)lastBucket ? lastBucket : std::max(fromBucket + 1, (int)bucketPosition);
+			tileBuckets[tileIndex] = bucket;
+			buckets[bucket % numBuckets].push_back(tileIndex);
+			++numQueued;
+		};
+		for (int bucket = 0; numQueued > 0; ++bucket)
+		{
+			std::vector<int>& bucketTiles = buckets[bucket % numBuckets];
+			for (size_t entry = 0; entry < bucketTiles.size(); ++entry)
+			{
+				int tileIndex = bucketTiles[entry];
+				--numQueued;
+				if (tileBuckets[tileIndex] == bucket)
+				{
+					relaxNeighbors(tileIndex, bucket, queueTile);
+				}
+			}
+			bucketTiles.clear();
+		}
+	}
+	else
+	{
+		auto queueTile = [&](int tileIndex, float distance, int)
+		{
+			heap.push(HeapEntry(distance, tileIndex));
+		};
+		while (!heap.empty())
+		{
+			HeapEntry entry = heap.top();
+			heap.pop();
+			if (entry.first == distances[entry.second])
+			{
+				relaxNeighbors(entry.second, 0, queueTile);
+			}
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+namespace
+{
+	bool IsQueuedTileWorse(float keyA, float keyB)
+	{
+		return keyA > keyB;
+	}
+}
+
+int TileDistanceFieldRepairer::RepairDistanceField(TileHeatMap& distances, TileHeatMap const& costs, std::vector<IntVec2> const& sources, std::vector<IntVec2> const& changedTiles, TilePathSettings const& settings)
+{
+	IntVec2 dims = costs.GetDimensions();
+	IntVec2 distanceDims = distances.GetDimensions();
+	GUARANTEE_OR_DIE(distanceDims.x == dims.x && distanceDims.y == dims.y, "RepairDistanceField needs a distance map the size of the cost map");
+
+	int numTiles = costs.GetNumTiles();
+	if (dims != m_dimensions || (int)m_neighborBasedStamps.size() != numTiles || m_repairStamp == 0xFFFFFFFFu)
+	{
+		m_dimensions = dims;
+		m_neighborBasedDistances.resize(numTiles);
+		m_neighborBasedStamps.assign(numTiles, 0);
+		m_changedStamps.assign(numTiles, 0);
+		m_repairStamp = 0;
+	}
+	++m_repairStamp;
+	m_distances = distances.GetValues();
+	m_costs = costs.GetValues();
+	m_settings = settings;
+	m_queue.clear();
+	m_changedTiles.clear();
+
+	m_sourceIndexes.clear();
+	for (IntVec2 const& source : sources)
+	{
+		if (source.x >= 0 && source.y >= 0 && source.x < dims.x && source.y < dims.y)
+		{
+			m_sourceIndexes.push_back(source.x + source.y * dims.x);
+		}
+	}
+	std::sort(m_sourceIndexes.begin(), m_sourceIndexes.end());
+
+	// An edit changes the cost of stepping onto the tile, and of the diagonal steps between its neighbors
+	for (IntVec2 const& tileCoords : changedTiles)
+	{
+		for (int y = std::max(0, tileCoords.y - 1); y <= std::min(dims.y - 1, tileCoords.y + 1); ++y)
+		{
+			for (int x = std::max(0, tileCoords.x - 1); x <= std::min(dims.x - 1, tileCoords.x + 1); ++x)
+			{
+				UpdateTile(x + y * dims.x);
+			}
+		}
+	}
+
+	int numNeighbors = settings.m_allowDiagonals ? 8 : 4;
+	int numTilesProcessed = 0;
+	while (!m_queue.empty())
+	{
+		std::pop_heap(m_queue.begin(), m_queue.end(), [](QueuedTile const& a, QueuedTile const& b) { return IsQueuedTileWorse(a.m_key, b.m_key); });
+		QueuedTile queued = m_queue.back();
+		m_queue.pop_back();
+
+		int tileIndex = queued.m_tileIndex;
+		float distance = m_distances[tileIndex];
+		float neighborBasedDistance = GetNeighborBasedDistance(tileIndex);
+		if (distance == neighborBasedDistance || queued.m_key != std::min(distance, neighborBasedDistance))
+		{
+			continue;
+		}
+		++numTilesProcessed;
+		MarkTileChanged(tileIndex);
+
+		int x = tileIndex % dims.x;
+		int y = tileIndex / dims.x;
+		if (neighborBasedDistance < distance)
+		{
+			// Lowered: neighbors can only get better through this tile, no need to rescan all of theirs
+			m_distances[tileIndex] = neighborBasedDistance;
+			for (int neighbor = 0; neighbor < numNeighbors; ++neighbor)
+			{
+				int neighborX = x + NEIGHBOR_OFFSET_X[neighbor];
+				int neighborY = y + NEIGHBOR_OFFSET_Y[neighbor];
+				if (neighborX < 0 || neighborY < 0 || neighborX >= dims.x || neighborY >= dims.y)
+				{
+					continue;
+				}
+				int neighborIndex = neighborX + neighborY * dims.x;
+				float stepCost = m_costs[neighborIndex];
+				if (!IsTilePassable(stepCost, settings) || std::binary_search(m_sourceIndexes.begin(), m_sourceIndexes.end(), neighborIndex))
+				{
+					continue;
+				}
+				if (neighbor >= 4)
+				{
+					int const* sides = DIAGONAL_SIDES[neighbor - 4];
+					if (!settings.m_allowCornerCutting &&
+						(!IsTilePassable(m_costs[x + NEIGHBOR_OFFSET_X[sides[0]] + y * dims.x], settings) ||
+						!IsTilePassable(m_costs[x + (y + NEIGHBOR_OFFSET_Y[sides[1]]) * dims.x], settings)))
+					{
+						continue;
+					}
+					stepCost *= SQRT_2;
+				}
+				float newDistance = neighborBasedDistance + stepCost;
+				if (newDistance <= settings.m_maxDistance && newDistance < GetNeighborBasedDistance(neighborIndex))
+				{
+					SetNeighborBasedDistance(neighborIndex, newDistance);
+					QueueTileIfInconsistent(neighborIndex);
+				}
+			}
+		}
+		else
+		{
+			// Raised: drop to unreached and let this tile and its neighbors find new support
+			m_distances[tileIndex] = TILE_DISTANCE_UNREACHED;
+			UpdateTile(tileIndex);
+			for (int neighbor = 0; neighbor < numNeighbors; ++neighbor)
+			{
+				int neighborX = x + NEIGHBOR_OFFSET_X[neighbor];
+				int neighborY = y + NEIGHBOR_OFFSET_Y[neighbor];
+				if (neighborX >= 0 && neighborY >= 0 && neighborX < dims.x && neighborY < dims.y)
+				{
+					UpdateTile(neighborX + neighborY * dims.x);
+				}
+			}
+		}
+	}
+	return numTilesProcessed;
+}
+
+float TileDistanceFieldRepairer::GetBestNeighborDistance(int tileIndex) const
+{
+	// Same float operations as GenerateDistanceField's relaxation, so untouched tiles compare exactly equal
+	float tileCost = m_costs[tileIndex];
+	if (!IsTilePassable(tileCost, m_settings))
+	{
+		return TILE_DISTANCE_UNREACHED;
+	}
+	if (std::binary_search(m_sourceIndexes.begin(), m_sourceIndexes.end(), tileIndex))
+	{
+		return 0.f;
+	}
+
+	int x = tileIndex % m_dimensions.x;
+	int y = tileIndex / m_dimensions.x;
+	int numNeighbors = m_settings.m_allowDiagonals ? 8 : 4;
+	float bestDistance = TILE_DISTANCE_UNREACHED;
+	for (int neighbor = 0; neighbor < numNeighbors; ++neighbor)
+	{
+		int neighborX = x + NEIGHBOR_OFFSET_X[neighbor];
+		int neighborY = y + NEIGHBOR_OFFSET_Y[neighbor];
+		if (neighborX < 0 || neighborY < 0 || neighborX >= m_dimensions.x || neighborY >= m_dimensions.y)
+		{
+			continue;
+		}
+		float neighborDistance = m_distances[neighborX + neighborY * m_dimensions.x];
+		if (neighborDistance >= TILE_DISTANCE_UNREACHED)
+		{
+			continue;
+		}
+		float stepCost = tileCost;
+		if (neighbor >= 4)
+		{
+			// The step from the neighbor passes the same two orthogonal tiles as a step to it
+			int const* sides = DIAGONAL_SIDES[neighbor - 4];
+			if (!m_settings.m_allowCornerCutting &&
+				(!IsTilePassable(m_costs[x + NEIGHBOR_OFFSET_X[sides[0]] + y * m_dimensions.x], m_settings) ||
+				!IsTilePassable(m_costs[x + (y + NEIGHBOR_OFFSET_Y[sides[1]]) * m_dimensions.x], m_settings)))
+			{
+				continue;
+			}
+			stepCost *= SQRT_2;
+		}
+		bestDistance = std::min(bestDistance, neighborDistance + stepCost);
+	}
+	return bestDistance <= m_settings.m_maxDistance ? bestDistance : TILE_DISTANCE_UNREACHED;
+}
+
+float TileDistanceFieldRepairer::GetNeighborBasedDistance(int tileIndex) const
+{
+	return m_neighborBasedStamps[tileIndex] == m_repairStamp ? m_neighborBasedDistances[tileIndex] : m_distances[tileIndex];
+}
+
+void TileDistanceFieldRepairer::SetNeighborBasedDistance(int tileIndex, float distance)
+{
+	m_neighborBasedDistances[tileIndex] = distance;
+	m_neighborBasedStamps[tileIndex] = m_repairStamp;
+}
+
+void TileDistanceFieldRepairer::UpdateTile(int tileIndex)
+{
+	SetNeighborBasedDistance(tileIndex, GetBestNeighborDistance(tileIndex));
+	QueueTileIfInconsistent(tileIndex);
+}
+
+void TileDistanceFieldRepairer::QueueTileIfInconsistent(int tileIndex)
+{
+	float distance = m_distances[tileIndex];
+	float neighborBasedDistance = m_neighborBasedDistances[tileIndex];
+	if (distance == neighborBasedDistance)
+	{
+		return;
+	}
+	QueuedTile queued;
+	queued.m_key = std::min(distance, neighborBasedDistance);
+	queued.m_tileIndex = tileIndex;
+	m_queue.push_back(queued);
+	std::push_heap(m_queue.begin(), m_queue.end(), [](QueuedTile const& a, QueuedTile const& b) { return IsQueuedTileWorse(a.m_key, b.m_key); });
+}
+
+void TileDistanceFieldRepairer::MarkTileChanged(int tileIndex)
+{
+	if (m_changedStamps[tileIndex] != m_repairStamp)
+	{
+		m_changedStamps[tileIndex] = m_repairStamp;
+		m_changedTiles.push_back(IntVec2(tileIndex % m_dimensions.x, tileIndex / m_dimensions.x));
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+void TileFlowField::Generate(TileHeatMap const& distances, TileHeatMap const& costs, TilePathSettings const& settings)
+{
+	m_dimensions = distances.GetDimensions();
+	IntVec2 costDims = costs.GetDimensions();
+	GUARANTEE_OR_DIE(costDims.x == m_dimensions.x && costDims.y == m_dimensions.y, "TileFlowField needs a cost map the size of the distance map");
+	m_directions.resize(distances.GetNumTiles());
+	for (int y = 0; y < m_dimensions.y; ++y)
+	{
+		for (int x = 0; x < m_dimensions.x; ++x)
+		{
+			m_directions[x + y * m_dimensions.x] = GetDownhillNeighbor(x, y, distances.GetValues(), costs.GetValues(), settings);
+		}
+	}
+}
+
+void TileFlowField::UpdateTiles(TileHeatMap const& distances, TileHeatMap const& costs, std::vector<IntVec2> const& changedTiles, TilePathSettings const& settings)
+{
+	IntVec2 dims = distances.GetDimensions();
+	if (dims != m_dimensions || (int)m_directions.size() != distances.GetNumTiles())
+	{
+		Generate(distances, costs, settings);
+		return;
+	}
+
+	// A tile's direction depends on its neighbors' distances and, through corner cutting, on its orthogonal neighbors' costs
+	for (IntVec2 const& tileCoords : changedTiles)
+	{
+		for (int y = std::max(0, tileCoords.y - 1); y <= std::min(m_dimensions.y - 1, tileCoords.y + 1); ++y)
+		{
+			for (int x = std::max(0, tileCoords.x - 1); x <= std::min(m_dimensions.x - 1, tileCoords.x + 1); ++x)
+			{
+				m_directions[x + y * m_dimensions.x] = GetDownhillNeighbor(x, y, distances.GetValues(), costs.GetValues(), settings);
+			}
+		}
+	}
+}
+
+uint8_t TileFlowField::GetDownhillNeighbor(int x, int y, float const* tileDistances, float const* tileCosts, TilePathSettings const& settings) const
+{
+	float bestDistance = tileDistances[x + y * m_dimensions.x];
+	if (bestDistance >= TILE_DISTANCE_UNREACHED)
+	{
+		return NO_DIRECTION;
+	}
+
+	uint8_t bestNeighbor = NO_DIRECTION;
+	int numNeighbors = settings.m_allowDiagonals ? 8 : 4;
+	for (int neighbor = 0; neighbor < numNeighbors; ++neighbor)
+	{
+		int neighborX = x + NEIGHBOR_OFFSET_X[neighbor];
+		int neighborY = y + NEIGHBOR_OFFSET_Y[neighbor];
+		if (neighborX < 0 || neighborY < 0 || neighborX >= m_dimensions.x || neighborY >= m_dimensions.y)
+		{
+			continue;
+		}
+		float neighborDistance = tileDistances[neighborX + neighborY * m_dimensions.x];
+		if (neighborDistance >= bestDistance)
+		{
+			continue;
+		}
+		if (neighbor >= 4 && !settings.m_allowCornerCutting)
+		{
+			int const* sides = DIAGONAL_SIDES[neighbor - 4];
+			if (!IsTilePassable(tileCosts[x + NEIGHBOR_OFFSET_X[sides[0]] + y * m_dimensions.x], settings) ||
+				!IsTilePassable(tileCosts[x + (y + NEIGHBOR_OFFSET_Y[sides[1]]) * m_dimensions.x], settings))
+			{
+				continue;
+			}
+		}
+		bestDistance = neighborDistance;
+		bestNeighbor = (uint8_t)neighbor;
+	}
+	return bestNeighbor;
+}
+
+bool TileFlowField::HasDirection(IntVec2 const& tileCoords) const
+{
+	if (tileCoords.x < 0 || tileCoords.y < 0 || tileCoords.x >= m_dimensions.x || tileCoords.y >= m_dimensions.y)
+	{
+		return false;
+	}
+	return m_directions[tileCoords.x + tileCoords.y * m_dimensions.x] != NO_DIRECTION;
+}
+
+IntVec2 TileFlowField::GetStepDirection(IntVec2 const& tileCoords) const
+{
+	if (!HasDirection(tileCoords))
+	{
+		return IntVec2(0, 0);
+	}
+	uint8_t neighbor = m_directions[tileCoords.x + tileCoords.y * m_dimensions.x];
+	return IntVec2(NEIGHBOR_OFFSET_X[neighbor], NEIGHBOR_OFFSET_Y[neighbor]);
+}
+
+Vec2 TileFlowField::GetFlowDirection(IntVec2 const& tileCoords) const
+{
+	IntVec2 step = GetStepDirection(tileCoords);
+	float scale = (step.x != 0 && step.y != 0) ? 1.f / SQRT_2 : 1.f;
+	return Vec2((float)step.x * scale, (float)step.y * scale);
+}
+
+//----------------------------------------------------------------------------------------------
+void TilePathfinder::BeginSearch(IntVec2 const& dimensions)
+{
+	int numTiles = dimensions.x * dimensions.y;
+	if (dimensions != m_dimensions || (int)m_nodeStamps.size() != numTiles || m_searchStamp >= 0xFFFFFFF0u)
+	{
+		m_dimensions = dimensions;
+		m_nodeCosts.resize(numTiles);
+		m_nodeParents.resize(numTiles);
+		m_nodeStamps.assign(numTiles, 0);
+		m_searchStamp = 0;
+	}
+	m_searchStamp += 2;
+	m_openNodes.clear();
+	m_numNodesExpanded = 0;
+	m_lastPathCost = 0.f;
+}
+
+namespace
+{
+	// Min-heap on estimated total; ties go to the node furthest along, which finishes straight runs first
+	bool IsWorseOpenNode(float totalA, float costSoFarA, float totalB, float costSoFarB)
+	{
+		return totalA > totalB || (totalA == totalB && costSoFarA < costSoFarB);
+	}
+}
+
+void TilePathfinder::OpenNodeAt(int tileIndex, int parentIndex, float costSoFar, float estimatedTotalCost)
+{
+	m_nodeCosts[tileIndex] = costSoFar;
+	m_nodeParents[tileIndex] = parentIndex;
+	m_nodeStamps[tileIndex] = m_searchStamp;
+
+	OpenNode node;
+	node.m_estimatedTotalCost = estimatedTotalCost;
+	node.m_costSoFar = costSoFar;
+	node.m_tileIndex = tileIndex;
+	m_openNodes.push_back(node);
+	std::push_heap(m_openNodes.begin(), m_openNodes.end(), [](OpenNode const& a, OpenNode const& b)
+	{
+		return IsWorseOpenNode(a.m_estimatedTotalCost, a.m_costSoFar, b.m_estimatedTotalCost, b.m_costSoFar);
+	});
+}
+
+bool TilePathfinder::PopBestOpenNode(int& out_tileIndex)
+{
+	while (!m_openNodes.empty())
+	{
+		std::pop_heap(m_openNodes.begin(), m_openNodes.end(), [](OpenNode const& a, OpenNode const& b)
+		{
+			return IsWorseOpenNode(a.m_estimatedTotalCost, a.m_costSoFar, b.m_estimatedTotalCost, b.m_costSoFar);
+		});
+		OpenNode node = m_openNodes.back();
+		m_openNodes.pop_back();
+
+		// Reopening a node pushes a second entry instead of fixing up the heap; the older one is skipped here
+		int tileIndex = node.m_tileIndex;
+		if (m_nodeStamps[tileIndex] != m_searchStamp || node.m_costSoFar > m_nodeCosts[tileIndex])
+		{
+			continue;
+		}
+		m_nodeStamps[tileIndex] = m_searchStamp + 1;
+		++m_numNodesExpanded;
+		out_tileIndex = tileIndex;
+		return true;
+	}
+	return false;
+}
+
+void TilePathfinder::BuildPath(int goalIndex, bool fillGapsBetweenNodes, std::vector<IntVec2>& out_path) const
+{
+	out_path.clear();
+	for (int tileIndex = goalIndex; tileIndex >= 0; tileIndex = m_nodeParents[tileIndex])
+	{
+		IntVec2 tileCoords(tileIndex % m_dimensions.x, tileIndex / m_dimensions.x);
+		if (fillGapsBetweenNodes && !out_path.empty())
+		{
+			// Jump points are joined by straight or exactly diagonal runs
+			IntVec2 laterCoords = out_path.back();
+			int stepX = GetSign(tileCoords.x - laterCoords.x);
+			int stepY = GetSign(tileCoords.y - laterCoords.y);
+			for (IntVec2 coords(laterCoords.x + stepX, laterCoords.y + stepY); coords != tileCoords; coords = IntVec2(coords.x + stepX, coords.y + stepY))
+			{
+				out_path.push_back(coords);
+			}
+		}
+		out_path.push_back(tileCoords);
+	}
+	std::reverse(out_path.begin(), out_path.end());
+}
+
+//----------------------------------------------------------------------------------------------
+bool TilePathfinder::FindPath(TileHeatMap const& costs, IntVec2 const& start, IntVec2 const& goal, std::vector<IntVec2>& out_path, TilePathSettings const& settings)
+{
+	out_path.clear();
+	IntVec2 dims = costs.GetDimensions();
+	TileGrid grid;
+	grid.m_costs = costs.GetValues();
+	grid.m_width = dims.x;
+	grid.m_height = dims.y;
+	grid.m_impassableCost = settings.m_impassableCost;
+	if (start.x < 0 || start.y < 0 || start.x >= dims.x || start.y >= dims.y || !grid.IsPassable(goal.x, goal.y))
+	{
+		return false;
+	}
+
+	BeginSearch(dims);
+	int numNeighbors = settings.m_allowDiagonals ? 8 : 4;
+	int goalIndex = goal.x + goal.y * dims.x;
+	float heuristicScale = settings.m_minStepCost;
+	auto getHeuristic = [&](int x, int y)
+	{
+		int deltaX = abs(goal.x - x);
+		int deltaY = abs(goal.y - y);
+		return heuristicScale * (settings.m_allowDiagonals ? GetOctileDistance(deltaX, deltaY) : (float)(deltaX + deltaY));
+	};
+	OpenNodeAt(start.x + start.y * dims.x, -1, 0.f, getHeuristic(start.x, start.y));
+
+	int tileIndex = 0;
+	while (PopBestOpenNode(tileIndex))
+	{
+		if (tileIndex == goalIndex)
+		{
+			m_lastPathCost = m_nodeCosts[goalIndex];
+			BuildPath(goalIndex, false, out_path);
+			return true;
+		}
+
+		int x = tileIndex % dims.x;
+		int y = tileIndex / dims.x;
+		float costSoFar = m_nodeCosts[tileIndex];
+		for (int neighbor = 0; neighbor < numNeighbors; ++neighbor)
+		{
+			int neighborX = x + NEIGHBOR_OFFSET_X[neighbor];
+			int neighborY = y + NEIGHBOR_OFFSET_Y[neighbor];
+			if (!grid.IsPassable(neighborX, neighborY))
+			{
+				continue;
+			}
+			int neighborIndex = neighborX + neighborY * dims.x;
+			if (m_nodeStamps[neighborIndex] == m_searchStamp + 1)
+			{
+				continue;
+			}
+			float stepCost = grid.m_costs[neighborIndex];
+			if (neighbor >= 4)
+			{
+				if (!settings.m_allowCornerCutting && (!grid.IsPassable(neighborX, y) || !grid.IsPassable(x, neighborY)))
+				{
+					continue;
+				}
+				stepCost *= SQRT_2;
+			}
+			float neighborCost = costSoFar + stepCost;
+			if (m_nodeStamps[neighborIndex] != m_searchStamp || neighborCost < m_nodeCosts[neighborIndex])
+			{
+				OpenNodeAt(neighborIndex, tileIndex, neighborCost, neighborCost + getHeuristic(neighborX, neighborY));
+			}
+		}
+	}
+	return false;
+}
+
+//----------------------------------------------------------------------------------------------
+bool TilePathfinder::FindPathJPS(TileHeatMap const& costs, IntVec2 const& start, IntVec2 const& goal, std::vector<IntVec2>& out_path, TilePathSettings const& settings)
+{
+	out_path.clear();
+	IntVec2 dims = costs.GetDimensions();
+	TileGrid grid;
+	grid.m_costs = costs.GetValues();
+	grid.m_width = dims.x;
+	grid.m_height = dims.y;
+	grid.m_impassableCost = settings.m_impassableCost;
+	if (start.x < 0 || start.y < 0 || start.x >= dims.x || start.y >= dims.y || !grid.IsPassable(goal.x, goal.y))
+	{
+		return false;
+	}
+
+	BeginSearch(dims);
+	int goalIndex = goal.x + goal.y * dims.x;
+	float stepCost = settings.m_minStepCost;
+	OpenNodeAt(start.x + start.y * dims.x, -1, 0.f, stepCost * GetOctileDistance(goal.x - start.x, goal.y - start.y));
+
+	IntVec2 directions[8];
+	int tileIndex = 0;
+	while (PopBestOpenNode(tileIndex))
+	{
+		if (tileIndex == goalIndex)
+		{
+			m_lastPathCost = m_nodeCosts[goalIndex];
+			BuildPath(goalIndex, true, out_path);
+			return true;
+		}
+
+		int x = tileIndex % dims.x;
+		int y = tileIndex / dims.x;
+		int dirX = 0;
+		int dirY = 0;
+		int parentIndex = m_nodeParents[tileIndex];
+		if (parentIndex >= 0)
+		{
+			dirX = GetSign(x - parentIndex % dims.x);
+			dirY = GetSign(y - parentIndex / dims.x);
+		}
+
+		float costSoFar = m_nodeCosts[tileIndex];
+		int numDirections = GetPrunedDirections(grid, x, y, dirX, dirY, directions);
+		for (int direction = 0; direction < numDirections; ++direction)
+		{
+			int jumpIndex = Jump(grid, x + directions[direction].x, y + directions[direction].y, directions[direction].x, directions[direction].y, goal.x, goal.y);
+			if (jumpIndex < 0 || m_nodeStamps[jumpIndex] == m_searchStamp + 1)
+			{
+				continue;
+			}
+			int jumpX = jumpIndex % dims.x;
+			int jumpY = jumpIndex / dims.x;
+			float jumpCost = costSoFar + stepCost * GetOctileDistance(jumpX - x, jumpY - y);
+			if (m_nodeStamps[jumpIndex] != m_searchStamp || jumpCost < m_nodeCosts[jumpIndex])
+			{
+				OpenNodeAt(jumpIndex, tileIndex, jumpCost, jumpCost + stepCost * GetOctileDistance(goal.x - jumpX, goal.y - jumpY));
+			}
+		}
+	}
+	return false;
+}
\ No newline at end of file
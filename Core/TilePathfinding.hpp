@@ -0,0 +1,148 @@
+#pragma once
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include <cstdint>
+#include <vector>
+
+class TileHeatMap;
+
+//----------------------------------------------------------------------------------------------
+// Pathfinding over a TileHeatMap of step costs: each value is what it costs to enter that tile (a diagonal step costs
+// sqrt(2) times as much). Tiles whose cost is negative or at least m_impassableCost are never entered.
+//
+// GenerateDistanceField is a multi-source Dijkstra that writes its result into another TileHeatMap (the classic
+// "distance map"), TileFlowField turns such a field into a per-tile step direction for crowds, and TilePathfinder
+// runs single A* / jump point searches. TilePathCache (TilePathCache.hpp) keeps their results between frames.
+//
+constexpr float TILE_COST_IMPASSABLE = 999999.f;
+constexpr float TILE_DISTANCE_UNREACHED = 999999.f;
+
+struct TilePathSettings
+{
+	float	m_impassableCost = TILE_COST_IMPASSABLE;
+	bool	m_allowDiagonals = true;
+	bool	m_allowCornerCutting = false;				// diagonal steps past a blocked orthogonal neighbor
+	float	m_maxDistance = TILE_DISTANCE_UNREACHED;	// distance fields stop expanding past this
+	float	m_minStepCost = 1.f;						// A* heuristic scale; at most the cheapest passable cost for optimal paths
+};
+
+// out_distances gets the cheapest cost from any source to each tile, TILE_DISTANCE_UNREACHED where none reaches
+// (or past m_maxDistance); it must have the dimensions of costs. Impassable sources are skipped. The queue is
+// bucketed with buckets as wide as the cheapest step, so a bucket can be settled in any order; costs spanning too
+// many buckets (or zero-cost tiles) fall back to a binary heap.
+void GenerateDistanceField(TileHeatMap& out_distances, TileHeatMap const& costs, std::vector<IntVec2> const& sources, TilePathSettings const& settings = TilePathSettings());
+
+bool IsTilePassable(float tileCost, TilePathSettings const& settings);
+
+//----------------------------------------------------------------------------------------------
+// Brings a distance field from GenerateDistanceField up to date after some tiles of its cost map changed, touching only
+// the region whose distances depend on them instead of the whole map. LPA*-style: each tile's distance should equal
+// its best "neighbor distance + step cost"; the edited tiles and their neighbors are rechecked, and tiles that no
+// longer match are queued by distance. A tile that got cheaper is lowered and passes that on; a tile whose support
+// is gone is first raised to unreached, then lowered again from whatever still reaches it. The result matches a full
+// regeneration exactly. Scratch arrays are stamped per repair like TilePathfinder's, so a repair costs nothing for
+// the untouched tiles.
+//
+class TileDistanceFieldRepairer
+{
+public:
+	// sources and settings must be the ones the field was generated with; returns the number of queued tiles processed
+	int		RepairDistanceField(TileHeatMap& distances, TileHeatMap const& costs, std::vector<IntVec2> const& sources, std::vector<IntVec2> const& changedTiles, TilePathSettings const& settings = TilePathSettings());
+
+	// Tiles whose distance the last repair rewrote, for TileFlowField::UpdateTiles and debug draw
+	std::vector<IntVec2> const&	GetChangedTiles() const		{ return m_changedTiles; }
+
+private:
+	float	GetBestNeighborDistance(int tileIndex) const;
+	float	GetNeighborBasedDistance(int tileIndex) const;
+	void	SetNeighborBasedDistance(int tileIndex, float distance);
+	void	UpdateTile(int tileIndex);
+	void	QueueTileIfInconsistent(int tileIndex);
+	void	MarkTileChanged(int tileIndex);
+
+private:
+	struct QueuedTile
+	{
+		float	m_key = 0.f;
+		int		m_tileIndex = 0;
+	};
+
+	IntVec2					m_dimensions;
+	float*					m_distances = nullptr;
+	float const*			m_costs = nullptr;
+	TilePathSettings		m_settings;
+	std::vector<int>		m_sourceIndexes;			// sorted
+	std::vector<float>		m_neighborBasedDistances;	// where stamped this repair; elsewhere it equals the distance
+	std::vector<uint32_t>	m_neighborBasedStamps;
+	std::vector<uint32_t>	m_changedStamps;
+	uint32_t				m_repairStamp = 0;
+	std::vector<QueuedTile>	m_queue;					// binary heap on key, may hold stale entries
+	std::vector<IntVec2>	m_changedTiles;
+};
+
+//----------------------------------------------------------------------------------------------
+// One step direction per tile, downhill through a distance field: crowds sample it instead of pathing per agent.
+// Sources, unreached tiles and local minima have no direction.
+//
+class TileFlowField
+{
+public:
+	// distances from GenerateDistanceField over costs, with the same settings
+	void	Generate(TileHeatMap const& distances, TileHeatMap const& costs, TilePathSettings const& settings = TilePathSettings());
+	// After a repair: recomputes the given tiles (TileDistanceFieldRepairer::GetChangedTiles plus the edited ones) and their neighbors
+	void	UpdateTiles(TileHeatMap const& distances, TileHeatMap const& costs, std::vector<IntVec2> const& changedTiles, TilePathSettings const& settings = TilePathSettings());
+
+	IntVec2	GetDimensions() const		{ return m_dimensions; }
+	bool	HasDirection(IntVec2 const& tileCoords) const;
+	IntVec2	GetStepDirection(IntVec2 const& tileCoords) const;		// (0,0) where there is none
+	Vec2	GetFlowDirection(IntVec2 const& tileCoords) const;		// normalized, zero where there is none
+
+private:
+	uint8_t	GetDownhillNeighbor(int x, int y, float const* tileDistances, float const* tileCosts, TilePathSettings const& settings) const;
+
+private:
+	IntVec2					m_dimensions;
+	std::vector<uint8_t>	m_directions;		// index into the 8 neighbor offsets, or NO_DIRECTION
+};
+
+//----------------------------------------------------------------------------------------------
+// A* and jump point search sharing one node pool. Per-tile costs, parents and open/closed states live in flat arrays
+// stamped with a search id, so a new search only bumps the id instead of clearing anything; the arrays are
+// reallocated only when the map dimensions change. Paths run start..goal inclusive; out_path is cleared and false
+// returned when the goal is off the map, impassable or unreachable.
+//
+class TilePathfinder
+{
+public:
+	bool	FindPath(TileHeatMap const& costs, IntVec2 const& start, IntVec2 const& goal, std::vector<IntVec2>& out_path, TilePathSettings const& settings = TilePathSettings());
+
+	// Uniform grids only: every passable tile costs m_minStepCost, 8-connected without corner cutting whatever the
+	// settings say. Expands only jump points, typically a small fraction of what FindPath visits on open maps.
+	bool	FindPathJPS(TileHeatMap const& costs, IntVec2 const& start, IntVec2 const& goal, std::vector<IntVec2>& out_path, TilePathSettings const& settings = TilePathSettings());
+
+	int		GetNumNodesExpanded() const		{ return m_numNodesExpanded; }		// by the last search
+	float	GetLastPathCost() const			{ return m_lastPathCost; }
+
+private:
+	struct OpenNode
+	{
+		float	m_estimatedTotalCost = 0.f;
+		float	m_costSoFar = 0.f;
+		int		m_tileIndex = 0;
+	};
+
+	void	BeginSearch(IntVec2 const& dimensions);
+	void	OpenNodeAt(int tileIndex, int parentIndex, float costSoFar, float estimatedTotalCost);
+	bool	PopBestOpenNode(int& out_tileIndex);
+	void	BuildPath(int goalIndex, bool fillGapsBetweenNodes, std::vector<IntVec2>& out_path) const;
+
+private:
+	IntVec2					m_dimensions;
+	std::vector<float>		m_nodeCosts;
+	std::vector<int>		m_nodeParents;
+	std::vector<uint32_t>	m_nodeStamps;			// m_searchStamp while open, m_searchStamp + 1 once closed
+	uint32_t				m_searchStamp = 0;
+	std::vector<OpenNode>	m_openNodes;			// binary heap, may hold stale entries
+	int						m_numNodesExpanded = 0;
+	float					m_lastPathCost = 0.f;
+};
\ No newline at end of file
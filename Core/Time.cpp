@@ -4,10 +4,15 @@
 
 //-----------------------------------------------------------------------------------------------
 #include "Engine/Core/Time.hpp"
+#if defined( _WIN32 )
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
+#else
+#include <chrono>
+#endif
 
 
+#if defined( _WIN32 )
 //-----------------------------------------------------------------------------------------------
 double InitializeTime( LARGE_INTEGER& out_initialTime )
 {
@@ -31,4 +36,16 @@ double GetCurrentTimeSeconds()
 	return currentSeconds;
 }
 
+#else
+//-----------------------------------------------------------------------------------------------
+// Headless builds off Windows (servers, CI): the same seconds-since-first-call from the steady clock
+double GetCurrentTimeSeconds()
+{
+	static std::chrono::steady_clock::time_point const initialTime = std::chrono::steady_clock::now();
+	std::chrono::duration< double > elapsedSinceInitialTime = std::chrono::steady_clock::now() - initialTime;
+	return elapsedSinceInitialTime.count();
+}
+
+#endif
+
 
@@ -0,0 +1,194 @@
+#include "Engine/Core/VertexCacheOptimizer.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+//----------------------------------------------------------------------------------------------
+// Picks the next fanning vertex: the candidate that is still live and will stay in cache longest once its
+// remaining triangles are emitted. Falls back to the dead-end stack, then to a linear scan.
+static int GetNextFanningVertex(std::vector<int> const& candidates, std::vector<int> const& liveTriangleCounts, std::vector<int> const& cacheTimestamps,
+	int timestamp, int cacheSize, std::vector<int>& deadEndStack, int& scanCursor)
+{
+	int bestVertex = -1;
+	int bestPriority = -1;
+	for (int vertex : candidates)
+	{
+		if (liveTriangleCounts[vertex] <= 0)
+		{
+			continue;
+		}
+		int priority = 0;
+		int age = timestamp - cacheTimestamps[vertex];
+		if (age + 2 * liveTriangleCounts[vertex] <= cacheSize)
+		{
+			priority = age;
+		}
+		if (priority > bestPriority)
+		{
+			bestPriority = priority;
+			bestVertex = vertex;
+		}
+	}
+	if (bestVertex >= 0)
+	{
+		return bestVertex;
+	}
+
+	while (!deadEndStack.empty())
+	{
+		int vertex = deadEndStack.back();
+		deadEndStack.pop_back();
+		if (liveTriangleCounts[vertex] > 0)
+		{
+			return vertex;
+		}
+	}
+
+	int numVertexes = static_cast<int>(liveTriangleCounts.size());
+	while (scanCursor < numVertexes)
+	{
+		int vertex = scanCursor++;
+		if (liveTriangleCounts[vertex] > 0)
+		{
+			return vertex;
+		}
+	}
+	return -1;
+}
+
+void OptimizeVertexCacheOrder(std::vector<unsigned int>& indexes, int numVertexes, int cacheSize)
+{
+	GUARANTEE_OR_DIE(indexes.size() % 3 == 0, "OptimizeVertexCacheOrder expects a triangle list");
+	int numTriangles = static_cast<int>(indexes.size() / 3);
+	if (numTriangles == 0 || numVertexes <= 0)
+	{
+		return;
+	}
+
+	// Vertex -> triangle adjacency in CSR form
+	std::vector<int> liveTriangleCounts(numVertexes, 0);
+	for (unsigned int index : indexes)
+	{
+		GUARANTEE_OR_DIE(index < static_cast<unsigned int>(numVertexes), "OptimizeVertexCacheOrder index out of range");
+		++liveTriangleCounts[index];
+	}
+	std::vector<int> adjacencyOffsets(numVertexes + 1, 0);
+	for (int vertex = 0; vertex < numVertexes; ++vertex)
+	{
+		adjacencyOffsets[vertex + 1] = adjacencyOffsets[vertex] + liveTriangleCounts[vertex];
+	}
+	std::vector<int> adjacentTriangles(adjacencyOffsets[numVertexes]);
+	std::vector<int> fillCursors(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+	for (int triangle = 0; triangle < numTriangles; ++triangle)
+	{
+		for (int corner = 0; corner < 3; ++corner)
+		{
+			adjacentTriangles[fillCursors[indexes[3 * triangle + corner]]++] = triangle;
+		}
+	}
+
+	std::vector<int> cacheTimestamps(numVertexes, 0);
+	std::vector<bool> isTriangleEmitted(numTriangles, false);
+	std::vector<int> deadEndStack;
+	std::vector<int> candidates;
+	std::vector<unsigned int> optimizedIndexes;
+	optimizedIndexes.reserve(indexes.size());
+	int timestamp = cacheSize + 1;
+	int scanCursor = 1;
+
+	int fanningVertex = 0;
+	while (liveTriangleCounts[fanningVertex] == 0 && fanningVertex + 1 < numVertexes)
+	{
+		++fanningVertex;
+	}
+	while (fanningVertex >= 0)
+	{
+		candidates.clear();
+		for (int adjacency = adjacencyOffsets[fanningVertex]; adjacency < adjacencyOffsets[fanningVertex + 1]; ++adjacency)
+		{
+			int triangle = adjacentTriangles[adjacency];
+			if (isTriangleEmitted[triangle])
+			{
+				continue;
+			}
+			for (int corner = 0; corner < 3; ++corner)
+			{
+				unsigned int vertex = indexes[3 * triangle + corner];
+				optimizedIndexes.push_back(vertex);
+				deadEndStack.push_back(vertex);
+				candidates.push_back(vertex);
+				--liveTriangleCounts[vertex];
+				if (timestamp - cacheTimestamps[vertex] > cacheSize)
+				{
+					cacheTimestamps[vertex] = timestamp++;
+				}
+			}
+			isTriangleEmitted[triangle] = true;
+		}
+		fanningVertex = GetNextFanningVertex(candidates, liveTriangleCounts, cacheTimestamps, timestamp, cacheSize, deadEndStack, scanCursor);
+	}
+
+	indexes.swap(optimizedIndexes);
+}
+
+//----------------------------------------------------------------------------------------------
+template <typename VertexType>
+static void ReorderVertexesByFirstUse(std::vector<VertexType>& verts, std::vector<unsigned int>& indexes)
+{
+	constexpr unsigned int UNASSIGNED = 0xFFFFFFFFu;
+	unsigned int numVertexes = static_cast<unsigned int>(verts.size());
+	std::vector<unsigned int> remap(numVertexes, UNASSIGNED);
+	std::vector<VertexType> reorderedVerts;
+	reorderedVerts.reserve(numVertexes);
+
+	for (unsigned int& index : indexes)
+	{
+		GUARANTEE_OR_DIE(index < numVertexes, "OptimizeVertexFetchOrder index out of range");
+		if (remap[index] == UNASSIGNED)
+		{
+			remap[index] = static_cast<unsigned int>(reorderedVerts.size());
+			reorderedVerts.push_back(verts[index]);
+		}
+		index = remap[index];
+	}
+	for (unsigned int vertex = 0; vertex < numVertexes; ++vertex)
+	{
+		if (remap[vertex] == UNASSIGNED)
+		{
+			reorderedVerts.push_back(verts[vertex]);
+		}
+	}
+
+	verts.swap(reorderedVerts);
+}
+
+void OptimizeVertexFetchOrder(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes)
+{
+	ReorderVertexesByFirstUse(verts, indexes);
+}
+
+void OptimizeVertexFetchOrder(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indexes)
+{
+	ReorderVertexesByFirstUse(verts, indexes);
+}
+
+//----------------------------------------------------------------------------------------------
+float GetAverageCacheMissRatio(std::vector<unsigned int> const& indexes, int numVertexes, int cacheSize)
+{
+	int numTriangles = static_cast<int>(indexes.size() / 3);
+	if (numTriangles == 0 || cacheSize <= 0)
+	{
+		return 0.f;
+	}
+
+	// FIFO cache: a vertex is resident if it was inserted fewer than cacheSize misses ago
+	std::vector<int> insertedAtMiss(numVertexes, -cacheSize - 1);
+	int numMisses = 0;
+	for (unsigned int index : indexes)
+	{
+		if (numMisses - insertedAtMiss[index] > cacheSize)
+		{
+			insertedAtMiss[index] = numMisses;
+			++numMisses;
+		}
+	}
+	return static_cast<float>(numMisses) / static_cast<float>(numTriangles);
+}
\ No newline at end of file
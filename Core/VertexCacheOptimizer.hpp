@@ -0,0 +1,20 @@
+#pragma once
+#include "Engine/Core/Vertex_PCU.hpp"
+#include <vector>
+
+//----------------------------------------------------------------------------------------------
+// Post-transform vertex cache optimization for indexed triangle lists (Tipsify, Sander et al. 2007).
+// Triangles are reordered so vertices are reused while they are still resident in a FIFO cache of
+// cacheSize entries; winding inside each triangle is preserved.
+//
+constexpr int DEFAULT_VERTEX_CACHE_SIZE = 16;
+
+void OptimizeVertexCacheOrder(std::vector<unsigned int>& indexes, int numVertexes, int cacheSize = DEFAULT_VERTEX_CACHE_SIZE);
+
+// Renumbers vertices in order of first use by indexes, so vertex fetches walk memory linearly.
+// Vertices that no index references keep their relative order at the end of the array.
+void OptimizeVertexFetchOrder(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes);
+void OptimizeVertexFetchOrder(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indexes);
+
+// Average cache miss ratio: simulated FIFO cache misses per triangle. 3.0 is the worst case, ~0.5 is ideal for large grids.
+float GetAverageCacheMissRatio(std::vector<unsigned int> const& indexes, int numVertexes, int cacheSize = DEFAULT_VERTEX_CACHE_SIZE);
\ No newline at end of file
@@ -1,18 +1,150 @@
 #include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Core/VertexWriter.hpp"
 #include "Engine/Math/Capsule2.hpp"
 #include "Engine/Math/LineSegment2.hpp"
 #include "Engine/Math/OBB2.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Math/OBB3.hpp"
+#include "Engine/Math/CatmullRomSpline3D.hpp"
+#include "Engine/Math/FastTrig.hpp"
+#include <mutex>
+#include <unordered_map>
+#include <memory>
+#include <cstring>
+#include <cstdint>
 
 constexpr float PI = 3.14159265358979323846f;
 
+//----------------------------------------------------------------------------------------------
+// Unit-geometry caches. Each table is built once per key under a mutex and never freed or
+// modified afterwards, so callers can keep the returned reference. A thread_local last-hit slot
+// skips the lock when the same slice count is requested repeatedly. Keys are 64-bit so a pair of
+// int counts packs into one without collisions.
+//
+template <typename TableType>
+class UnitGeometryCache
+{
+public:
+	template <typename BuildFunction>
+	TableType const& GetOrBuild(int64_t key, BuildFunction const& build)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		std::unique_ptr<TableType>& table = m_tables[key];
+		if (table == nullptr)
+		{
+			table = std::make_unique<TableType>();
+			build(*table);
+		}
+		return *table;
+	}
+
+private:
+	std::mutex m_mutex;
+	std::unordered_map<int64_t, std::unique_ptr<TableType>> m_tables;
+};
+
+std::vector<Vec2> const& GetUnitCirclePoints(int numSlices)
+{
+	static UnitGeometryCache<std::vector<Vec2>> s_cache;
+	thread_local int t_lastNumSlices = -1;
+	thread_local std::vector<Vec2> const* t_lastTable = nullptr;
+	if (numSlices == t_lastNumSlices)
+	{
+		return *t_lastTable;
+	}
+
+	t_lastTable = &s_cache.GetOrBuild(numSlices, [numSlices](std::vector<Vec2>& points)
+		{
+			points.resize(numSlices + 1);
+			for (int pointIndex = 0; pointIndex < numSlices; ++pointIndex)
+			{
+				FastSinCosDegrees(360.f * pointIndex / numSlices, points[pointIndex].y, points[pointIndex].x);
+			}
+			points[numSlices] = points[0];
+		});
+	t_lastNumSlices = numSlices;
+	return *t_lastTable;
+}
+
+std::vector<Vertex_PCU> const& GetUnitSphereTemplate(int numSlices, int numStacks)
+{
+	static UnitGeometryCache<std::vector<Vertex_PCU>> s_cache;
+	thread_local int64_t t_lastKey = -1;
+	thread_local std::vector<Vertex_PCU> const* t_lastTable = nullptr;
+	int64_t key = (static_cast<int64_t>(numSlices) << 32) | static_cast<uint32_t>(numStacks);
+	if (key == t_lastKey)
+	{
+		return *t_lastTable;
+	}
+
+	t_lastTable = &s_cache.GetOrBuild(key, [numSlices, numStacks](std::vector<Vertex_PCU>& verts)
+		{
+			std::vector<Vec2> const& meridians = GetUnitCirclePoints(numSlices);
+			std::vector<Vec2> rings(numStacks + 1);
+			for (int stackIndex = 0; stackIndex <= numStacks; ++stackIndex)
+			{
+				FastSinCosDegrees(180.f * stackIndex / numStacks - 90.f, rings[stackIndex].y, rings[stackIndex].x);
+			}
+			auto GetPoint = [&](int stackIndex, int sliceIndex)
+				{
+					return Vec3(rings[stackIndex].x * meridians[sliceIndex].x, rings[stackIndex].x * meridians[sliceIndex].y, rings[stackIndex].y);
+				};
+			auto GetUV = [&](int stackIndex, int sliceIndex)
+				{
+					return Vec2(static_cast<float>(sliceIndex) / numSlices, static_cast<float>(stackIndex) / numStacks);
+				};
+
+			verts.reserve(6 * numSlices * numStacks);
+			for (int stackIndex = 0; stackIndex < numStacks; ++stackIndex)
+			{
+				for (int sliceIndex = 0; sliceIndex < numSlices; ++sliceIndex)
+				{
+					Vertex_PCU v1(GetPoint(stackIndex, sliceIndex), Rgba8::WHITE, GetUV(stackIndex, sliceIndex));
+					Vertex_PCU v2(GetPoint(stackIndex, sliceIndex + 1), Rgba8::WHITE, GetUV(stackIndex, sliceIndex + 1));
+					Vertex_PCU v3(GetPoint(stackIndex + 1, sliceIndex), Rgba8::WHITE, GetUV(stackIndex + 1, sliceIndex));
+					Vertex_PCU v4(GetPoint(stackIndex + 1, sliceIndex + 1), Rgba8::WHITE, GetUV(stackIndex + 1, sliceIndex + 1));
+
+					verts.push_back(v2);
+					verts.push_back(v4);
+					verts.push_back(v3);
+
+					verts.push_back(v2);
+					verts.push_back(v3);
+					verts.push_back(v1);
+				}
+			}
+		});
+	t_lastKey = key;
+	return *t_lastTable;
+}
+
+// Writes a unit-space template scaled by radius and moved to center; the inner loop is plain float math
+static void WriteVertsFromTemplate(Vertex_PCU* out, std::vector<Vertex_PCU> const& unitTemplate, Vec3 const& center, float radius, Rgba8 const& color)
+{
+	size_t numVerts = unitTemplate.size();
+	Vertex_PCU const* in = unitTemplate.data();
+	for (size_t vertIndex = 0; vertIndex < numVerts; ++vertIndex)
+	{
+		out[vertIndex].m_position.x = center.x + in[vertIndex].m_position.x * radius;
+		out[vertIndex].m_position.y = center.y + in[vertIndex].m_position.y * radius;
+		out[vertIndex].m_position.z = center.z + in[vertIndex].m_position.z * radius;
+		out[vertIndex].m_color = color;
+		out[vertIndex].m_uvTexCoords = in[vertIndex].m_uvTexCoords;
+	}
+}
+
 void TransfromVertexArrayXY3D(int numVerts, Vertex_PCU* verts, float scaleXY, float rotationDegreesAboutZ, Vec2 const& translationXY)
 {
+	// One sin/cos for the whole array, then a plain basis transform per vertex
+	float sine;
+	float cosine;
+	FastSinCosDegrees(rotationDegreesAboutZ, sine, cosine);
+	Vec2 iBasis(cosine * scaleXY, sine * scaleXY);
+	Vec2 jBasis(-sine * scaleXY, cosine * scaleXY);
 	for (int vertIndex = 0; vertIndex < numVerts; ++vertIndex)
 	{
 		Vec3& pos = verts[vertIndex].m_position;
-		TransformPositionXY3D(pos, scaleXY, rotationDegreesAboutZ, translationXY);
+		TransformPositionXY3D(pos, iBasis, jBasis, translationXY);
 	}
 }
 
@@ -22,6 +154,12 @@ void AddVertsForCapsule2D(std::vector<Vertex_PCU>& verts, Capsule2 const& capsul
 }
 
 void AddVertsForCapsule2D(std::vector<Vertex_PCU>& verts, Vec2 const& boneStart, Vec2 const& boneEnd, float radius, Rgba8 const& color)
+{
+	VertexWriter writer(verts, GetNumVertsForCapsule2D());
+	AddVertsForCapsule2D(writer, boneStart, boneEnd, radius, color);
+}
+
+void AddVertsForCapsule2D(VertexWriter& writer, Vec2 const& boneStart, Vec2 const& boneEnd, float radius, Rgba8 const& color)
 {
 	Vec2 displacement = boneEnd - boneStart;
 	Vec2 direction = displacement.GetNormalized();
@@ -33,97 +171,98 @@ void AddVertsForCapsule2D(std::vector<Vertex_PCU>& verts, Vec2 const& boneStart,
 	Vertex_PCU p2 = Vertex_PCU(Vec3(boneEnd.x - offset.x, boneEnd.y - offset.y, 0.f), color, Vec2(0.f, 0.f));
 	Vertex_PCU p3 = Vertex_PCU(Vec3(boneEnd.x + offset.x, boneEnd.y + offset.y, 0.f), color, Vec2(0.f, 0.f));
 
-	verts.push_back(p0);
-	verts.push_back(p1);
-	verts.push_back(p2);
-
-	verts.push_back(p0);
-	verts.push_back(p2);
-	verts.push_back(p3);
+	Vertex_PCU* out = writer.Allocate(GetNumVertsForCapsule2D());
+	out[0] = p0;
+	out[1] = p1;
+	out[2] = p2;
 
-	const int numSlices = 20;
+	out[3] = p0;
+	out[4] = p2;
+	out[5] = p3;
+	out += 6;
 
-	for (int sliceIndex = 0; sliceIndex < numSlices; ++sliceIndex)
+	// Half circles of 20 slices each, taken from the first half of a 40-slice unit circle
+	std::vector<Vec2> const& circle = GetUnitCirclePoints(2 * CAPSULE2D_SLICES_PER_CAP);
+	for (int sliceIndex = 0; sliceIndex < CAPSULE2D_SLICES_PER_CAP; ++sliceIndex)
 	{
-		float fraction0 = (float)sliceIndex / numSlices;
-		float fraction1 = (float)(sliceIndex + 1) / numSlices;
-
-		Vec2 capStart0 = boneStart + (tangent * radius * cosf(fraction0 * 3.1415926f)) - (direction * radius * sinf(fraction0 * 3.1415926f));
-		Vec2 capStart1 = boneStart + (tangent * radius * cosf(fraction1 * 3.1415926f)) - (direction * radius * sinf(fraction1 * 3.1415926f));
-		verts.push_back(Vertex_PCU(Vec3(boneStart.x, boneStart.y, 0.f), color, Vec2(0.f, 0.f)));
-		verts.push_back(Vertex_PCU(Vec3(capStart0.x, capStart0.y, 0.f), color, Vec2(0.f, 0.f)));
-		verts.push_back(Vertex_PCU(Vec3(capStart1.x, capStart1.y, 0.f), color, Vec2(0.f, 0.f)));
-
-		Vec2 capEnd0 = boneEnd + (tangent * radius * cosf(fraction0 * 3.1415926f)) + (direction * radius * sinf(fraction0 * 3.1415926f));
-		Vec2 capEnd1 = boneEnd + (tangent * radius * cosf(fraction1 * 3.1415926f)) + (direction * radius * sinf(fraction1 * 3.1415926f));
-		verts.push_back(Vertex_PCU(Vec3(boneEnd.x, boneEnd.y, 0.f), color, Vec2(0.f, 0.f)));
-		verts.push_back(Vertex_PCU(Vec3(capEnd0.x, capEnd0.y, 0.f), color, Vec2(0.f, 0.f)));
-		verts.push_back(Vertex_PCU(Vec3(capEnd1.x, capEnd1.y, 0.f), color, Vec2(0.f, 0.f)));
+		Vec2 const& arc0 = circle[sliceIndex];
+		Vec2 const& arc1 = circle[sliceIndex + 1];
+
+		Vec2 capStart0 = boneStart + (tangent * radius * arc0.x) - (direction * radius * arc0.y);
+		Vec2 capStart1 = boneStart + (tangent * radius * arc1.x) - (direction * radius * arc1.y);
+		out[0] = Vertex_PCU(Vec3(boneStart.x, boneStart.y, 0.f), color, Vec2(0.f, 0.f));
+		out[1] = Vertex_PCU(Vec3(capStart0.x, capStart0.y, 0.f), color, Vec2(0.f, 0.f));
+		out[2] = Vertex_PCU(Vec3(capStart1.x, capStart1.y, 0.f), color, Vec2(0.f, 0.f));
+
+		Vec2 capEnd0 = boneEnd + (tangent * radius * arc0.x) + (direction * radius * arc0.y);
+		Vec2 capEnd1 = boneEnd + (tangent * radius * arc1.x) + (direction * radius * arc1.y);
+		out[3] = Vertex_PCU(Vec3(boneEnd.x, boneEnd.y, 0.f), color, Vec2(0.f, 0.f));
+		out[4] = Vertex_PCU(Vec3(capEnd0.x, capEnd0.y, 0.f), color, Vec2(0.f, 0.f));
+		out[5] = Vertex_PCU(Vec3(capEnd1.x, capEnd1.y, 0.f), color, Vec2(0.f, 0.f));
+		out += 6;
 	}
 }
 
 void AddVertsForDisc2D(std::vector<Vertex_PCU>& verts, Vec2 const& center, float radius, Rgba8 const& color)
 {
-	constexpr int numSides = 32;
-	constexpr float degreesPerSide = 360.f / numSides;
+	VertexWriter writer(verts, GetNumVertsForDisc2D());
+	AddVertsForDisc2D(writer, center, radius, color);
+}
 
-	Vec2 prevPoint = Vec2(radius, 0.f) + center;
+void AddVertsForDisc2D(VertexWriter& writer, Vec2 const& center, float radius, Rgba8 const& color)
+{
+	std::vector<Vec2> const& circle = GetUnitCirclePoints(DISC2D_NUM_SIDES);
 	Vec2 uvCenter = Vec2(0.5f, 0.5f);
 
-	for (int sideIndex = 1; sideIndex <= numSides; ++sideIndex) {
-		float angleDegrees = degreesPerSide * sideIndex;
-		Vec2 point = Vec2::MakeFromPolarDegrees(angleDegrees) * radius + center;
-		Vec2 uvPoint = Vec2::MakeFromPolarDegrees(angleDegrees) * 0.5f + uvCenter;
-
-		verts.push_back(Vertex_PCU(Vec3(center.x, center.y, 0.f), color, uvCenter));
-		verts.push_back(Vertex_PCU(Vec3(prevPoint.x, prevPoint.y, 0.f), color, uvPoint));
-		verts.push_back(Vertex_PCU(Vec3(point.x, point.y, 0.f), color, uvPoint));
+	Vertex_PCU* out = writer.Allocate(GetNumVertsForDisc2D());
+	for (int sideIndex = 1; sideIndex <= DISC2D_NUM_SIDES; ++sideIndex) {
+		Vec2 const& prevDirection = circle[sideIndex - 1];
+		Vec2 const& direction = circle[sideIndex];
+		Vec2 uvPoint = direction * 0.5f + uvCenter;
 
-		prevPoint = point;
+		out[0] = Vertex_PCU(Vec3(center.x, center.y, 0.f), color, uvCenter);
+		out[1] = Vertex_PCU(Vec3(center.x + prevDirection.x * radius, center.y + prevDirection.y * radius, 0.f), color, uvPoint);
+		out[2] = Vertex_PCU(Vec3(center.x + direction.x * radius, center.y + direction.y * radius, 0.f), color, uvPoint);
+		out += 3;
 	}
 }
 
 void AddVertsForAABB2D(std::vector<Vertex_PCU>& verts, AABB2 const& bounds, Rgba8 const& color)
 {
-	constexpr int NUM_TRIS = 2;
-	constexpr int NUM_VERTS = 3 * NUM_TRIS;
-	verts.reserve(verts.size() + NUM_VERTS);
+	VertexWriter writer(verts, GetNumVertsForAABB2D());
+	AddVertsForAABB2D(writer, bounds, color, Vec2(0.f, 0.f), Vec2(1.f, 1.f));
+}
 
+void AddVertsForAABB2D(std::vector<Vertex_PCU>& verts, AABB2 const& bounds, Rgba8 const& color, Vec2 uvAtMins, Vec2 uvAtMaxs)
+{
+	VertexWriter writer(verts, GetNumVertsForAABB2D());
+	AddVertsForAABB2D(writer, bounds, color, uvAtMins, uvAtMaxs);
+}
+
+void AddVertsForAABB2D(VertexWriter& writer, AABB2 const& bounds, Rgba8 const& color, Vec2 const& uvAtMins /*= Vec2(0.f, 0.f)*/, Vec2 const& uvAtMaxs /*= Vec2(1.f, 1.f)*/)
+{
 	Vec3 BL = Vec3(bounds.m_mins.x, bounds.m_mins.y, 0.f);
 	Vec3 BR = Vec3(bounds.m_maxs.x, bounds.m_mins.y, 0.f);
 	Vec3 TR = Vec3(bounds.m_maxs.x, bounds.m_maxs.y, 0.f);
 	Vec3 TL = Vec3(bounds.m_mins.x, bounds.m_maxs.y, 0.f);
 
-	verts.push_back(Vertex_PCU(BL, color, Vec2(0.f, 0.f)));
-	verts.push_back(Vertex_PCU(BR, color, Vec2(1.f, 0.f)));
-	verts.push_back(Vertex_PCU(TR, color, Vec2(1.f, 1.f)));
+	Vertex_PCU* out = writer.Allocate(GetNumVertsForAABB2D());
+	out[0] = Vertex_PCU(BL, color, Vec2(uvAtMins.x, uvAtMins.y));
+	out[1] = Vertex_PCU(BR, color, Vec2(uvAtMaxs.x, uvAtMins.y));
+	out[2] = Vertex_PCU(TR, color, Vec2(uvAtMaxs.x, uvAtMaxs.y));
 
-	verts.push_back(Vertex_PCU(BL, color, Vec2(0.f, 0.f)));
-	verts.push_back(Vertex_PCU(TR, color, Vec2(1.f, 1.f)));
-	verts.push_back(Vertex_PCU(TL, color, Vec2(0.f, 1.f)));
+	out[3] = Vertex_PCU(BL, color, Vec2(uvAtMins.x, uvAtMins.y));
+	out[4] = Vertex_PCU(TR, color, Vec2(uvAtMaxs.x, uvAtMaxs.y));
+	out[5] = Vertex_PCU(TL, color, Vec2(uvAtMins.x, uvAtMaxs.y));
 }
 
-void AddVertsForAABB2D(std::vector<Vertex_PCU>& verts, AABB2 const& bounds, Rgba8 const& color, Vec2 uvAtMins, Vec2 uvAtMaxs)
+void AddVertsForOBB2D(std::vector<Vertex_PCU>& verts, OBB2 const& box, Rgba8 const& color)
 {
-	constexpr int NUM_TRIS = 2;
-	constexpr int NUM_VERTS = 3 * NUM_TRIS;
-	verts.reserve(verts.size() + NUM_VERTS);
-
-	Vec3 BL = Vec3(bounds.m_mins.x, bounds.m_mins.y, 0.f); 
-	Vec3 BR = Vec3(bounds.m_maxs.x, bounds.m_mins.y, 0.f); 
-	Vec3 TR = Vec3(bounds.m_maxs.x, bounds.m_maxs.y, 0.f);
-	Vec3 TL = Vec3(bounds.m_mins.x, bounds.m_maxs.y, 0.f); 
-
-	verts.push_back(Vertex_PCU(BL, color, Vec2(uvAtMins.x, uvAtMins.y)));
-	verts.push_back(Vertex_PCU(BR, color, Vec2(uvAtMaxs.x, uvAtMins.y)));
-	verts.push_back(Vertex_PCU(TR, color, Vec2(uvAtMaxs.x, uvAtMaxs.y)));
-
-	verts.push_back(Vertex_PCU(BL, color, Vec2(uvAtMins.x, uvAtMins.y)));
-	verts.push_back(Vertex_PCU(TR, color, Vec2(uvAtMaxs.x, uvAtMaxs.y)));
-	verts.push_back(Vertex_PCU(TL, color, Vec2(uvAtMins.x, uvAtMaxs.y)));
+	VertexWriter writer(verts, GetNumVertsForOBB2D());
+	AddVertsForOBB2D(writer, box, color);
 }
 
-void AddVertsForOBB2D(std::vector<Vertex_PCU>& verts, OBB2 const& box, Rgba8 const& color)
+void AddVertsForOBB2D(VertexWriter& writer, OBB2 const& box, Rgba8 const& color)
 {
 	Vec2 right = box.m_iBasisNormal * box.m_halfDimensions.x;
 	Vec2 up = box.m_iBasisNormal.GetRotated90Degrees() * box.m_halfDimensions.y;
@@ -133,16 +272,23 @@ void AddVertsForOBB2D(std::vector<Vertex_PCU>& verts, OBB2 const& box, Rgba8 con
 	Vec2 bottomLeft = box.m_center - right - up;
 	Vec2 bottomRight = box.m_center + right - up;
 
-	verts.push_back(Vertex_PCU(Vec3(topRight.x, topRight.y, 0.f), color, Vec2(1.f, 1.f)));
-	verts.push_back(Vertex_PCU(Vec3(topLeft.x, topLeft.y, 0.f), color, Vec2(0.f, 1.f)));
-	verts.push_back(Vertex_PCU(Vec3(bottomLeft.x, bottomLeft.y, 0.f), color, Vec2(0.f, 0.f)));
+	Vertex_PCU* out = writer.Allocate(GetNumVertsForOBB2D());
+	out[0] = Vertex_PCU(Vec3(topRight.x, topRight.y, 0.f), color, Vec2(1.f, 1.f));
+	out[1] = Vertex_PCU(Vec3(topLeft.x, topLeft.y, 0.f), color, Vec2(0.f, 1.f));
+	out[2] = Vertex_PCU(Vec3(bottomLeft.x, bottomLeft.y, 0.f), color, Vec2(0.f, 0.f));
 
-	verts.push_back(Vertex_PCU(Vec3(bottomLeft.x, bottomLeft.y, 0.f), color, Vec2(0.f, 0.f)));
-	verts.push_back(Vertex_PCU(Vec3(bottomRight.x, bottomRight.y, 0.f), color, Vec2(1.f, 0.f)));
-	verts.push_back(Vertex_PCU(Vec3(topRight.x, topRight.y, 0.f), color, Vec2(1.f, 1.f)));
+	out[3] = Vertex_PCU(Vec3(bottomLeft.x, bottomLeft.y, 0.f), color, Vec2(0.f, 0.f));
+	out[4] = Vertex_PCU(Vec3(bottomRight.x, bottomRight.y, 0.f), color, Vec2(1.f, 0.f));
+	out[5] = Vertex_PCU(Vec3(topRight.x, topRight.y, 0.f), color, Vec2(1.f, 1.f));
 }
 
 void AddVertsForLineSegment2D(std::vector<Vertex_PCU>& verts, Vec2 const& start, Vec2 const& end, float thickness, Rgba8 const& color)
+{
+	VertexWriter writer(verts, GetNumVertsForLineSegment2D());
+	AddVertsForLineSegment2D(writer, start, end, thickness, color);
+}
+
+void AddVertsForLineSegment2D(VertexWriter& writer, Vec2 const& start, Vec2 const& end, float thickness, Rgba8 const& color)
 {
 	Vec2 forward = (end - start).GetNormalized();
 	Vec2 left = Vec2(-forward.y, forward.x);
@@ -154,13 +300,14 @@ void AddVertsForLineSegment2D(std::vector<Vertex_PCU>& verts, Vec2 const& start,
 	Vec2 p2 = end + offset;
 	Vec2 p3 = end - offset;
 
-	verts.push_back(Vertex_PCU(Vec3(p0.x, p0.y, 0.f), color, Vec2(0.f, 0.f)));
-	verts.push_back(Vertex_PCU(Vec3(p1.x, p1.y, 0.f), color, Vec2(1.f, 0.f)));
-	verts.push_back(Vertex_PCU(Vec3(p2.x, p2.y, 0.f), color, Vec2(1.f, 1.f)));
+	Vertex_PCU* out = writer.Allocate(GetNumVertsForLineSegment2D());
+	out[0] = Vertex_PCU(Vec3(p0.x, p0.y, 0.f), color, Vec2(0.f, 0.f));
+	out[1] = Vertex_PCU(Vec3(p1.x, p1.y, 0.f), color, Vec2(1.f, 0.f));
+	out[2] = Vertex_PCU(Vec3(p2.x, p2.y, 0.f), color, Vec2(1.f, 1.f));
 
-	verts.push_back(Vertex_PCU(Vec3(p0.x, p0.y, 0.f), color, Vec2(0.f, 0.f)));
-	verts.push_back(Vertex_PCU(Vec3(p2.x, p2.y, 0.f), color, Vec2(1.f, 1.f)));
-	verts.push_back(Vertex_PCU(Vec3(p3.x, p3.y, 0.f), color, Vec2(0.f, 1.f)));
+	out[3] = Vertex_PCU(Vec3(p0.x, p0.y, 0.f), color, Vec2(0.f, 0.f));
+	out[4] = Vertex_PCU(Vec3(p2.x, p2.y, 0.f), color, Vec2(1.f, 1.f));
+	out[5] = Vertex_PCU(Vec3(p3.x, p3.y, 0.f), color, Vec2(0.f, 1.f));
 }
 
 void AddVertsForLineSegment2D(std::vector<Vertex_PCU>& verts, LineSegment2 const& lineSegment, float thickness, Rgba8 const& color)
@@ -200,13 +347,20 @@ void AddVertsForArrow2D(std::vector<Vertex_PCU>& verts, Vec2 tailPos, Vec2 tipPo
 
 void AddVertsForQuad3D(std::vector<Vertex_PCU>& verts, const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topRight, const Vec3& topLeft, const Rgba8& color, const AABB2& UVs)
 {
-		verts.push_back(Vertex_PCU(bottomLeft, color, Vec2(UVs.m_mins.x, UVs.m_mins.y))); // Bottom left
-		verts.push_back(Vertex_PCU(bottomRight, color, Vec2(UVs.m_maxs.x, UVs.m_mins.y))); // Bottom right
-		verts.push_back(Vertex_PCU(topRight, color, Vec2(UVs.m_maxs.x, UVs.m_maxs.y))); // Top right
-	
-		verts.push_back(Vertex_PCU(bottomLeft, color, Vec2(UVs.m_mins.x, UVs.m_mins.y))); // Bottom left
-		verts.push_back(Vertex_PCU(topRight, color, Vec2(UVs.m_maxs.x, UVs.m_maxs.y))); // Top right
-		verts.push_back(Vertex_PCU(topLeft, color, Vec2(UVs.m_mins.x, UVs.m_maxs.y))); // Top left
+	VertexWriter writer(verts, GetNumVertsForQuad3D());
+	AddVertsForQuad3D(writer, bottomLeft, bottomRight, topRight, topLeft, color, UVs);
+}
+
+void AddVertsForQuad3D(VertexWriter& writer, const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topRight, const Vec3& topLeft, const Rgba8& color /*= Rgba8::WHITE*/, const AABB2& UVs /*= AABB2::ZERO_TO_ONE*/)
+{
+	Vertex_PCU* out = writer.Allocate(GetNumVertsForQuad3D());
+	out[0] = Vertex_PCU(bottomLeft, color, Vec2(UVs.m_mins.x, UVs.m_mins.y)); // Bottom left
+	out[1] = Vertex_PCU(bottomRight, color, Vec2(UVs.m_maxs.x, UVs.m_mins.y)); // Bottom right
+	out[2] = Vertex_PCU(topRight, color, Vec2(UVs.m_maxs.x, UVs.m_maxs.y)); // Top right
+
+	out[3] = Vertex_PCU(bottomLeft, color, Vec2(UVs.m_mins.x, UVs.m_mins.y)); // Bottom left
+	out[4] = Vertex_PCU(topRight, color, Vec2(UVs.m_maxs.x, UVs.m_maxs.y)); // Top right
+	out[5] = Vertex_PCU(topLeft, color, Vec2(UVs.m_mins.x, UVs.m_maxs.y)); // Top left
 }
 
 void AddVertsForQuad3DInverse(std::vector<Vertex_PCU>& verts, const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topRight, const Vec3& topLeft, const Rgba8& color, const AABB2& UVs)
@@ -248,6 +402,12 @@ void AddVertsForQuad3D(std::vector<Vertex_PCUTBN>& vertexes, std::vector<unsigne
 }
 
 void AddVertsForOBB3D(std::vector<Vertex_PCU>& verts, OBB3 obb, const Rgba8& color /*= Rgba8::WHITE*/, const AABB2& UVs /*= AABB2::ZERO_TO_ONE*/)
+{
+	VertexWriter writer(verts, GetNumVertsForOBB3D());
+	AddVertsForOBB3D(writer, obb, color, UVs);
+}
+
+void AddVertsForOBB3D(VertexWriter& writer, OBB3 const& obb, const Rgba8& color /*= Rgba8::WHITE*/, const AABB2& UVs /*= AABB2::ZERO_TO_ONE*/)
 {
 	Vec3 iBasis = obb.iBasis.GetNormalized() * obb.halfDimensions.x;
 	Vec3 jBasis = obb.jBasis.GetNormalized() * obb.halfDimensions.y;
@@ -265,12 +425,12 @@ void AddVertsForOBB3D(std::vector<Vertex_PCU>& verts, OBB3 obb, const Rgba8& col
 	corners[6] = obb.center - iBasis - jBasis - kBasis; // bottomLeftFront
 	corners[7] = obb.center + iBasis - jBasis - kBasis; // bottomRightFront
 
-	AddVertsForQuad3D(verts, corners[2], corners[3], corners[0], corners[1], color, UVs);
-	AddVertsForQuad3D(verts, corners[5], corners[4], corners[7], corners[6], color, UVs);
-	AddVertsForQuad3D(verts, corners[4], corners[5], corners[1], corners[0], color, UVs);
-	AddVertsForQuad3D(verts, corners[6], corners[7], corners[3], corners[2], color, UVs);
-	AddVertsForQuad3D(verts, corners[7], corners[4], corners[0], corners[3], color, UVs);
-	AddVertsForQuad3D(verts, corners[5], corners[6], corners[2], corners[1], color, UVs);
+	AddVertsForQuad3D(writer, corners[2], corners[3], corners[0], corners[1], color, UVs);
+	AddVertsForQuad3D(writer, corners[5], corners[4], corners[7], corners[6], color, UVs);
+	AddVertsForQuad3D(writer, corners[4], corners[5], corners[1], corners[0], color, UVs);
+	AddVertsForQuad3D(writer, corners[6], corners[7], corners[3], corners[2], color, UVs);
+	AddVertsForQuad3D(writer, corners[7], corners[4], corners[0], corners[3], color, UVs);
+	AddVertsForQuad3D(writer, corners[5], corners[6], corners[2], corners[1], color, UVs);
 }
 
 void AddVertsForRoundedQuad3D(std::vector<Vertex_PCUTBN>& vertexes, const Vec3& topLeft, const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topRight, const Rgba8& color /*= Rgba8::WHITE*/, const AABB2& UVs /*= AABB2::ZERO_TO_ONE*/)
@@ -364,6 +524,12 @@ void AddVertsForLineSegment3D(std::vector<Vertex_PCUTBN>& vertexes, std::vector<
 }
 
 void AddVertsForAABB3D(std::vector<Vertex_PCU>& verts, const AABB3& bounds, const Rgba8& color /*= Rgba::WHITE*/, const AABB2& UVs /*= AABB2::ZERO_TO_ONE*/)
+{
+	VertexWriter writer(verts, GetNumVertsForAABB3D());
+	AddVertsForAABB3D(writer, bounds, color, UVs);
+}
+
+void AddVertsForAABB3D(VertexWriter& writer, const AABB3& bounds, const Rgba8& color /*= Rgba8::WHITE*/, const AABB2& UVs /*= AABB2::ZERO_TO_ONE*/)
 {
 	Vec3 topRightBack(bounds.m_maxs.x, bounds.m_maxs.y, bounds.m_maxs.z);
 	Vec3 topLeftBack(bounds.m_mins.x, bounds.m_maxs.y, bounds.m_maxs.z);
@@ -374,43 +540,29 @@ void AddVertsForAABB3D(std::vector<Vertex_PCU>& verts, const AABB3& bounds, cons
 	Vec3 bottomLeftFront(bounds.m_mins.x, bounds.m_mins.y, bounds.m_mins.z);
 	Vec3 bottomRightFront(bounds.m_maxs.x, bounds.m_mins.y, bounds.m_mins.z);
 
-	AddVertsForQuad3D(verts, bottomLeftBack, bottomRightBack, topRightBack, topLeftBack, color, UVs);//z
-	AddVertsForQuad3D(verts, topLeftFront, topRightFront, bottomRightFront, bottomLeftFront,color, UVs);//-z
-	AddVertsForQuad3D(verts, topRightFront, topLeftFront, topLeftBack, topRightBack, color, UVs);//y
-	AddVertsForQuad3D(verts, bottomLeftFront, bottomRightFront, bottomRightBack, bottomLeftBack, color, UVs);//-y
-	AddVertsForQuad3D(verts, bottomRightFront, topRightFront, topRightBack, bottomRightBack, color, UVs);//x
-	AddVertsForQuad3D(verts, topLeftFront, bottomLeftFront, bottomLeftBack, topLeftBack, color, UVs);//-x
+	AddVertsForQuad3D(writer, bottomLeftBack, bottomRightBack, topRightBack, topLeftBack, color, UVs);//z
+	AddVertsForQuad3D(writer, topLeftFront, topRightFront, bottomRightFront, bottomLeftFront,color, UVs);//-z
+	AddVertsForQuad3D(writer, topRightFront, topLeftFront, topLeftBack, topRightBack, color, UVs);//y
+	AddVertsForQuad3D(writer, bottomLeftFront, bottomRightFront, bottomRightBack, bottomLeftBack, color, UVs);//-y
+	AddVertsForQuad3D(writer, bottomRightFront, topRightFront, topRightBack, bottomRightBack, color, UVs);//x
+	AddVertsForQuad3D(writer, topLeftFront, bottomLeftFront, bottomLeftBack, topLeftBack, color, UVs);//-x
 }
 
 void AddVertsForSphere3D(std::vector<Vertex_PCU>& verts, const Vec3& center, float radius, const Rgba8& color /*= Rgba8::WHITE*/, const AABB2& UVs /*= AABB2::ZERO_TO_ONE*/, int numLatitudesSlices /*= 8*/)
+{
+	AddVertsForSphere3D(verts, center, radius, color, UVs, numLatitudesSlices, numLatitudesSlices);
+}
+
+void AddVertsForSphere3D(std::vector<Vertex_PCU>& verts, const Vec3& center, float radius, const Rgba8& color, const AABB2& UVs, int numSlices, int numStacks)
+{
+	VertexWriter writer(verts, GetNumVertsForSphere3D(numSlices, numStacks));
+	AddVertsForSphere3D(writer, center, radius, color, UVs, numSlices, numStacks);
+}
+
+void AddVertsForSphere3D(VertexWriter& writer, const Vec3& center, float radius, const Rgba8& color /*= Rgba8::WHITE*/, const AABB2& UVs /*= AABB2::ZERO_TO_ONE*/, int numSlices /*= 8*/, int numStacks /*= 8*/)
 {
 	UNUSED(UVs);
-	for (int latIndex = 0; latIndex < numLatitudesSlices; ++latIndex) {
-		for (int longIndex = 0; longIndex < numLatitudesSlices; ++longIndex) {
-			float latStart = PI * latIndex / numLatitudesSlices - PI / 2;
-			float latEnd = PI * (latIndex + 1) / numLatitudesSlices - PI / 2;
-			float longStart = 2 * PI * longIndex / numLatitudesSlices;
-			float longEnd = 2 * PI * (longIndex + 1) / numLatitudesSlices;
-
-			Vec3 v1 = Vec3::MakeFromPolarRadians(latStart, longStart, radius) + center;
-			Vec3 v2 = Vec3::MakeFromPolarRadians(latStart, longEnd, radius) + center;
-			Vec3 v3 = Vec3::MakeFromPolarRadians(latEnd, longStart, radius) + center;
-			Vec3 v4 = Vec3::MakeFromPolarRadians(latEnd, longEnd, radius) + center;
-
-			Vec2 uv1 = Vec2(static_cast<float>(longIndex) / numLatitudesSlices, static_cast<float>(latIndex) / numLatitudesSlices);
-			Vec2 uv2 = Vec2(static_cast<float>(longIndex + 1) / numLatitudesSlices, static_cast<float>(latIndex) / numLatitudesSlices);
-			Vec2 uv3 = Vec2(static_cast<float>(longIndex) / numLatitudesSlices, static_cast<float>(latIndex + 1) / numLatitudesSlices);
-			Vec2 uv4 = Vec2(static_cast<float>(longIndex + 1) / numLatitudesSlices, static_cast<float>(latIndex + 1) / numLatitudesSlices);
-
-			verts.push_back(Vertex_PCU(v2, color, uv2));
-			verts.push_back(Vertex_PCU(v4, color, uv4));
-			verts.push_back(Vertex_PCU(v3, color, uv3));
-
-			verts.push_back(Vertex_PCU(v2, color, uv2));
-			verts.push_back(Vertex_PCU(v3, color, uv3));
-			verts.push_back(Vertex_PCU(v1, color, uv1));
-		}
-	}
+	WriteVertsFromTemplate(writer.Allocate(GetNumVertsForSphere3D(numSlices, numStacks)), GetUnitSphereTemplate(numSlices, numStacks), center, radius, color);
 }
 
 void TransformVertexArray3D(std::vector<Vertex_PCU>& verts, const Mat44& transform)
@@ -448,15 +600,21 @@ void AddVertsForCylinder3D(std::vector<Vertex_PCU>& verts, const Vec3& start, co
 	Vec3 rightVector = CrossProduct3D(arbitraryVector, upVector).GetNormalized();
 	Vec3 forwardVector = CrossProduct3D(rightVector, upVector).GetNormalized();
 
+	// Sides and caps share the same numSlices+1 rim directions
+	std::vector<Vec2> const& rim = GetUnitCirclePoints(numSlices);
+	verts.reserve(verts.size() + GetNumVertsForCylinder3D(numSlices));
+
 	// Generate sides
 	for (int sliceIndex = 0; sliceIndex < numSlices; ++sliceIndex) {
 		float thetaStart = (static_cast<float>(sliceIndex) / numSlices) * 2.0f * PI;
 		float thetaEnd = (static_cast<float>(sliceIndex + 1) / numSlices) * 2.0f * PI;
 
-		Vec3 quadStartLower = start + (cosf(thetaStart) * rightVector + sinf(thetaStart) * forwardVector) * radius;
-		Vec3 quadEndLower = start + (cosf(thetaEnd) * rightVector + sinf(thetaEnd) * forwardVector) * radius;
-		Vec3 quadStartUpper = end + (cosf(thetaStart) * rightVector + sinf(thetaStart) * forwardVector) * radius;
-		Vec3 quadEndUpper = end + (cosf(thetaEnd) * rightVector + sinf(thetaEnd) * forwardVector) * radius;
+		Vec3 rimOffsetStart = (rim[sliceIndex].x * rightVector + rim[sliceIndex].y * forwardVector) * radius;
+		Vec3 rimOffsetEnd = (rim[sliceIndex + 1].x * rightVector + rim[sliceIndex + 1].y * forwardVector) * radius;
+		Vec3 quadStartLower = start + rimOffsetStart;
+		Vec3 quadEndLower = start + rimOffsetEnd;
+		Vec3 quadStartUpper = end + rimOffsetStart;
+		Vec3 quadEndUpper = end + rimOffsetEnd;
 
 		float uStart = UVs.m_maxs.x - (thetaStart / (2.0f * PI)) * (UVs.m_maxs.x - UVs.m_mins.x);
 		float uEnd = UVs.m_maxs.x - (thetaEnd / (2.0f * PI)) * (UVs.m_maxs.x - UVs.m_mins.x);
@@ -479,14 +637,14 @@ void AddVertsForCylinder3D(std::vector<Vertex_PCU>& verts, const Vec3& start, co
 
 	// Generate caps
 	for (int sliceIndex = 0; sliceIndex < numSlices; ++sliceIndex) {
-		float thetaStart = (static_cast<float>(sliceIndex) / numSlices) * 2.0f * PI;
-		float thetaEnd = (static_cast<float>(sliceIndex + 1) / numSlices) * 2.0f * PI;
+		Vec2 const& rimStart = rim[sliceIndex];
+		Vec2 const& rimEnd = rim[sliceIndex + 1];
 
-		Vec3 pointStart = (cosf(thetaStart) * rightVector + sinf(thetaStart) * forwardVector) * radius;
-		Vec3 pointEnd = (cosf(thetaEnd) * rightVector + sinf(thetaEnd) * forwardVector) * radius;
+		Vec3 pointStart = (rimStart.x * rightVector + rimStart.y * forwardVector) * radius;
+		Vec3 pointEnd = (rimEnd.x * rightVector + rimEnd.y * forwardVector) * radius;
 
-		Vec2 uvStart = Vec2(cosf(thetaStart), sinf(thetaStart)) * capUVRadius + capCenterUV;
-		Vec2 uvEnd = Vec2(cosf(thetaEnd), sinf(thetaEnd)) * capUVRadius + capCenterUV;
+		Vec2 uvStart = rimStart * capUVRadius + capCenterUV;
+		Vec2 uvEnd = rimEnd * capUVRadius + capCenterUV;
 
 		// Bottom cap with adjusted UVs
 		verts.push_back(Vertex_PCU(start, color, capCenterUV));
@@ -515,12 +673,14 @@ void AddVertsForCone3D(std::vector<Vertex_PCU>& verts, const Vec3& start, const
 	Vec2 tipUV = Vec2(0.5f, 1.0f);
 	Vec2 baseCenterUV = Vec2(0.5f, 0.5f);
 
+	std::vector<Vec2> const& rim = GetUnitCirclePoints(numSlices);
+	verts.reserve(verts.size() + GetNumVertsForCone3D(numSlices));
 	for (int sliceIndex = 0; sliceIndex < numSlices; ++sliceIndex) {
 		float startAngle = (static_cast<float>(sliceIndex) / numSlices) * 2.0f * PI;
 		float endAngle = (static_cast<float>(sliceIndex + 1) / numSlices) * 2.0f * PI;
 
-		Vec3 startVertex = start + (cosf(startAngle) * rightVector + sinf(startAngle) * forwardVector) * radius;
-		Vec3 endVertex = start + (cosf(endAngle) * rightVector + sinf(endAngle) * forwardVector) * radius;
+		Vec3 startVertex = start + (rim[sliceIndex].x * rightVector + rim[sliceIndex].y * forwardVector) * radius;
+		Vec3 endVertex = start + (rim[sliceIndex + 1].x * rightVector + rim[sliceIndex + 1].y * forwardVector) * radius;
 
 		// Base triangle
 		verts.push_back(Vertex_PCU(startVertex, color, baseCenterUV));
@@ -534,4 +694,611 @@ void AddVertsForCone3D(std::vector<Vertex_PCU>& verts, const Vec3& start, const
 	}
 }
 
+//----------------------------------------------------------------------------------------------
+// Indexed Vertex_PCU builders. Corners shared by neighbouring triangles are written once and referenced through
+// the index list; vertices are only duplicated where UVs differ (face edges, the u=0/u=1 seam).
+//
+void AddVertsForQuad3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topRight, const Vec3& topLeft, const Rgba8& color /*= Rgba8::WHITE*/, const AABB2& UVs /*= AABB2::ZERO_TO_ONE*/)
+{
+	unsigned int currentVertexCount = static_cast<unsigned int>(verts.size());
+
+	verts.push_back(Vertex_PCU(bottomLeft, color, Vec2(UVs.m_mins.x, UVs.m_mins.y)));
+	verts.push_back(Vertex_PCU(bottomRight, color, Vec2(UVs.m_maxs.x, UVs.m_mins.y)));
+	verts.push_back(Vertex_PCU(topRight, color, Vec2(UVs.m_maxs.x, UVs.m_maxs.y)));
+	verts.push_back(Vertex_PCU(topLeft, color, Vec2(UVs.m_mins.x, UVs.m_maxs.y)));
+
+	indexes.push_back(currentVertexCount + 0); // bottomLeft
+	indexes.push_back(currentVertexCount + 1); // bottomRight
+	indexes.push_back(currentVertexCount + 2); // topRight
+
+	indexes.push_back(currentVertexCount + 0); // bottomLeft
+	indexes.push_back(currentVertexCount + 2); // topRight
+	indexes.push_back(currentVertexCount + 3); // topLeft
+}
+
+void AddVertsForAABB3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, const AABB3& bounds, const Rgba8& color /*= Rgba8::WHITE*/, const AABB2& UVs /*= AABB2::ZERO_TO_ONE*/)
+{
+	Vec3 topRightBack(bounds.m_maxs.x, bounds.m_maxs.y, bounds.m_maxs.z);
+	Vec3 topLeftBack(bounds.m_mins.x, bounds.m_maxs.y, bounds.m_maxs.z);
+	Vec3 bottomLeftBack(bounds.m_mins.x, bounds.m_mins.y, bounds.m_maxs.z);
+	Vec3 bottomRightBack(bounds.m_maxs.x, bounds.m_mins.y, bounds.m_maxs.z);
+	Vec3 topRightFront(bounds.m_maxs.x, bounds.m_maxs.y, bounds.m_mins.z);
+	Vec3 topLeftFront(bounds.m_mins.x, bounds.m_maxs.y, bounds.m_mins.z);
+	Vec3 bottomLeftFront(bounds.m_mins.x, bounds.m_mins.y, bounds.m_mins.z);
+	Vec3 bottomRightFront(bounds.m_maxs.x, bounds.m_mins.y, bounds.m_mins.z);
+
+	verts.reserve(verts.size() + GetNumIndexedVertsForAABB3D());
+	indexes.reserve(indexes.size() + GetNumIndexesForAABB3D());
+	AddVertsForQuad3D(verts, indexes, bottomLeftBack, bottomRightBack, topRightBack, topLeftBack, color, UVs);//z
+	AddVertsForQuad3D(verts, indexes, topLeftFront, topRightFront, bottomRightFront, bottomLeftFront, color, UVs);//-z
+	AddVertsForQuad3D(verts, indexes, topRightFront, topLeftFront, topLeftBack, topRightBack, color, UVs);//y
+	AddVertsForQuad3D(verts, indexes, bottomLeftFront, bottomRightFront, bottomRightBack, bottomLeftBack, color, UVs);//-y
+	AddVertsForQuad3D(verts, indexes, bottomRightFront, topRightFront, topRightBack, bottomRightBack, color, UVs);//x
+	AddVertsForQuad3D(verts, indexes, topLeftFront, bottomLeftFront, bottomLeftBack, topLeftBack, color, UVs);//-x
+}
+
+void AddVertsForOBB3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, OBB3 const& obb, const Rgba8& color /*= Rgba8::WHITE*/, const AABB2& UVs /*= AABB2::ZERO_TO_ONE*/)
+{
+	Vec3 iBasis = obb.iBasis.GetNormalized() * obb.halfDimensions.x;
+	Vec3 jBasis = obb.jBasis.GetNormalized() * obb.halfDimensions.y;
+	Vec3 kBasis = CrossProduct3D(obb.iBasis, obb.jBasis).GetNormalized() * obb.halfDimensions.z;
+
+	Vec3 corners[8];
+	corners[0] = obb.center + iBasis + jBasis + kBasis; // topRightBack
+	corners[1] = obb.center - iBasis + jBasis + kBasis; // topLeftBack
+	corners[2] = obb.center - iBasis - jBasis + kBasis; // bottomLeftBack
+	corners[3] = obb.center + iBasis - jBasis + kBasis; // bottomRightBack
+	corners[4] = obb.center + iBasis + jBasis - kBasis; // topRightFront
+	corners[5] = obb.center - iBasis + jBasis - kBasis; // topLeftFront
+	corners[6] = obb.center - iBasis - jBasis - kBasis; // bottomLeftFront
+	corners[7] = obb.center + iBasis - jBasis - kBasis; // bottomRightFront
+
+	verts.reserve(verts.size() + GetNumIndexedVertsForAABB3D());
+	indexes.reserve(indexes.size() + GetNumIndexesForAABB3D());
+	AddVertsForQuad3D(verts, indexes, corners[2], corners[3], corners[0], corners[1], color, UVs);
+	AddVertsForQuad3D(verts, indexes, corners[5], corners[4], corners[7], corners[6], color, UVs);
+	AddVertsForQuad3D(verts, indexes, corners[4], corners[5], corners[1], corners[0], color, UVs);
+	AddVertsForQuad3D(verts, indexes, corners[6], corners[7], corners[3], corners[2], color, UVs);
+	AddVertsForQuad3D(verts, indexes, corners[7], corners[4], corners[0], corners[3], color, UVs);
+	AddVertsForQuad3D(verts, indexes, corners[5], corners[6], corners[2], corners[1], color, UVs);
+}
+
+void AddVertsForSphere3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, const Vec3& center, float radius, const Rgba8& color /*= Rgba8::WHITE*/, const AABB2& UVs /*= AABB2::ZERO_TO_ONE*/, int numSlices /*= 8*/, int numStacks /*= 8*/)
+{
+	UNUSED(UVs);
+	std::vector<Vec2> const& meridians = GetUnitCirclePoints(numSlices);
+	unsigned int firstVertex = static_cast<unsigned int>(verts.size());
+	unsigned int vertsPerRing = static_cast<unsigned int>(numSlices + 1);
+
+	// (numStacks+1) rings of (numSlices+1) vertices; the last column repeats the first with u = 1
+	verts.reserve(verts.size() + GetNumIndexedVertsForSphere3D(numSlices, numStacks));
+	for (int stackIndex = 0; stackIndex <= numStacks; ++stackIndex)
+	{
+		float ringSine;
+		float ringCosine;
+		FastSinCosDegrees(180.f * stackIndex / numStacks - 90.f, ringSine, ringCosine);
+		float v = static_cast<float>(stackIndex) / numStacks;
+		for (int sliceIndex = 0; sliceIndex <= numSlices; ++sliceIndex)
+		{
+			Vec3 unitPoint(ringCosine * meridians[sliceIndex].x, ringCosine * meridians[sliceIndex].y, ringSine);
+			verts.push_back(Vertex_PCU(center + unitPoint * radius, color, Vec2(static_cast<float>(sliceIndex) / numSlices, v)));
+		}
+	}
+
+	// Same winding as the triangle-list version, minus the zero-area triangles touching the poles
+	indexes.reserve(indexes.size() + GetNumIndexesForSphere3D(numSlices, numStacks));
+	for (int stackIndex = 0; stackIndex < numStacks; ++stackIndex)
+	{
+		for (int sliceIndex = 0; sliceIndex < numSlices; ++sliceIndex)
+		{
+			unsigned int v1 = firstVertex + stackIndex * vertsPerRing + sliceIndex;
+			unsigned int v2 = v1 + 1;
+			unsigned int v3 = v1 + vertsPerRing;
+			unsigned int v4 = v3 + 1;
+
+			if (stackIndex != numStacks - 1)
+			{
+				indexes.push_back(v2);
+				indexes.push_back(v4);
+				indexes.push_back(v3);
+			}
+			if (stackIndex != 0)
+			{
+				indexes.push_back(v2);
+				indexes.push_back(v3);
+				indexes.push_back(v1);
+			}
+		}
+	}
+}
+
+void AddVertsForCylinder3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, const Vec3& start, const Vec3& end, float radius, const Rgba8& color /*= Rgba8::WHITE*/, const AABB2& UVs /*= AABB2::ZERO_TO_ONE*/, int numSlices /*= 8*/)
+{
+	Vec3 cylinderAxis = end - start;
+	Vec3 upVector = cylinderAxis.GetNormalized();
+
+	Vec3 arbitraryVector = (fabsf(upVector.x) < 0.99f) ? Vec3(1, 0, 0) : Vec3(0, 1, 0);
+	Vec3 rightVector = CrossProduct3D(arbitraryVector, upVector).GetNormalized();
+	Vec3 forwardVector = CrossProduct3D(rightVector, upVector).GetNormalized();
+
+	std::vector<Vec2> const& rim = GetUnitCirclePoints(numSlices);
+	unsigned int firstVertex = static_cast<unsigned int>(verts.size());
+	verts.reserve(verts.size() + GetNumIndexedVertsForCylinder3D(numSlices));
+	indexes.reserve(indexes.size() + GetNumIndexesForCylinder3D(numSlices));
+
+	// Sides: a lower and an upper rim, each with a seam vertex so u can run from max to min
+	for (int rimIndex = 0; rimIndex <= numSlices; ++rimIndex)
+	{
+		Vec3 rimOffset = (rim[rimIndex].x * rightVector + rim[rimIndex].y * forwardVector) * radius;
+		float u = UVs.m_maxs.x - (static_cast<float>(rimIndex) / numSlices) * (UVs.m_maxs.x - UVs.m_mins.x);
+		verts.push_back(Vertex_PCU(start + rimOffset, color, Vec2(u, UVs.m_mins.y)));
+		verts.push_back(Vertex_PCU(end + rimOffset, color, Vec2(u, UVs.m_maxs.y)));
+	}
+	for (unsigned int sliceIndex = 0; sliceIndex < static_cast<unsigned int>(numSlices); ++sliceIndex)
+	{
+		unsigned int startLower = firstVertex + 2 * sliceIndex;
+		unsigned int startUpper = startLower + 1;
+		unsigned int endLower = startLower + 2;
+		unsigned int endUpper = startLower + 3;
+
+		indexes.push_back(endUpper);
+		indexes.push_back(endLower);
+		indexes.push_back(startUpper);
+
+		indexes.push_back(startUpper);
+		indexes.push_back(endLower);
+		indexes.push_back(startLower);
+	}
+
+	// Caps: a center vertex plus a rim each, with the same UV mapping as the triangle-list version
+	Vec2 capCenterUV = 0.5f * (UVs.m_mins + UVs.m_maxs);
+	float capUVRadius = 0.5f * (UVs.m_maxs.x - UVs.m_mins.x);
+	unsigned int bottomCenter = static_cast<unsigned int>(verts.size());
+	verts.push_back(Vertex_PCU(start, color, capCenterUV));
+	for (int rimIndex = 0; rimIndex <= numSlices; ++rimIndex)
+	{
+		Vec3 rimOffset = (rim[rimIndex].x * rightVector + rim[rimIndex].y * forwardVector) * radius;
+		verts.push_back(Vertex_PCU(start + rimOffset, color, rim[rimIndex] * capUVRadius + capCenterUV));
+	}
+	unsigned int topCenter = static_cast<unsigned int>(verts.size());
+	verts.push_back(Vertex_PCU(end, color, Vec2(0.5f, 0.5f)));
+	for (int rimIndex = 0; rimIndex <= numSlices; ++rimIndex)
+	{
+		Vec3 rimOffset = (rim[rimIndex].x * rightVector + rim[rimIndex].y * forwardVector) * radius;
+		Vec2 uv = rim[rimIndex] * capUVRadius + capCenterUV;
+		verts.push_back(Vertex_PCU(end + rimOffset, color, Vec2(uv.x, 1.0f - uv.y)));
+	}
+	for (unsigned int sliceIndex = 0; sliceIndex < static_cast<unsigned int>(numSlices); ++sliceIndex)
+	{
+		indexes.push_back(bottomCenter);
+		indexes.push_back(bottomCenter + 1 + sliceIndex);
+		indexes.push_back(bottomCenter + 2 + sliceIndex);
+
+		indexes.push_back(topCenter + 2 + sliceIndex);
+		indexes.push_back(topCenter + 1 + sliceIndex);
+		indexes.push_back(topCenter);
+	}
+}
+
+void AddVertsForCone3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, const Vec3& start, const Vec3& end, float radius, const Rgba8& color /*= Rgba8::WHITE*/, const AABB2& UVs /*= AABB2::ZERO_TO_ONE*/, int numSlices /*= 8*/)
+{
+	UNUSED(UVs);
+	Vec3 coneAxis = end - start;
+
+	Vec3 upVector(0, 1, 0);
+	if (fabsf(DotProduct3D(upVector, coneAxis)) > 0.999f) {
+		upVector = Vec3(0, 0, 1);
+	}
+	Vec3 rightVector = CrossProduct3D(upVector, coneAxis).GetNormalized();
+	Vec3 forwardVector = CrossProduct3D(coneAxis, rightVector).GetNormalized();
+
+	Vec2 tipUV = Vec2(0.5f, 1.0f);
+	Vec2 baseCenterUV = Vec2(0.5f, 0.5f);
+
+	std::vector<Vec2> const& rim = GetUnitCirclePoints(numSlices);
+	unsigned int baseCenter = static_cast<unsigned int>(verts.size());
+	unsigned int tip = baseCenter + 1;
+	verts.reserve(verts.size() + GetNumIndexedVertsForCone3D(numSlices));
+	indexes.reserve(indexes.size() + GetNumIndexesForCone3D(numSlices));
+	verts.push_back(Vertex_PCU(start, color, baseCenterUV));
+	verts.push_back(Vertex_PCU(end, color, tipUV));
+
+	// Base and side rims differ only in UV; the base rim wraps around instead of carrying a seam vertex
+	unsigned int firstBaseRim = static_cast<unsigned int>(verts.size());
+	for (int rimIndex = 0; rimIndex < numSlices; ++rimIndex)
+	{
+		verts.push_back(Vertex_PCU(start + (rim[rimIndex].x * rightVector + rim[rimIndex].y * forwardVector) * radius, color, baseCenterUV));
+	}
+	unsigned int firstSideRim = static_cast<unsigned int>(verts.size());
+	for (int rimIndex = 0; rimIndex <= numSlices; ++rimIndex)
+	{
+		Vec3 rimPoint = start + (rim[rimIndex].x * rightVector + rim[rimIndex].y * forwardVector) * radius;
+		verts.push_back(Vertex_PCU(rimPoint, color, Vec2(static_cast<float>(rimIndex) / numSlices, 0.0f)));
+	}
+
+	for (unsigned int sliceIndex = 0; sliceIndex < static_cast<unsigned int>(numSlices); ++sliceIndex)
+	{
+		unsigned int nextSliceIndex = (sliceIndex + 1) % static_cast<unsigned int>(numSlices);
+
+		// Base triangle
+		indexes.push_back(firstBaseRim + sliceIndex);
+		indexes.push_back(baseCenter);
+		indexes.push_back(firstBaseRim + nextSliceIndex);
+
+		// Side triangle
+		indexes.push_back(firstSideRim + sliceIndex + 1);
+		indexes.push_back(tip);
+		indexes.push_back(firstSideRim + sliceIndex);
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+// Spline meshes: one batch of samples (SIMD in CatmullRomSpline3D), then one ribbon pair or tube ring per sample
+//
+static void SampleSplineForMesh(CatmullRomSpline3D const& spline, int samplesPerSection, std::vector<Vec3>& out_positions, std::vector<Vec3>& out_tangents, std::vector<float>& out_fractionsAlong)
+{
+	int numSamples = spline.GetNumUniformSamples(samplesPerSection);
+	out_positions.resize(numSamples);
+	out_tangents.resize(numSamples);
+	out_fractionsAlong.resize(numSamples);
+	if (numSamples == 0)
+	{
+		return;
+	}
+	spline.EvaluateUniformSamples(samplesPerSection, out_positions.data(), out_tangents.data());
+
+	float lengthSoFar = 0.f;
+	out_fractionsAlong[0] = 0.f;
+	for (int sampleIndex = 1; sampleIndex < numSamples; ++sampleIndex)
+	{
+		lengthSoFar += GetDistance3D(out_positions[sampleIndex], out_positions[sampleIndex - 1]);
+		out_fractionsAlong[sampleIndex] = lengthSoFar;
+	}
+	float inverseLength = (lengthSoFar > 0.f) ? 1.f / lengthSoFar : 0.f;
+
+	// Catmull-Rom velocity is zero at both ends, and rounding leaves a tiny vector pointing anywhere; wherever the
+	// velocity is negligible next to the chord through the neighbouring samples, the chord gives the direction
+	Vec3 lastTangent(1.f, 0.f, 0.f);
+	for (int sampleIndex = 0; sampleIndex < numSamples; ++sampleIndex)
+	{
+		out_fractionsAlong[sampleIndex] *= inverseLength;
+		int previousIndex = (sampleIndex > 0) ? sampleIndex - 1 : 0;
+		int nextIndex = (sampleIndex < numSamples - 1) ? sampleIndex + 1 : numSamples - 1;
+		Vec3 chord = out_positions[nextIndex] - out_positions[previousIndex];
+		float chordSpeed = chord.GetLength() * static_cast<float>(samplesPerSection) / static_cast<float>(nextIndex - previousIndex);
+
+		Vec3 tangent = out_tangents[sampleIndex];
+		if (tangent.GetLength() <= 0.001f * chordSpeed)
+		{
+			tangent = chord;
+		}
+		out_tangents[sampleIndex] = (tangent.GetLengthSquared() > 0.f) ? tangent.GetNormalized() : lastTangent;
+		lastTangent = out_tangents[sampleIndex];
+	}
+}
+
+// Same quad winding as the cylinder sides: "lower"/"upper" are consecutive samples, "start"/"end" neighbouring columns
+static void AddIndexesForSplineQuad(std::vector<unsigned int>& indexes, unsigned int startLower, unsigned int endLower, unsigned int startUpper, unsigned int endUpper)
+{
+	indexes.push_back(endUpper);
+	indexes.push_back(endLower);
+	indexes.push_back(startUpper);
+
+	indexes.push_back(startUpper);
+	indexes.push_back(endLower);
+	indexes.push_back(startLower);
+}
+
+static Vec3 GetAnyPerpendicular(Vec3 const& unitVector)
+{
+	Vec3 arbitraryVector = (fabsf(unitVector.x) < 0.99f) ? Vec3(1, 0, 0) : Vec3(0, 1, 0);
+	return CrossProduct3D(arbitraryVector, unitVector).GetNormalized();
+}
+
+void AddVertsForRibbon3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, CatmullRomSpline3D const& spline, float halfWidth, Vec3 const& ribbonNormal, const Rgba8& color /*= Rgba8::WHITE*/, const AABB2& UVs /*= AABB2::ZERO_TO_ONE*/, int samplesPerSection /*= 16*/)
+{
+	std::vector<Vec3> positions;
+	std::vector<Vec3> tangents;
+	std::vector<float> fractionsAlong;
+	SampleSplineForMesh(spline, samplesPerSection, positions, tangents, fractionsAlong);
+	int numSamples = static_cast<int>(positions.size());
+	if (numSamples < 2)
+	{
+		return;
+	}
+
+	unsigned int firstVertex = static_cast<unsigned int>(verts.size());
+	verts.reserve(verts.size() + GetNumIndexedVertsForRibbon3D(numSamples));
+	indexes.reserve(indexes.size() + GetNumIndexesForRibbon3D(numSamples));
+
+	// side = ribbonNormal x tangent makes (tangent x side) = ribbonNormal, the front face; where the curve runs along
+	// ribbonNormal the cross product vanishes and the previous side is kept
+	Vec3 side = GetAnyPerpendicular(tangents[0]);
+	for (int sampleIndex = 0; sampleIndex < numSamples; ++sampleIndex)
+	{
+		Vec3 sideDirection = CrossProduct3D(ribbonNormal, tangents[sampleIndex]);
+		if (sideDirection.GetLengthSquared() > 1e-12f)
+		{
+			side = sideDirection.GetNormalized();
+		}
+		Vec3 sideOffset = side * halfWidth;
+		float u = Interpolate(UVs.m_mins.x, UVs.m_maxs.x, fractionsAlong[sampleIndex]);
+		verts.push_back(Vertex_PCU(positions[sampleIndex] - sideOffset, color, Vec2(u, UVs.m_mins.y)));
+		verts.push_back(Vertex_PCU(positions[sampleIndex] + sideOffset, color, Vec2(u, UVs.m_maxs.y)));
+	}
+	for (unsigned int sampleIndex = 0; sampleIndex + 1 < static_cast<unsigned int>(numSamples); ++sampleIndex)
+	{
+		unsigned int startLower = firstVertex + 2 * sampleIndex;
+		AddIndexesForSplineQuad(indexes, startLower, startLower + 1, startLower + 2, startLower + 3);
+	}
+}
+
+void AddVertsForTube3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, CatmullRomSpline3D const& spline, float radius, const Rgba8& color /*= Rgba8::WHITE*/, const AABB2& UVs /*= AABB2::ZERO_TO_ONE*/, int samplesPerSection /*= 16*/, int numSlices /*= 8*/)
+{
+	std::vector<Vec3> positions;
+	std::vector<Vec3> tangents;
+	std::vector<float> fractionsAlong;
+	SampleSplineForMesh(spline, samplesPerSection, positions, tangents, fractionsAlong);
+	int numSamples = static_cast<int>(positions.size());
+	if (numSamples < 2)
+	{
+		return;
+	}
+
+	std::vector<Vec2> const& rim = GetUnitCirclePoints(numSlices);
+	unsigned int firstVertex = static_cast<unsigned int>(verts.size());
+	unsigned int rimCount = static_cast<unsigned int>(numSlices + 1);
+	verts.reserve(verts.size() + GetNumIndexedVertsForTube3D(numSamples, numSlices));
+	indexes.reserve(indexes.size() + GetNumIndexesForTube3D(numSamples, numSlices));
+
+	// Each ring's right vector is the previous one with its tangent component removed (projection transport), so the
+	// rings don't spin around the curve the way a fixed reference axis would make them
+	Vec3 rightVector = GetAnyPerpendicular(tangents[0]);
+	for (int sampleIndex = 0; sampleIndex < numSamples; ++sampleIndex)
+	{
+		Vec3 const& tangent = tangents[sampleIndex];
+		Vec3 transported = rightVector - tangent * DotProduct3D(rightVector, tangent);
+		rightVector = (transported.GetLengthSquared() > 1e-12f) ? transported.GetNormalized() : GetAnyPerpendicular(tangent);
+		Vec3 forwardVector = CrossProduct3D(rightVector, tangent);
+
+		float u = Interpolate(UVs.m_mins.x, UVs.m_maxs.x, fractionsAlong[sampleIndex]);
+		for (int rimIndex = 0; rimIndex <= numSlices; ++rimIndex)
+		{
+			Vec3 rimOffset = (rim[rimIndex].x * rightVector + rim[rimIndex].y * forwardVector) * radius;
+			float v = UVs.m_mins.y + (static_cast<float>(rimIndex) / numSlices) * (UVs.m_maxs.y - UVs.m_mins.y);
+			verts.push_back(Vertex_PCU(positions[sampleIndex] + rimOffset, color, Vec2(u, v)));
+		}
+	}
+	for (unsigned int sampleIndex = 0; sampleIndex + 1 < static_cast<unsigned int>(numSamples); ++sampleIndex)
+	{
+		unsigned int lowerRing = firstVertex + sampleIndex * rimCount;
+		unsigned int upperRing = lowerRing + rimCount;
+		for (unsigned int sliceIndex = 0; sliceIndex < static_cast<unsigned int>(numSlices); ++sliceIndex)
+		{
+			AddIndexesForSplineQuad(indexes, lowerRing + sliceIndex, lowerRing + sliceIndex + 1, upperRing + sliceIndex, upperRing + sliceIndex + 1);
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+// Quantization helpers
+//
+static float SignNotZero(float value)
+{
+	return value >= 0.f ? 1.f : -1.f;
+}
+
+Vec2 EncodeOctahedralUnitVector(Vec3 const& unitVector)
+{
+	// Project onto the octahedron |x|+|y|+|z| = 1, then fold the lower hemisphere over the diagonals
+	float l1Norm = fabsf(unitVector.x) + fabsf(unitVector.y) + fabsf(unitVector.z);
+	if (l1Norm == 0.f)
+	{
+		return Vec2(0.f, 0.f);
+	}
+	float invL1Norm = 1.f / l1Norm;
+	Vec2 octahedral(unitVector.x * invL1Norm, unitVector.y * invL1Norm);
+	if (unitVector.z < 0.f)
+	{
+		octahedral = Vec2((1.f - fabsf(octahedral.y)) * SignNotZero(octahedral.x), (1.f - fabsf(octahedral.x)) * SignNotZero(octahedral.y));
+	}
+	return octahedral;
+}
+
+Vec3 DecodeOctahedralUnitVector(Vec2 const& octahedral)
+{
+	Vec3 unitVector(octahedral.x, octahedral.y, 1.f - fabsf(octahedral.x) - fabsf(octahedral.y));
+	if (unitVector.z < 0.f)
+	{
+		unitVector.x = (1.f - fabsf(octahedral.y)) * SignNotZero(octahedral.x);
+		unitVector.y = (1.f - fabsf(octahedral.x)) * SignNotZero(octahedral.y);
+	}
+	return unitVector.GetNormalized();
+}
+
+unsigned short FloatToHalf(float value)
+{
+	unsigned int bits;
+	memcpy(&bits, &value, sizeof(bits));
+	unsigned int sign = (bits >> 16) & 0x8000u;
+	unsigned int absBits = bits & 0x7FFFFFFFu;
+
+	if (absBits >= 0x7F800000u)
+	{
+		// Inf stays inf, NaN stays a (quiet) NaN
+		return static_cast<unsigned short>(sign | 0x7C00u | (absBits > 0x7F800000u ? 0x0200u : 0u));
+	}
+	if (absBits >= 0x477FF000u)
+	{
+		// 65520 and above round past the largest half (65504)
+		return static_cast<unsigned short>(sign | 0x7C00u);
+	}
+	if (absBits < 0x38800000u)
+	{
+		// Below the smallest normal half (2^-14): subnormal result in units of 2^-24
+		if (absBits < 0x33000000u)
+		{
+			return static_cast<unsigned short>(sign);
+		}
+		unsigned int mantissa = (absBits & 0x007FFFFFu) | 0x00800000u;
+		unsigned int shift = 126u - (absBits >> 23);
+		unsigned int half = mantissa >> shift;
+		unsigned int remainder = mantissa & ((1u << shift) - 1u);
+		unsigned int halfway = 1u << (shift - 1u);
+		if (remainder > halfway || (remainder == halfway && (half & 1u)))
+		{
+			++half;
+		}
+		return static_cast<unsigned short>(sign | half);
+	}
+
+	// Rebias the exponent from 127 to 15 and round the 13 dropped mantissa bits to nearest even
+	unsigned int half = (absBits - 0x38000000u) >> 13;
+	unsigned int remainder = absBits & 0x1FFFu;
+	if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u)))
+	{
+		++half;
+	}
+	return static_cast<unsigned short>(sign | half);
+}
+
+float HalfToFloat(unsigned short half)
+{
+	unsigned int sign = static_cast<unsigned int>(half & 0x8000u) << 16;
+	unsigned int exponent = (half >> 10) & 0x1Fu;
+	unsigned int mantissa = half & 0x03FFu;
+
+	unsigned int bits;
+	if (exponent == 0)
+	{
+		float magnitude = static_cast<float>(mantissa) * 5.9604644775390625e-8f; // 2^-24
+		return sign ? -magnitude : magnitude;
+	}
+	else if (exponent == 31)
+	{
+		bits = sign | 0x7F800000u | (mantissa << 13);
+	}
+	else
+	{
+		bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+	}
+
+	float value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+short FloatToSnorm16(float value)
+{
+	float scaled = Clamp(value, -1.f, 1.f) * 32767.f;
+	return static_cast<short>(scaled >= 0.f ? scaled + 0.5f : scaled - 0.5f);
+}
+
+float Snorm16ToFloat(short snorm)
+{
+	// Matches the D3D SNORM conversion: -32768 and -32767 both map to -1
+	return Clamp(static_cast<float>(snorm) / 32767.f, -1.f, 1.f);
+}
 
+signed char FloatToSnorm8(float value)
+{
+	float scaled = Clamp(value, -1.f, 1.f) * 127.f;
+	return static_cast<signed char>(scaled >= 0.f ? scaled + 0.5f : scaled - 0.5f);
+}
+
+float Snorm8ToFloat(signed char snorm)
+{
+	return Clamp(static_cast<float>(snorm) / 127.f, -1.f, 1.f);
+}
+
+unsigned short FloatToUnorm16(float value)
+{
+	return static_cast<unsigned short>(ClampZeroToOne(value) * 65535.f + 0.5f);
+}
+
+float Unorm16ToFloat(unsigned short unorm)
+{
+	return static_cast<float>(unorm) / 65535.f;
+}
+
+Vertex_PCUTBNCompact EncodeCompactVertex(Vertex_PCUTBN const& vertex)
+{
+	Vertex_PCUTBNCompact compact;
+	compact.m_position = vertex.m_position;
+	compact.m_color = vertex.m_color;
+	compact.m_uvTexCoords[0] = FloatToHalf(vertex.m_uvTexCoords.x);
+	compact.m_uvTexCoords[1] = FloatToHalf(vertex.m_uvTexCoords.y);
+
+	Vec3 normal = vertex.m_normal.GetNormalized();
+	Vec2 normalOct = EncodeOctahedralUnitVector(normal);
+	compact.m_normalOct[0] = FloatToSnorm16(normalOct.x);
+	compact.m_normalOct[1] = FloatToSnorm16(normalOct.y);
+
+	// Only the tangent direction is stored; the bitangent is rebuilt from cross(normal, tangent) and its sign
+	Vec3 tangent = vertex.m_tangent.GetNormalized();
+	if (tangent.GetLengthSquared() == 0.f)
+	{
+		tangent = CrossProduct3D(fabsf(normal.x) < 0.99f ? Vec3(1.f, 0.f, 0.f) : Vec3(0.f, 1.f, 0.f), normal).GetNormalized();
+	}
+	Vec2 tangentOct = EncodeOctahedralUnitVector(tangent);
+	float bitangentSign = DotProduct3D(CrossProduct3D(normal, tangent), vertex.m_bitangent) < 0.f ? -1.f : 1.f;
+	compact.m_tangentOctAndSign[0] = FloatToSnorm8(tangentOct.x);
+	compact.m_tangentOctAndSign[1] = FloatToSnorm8(tangentOct.y);
+	compact.m_tangentOctAndSign[2] = 0;
+	compact.m_tangentOctAndSign[3] = FloatToSnorm8(bitangentSign);
+	return compact;
+}
+
+Vertex_PCUTBN DecodeCompactVertex(Vertex_PCUTBNCompact const& vertex)
+{
+	Vec3 normal = DecodeOctahedralUnitVector(Vec2(Snorm16ToFloat(vertex.m_normalOct[0]), Snorm16ToFloat(vertex.m_normalOct[1])));
+	Vec3 tangent = DecodeOctahedralUnitVector(Vec2(Snorm8ToFloat(vertex.m_tangentOctAndSign[0]), Snorm8ToFloat(vertex.m_tangentOctAndSign[1])));
+	float bitangentSign = vertex.m_tangentOctAndSign[3] < 0 ? -1.f : 1.f;
+	Vec3 bitangent = CrossProduct3D(normal, tangent) * bitangentSign;
+
+	Vec2 uvTexCoords(HalfToFloat(vertex.m_uvTexCoords[0]), HalfToFloat(vertex.m_uvTexCoords[1]));
+	return Vertex_PCUTBN(vertex.m_position, vertex.m_color, uvTexCoords, tangent, bitangent, normal);
+}
+
+void EncodeCompactVertexes(std::vector<Vertex_PCUTBN> const& vertexes, std::vector<Vertex_PCUTBNCompact>& out_compactVertexes)
+{
+	out_compactVertexes.resize(vertexes.size());
+	for (size_t vertIndex = 0; vertIndex < vertexes.size(); ++vertIndex)
+	{
+		out_compactVertexes[vertIndex] = EncodeCompactVertex(vertexes[vertIndex]);
+	}
+}
+
+Vertex_Chunk EncodeChunkVertex(Vec3 const& chunkRelativePosition, Rgba8 const& color, Vec2 const& uvTexCoords, Vec3 const& normal)
+{
+	constexpr float MAX_CHUNK_OFFSET = 32767.f / CHUNK_VERTEX_POSITION_SCALE;
+	GUARANTEE_OR_DIE(fabsf(chunkRelativePosition.x) <= MAX_CHUNK_OFFSET && fabsf(chunkRelativePosition.y) <= MAX_CHUNK_OFFSET && fabsf(chunkRelativePosition.z) <= MAX_CHUNK_OFFSET,
+		"EncodeChunkVertex position is outside the int16 chunk-relative range");
+
+	Vertex_Chunk chunkVertex;
+	float const position[3] = { chunkRelativePosition.x, chunkRelativePosition.y, chunkRelativePosition.z };
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		float scaled = position[axis] * CHUNK_VERTEX_POSITION_SCALE;
+		chunkVertex.m_position[axis] = static_cast<short>(scaled >= 0.f ? scaled + 0.5f : scaled - 0.5f);
+	}
+	chunkVertex.m_color = color;
+	chunkVertex.m_uvTexCoords[0] = FloatToUnorm16(uvTexCoords.x);
+	chunkVertex.m_uvTexCoords[1] = FloatToUnorm16(uvTexCoords.y);
+
+	Vec2 normalOct = EncodeOctahedralUnitVector(normal.GetNormalized());
+	chunkVertex.m_normalOct[0] = FloatToSnorm8(normalOct.x);
+	chunkVertex.m_normalOct[1] = FloatToSnorm8(normalOct.y);
+	return chunkVertex;
+}
+
+Vec3 DecodeChunkVertexPosition(Vertex_Chunk const& vertex)
+{
+	constexpr float INV_SCALE = 1.f / CHUNK_VERTEX_POSITION_SCALE;
+	return Vec3(vertex.m_position[0] * INV_SCALE, vertex.m_position[1] * INV_SCALE, vertex.m_position[2] * INV_SCALE);
+}
+
+Vec3 DecodeChunkVertexNormal(Vertex_Chunk const& vertex)
+{
+	return DecodeOctahedralUnitVector(Vec2(Snorm8ToFloat(vertex.m_normalOct[0]), Snorm8ToFloat(vertex.m_normalOct[1])));
+}
@@ -6,6 +6,51 @@
 #include "Engine/Math/AABB3.hpp"
 #include <vector>
 
+class VertexWriter;
+class CatmullRomSpline3D;
+
+// Cached unit geometry used by the primitive generators; built on first use, thread-safe, valid for the process lifetime.
+// GetUnitCirclePoints returns numSlices+1 (cos, sin) points with the last equal to the first.
+// GetUnitSphereTemplate returns the AddVertsForSphere3D triangle list for a unit sphere at the origin.
+std::vector<Vec2> const& GetUnitCirclePoints(int numSlices);
+std::vector<Vertex_PCU> const& GetUnitSphereTemplate(int numSlices, int numStacks);
+
+//----------------------------------------------------------------------------------------------
+// Exact number of vertices (and indexes, for the indexed builders) each AddVertsFor* call writes.
+// Use these to size a VertexWriter, reserve a std::vector once, or map a GPU buffer before building.
+//
+constexpr int DISC2D_NUM_SIDES = 32;
+constexpr int CAPSULE2D_SLICES_PER_CAP = 20;
+
+constexpr int GetNumVertsForAABB2D()							{ return 6; }
+constexpr int GetNumVertsForOBB2D()								{ return 6; }
+constexpr int GetNumVertsForLineSegment2D()						{ return 6; }
+constexpr int GetNumVertsForArrow2D()							{ return 9; }
+constexpr int GetNumVertsForDisc2D()							{ return 3 * DISC2D_NUM_SIDES; }
+constexpr int GetNumVertsForCapsule2D()							{ return 6 + 6 * CAPSULE2D_SLICES_PER_CAP; }
+constexpr int GetNumVertsForQuad3D()							{ return 6; }
+constexpr int GetNumVertsForAABB3D()							{ return 6 * GetNumVertsForQuad3D(); }
+constexpr int GetNumVertsForOBB3D()								{ return 6 * GetNumVertsForQuad3D(); }
+constexpr int GetNumVertsForSphere3D(int numSlices, int numStacks)	{ return 6 * numSlices * numStacks; }
+constexpr int GetNumVertsForCylinder3D(int numSlices)			{ return 12 * numSlices; }
+constexpr int GetNumVertsForCone3D(int numSlices)				{ return 6 * numSlices; }
+
+constexpr int GetNumIndexedVertsForQuad3D()								{ return 4; }
+constexpr int GetNumIndexesForQuad3D()									{ return 6; }
+constexpr int GetNumIndexedVertsForAABB3D()								{ return 6 * GetNumIndexedVertsForQuad3D(); }
+constexpr int GetNumIndexesForAABB3D()									{ return 6 * GetNumIndexesForQuad3D(); }
+constexpr int GetNumIndexedVertsForSphere3D(int numSlices, int numStacks)	{ return (numSlices + 1) * (numStacks + 1); }
+constexpr int GetNumIndexesForSphere3D(int numSlices, int numStacks)		{ return 6 * numSlices * (numStacks - 1); }
+constexpr int GetNumIndexedVertsForCylinder3D(int numSlices)				{ return 4 * (numSlices + 1) + 2; }
+constexpr int GetNumIndexesForCylinder3D(int numSlices)					{ return 12 * numSlices; }
+constexpr int GetNumIndexedVertsForCone3D(int numSlices)					{ return 2 * numSlices + 3; }
+constexpr int GetNumIndexesForCone3D(int numSlices)						{ return 6 * numSlices; }
+// numSamples is CatmullRomSpline3D::GetNumUniformSamples(samplesPerSection)
+constexpr int GetNumIndexedVertsForRibbon3D(int numSamples)				{ return 2 * numSamples; }
+constexpr int GetNumIndexesForRibbon3D(int numSamples)					{ return 6 * (numSamples - 1); }
+constexpr int GetNumIndexedVertsForTube3D(int numSamples, int numSlices)	{ return numSamples * (numSlices + 1); }
+constexpr int GetNumIndexesForTube3D(int numSamples, int numSlices)		{ return 6 * numSlices * (numSamples - 1); }
+
 void TransfromVertexArrayXY3D(int numVerts, Vertex_PCU* verts, float scaleXY, float rotationDegreesAboutZ, Vec2 const& translationXY);
 void AddVertsForCapsule2D( std::vector<Vertex_PCU>& verts, Capsule2 const& capsule, Rgba8 const& color);
 void AddVertsForCapsule2D( std::vector<Vertex_PCU>& verts, Vec2 const& boneStart, Vec2 const& boneEnd, float radius, Rgba8 const& color );
@@ -21,6 +66,7 @@ void AddVertsForQuad3DInverse(std::vector<Vertex_PCU>& verts, const Vec3& bottom
 void AddVertsForAABB3D(std::vector<Vertex_PCU>& verts, const AABB3& bounds, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
 void AddVertsForOBB3D(std::vector<Vertex_PCU>& verts, OBB3 obb, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
 void AddVertsForSphere3D(std::vector<Vertex_PCU>& verts, const Vec3& center, float radius, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE, int numLatitudesSlices = 8);
+void AddVertsForSphere3D(std::vector<Vertex_PCU>& verts, const Vec3& center, float radius, const Rgba8& color, const AABB2& UVs, int numSlices, int numStacks);
 void TransformVertexArray3D(std::vector<Vertex_PCU>& verts, const Mat44& transform);
 AABB2 GetVertexBounds2D(const std::vector<Vertex_PCU>& verts);
 void AddVertsForCylinder3D(std::vector<Vertex_PCU>& verts, const Vec3& start, const Vec3& end, float radius, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE, int numSlices = 8);
@@ -30,5 +76,53 @@ void AddVertsForQuad3D(std::vector<Vertex_PCUTBN>& vertexes, std::vector<unsigne
 	const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
 void AddVertsForRoundedQuad3D(std::vector<Vertex_PCUTBN>& vertexes, const Vec3& topLeft, const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topRight, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
 
+// VertexWriter overloads write straight into caller-provided memory; the std::vector versions above size a writer and forward here
+void AddVertsForCapsule2D(VertexWriter& writer, Vec2 const& boneStart, Vec2 const& boneEnd, float radius, Rgba8 const& color);
+void AddVertsForDisc2D(VertexWriter& writer, Vec2 const& center, float radius, Rgba8 const& color);
+void AddVertsForAABB2D(VertexWriter& writer, AABB2 const& bounds, Rgba8 const& color, Vec2 const& uvAtMins = Vec2(0.f, 0.f), Vec2 const& uvAtMaxs = Vec2(1.f, 1.f));
+void AddVertsForOBB2D(VertexWriter& writer, OBB2 const& box, Rgba8 const& color);
+void AddVertsForLineSegment2D(VertexWriter& writer, Vec2 const& start, Vec2 const& end, float thickness, Rgba8 const& color);
+void AddVertsForQuad3D(VertexWriter& writer, const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topRight, const Vec3& topLeft, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+void AddVertsForAABB3D(VertexWriter& writer, const AABB3& bounds, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+void AddVertsForOBB3D(VertexWriter& writer, OBB3 const& obb, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+void AddVertsForSphere3D(VertexWriter& writer, const Vec3& center, float radius, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE, int numSlices = 8, int numStacks = 8);
+
+// Indexed overloads: shared corners are emitted once and referenced from indexes (offset by the current verts.size())
+void AddVertsForQuad3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topRight, const Vec3& topLeft, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+void AddVertsForAABB3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, const AABB3& bounds, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+void AddVertsForOBB3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, OBB3 const& obb, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+void AddVertsForSphere3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, const Vec3& center, float radius, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE, int numSlices = 8, int numStacks = 8);
+void AddVertsForCylinder3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, const Vec3& start, const Vec3& end, float radius, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE, int numSlices = 8);
+void AddVertsForCone3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, const Vec3& start, const Vec3& end, float radius, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE, int numSlices = 8);
+
+// Whole-spline meshes (camera paths, projectile trails) built from one batch of spline samples; u runs along the
+// curve by length. The ribbon's front face points along ribbonNormal: world up for a flat strip, the direction
+// toward the camera for a trail that faces the viewer. The tube is open at both ends and its rings follow the curve
+// without twisting.
+void AddVertsForRibbon3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, CatmullRomSpline3D const& spline, float halfWidth, Vec3 const& ribbonNormal, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE, int samplesPerSection = 16);
+void AddVertsForTube3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, CatmullRomSpline3D const& spline, float radius, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE, int samplesPerSection = 16, int numSlices = 8);
+
 void AddVertsForLineSegment3D(std::vector<Vertex_PCU>& mainVertexList, Vec3 const& start, Vec3 const& end, float thickness, Rgba8 const& color);
-void AddVertsForLineSegment3D(std::vector<Vertex_PCUTBN>& vertexes, std::vector<unsigned int>& indexes, Vec3 const& start, Vec3 const& end, float thickness, Rgba8 const& color);
\ No newline at end of file
+void AddVertsForLineSegment3D(std::vector<Vertex_PCUTBN>& vertexes, std::vector<unsigned int>& indexes, Vec3 const& start, Vec3 const& end, float thickness, Rgba8 const& color);
+
+//----------------------------------------------------------------------------------------------
+// Quantization helpers for the compact vertex formats in Vertex_PCU.hpp
+//
+Vec2			EncodeOctahedralUnitVector(Vec3 const& unitVector);		// [-1,1]^2
+Vec3			DecodeOctahedralUnitVector(Vec2 const& octahedral);		// normalized
+unsigned short	FloatToHalf(float value);								// round to nearest even, keeps inf/NaN
+float			HalfToFloat(unsigned short half);
+short			FloatToSnorm16(float value);
+float			Snorm16ToFloat(short snorm);
+signed char		FloatToSnorm8(float value);
+float			Snorm8ToFloat(signed char snorm);
+unsigned short	FloatToUnorm16(float value);
+float			Unorm16ToFloat(unsigned short unorm);
+
+Vertex_PCUTBNCompact	EncodeCompactVertex(Vertex_PCUTBN const& vertex);
+Vertex_PCUTBN			DecodeCompactVertex(Vertex_PCUTBNCompact const& vertex);
+void					EncodeCompactVertexes(std::vector<Vertex_PCUTBN> const& vertexes, std::vector<Vertex_PCUTBNCompact>& out_compactVertexes);
+
+Vertex_Chunk	EncodeChunkVertex(Vec3 const& chunkRelativePosition, Rgba8 const& color, Vec2 const& uvTexCoords, Vec3 const& normal);
+Vec3			DecodeChunkVertexPosition(Vertex_Chunk const& vertex);
+Vec3			DecodeChunkVertexNormal(Vertex_Chunk const& vertex);
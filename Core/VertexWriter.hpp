@@ -0,0 +1,79 @@
+#pragma once
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include <vector>
+
+//----------------------------------------------------------------------------------------------
+// Bounded writer over caller-owned vertex memory: a raw array, a mapped GPU vertex buffer, or the tail of a
+// std::vector that is grown exactly once up front. Builders ask for their exact vertex count with Allocate()
+// and fill the returned span in place, so a large build never reallocates or copies part way through.
+//
+class VertexWriter
+{
+public:
+	VertexWriter(Vertex_PCU* vertexes, int capacity);
+	VertexWriter(std::vector<Vertex_PCU>& verts, int maxVertsToAppend);
+	~VertexWriter();
+	VertexWriter(VertexWriter const& copy) = delete;
+	VertexWriter& operator=(VertexWriter const& copy) = delete;
+
+	Vertex_PCU* Allocate(int numVerts);
+	void		Write(Vertex_PCU const& vert);
+
+	int			GetNumWritten() const	{ return m_numWritten; }
+	int			GetCapacity() const		{ return m_capacity; }
+	int			GetNumRemaining() const	{ return m_capacity - m_numWritten; }
+
+	// Trims a vector-backed writer down to what was actually written; also done by the destructor
+	void		Finish();
+
+private:
+	Vertex_PCU*					m_vertexes = nullptr;
+	int							m_capacity = 0;
+	int							m_numWritten = 0;
+	std::vector<Vertex_PCU>*	m_ownerVector = nullptr;
+	size_t						m_firstVertexInOwner = 0;
+};
+
+//----------------------------------------------------------------------------------------------
+inline VertexWriter::VertexWriter(Vertex_PCU* vertexes, int capacity)
+	: m_vertexes(vertexes)
+	, m_capacity(capacity)
+{
+}
+
+inline VertexWriter::VertexWriter(std::vector<Vertex_PCU>& verts, int maxVertsToAppend)
+	: m_capacity(maxVertsToAppend)
+	, m_ownerVector(&verts)
+	, m_firstVertexInOwner(verts.size())
+{
+	verts.resize(m_firstVertexInOwner + maxVertsToAppend);
+	m_vertexes = verts.data() + m_firstVertexInOwner;
+}
+
+inline VertexWriter::~VertexWriter()
+{
+	Finish();
+}
+
+inline Vertex_PCU* VertexWriter::Allocate(int numVerts)
+{
+	ASSERT_OR_DIE(m_numWritten + numVerts <= m_capacity, "VertexWriter overflow; the builder's vertex count query is wrong");
+	Vertex_PCU* span = m_vertexes + m_numWritten;
+	m_numWritten += numVerts;
+	return span;
+}
+
+inline void VertexWriter::Write(Vertex_PCU const& vert)
+{
+	*Allocate(1) = vert;
+}
+
+inline void VertexWriter::Finish()
+{
+	if (m_ownerVector != nullptr && m_numWritten < m_capacity)
+	{
+		m_ownerVector->resize(m_firstVertexInOwner + m_numWritten);
+		m_capacity = m_numWritten;
+	}
+}
\ No newline at end of file
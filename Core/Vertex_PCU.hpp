@@ -48,5 +48,33 @@ struct Vertex_PCUTBN
 	Vec3 m_normal;
 };
 
+//----------------------------------------------------------------------------------------------
+// Quantized vertex formats for memory- and bandwidth-bound meshes. Build them from the float formats with the
+// Encode*/Decode* helpers in VertexUtils; the matching VertexType entries set up the input layout.
+//
+// Vertex_PCUTBNCompact (28 bytes vs 60 for Vertex_PCUTBN):
+//   POSITION float3, COLOR unorm8x4, TEXCOORD half2, NORMAL snorm16x2 (octahedral),
+//   TANGENT snorm8x4 = (octahedral tangent xy, 0, bitangent sign). Bitangent = sign * cross(normal, tangent).
+//
+struct Vertex_PCUTBNCompact
+{
+	Vec3			m_position;
+	Rgba8			m_color;
+	unsigned short	m_uvTexCoords[2] = {};
+	short			m_normalOct[2] = {};
+	signed char		m_tangentOctAndSign[4] = {};
+};
 
+// Vertex_Chunk (20 bytes): chunk-relative voxel mesh vertex.
+//   POSITION sint16x4, xyz in 1/CHUNK_VERTEX_POSITION_SCALE units relative to the chunk origin (w is free for per-vertex data),
+//   COLOR unorm8x4, TEXCOORD unorm16x2, NORMAL snorm8x4 = (octahedral normal xy, 0, 0).
+//
+constexpr float CHUNK_VERTEX_POSITION_SCALE = 64.f;
 
+struct Vertex_Chunk
+{
+	short			m_position[4] = {};
+	Rgba8			m_color;
+	unsigned short	m_uvTexCoords[2] = {};
+	signed char		m_normalOct[4] = {};
+};
@@ -0,0 +1,368 @@
+#include "Engine/Core/VoxelChunk.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+
+namespace
+{
+	constexpr uint8_t RLE_MAGIC_0 = 'V';
+	constexpr uint8_t RLE_MAGIC_1 = 'C';
+	constexpr uint8_t RLE_VERSION = 1;
+	constexpr size_t RLE_HEADER_SIZE = 9;
+	constexpr int RLE_MAX_RUN_LENGTH = 0xFFFF;
+
+	int GetBitsForPaletteSize(int numPaletteEntries)
+	{
+		if (numPaletteEntries <= 1) return 0;
+		if (numPaletteEntries <= 2) return 1;
+		if (numPaletteEntries <= 4) return 2;
+		if (numPaletteEntries <= 16) return 4;
+		return 8;
+	}
+
+	void AppendUInt16(std::vector<uint8_t>& bytes, int value)
+	{
+		bytes.push_back((uint8_t)(value & 0xFF));
+		bytes.push_back((uint8_t)((value >> 8) & 0xFF));
+	}
+
+	int ReadUInt16(uint8_t const* bytes)
+	{
+		return (int)bytes[0] | ((int)bytes[1] << 8);
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+VoxelChunk::VoxelChunk(IntVec3 const& chunkCoords, IntVec3 const& dimensions, ChunkBlockType fillBlock)
+	: m_chunkCoords(chunkCoords)
+	, m_dimensions(dimensions)
+{
+	GUARANTEE_OR_DIE(dimensions.x > 0 && dimensions.y > 0 && dimensions.z > 0, "VoxelChunk dimensions must be positive");
+	m_numBlocks = dimensions.x * dimensions.y * dimensions.z;
+	Fill(fillBlock);
+}
+
+bool VoxelChunk::IsInBounds(IntVec3 const& localCoords) const
+{
+	return localCoords.x >= 0 && localCoords.x < m_dimensions.x
+		&& localCoords.y >= 0 && localCoords.y < m_dimensions.y
+		&& localCoords.z >= 0 && localCoords.z < m_dimensions.z;
+}
+
+int VoxelChunk::GetBlockIndex(IntVec3 const& localCoords) const
+{
+	return localCoords.x + localCoords.y * m_dimensions.x + localCoords.z * m_dimensions.x * m_dimensions.y;
+}
+
+IntVec3 VoxelChunk::GetLocalCoordsForBlockIndex(int blockIndex) const
+{
+	int blocksPerLayer = m_dimensions.x * m_dimensions.y;
+	int indexInLayer = blockIndex % blocksPerLayer;
+	return IntVec3(indexInLayer % m_dimensions.x, indexInLayer / m_dimensions.x, blockIndex / blocksPerLayer);
+}
+
+//----------------------------------------------------------------------------------------------
+ChunkBlockType VoxelChunk::GetBlock(IntVec3 const& localCoords) const
+{
+	return GetBlockAtIndex(GetBlockIndex(localCoords));
+}
+
+ChunkBlockType VoxelChunk::GetBlockAtIndex(int blockIndex) const
+{
+	ASSERT_OR_DIE(blockIndex >= 0 && blockIndex < m_numBlocks, "VoxelChunk block index out of range");
+	return m_palette[GetPaletteIndexAt(blockIndex)];
+}
+
+void VoxelChunk::SetBlock(IntVec3 const& localCoords, ChunkBlockType blockType)
+{
+	SetBlockAtIndex(GetBlockIndex(localCoords), blockType);
+}
+
+void VoxelChunk::SetBlockAtIndex(int blockIndex, ChunkBlockType blockType)
+{
+	ASSERT_OR_DIE(blockIndex >= 0 && blockIndex < m_numBlocks, "VoxelChunk block index out of range");
+	int oldPaletteIndex = GetPaletteIndexAt(blockIndex);
+	if (m_palette[oldPaletteIndex] == blockType)
+	{
+		return;
+	}
+
+	// Acquire before releasing so the old slot cannot be handed back out while this block still uses it
+	int newPaletteIndex = AcquirePaletteIndex(blockType);
+	++m_paletteRefCounts[newPaletteIndex];
+	if (--m_paletteRefCounts[oldPaletteIndex] == 0)
+	{
+		m_paletteIndexForBlock[m_palette[oldPaletteIndex]] = -1;
+	}
+	SetPaletteIndexAt(blockIndex, newPaletteIndex);
+}
+
+void VoxelChunk::Fill(ChunkBlockType blockType)
+{
+	for (short& paletteIndex : m_paletteIndexForBlock)
+	{
+		paletteIndex = -1;
+	}
+	m_palette.assign(1, blockType);
+	m_paletteRefCounts.assign(1, m_numBlocks);
+	m_paletteIndexForBlock[blockType] = 0;
+	m_bitsPerIndex = 0;
+	m_packedIndexes.clear();
+	m_packedIndexes.shrink_to_fit();
+}
+
+//----------------------------------------------------------------------------------------------
+void VoxelChunk::CopyBlocksTo(ChunkBlockType* outBlocks) const
+{
+	ForEachBlock([outBlocks](int blockIndex, ChunkBlockType blockType) { outBlocks[blockIndex] = blockType; });
+}
+
+void VoxelChunk::SetBlocksFrom(ChunkBlockType const* blocks)
+{
+	int counts[256] = {};
+	for (int blockIndex = 0; blockIndex < m_numBlocks; ++blockIndex)
+	{
+		++counts[blocks[blockIndex]];
+	}
+
+	ResetPaletteFromCounts(counts);
+	if (m_bitsPerIndex == 0)
+	{
+		return;
+	}
+	for (int blockIndex = 0; blockIndex < m_numBlocks; ++blockIndex)
+	{
+		size_t bitOffset = (size_t)blockIndex * m_bitsPerIndex;
+		m_packedIndexes[bitOffset >> 6] |= (uint64_t)m_paletteIndexForBlock[blocks[blockIndex]] << (bitOffset & 63);
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+int VoxelChunk::GetNumPaletteEntries() const
+{
+	int numInUse = 0;
+	for (int refCount : m_paletteRefCounts)
+	{
+		numInUse += refCount > 0 ? 1 : 0;
+	}
+	return numInUse;
+}
+
+size_t VoxelChunk::GetMemoryUsageBytes() const
+{
+	return sizeof(VoxelChunk) + m_packedIndexes.capacity() * sizeof(uint64_t) + m_palette.capacity() * sizeof(ChunkBlockType)
+		+ m_paletteRefCounts.capacity() * sizeof(int);
+}
+
+void VoxelChunk::Compact()
+{
+	std::vector<int> remap(m_palette.size(), -1);
+	std::vector<ChunkBlockType> newPalette;
+	std::vector<int> newRefCounts;
+	for (int paletteIndex = 0; paletteIndex < (int)m_palette.size(); ++paletteIndex)
+	{
+		if (m_paletteRefCounts[paletteIndex] > 0)
+		{
+			remap[paletteIndex] = (int)newPalette.size();
+			m_paletteIndexForBlock[m_palette[paletteIndex]] = (short)newPalette.size();
+			newPalette.push_back(m_palette[paletteIndex]);
+			newRefCounts.push_back(m_paletteRefCounts[paletteIndex]);
+		}
+	}
+
+	Repack(GetBitsForPaletteSize((int)newPalette.size()), &remap);
+	m_palette.swap(newPalette);
+	m_paletteRefCounts.swap(newRefCounts);
+	m_palette.shrink_to_fit();
+	m_paletteRefCounts.shrink_to_fit();
+}
+
+//----------------------------------------------------------------------------------------------
+void VoxelChunk::SerializeRLE(std::vector<uint8_t>& outBytes) const
+{
+	outBytes.push_back(RLE_MAGIC_0);
+	outBytes.push_back(RLE_MAGIC_1);
+	outBytes.push_back(RLE_VERSION);
+	AppendUInt16(outBytes, m_dimensions.x);
+	AppendUInt16(outBytes, m_dimensions.y);
+	AppendUInt16(outBytes, m_dimensions.z);
+
+	int runLength = 0;
+	ChunkBlockType runBlock = CHUNK_BLOCK_AIR;
+	ForEachBlock([&](int blockIndex, ChunkBlockType blockType)
+		{
+			UNUSED(blockIndex)
+			if (runLength > 0 && (blockType != runBlock || runLength == RLE_MAX_RUN_LENGTH))
+			{
+				AppendUInt16(outBytes, runLength);
+				outBytes.push_back(runBlock);
+				runLength = 0;
+			}
+			runBlock = blockType;
+			++runLength;
+		});
+	AppendUInt16(outBytes, runLength);
+	outBytes.push_back(runBlock);
+}
+
+bool VoxelChunk::DeserializeRLE(uint8_t const* bytes, size_t numBytes)
+{
+	if (numBytes < RLE_HEADER_SIZE || bytes[0] != RLE_MAGIC_0 || bytes[1] != RLE_MAGIC_1 || bytes[2] != RLE_VERSION)
+	{
+		return false;
+	}
+	IntVec3 dimensions(ReadUInt16(bytes + 3), ReadUInt16(bytes + 5), ReadUInt16(bytes + 7));
+	if (dimensions != m_dimensions || (numBytes - RLE_HEADER_SIZE) % 3 != 0)
+	{
+		return false;
+	}
+
+	// Validate and count first so a malformed stream leaves the chunk untouched, then pack the runs straight
+	// into palette indexes without going through a dense block array
+	int counts[256] = {};
+	int numDecoded = 0;
+	for (size_t byteIndex = RLE_HEADER_SIZE; byteIndex < numBytes; byteIndex += 3)
+	{
+		int runLength = ReadUInt16(bytes + byteIndex);
+		if (runLength == 0 || runLength > m_numBlocks - numDecoded)
+		{
+			return false;
+		}
+		counts[bytes[byteIndex + 2]] += runLength;
+		numDecoded += runLength;
+	}
+	if (numDecoded != m_numBlocks)
+	{
+		return false;
+	}
+
+	ResetPaletteFromCounts(counts);
+	if (m_bitsPerIndex == 0)
+	{
+		return true;
+	}
+	int const indexesPerWord = 64 / m_bitsPerIndex;
+	int blockIndex = 0;
+	for (size_t byteIndex = RLE_HEADER_SIZE; byteIndex < numBytes; byteIndex += 3)
+	{
+		int runLength = ReadUInt16(bytes + byteIndex);
+		int paletteIndex = m_paletteIndexForBlock[bytes[byteIndex + 2]];
+		uint64_t wholeWord = 0;
+		for (int slot = 0; slot < indexesPerWord; ++slot)
+		{
+			wholeWord |= (uint64_t)paletteIndex << (slot * m_bitsPerIndex);
+		}
+		int runEnd = blockIndex + runLength;
+		while (blockIndex < runEnd)
+		{
+			if (blockIndex % indexesPerWord == 0 && runEnd - blockIndex >= indexesPerWord)
+			{
+				m_packedIndexes[blockIndex / indexesPerWord] = wholeWord;
+				blockIndex += indexesPerWord;
+				continue;
+			}
+			SetPaletteIndexAt(blockIndex, paletteIndex);
+			++blockIndex;
+		}
+	}
+	return true;
+}
+
+size_t VoxelChunk::GetMaxRLESize(IntVec3 const& dimensions)
+{
+	return RLE_HEADER_SIZE + 3 * (size_t)dimensions.x * (size_t)dimensions.y * (size_t)dimensions.z;
+}
+
+//----------------------------------------------------------------------------------------------
+// Rebuilds the palette from per-type block counts and zeroes the packed indexes at the matching width
+void VoxelChunk::ResetPaletteFromCounts(int const counts[256])
+{
+	for (short& paletteIndex : m_paletteIndexForBlock)
+	{
+		paletteIndex = -1;
+	}
+	m_palette.clear();
+	m_paletteRefCounts.clear();
+	for (int blockType = 0; blockType < 256; ++blockType)
+	{
+		if (counts[blockType] > 0)
+		{
+			m_paletteIndexForBlock[blockType] = (short)m_palette.size();
+			m_palette.push_back((ChunkBlockType)blockType);
+			m_paletteRefCounts.push_back(counts[blockType]);
+		}
+	}
+
+	m_bitsPerIndex = GetBitsForPaletteSize((int)m_palette.size());
+	m_packedIndexes.assign(((size_t)m_numBlocks * m_bitsPerIndex + 63) / 64, 0);
+	if (m_bitsPerIndex == 0)
+	{
+		m_packedIndexes.shrink_to_fit();
+	}
+}
+
+int VoxelChunk::GetPaletteIndexAt(int blockIndex) const
+{
+	if (m_bitsPerIndex == 0)
+	{
+		return 0;
+	}
+	size_t bitOffset = (size_t)blockIndex * m_bitsPerIndex;
+	return (int)((m_packedIndexes[bitOffset >> 6] >> (bitOffset & 63)) & ((1ull << m_bitsPerIndex) - 1ull));
+}
+
+void VoxelChunk::SetPaletteIndexAt(int blockIndex, int paletteIndex)
+{
+	size_t bitOffset = (size_t)blockIndex * m_bitsPerIndex;
+	uint64_t indexMask = ((1ull << m_bitsPerIndex) - 1ull) << (bitOffset & 63);
+	uint64_t& word = m_packedIndexes[bitOffset >> 6];
+	word = (word & ~indexMask) | ((uint64_t)paletteIndex << (bitOffset & 63));
+}
+
+int VoxelChunk::AcquirePaletteIndex(ChunkBlockType blockType)
+{
+	int paletteIndex = m_paletteIndexForBlock[blockType];
+	if (paletteIndex >= 0)
+	{
+		return paletteIndex;
+	}
+
+	for (paletteIndex = 0; paletteIndex < (int)m_palette.size(); ++paletteIndex)
+	{
+		if (m_paletteRefCounts[paletteIndex] == 0)
+		{
+			break;
+		}
+	}
+	if (paletteIndex == (int)m_palette.size())
+	{
+		m_palette.push_back(blockType);
+		m_paletteRefCounts.push_back(0);
+		if (paletteIndex >= (1 << m_bitsPerIndex))
+		{
+			Repack(GetBitsForPaletteSize(paletteIndex + 1), nullptr);
+		}
+	}
+	m_palette[paletteIndex] = blockType;
+	m_paletteIndexForBlock[blockType] = (short)paletteIndex;
+	return paletteIndex;
+}
+
+void VoxelChunk::Repack(int newBitsPerIndex, std::vector<int> const* paletteRemap)
+{
+	std::vector<uint64_t> newPackedIndexes(((size_t)m_numBlocks * newBitsPerIndex + 63) / 64, 0);
+	if (newBitsPerIndex > 0)
+	{
+		for (int blockIndex = 0; blockIndex < m_numBlocks; ++blockIndex)
+		{
+			int paletteIndex = GetPaletteIndexAt(blockIndex);
+			if (paletteRemap != nullptr)
+			{
+				paletteIndex = (*paletteRemap)[paletteIndex];
+			}
+			size_t bitOffset = (size_t)blockIndex * newBitsPerIndex;
+			newPackedIndexes[bitOffset >> 6] |= (uint64_t)paletteIndex << (bitOffset & 63);
+		}
+	}
+	m_packedIndexes.swap(newPackedIndexes);
+	m_bitsPerIndex = newBitsPerIndex;
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+#include "Engine/Core/ChunkMesher.hpp"
+#include "Engine/Math/IntVec3.hpp"
+#include <cstdint>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------
+// Palette-compressed block storage for one chunk. Each block stores an index into a small palette of the block
+// types present, packed at 0, 1, 2, 4 or 8 bits per block (a power of two, so an index never straddles a word).
+// A chunk of one block type stores no indexes at all; a typical terrain chunk with a handful of types uses 2-4 bits
+// instead of 8. Get/Set are O(1); Set widens the packing (amortized) when a new type does not fit the palette.
+//
+// Blocks are addressed by chunk-local IntVec3 coords or by block index x + y*dimX + z*dimX*dimY, the same layout
+// ChunkMeshInput::m_blocks expects. For meshing and lighting prefer CopyBlocksTo / ForEachBlock over per-block Get,
+// which decode a whole word at a time.
+//
+// SerializeRLE writes a run-length encoding of the block types for disk; it is independent of the palette layout.
+//
+class VoxelChunk
+{
+public:
+	explicit VoxelChunk(IntVec3 const& chunkCoords = IntVec3(), IntVec3 const& dimensions = IntVec3(16, 16, 128), ChunkBlockType fillBlock = CHUNK_BLOCK_AIR);
+
+	IntVec3 const&	GetChunkCoords() const		{ return m_chunkCoords; }
+	IntVec3 const&	GetDimensions() const		{ return m_dimensions; }
+	int				GetNumBlocks() const		{ return m_numBlocks; }
+	bool			IsInBounds(IntVec3 const& localCoords) const;
+	int				GetBlockIndex(IntVec3 const& localCoords) const;
+	IntVec3			GetLocalCoordsForBlockIndex(int blockIndex) const;
+
+	ChunkBlockType	GetBlock(IntVec3 const& localCoords) const;
+	ChunkBlockType	GetBlockAtIndex(int blockIndex) const;
+	void			SetBlock(IntVec3 const& localCoords, ChunkBlockType blockType);
+	void			SetBlockAtIndex(int blockIndex, ChunkBlockType blockType);
+	void			Fill(ChunkBlockType blockType);
+
+	// Bulk access; blocks must hold GetNumBlocks() entries
+	void			CopyBlocksTo(ChunkBlockType* outBlocks) const;
+	void			SetBlocksFrom(ChunkBlockType const* blocks);
+	template <typename BlockVisitor>
+	void			ForEachBlock(BlockVisitor&& visitor) const;	// visitor(int blockIndex, ChunkBlockType blockType), in block index order
+
+	int				GetBitsPerBlock() const		{ return m_bitsPerIndex; }
+	int				GetNumPaletteEntries() const;
+	size_t			GetMemoryUsageBytes() const;
+
+	// Drops palette entries no longer referenced and repacks at the narrowest width that fits
+	void			Compact();
+
+	// Format: 'V','C', version, 3 x uint16 dimensions, then (uint16 run length, block type) pairs; all little-endian
+	void			SerializeRLE(std::vector<uint8_t>& outBytes) const;
+	bool			DeserializeRLE(uint8_t const* bytes, size_t numBytes);	// false (chunk unchanged) if malformed or the wrong size
+	static size_t	GetMaxRLESize(IntVec3 const& dimensions);					// header plus one run per block
+
+private:
+	int				GetPaletteIndexAt(int blockIndex) const;
+	void			SetPaletteIndexAt(int blockIndex, int paletteIndex);
+	int				AcquirePaletteIndex(ChunkBlockType blockType);
+	void			ResetPaletteFromCounts(int const counts[256]);
+	void			Repack(int newBitsPerIndex, std::vector<int> const* paletteRemap);
+
+private:
+	IntVec3						m_chunkCoords;
+	IntVec3						m_dimensions;
+	int							m_numBlocks = 0;
+	int							m_bitsPerIndex = 0;
+	std::vector<uint64_t>		m_packedIndexes;
+	std::vector<ChunkBlockType>	m_palette;
+	std::vector<int>			m_paletteRefCounts;				// 0 marks a free slot that can be reused
+	short						m_paletteIndexForBlock[256];	// -1 if the block type is not in the palette
+};
+
+//----------------------------------------------------------------------------------------------
+template <typename BlockVisitor>
+void VoxelChunk::ForEachBlock(BlockVisitor&& visitor) const
+{
+	if (m_bitsPerIndex == 0)
+	{
+		ChunkBlockType blockType = m_palette[0];
+		for (int blockIndex = 0; blockIndex < m_numBlocks; ++blockIndex)
+		{
+			visitor(blockIndex, blockType);
+		}
+		return;
+	}
+
+	int const indexesPerWord = 64 / m_bitsPerIndex;
+	uint64_t const indexMask = (1ull << m_bitsPerIndex) - 1ull;
+	int blockIndex = 0;
+	for (uint64_t word : m_packedIndexes)
+	{
+		for (int slot = 0; slot < indexesPerWord && blockIndex < m_numBlocks; ++slot, ++blockIndex)
+		{
+			visitor(blockIndex, m_palette[(size_t)(word & indexMask)]);
+			word >>= m_bitsPerIndex;
+		}
+	}
+}
\ No newline at end of file
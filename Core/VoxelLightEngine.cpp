@@ -0,0 +1,599 @@
+#include "Engine/Core/VoxelLightEngine.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include <algorithm>
+
+//----------------------------------------------------------------------------------------------
+// Queue entries follow the usual two-queue scheme: removal floods (REMOVE_START, REMOVE_PROBE) clear every cell
+// that could have been lit through the removed light and re-seed from the brighter cells around the hole, then
+// additions (PROPOSE, SEED) flood outward, only ever raising a cell's level. Removals are drained before additions.
+//
+enum VoxelLightEntryKind : uint8_t
+{
+	LIGHT_ENTRY_PROPOSE,		// raise the cell to m_level if brighter, then spread
+	LIGHT_ENTRY_SEED,			// spread the cell's current level to its neighbors
+	LIGHT_ENTRY_REMOVE_START,	// clear the cell and flood the removal from it
+	LIGHT_ENTRY_REMOVE_PROBE,	// a neighbor at level m_level went dark; clear this cell too if it depended on it
+};
+
+struct VoxelLightQueueEntry
+{
+	short	m_x = 0;
+	short	m_y = 0;
+	short	m_z = 0;
+	uint8_t	m_level = 0;
+	uint8_t	m_channel = 0;
+	uint8_t	m_kind = LIGHT_ENTRY_PROPOSE;
+	bool	m_isFromAbove = false;
+};
+
+struct VoxelChunkLight
+{
+	VoxelChunk const*					m_chunk = nullptr;
+	IntVec3								m_coords;
+	IntVec3								m_regionCoords;
+	std::vector<uint8_t>				m_levels;
+	VoxelChunkLight*					m_neighbors[6] = {};
+	std::vector<VoxelLightQueueEntry>	m_pending;
+	std::atomic<bool>					m_isDirty{ true };
+};
+
+namespace
+{
+	// Direction order +X -X +Y -Y +Z -Z; each direction's opposite is dir ^ 1
+	constexpr int DIR_POS_Z = 4;
+	constexpr int DIR_NEG_Z = 5;
+	int const DIR_OFFSETS[6][3] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+
+	int FloorDivide(int numerator, int denominator)
+	{
+		int quotient = numerator / denominator;
+		return (numerator % denominator != 0 && (numerator < 0) != (denominator < 0)) ? quotient - 1 : quotient;
+	}
+
+	bool IsRemovalEntry(VoxelLightQueueEntry const& entry)
+	{
+		return entry.m_kind == LIGHT_ENTRY_REMOVE_START || entry.m_kind == LIGHT_ENTRY_REMOVE_PROBE;
+	}
+
+	VoxelLightQueueEntry MakeEntry(int x, int y, int z, VoxelLightEntryKind kind, int channel, int level, bool isFromAbove = false)
+	{
+		VoxelLightQueueEntry entry;
+		entry.m_x = (short)x;
+		entry.m_y = (short)y;
+		entry.m_z = (short)z;
+		entry.m_kind = (uint8_t)kind;
+		entry.m_channel = (uint8_t)channel;
+		entry.m_level = (uint8_t)level;
+		entry.m_isFromAbove = isFromAbove;
+		return entry;
+	}
+
+	int GetLevel(VoxelChunkLight const* chunk, int blockIndex, int channel)
+	{
+		uint8_t packed = chunk->m_levels[blockIndex];
+		return channel == (int)VoxelLightChannel::SKY ? (packed >> 4) : (packed & 0x0F);
+	}
+
+	void SetLevel(VoxelChunkLight* chunk, int blockIndex, int channel, int level)
+	{
+		uint8_t& packed = chunk->m_levels[blockIndex];
+		packed = channel == (int)VoxelLightChannel::SKY ? (uint8_t)((packed & 0x0F) | (level << 4)) : (uint8_t)((packed & 0xF0) | level);
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+class VoxelLightRegionJob : public Job
+{
+public:
+	VoxelLightRegionJob(VoxelLightEngine const* engine, IntVec3 const& regionCoords)
+		: m_engine(engine)
+		, m_regionCoords(regionCoords)
+	{
+	}
+
+	virtual void Execute() override
+	{
+		m_engine->ProcessQueues(m_chunks, &m_regionCoords, m_handOffs);
+	}
+
+public:
+	VoxelLightEngine const*										m_engine = nullptr;
+	IntVec3														m_regionCoords;
+	std::vector<VoxelChunkLight*>								m_chunks;
+	std::vector<std::pair<VoxelChunkLight*, VoxelLightQueueEntry>>	m_handOffs;
+};
+
+//----------------------------------------------------------------------------------------------
+VoxelLightEngine::VoxelLightEngine(VoxelLightEngineConfig const& config)
+	: m_config(config)
+{
+	IntVec3 const& dims = m_config.m_chunkDimensions;
+	GUARANTEE_OR_DIE(dims.x > 0 && dims.y > 0 && dims.z > 0 && dims.x <= 0x7FFF && dims.y <= 0x7FFF && dims.z <= 0x7FFF, "VoxelLightEngine chunk dimensions out of range");
+	GUARANTEE_OR_DIE(m_config.m_regionSizeInChunks.x > 0 && m_config.m_regionSizeInChunks.y > 0 && m_config.m_regionSizeInChunks.z > 0, "VoxelLightEngine region size must be positive");
+
+	int numDefs = (int)m_config.m_blockDefs.size();
+	for (int blockType = 0; blockType < 256; ++blockType)
+	{
+		VoxelLightBlockDef def = blockType < numDefs ? m_config.m_blockDefs[blockType] : VoxelLightBlockDef();
+		m_isOpaque[blockType] = blockType != CHUNK_BLOCK_AIR && def.m_isOpaque;
+		m_emission[blockType] = (uint8_t)(def.m_emission < 0 ? 0 : (def.m_emission > MAX_VOXEL_LIGHT_LEVEL ? MAX_VOXEL_LIGHT_LEVEL : def.m_emission));
+	}
+}
+
+VoxelLightEngine::~VoxelLightEngine()
+{
+	for (auto& chunkPair : m_chunks)
+	{
+		delete chunkPair.second;
+	}
+	m_chunks.clear();
+}
+
+//----------------------------------------------------------------------------------------------
+void VoxelLightEngine::AddChunk(VoxelChunk const* chunk)
+{
+	IntVec3 const& dims = m_config.m_chunkDimensions;
+	GUARANTEE_OR_DIE(chunk != nullptr && chunk->GetDimensions() == dims, "VoxelLightEngine::AddChunk needs a chunk of the configured dimensions");
+	GUARANTEE_OR_DIE(m_chunks.find(chunk->GetChunkCoords()) == m_chunks.end(), "VoxelLightEngine::AddChunk called twice for the same chunk coords");
+
+	VoxelChunkLight* light = new VoxelChunkLight();
+	light->m_chunk = chunk;
+	light->m_coords = chunk->GetChunkCoords();
+	IntVec3 const& regionSize = m_config.m_regionSizeInChunks;
+	light->m_regionCoords = IntVec3(FloorDivide(light->m_coords.x, regionSize.x), FloorDivide(light->m_coords.y, regionSize.y), FloorDivide(light->m_coords.z, regionSize.z));
+	light->m_levels.assign(chunk->GetNumBlocks(), 0);
+	m_chunks[light->m_coords] = light;
+
+	for (int dir = 0; dir < 6; ++dir)
+	{
+		IntVec3 neighborCoords = light->m_coords + IntVec3(DIR_OFFSETS[dir][0], DIR_OFFSETS[dir][1], DIR_OFFSETS[dir][2]);
+		auto found = m_chunks.find(neighborCoords);
+		if (found != m_chunks.end())
+		{
+			light->m_neighbors[dir] = found->second;
+			found->second->m_neighbors[dir ^ 1] = light;
+		}
+	}
+
+	// Emitters
+	chunk->ForEachBlock([&](int blockIndex, ChunkBlockType blockType)
+		{
+			int emission = GetEmission(blockType);
+			if (emission > 0)
+			{
+				IntVec3 local = chunk->GetLocalCoordsForBlockIndex(blockIndex);
+				light->m_pending.push_back(MakeEntry(local.x, local.y, local.z, LIGHT_ENTRY_PROPOSE, (int)VoxelLightChannel::BLOCK, emission));
+			}
+		});
+
+	// Sky enters through the top face when nothing is loaded above, otherwise it flows down from the chunk above
+	if (light->m_neighbors[DIR_POS_Z] == nullptr)
+	{
+		int topZ = dims.z - 1;
+		for (int y = 0; y < dims.y; ++y)
+		{
+			for (int x = 0; x < dims.x; ++x)
+			{
+				if (!IsOpaque(chunk->GetBlock(IntVec3(x, y, topZ))))
+				{
+					light->m_pending.push_back(MakeEntry(x, y, topZ, LIGHT_ENTRY_PROPOSE, (int)VoxelLightChannel::SKY, MAX_VOXEL_LIGHT_LEVEL));
+				}
+			}
+		}
+	}
+
+	// Light already in the neighbors flows in; a chunk below that was open to the sky is now covered
+	for (int dir = 0; dir < 6; ++dir)
+	{
+		if (light->m_neighbors[dir] != nullptr)
+		{
+			QueueSeedsFromBorder(light->m_neighbors[dir], dir ^ 1);
+		}
+	}
+	if (light->m_neighbors[DIR_NEG_Z] != nullptr)
+	{
+		QueueSkyCoveredByChunkAbove(light->m_neighbors[DIR_NEG_Z]);
+	}
+}
+
+void VoxelLightEngine::RemoveChunk(IntVec3 const& chunkCoords)
+{
+	auto found = m_chunks.find(chunkCoords);
+	if (found == m_chunks.end())
+	{
+		return;
+	}
+
+	// Light that flowed out of the removed chunk stays in its neighbors; only the sky of a newly uncovered chunk is restored
+	VoxelChunkLight* light = found->second;
+	for (int dir = 0; dir < 6; ++dir)
+	{
+		if (light->m_neighbors[dir] != nullptr)
+		{
+			light->m_neighbors[dir]->m_neighbors[dir ^ 1] = nullptr;
+		}
+	}
+	VoxelChunkLight* below = light->m_neighbors[DIR_NEG_Z];
+	if (below != nullptr)
+	{
+		IntVec3 const& dims = m_config.m_chunkDimensions;
+		int topZ = dims.z - 1;
+		for (int y = 0; y < dims.y; ++y)
+		{
+			for (int x = 0; x < dims.x; ++x)
+			{
+				if (!IsOpaque(below->m_chunk->GetBlock(IntVec3(x, y, topZ))))
+				{
+					below->m_pending.push_back(MakeEntry(x, y, topZ, LIGHT_ENTRY_PROPOSE, (int)VoxelLightChannel::SKY, MAX_VOXEL_LIGHT_LEVEL));
+				}
+			}
+		}
+	}
+	delete light;
+	m_chunks.erase(found);
+}
+
+void VoxelLightEngine::OnBlockChanged(IntVec3 const& worldCoords)
+{
+	IntVec3 const& dims = m_config.m_chunkDimensions;
+	IntVec3 chunkCoords = GetChunkCoordsForWorldCoords(worldCoords);
+	auto found = m_chunks.find(chunkCoords);
+	if (found == m_chunks.end())
+	{
+		return;
+	}
+	VoxelChunkLight* light = found->second;
+	IntVec3 local = worldCoords - chunkCoords * dims;
+
+	// Drop whatever light the old block had or passed on, then let the surroundings (and its own emission) refill it
+	for (int channel = 0; channel < (int)VoxelLightChannel::COUNT; ++channel)
+	{
+		light->m_pending.push_back(MakeEntry(local.x, local.y, local.z, LIGHT_ENTRY_REMOVE_START, channel, 0));
+	}
+	int const localCoords[3] = { local.x, local.y, local.z };
+	int const dimsArray[3] = { dims.x, dims.y, dims.z };
+	for (int dir = 0; dir < 6; ++dir)
+	{
+		int neighbor[3] = { localCoords[0] + DIR_OFFSETS[dir][0], localCoords[1] + DIR_OFFSETS[dir][1], localCoords[2] + DIR_OFFSETS[dir][2] };
+		VoxelChunkLight* neighborLight = light;
+		int axis = dir >> 1;
+		if (neighbor[axis] < 0 || neighbor[axis] >= dimsArray[axis])
+		{
+			neighborLight = light->m_neighbors[dir];
+			neighbor[axis] = neighbor[axis] < 0 ? dimsArray[axis] - 1 : 0;
+		}
+		if (neighborLight == nullptr)
+		{
+			if (dir == DIR_POS_Z && !IsOpaque(light->m_chunk->GetBlockAtIndex(light->m_chunk->GetBlockIndex(local))))
+			{
+				light->m_pending.push_back(MakeEntry(local.x, local.y, local.z, LIGHT_ENTRY_PROPOSE, (int)VoxelLightChannel::SKY, MAX_VOXEL_LIGHT_LEVEL));
+			}
+			continue;
+		}
+		for (int channel = 0; channel < (int)VoxelLightChannel::COUNT; ++channel)
+		{
+			neighborLight->m_pending.push_back(MakeEntry(neighbor[0], neighbor[1], neighbor[2], LIGHT_ENTRY_SEED, channel, 0));
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+void VoxelLightEngine::PropagateLight(JobSystem* jobSystem)
+{
+	std::vector<std::pair<VoxelChunkLight*, VoxelLightQueueEntry>> handOffs;
+	for (;;)
+	{
+		// Group the chunks with pending work by region
+		std::map<IntVec3, std::vector<VoxelChunkLight*>> chunksByRegion;
+		for (auto& chunkPair : m_chunks)
+		{
+			if (!chunkPair.second->m_pending.empty())
+			{
+				chunksByRegion[chunkPair.second->m_regionCoords].push_back(chunkPair.second);
+			}
+		}
+		if (chunksByRegion.empty())
+		{
+			return;
+		}
+
+		if (jobSystem == nullptr || chunksByRegion.size() == 1)
+		{
+			std::vector<VoxelChunkLight*> chunks;
+			for (auto& regionPair : chunksByRegion)
+			{
+				chunks.insert(chunks.end(), regionPair.second.begin(), regionPair.second.end());
+			}
+			ProcessQueues(chunks, nullptr, handOffs);
+			continue;
+		}
+
+		std::vector<Job*> jobs;
+		for (auto& regionPair : chunksByRegion)
+		{
+			VoxelLightRegionJob* job = new VoxelLightRegionJob(this, regionPair.first);
+			job->m_chunks.swap(regionPair.second);
+			jobs.push_back(job);
+			jobSystem->QueueJob(job);
+		}
+		jobSystem->WaitUntilJobsCompleted(jobs);
+		for (Job* job : jobs)
+		{
+			VoxelLightRegionJob* regionJob = static_cast<VoxelLightRegionJob*>(job);
+			for (auto const& handOff : regionJob->m_handOffs)
+			{
+				handOff.first->m_pending.push_back(handOff.second);
+			}
+			delete job;
+		}
+	}
+}
+
+bool VoxelLightEngine::HasPendingWork() const
+{
+	for (auto const& chunkPair : m_chunks)
+	{
+		if (!chunkPair.second->m_pending.empty())
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+//----------------------------------------------------------------------------------------------
+int VoxelLightEngine::GetLightLevel(IntVec3 const& worldCoords, VoxelLightChannel channel) const
+{
+	IntVec3 chunkCoords = GetChunkCoordsForWorldCoords(worldCoords);
+	auto found = m_chunks.find(chunkCoords);
+	if (found == m_chunks.end())
+	{
+		return 0;
+	}
+	VoxelChunkLight const* light = found->second;
+	return GetLevel(light, light->m_chunk->GetBlockIndex(worldCoords - chunkCoords * m_config.m_chunkDimensions), (int)channel);
+}
+
+uint8_t const* VoxelLightEngine::GetChunkLightLevels(IntVec3 const& chunkCoords) const
+{
+	auto found = m_chunks.find(chunkCoords);
+	return found != m_chunks.end() ? found->second->m_levels.data() : nullptr;
+}
+
+void VoxelLightEngine::ConsumeDirtyChunks(std::vector<IntVec3>& outChunkCoords)
+{
+	for (auto& chunkPair : m_chunks)
+	{
+		if (chunkPair.second->m_isDirty.exchange(false))
+		{
+			outChunkCoords.push_back(chunkPair.first);
+		}
+	}
+}
+
+IntVec3 VoxelLightEngine::GetChunkCoordsForWorldCoords(IntVec3 const& worldCoords) const
+{
+	IntVec3 const& dims = m_config.m_chunkDimensions;
+	return IntVec3(FloorDivide(worldCoords.x, dims.x), FloorDivide(worldCoords.y, dims.y), FloorDivide(worldCoords.z, dims.z));
+}
+
+//----------------------------------------------------------------------------------------------
+void VoxelLightEngine::QueueSeedsFromBorder(VoxelChunkLight* source, int faceDir)
+{
+	IntVec3 const& dims = m_config.m_chunkDimensions;
+	int const dimsArray[3] = { dims.x, dims.y, dims.z };
+	int const axis = faceDir >> 1;
+	int const axisU = (axis + 1) % 3;
+	int const axisV = (axis + 2) % 3;
+	int cell[3];
+	cell[axis] = (faceDir & 1) == 0 ? dimsArray[axis] - 1 : 0;
+	for (int v = 0; v < dimsArray[axisV]; ++v)
+	{
+		for (int u = 0; u < dimsArray[axisU]; ++u)
+		{
+			cell[axisU] = u;
+			cell[axisV] = v;
+			int blockIndex = cell[0] + cell[1] * dims.x + cell[2] * dims.x * dims.y;
+			for (int channel = 0; channel < (int)VoxelLightChannel::COUNT; ++channel)
+			{
+				if (GetLevel(source, blockIndex, channel) > 1)
+				{
+					source->m_pending.push_back(MakeEntry(cell[0], cell[1], cell[2], LIGHT_ENTRY_SEED, channel, 0));
+				}
+			}
+		}
+	}
+}
+
+void VoxelLightEngine::QueueSkyCoveredByChunkAbove(VoxelChunkLight* below)
+{
+	IntVec3 const& dims = m_config.m_chunkDimensions;
+	int topZ = dims.z - 1;
+
+	// Open-sky proposals still queued from when nothing was above (AddChunk, RemoveChunk, OnBlockChanged) are stale;
+	// between PropagateLight calls they are the only full-strength sky proposals in the top layer
+	std::vector<VoxelLightQueueEntry>& pending = below->m_pending;
+	pending.erase(std::remove_if(pending.begin(), pending.end(), [topZ](VoxelLightQueueEntry const& entry)
+		{
+			return entry.m_kind == LIGHT_ENTRY_PROPOSE && entry.m_channel == (int)VoxelLightChannel::SKY && entry.m_z == topZ && entry.m_level == MAX_VOXEL_LIGHT_LEVEL;
+		}), pending.end());
+
+	// Sky already propagated through the top layer is removed and refilled from the sides
+	for (int y = 0; y < dims.y; ++y)
+	{
+		for (int x = 0; x < dims.x; ++x)
+		{
+			int blockIndex = x + y * dims.x + topZ * dims.x * dims.y;
+			if (GetLevel(below, blockIndex, (int)VoxelLightChannel::SKY) == MAX_VOXEL_LIGHT_LEVEL)
+			{
+				below->m_pending.push_back(MakeEntry(x, y, topZ, LIGHT_ENTRY_REMOVE_START, (int)VoxelLightChannel::SKY, 0));
+			}
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+// Drains the pending queues of the given chunks. With regionCoords, light is only written inside that region and any
+// step into another region goes to outHandOffs; without it every chunk is fair game.
+//
+void VoxelLightEngine::ProcessQueues(std::vector<VoxelChunkLight*> const& chunks, IntVec3 const* regionCoords,
+	std::vector<std::pair<VoxelChunkLight*, VoxelLightQueueEntry>>& outHandOffs) const
+{
+	IntVec3 const& dims = m_config.m_chunkDimensions;
+	int const dimsArray[3] = { dims.x, dims.y, dims.z };
+	int const layerSize = dims.x * dims.y;
+
+	typedef std::pair<VoxelChunkLight*, VoxelLightQueueEntry> WorkItem;
+	std::vector<WorkItem> removals;
+	std::vector<WorkItem> additions;
+	for (VoxelChunkLight* chunk : chunks)
+	{
+		for (VoxelLightQueueEntry const& entry : chunk->m_pending)
+		{
+			(IsRemovalEntry(entry) ? removals : additions).push_back(WorkItem(chunk, entry));
+		}
+		chunk->m_pending.clear();
+	}
+
+	auto isInRegion = [regionCoords](VoxelChunkLight const* chunk)
+		{
+			return regionCoords == nullptr || chunk->m_regionCoords == *regionCoords;
+		};
+	auto push = [&](VoxelChunkLight* chunk, VoxelLightQueueEntry const& entry)
+		{
+			if (!isInRegion(chunk))
+			{
+				outHandOffs.push_back(WorkItem(chunk, entry));
+				return;
+			}
+			(IsRemovalEntry(entry) ? removals : additions).push_back(WorkItem(chunk, entry));
+		};
+	auto markDirty = [&](VoxelChunkLight* chunk, int const cell[3])
+		{
+			chunk->m_isDirty.store(true, std::memory_order_relaxed);
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				int dir = cell[axis] == 0 ? axis * 2 + 1 : (cell[axis] == dimsArray[axis] - 1 ? axis * 2 : -1);
+				if (dir >= 0 && chunk->m_neighbors[dir] != nullptr)
+				{
+					chunk->m_neighbors[dir]->m_isDirty.store(true, std::memory_order_relaxed);
+				}
+			}
+		};
+	// Calls visit(neighborChunk, neighborCell, dir) for each loaded neighbor cell
+	auto forEachNeighbor = [&](VoxelChunkLight* chunk, int const cell[3], auto&& visit)
+		{
+			for (int dir = 0; dir < 6; ++dir)
+			{
+				int neighbor[3] = { cell[0] + DIR_OFFSETS[dir][0], cell[1] + DIR_OFFSETS[dir][1], cell[2] + DIR_OFFSETS[dir][2] };
+				VoxelChunkLight* neighborChunk = chunk;
+				int axis = dir >> 1;
+				if (neighbor[axis] < 0 || neighbor[axis] >= dimsArray[axis])
+				{
+					neighborChunk = chunk->m_neighbors[dir];
+					if (neighborChunk == nullptr)
+					{
+						continue;
+					}
+					neighbor[axis] = neighbor[axis] < 0 ? dimsArray[axis] - 1 : 0;
+				}
+				visit(neighborChunk, neighbor, dir);
+			}
+		};
+	auto spread = [&](VoxelChunkLight* chunk, int const cell[3], int channel, int level)
+		{
+			forEachNeighbor(chunk, cell, [&](VoxelChunkLight* neighborChunk, int const neighbor[3], int dir)
+				{
+					bool isSkyFall = channel == (int)VoxelLightChannel::SKY && dir == DIR_NEG_Z && level == MAX_VOXEL_LIGHT_LEVEL;
+					int neighborLevel = isSkyFall ? level : level - 1;
+					if (neighborLevel <= 0)
+					{
+						return;
+					}
+					if (isInRegion(neighborChunk) && GetLevel(neighborChunk, neighbor[0] + neighbor[1] * dims.x + neighbor[2] * layerSize, channel) >= neighborLevel)
+					{
+						return;
+					}
+					push(neighborChunk, MakeEntry(neighbor[0], neighbor[1], neighbor[2], LIGHT_ENTRY_PROPOSE, channel, neighborLevel));
+				});
+		};
+	auto proposeOwnEmission = [&](VoxelChunkLight* chunk, int const cell[3], int blockIndex, int channel)
+		{
+			int emission = channel == (int)VoxelLightChannel::BLOCK ? GetEmission(chunk->m_chunk->GetBlockAtIndex(blockIndex)) : 0;
+			if (emission > 0)
+			{
+				push(chunk, MakeEntry(cell[0], cell[1], cell[2], LIGHT_ENTRY_PROPOSE, channel, emission));
+			}
+		};
+
+	// Removal flood
+	for (size_t itemIndex = 0; itemIndex < removals.size(); ++itemIndex)
+	{
+		VoxelChunkLight* chunk = removals[itemIndex].first;
+		VoxelLightQueueEntry entry = removals[itemIndex].second;
+		int const cell[3] = { entry.m_x, entry.m_y, entry.m_z };
+		int const blockIndex = cell[0] + cell[1] * dims.x + cell[2] * layerSize;
+		int const channel = entry.m_channel;
+		int const level = GetLevel(chunk, blockIndex, channel);
+
+		bool dependsOnRemovedLight = entry.m_kind == LIGHT_ENTRY_REMOVE_START || level < entry.m_level
+			|| (channel == (int)VoxelLightChannel::SKY && entry.m_isFromAbove && entry.m_level == MAX_VOXEL_LIGHT_LEVEL && level == MAX_VOXEL_LIGHT_LEVEL);
+		if (level == 0)
+		{
+			if (entry.m_kind == LIGHT_ENTRY_REMOVE_START)
+			{
+				proposeOwnEmission(chunk, cell, blockIndex, channel);
+			}
+			continue;
+		}
+		if (!dependsOnRemovedLight)
+		{
+			// Independently lit and at least as bright: it refills the hole
+			push(chunk, MakeEntry(cell[0], cell[1], cell[2], LIGHT_ENTRY_SEED, channel, 0));
+			continue;
+		}
+
+		SetLevel(chunk, blockIndex, channel, 0);
+		markDirty(chunk, cell);
+		forEachNeighbor(chunk, cell, [&](VoxelChunkLight* neighborChunk, int const neighbor[3], int dir)
+			{
+				push(neighborChunk, MakeEntry(neighbor[0], neighbor[1], neighbor[2], LIGHT_ENTRY_REMOVE_PROBE, channel, level, dir == DIR_NEG_Z));
+			});
+		proposeOwnEmission(chunk, cell, blockIndex, channel);
+	}
+	removals.clear();
+
+	// Addition flood
+	for (size_t itemIndex = 0; itemIndex < additions.size(); ++itemIndex)
+	{
+		VoxelChunkLight* chunk = additions[itemIndex].first;
+		VoxelLightQueueEntry entry = additions[itemIndex].second;
+		int const cell[3] = { entry.m_x, entry.m_y, entry.m_z };
+		int const blockIndex = cell[0] + cell[1] * dims.x + cell[2] * layerSize;
+		int const channel = entry.m_channel;
+		int const level = GetLevel(chunk, blockIndex, channel);
+
+		if (entry.m_kind == LIGHT_ENTRY_SEED)
+		{
+			if (level > 0)
+			{
+				spread(chunk, cell, channel, level);
+			}
+			continue;
+		}
+
+		// Opaque cells only hold their own emission
+		ChunkBlockType blockType = chunk->m_chunk->GetBlockAtIndex(blockIndex);
+		int maxLevel = IsOpaque(blockType) ? (channel == (int)VoxelLightChannel::BLOCK ? GetEmission(blockType) : 0) : MAX_VOXEL_LIGHT_LEVEL;
+		int newLevel = entry.m_level < maxLevel ? entry.m_level : maxLevel;
+		if (newLevel <= level)
+		{
+			continue;
+		}
+		SetLevel(chunk, blockIndex, channel, newLevel);
+		markDirty(chunk, cell);
+		spread(chunk, cell, channel, newLevel);
+	}
+	additions.clear();
+}
\ No newline at end of file
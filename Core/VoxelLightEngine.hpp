@@ -0,0 +1,95 @@
+#pragma once
+#include "Engine/Core/VoxelChunk.hpp"
+#include "Engine/Math/IntVec3.hpp"
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+class JobSystem;
+
+//----------------------------------------------------------------------------------------------
+// Flood-fill sky and block light over registered VoxelChunks, 4 bits per channel (0..MAX_VOXEL_LIGHT_LEVEL).
+// Chunk (cx,cy,cz) covers world blocks [cx*dimX, (cx+1)*dimX) etc.; +Z is up.
+//
+// Light only ever changes through queued work: adding a chunk seeds its emitters, its sky (when no chunk is
+// loaded above it) and the light flowing in from loaded neighbors; OnBlockChanged queues a removal flood from the
+// changed cell plus re-seeds around it. PropagateLight then drains the queues, touching only the cells whose light
+// actually changes. Sky light of 15 travels straight down without falloff; everything else loses one level per
+// step. Every chunk whose light changes (or whose border neighbor's light changes) is flagged for remeshing.
+//
+// With a JobSystem, chunks with pending work are grouped into regions of m_regionSizeInChunks and each region is
+// drained by one job. A job only writes light inside its own region; steps that cross into another region are
+// handed over and picked up by the next pass, so passes repeat until no work is left. The registered VoxelChunks
+// must not be modified while PropagateLight runs.
+//
+constexpr int MAX_VOXEL_LIGHT_LEVEL = 15;
+
+enum class VoxelLightChannel
+{
+	SKY,
+	BLOCK,
+	COUNT
+};
+
+struct VoxelLightBlockDef
+{
+	bool	m_isOpaque = true;
+	int		m_emission = 0;		// block light emitted, 0..MAX_VOXEL_LIGHT_LEVEL
+};
+
+struct VoxelLightEngineConfig
+{
+	IntVec3							m_chunkDimensions = IntVec3(16, 16, 128);
+	std::vector<VoxelLightBlockDef>	m_blockDefs;		// indexed by block type; air is never opaque, types past the end are opaque
+	IntVec3							m_regionSizeInChunks = IntVec3(4, 4, 1);
+};
+
+struct VoxelLightQueueEntry;
+struct VoxelChunkLight;
+
+class VoxelLightEngine
+{
+public:
+	explicit VoxelLightEngine(VoxelLightEngineConfig const& config);
+	~VoxelLightEngine();
+	VoxelLightEngine(VoxelLightEngine const& copy) = delete;
+	VoxelLightEngine& operator=(VoxelLightEngine const& copy) = delete;
+
+	// The chunk must have the configured dimensions and stay alive until RemoveChunk; light starts dark and is
+	// filled in by the next PropagateLight
+	void			AddChunk(VoxelChunk const* chunk);
+	void			RemoveChunk(IntVec3 const& chunkCoords);
+
+	// Call after the block at worldCoords has been changed in its VoxelChunk
+	void			OnBlockChanged(IntVec3 const& worldCoords);
+
+	// Drains all queued light work; inline when jobSystem is null
+	void			PropagateLight(JobSystem* jobSystem = nullptr);
+	bool			HasPendingWork() const;
+
+	int				GetLightLevel(IntVec3 const& worldCoords, VoxelLightChannel channel) const;	// 0 outside loaded chunks
+	uint8_t const*	GetChunkLightLevels(IntVec3 const& chunkCoords) const;	// sky << 4 | block per block index, null if not loaded
+
+	// Chunks whose light changed since the last call, for remeshing
+	void			ConsumeDirtyChunks(std::vector<IntVec3>& outChunkCoords);
+
+	IntVec3			GetChunkCoordsForWorldCoords(IntVec3 const& worldCoords) const;
+
+private:
+	friend class VoxelLightRegionJob;
+
+	void			QueueSeedsFromBorder(VoxelChunkLight* source, int faceDir);
+	void			QueueSkyCoveredByChunkAbove(VoxelChunkLight* below);
+	void			ProcessQueues(std::vector<VoxelChunkLight*> const& chunks, IntVec3 const* regionCoords,
+						std::vector<std::pair<VoxelChunkLight*, VoxelLightQueueEntry>>& outHandOffs) const;
+	bool			IsOpaque(ChunkBlockType blockType) const			{ return m_isOpaque[blockType]; }
+	int				GetEmission(ChunkBlockType blockType) const			{ return m_emission[blockType]; }
+
+private:
+	VoxelLightEngineConfig					m_config;
+	bool									m_isOpaque[256];
+	uint8_t									m_emission[256];
+	std::map<IntVec3, VoxelChunkLight*>		m_chunks;
+};
\ No newline at end of file
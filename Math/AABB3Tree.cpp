@@ -0,0 +1,81 @@
+#include "Engine/Math/AABB3Tree.hpp"
+#include <algorithm>
+
+void AABB3Tree::Build(std::vector<AABB3> const& boxes)
+{
+	Clear();
+	int numBoxes = (int)boxes.size();
+	if (numBoxes == 0)
+	{
+		return;
+	}
+
+	m_primitiveBounds = boxes;
+	m_primitiveIndices.resize(numBoxes);
+	std::vector<Vec3> centroids(numBoxes);
+	for (int boxIndex = 0; boxIndex < numBoxes; ++boxIndex)
+	{
+		m_primitiveIndices[boxIndex] = boxIndex;
+		centroids[boxIndex] = boxes[boxIndex].GetCenter();
+	}
+
+	m_nodes.reserve(2 * (numBoxes / MAX_PRIMITIVES_PER_LEAF + 1));
+	m_nodes.emplace_back();
+	BuildNode(0, 0, numBoxes, centroids);
+}
+
+void AABB3Tree::Clear()
+{
+	m_nodes.clear();
+	m_primitiveIndices.clear();
+	m_primitiveBounds.clear();
+}
+
+void AABB3Tree::BuildNode(int nodeIndex, int firstPrimitive, int numPrimitives, std::vector<Vec3> const& centroids)
+{
+	AABB3 bounds = m_primitiveBounds[m_primitiveIndices[firstPrimitive]];
+	AABB3 centroidBounds(centroids[m_primitiveIndices[firstPrimitive]], centroids[m_primitiveIndices[firstPrimitive]]);
+	for (int i = firstPrimitive + 1; i < firstPrimitive + numPrimitives; ++i)
+	{
+		AABB3 const& box = m_primitiveBounds[m_primitiveIndices[i]];
+		Vec3 const& centroid = centroids[m_primitiveIndices[i]];
+		bounds.m_mins = Vec3(std::min(bounds.m_mins.x, box.m_mins.x), std::min(bounds.m_mins.y, box.m_mins.y), std::min(bounds.m_mins.z, box.m_mins.z));
+		bounds.m_maxs = Vec3(std::max(bounds.m_maxs.x, box.m_maxs.x), std::max(bounds.m_maxs.y, box.m_maxs.y), std::max(bounds.m_maxs.z, box.m_maxs.z));
+		centroidBounds.m_mins = Vec3(std::min(centroidBounds.m_mins.x, centroid.x), std::min(centroidBounds.m_mins.y, centroid.y), std::min(centroidBounds.m_mins.z, centroid.z));
+		centroidBounds.m_maxs = Vec3(std::max(centroidBounds.m_maxs.x, centroid.x), std::max(centroidBounds.m_maxs.y, centroid.y), std::max(centroidBounds.m_maxs.z, centroid.z));
+	}
+	m_nodes[nodeIndex].m_bounds = bounds;
+
+	if (numPrimitives <= MAX_PRIMITIVES_PER_LEAF)
+	{
+		m_nodes[nodeIndex].m_firstChildOrPrimitive = firstPrimitive;
+		m_nodes[nodeIndex].m_numPrimitives = numPrimitives;
+		return;
+	}
+
+	// Split at the median centroid along the axis with the widest centroid spread
+	Vec3 spread = centroidBounds.GetDimensions();
+	int axis = 0;
+	if (spread.y > spread.x) axis = 1;
+	if (spread.z > (axis == 0 ? spread.x : spread.y)) axis = 2;
+
+	int* first = m_primitiveIndices.data() + firstPrimitive;
+	int* median = first + numPrimitives / 2;
+	int* last = first + numPrimitives;
+	std::nth_element(first, median, last, [&](int a, int b)
+		{
+			float centroidA = axis == 0 ? centroids[a].x : (axis == 1 ? centroids[a].y : centroids[a].z);
+			float centroidB = axis == 0 ? centroids[b].x : (axis == 1 ? centroids[b].y : centroids[b].z);
+			return centroidA < centroidB;
+		});
+
+	int leftChild = (int)m_nodes.size();
+	m_nodes.emplace_back();
+	m_nodes.emplace_back();
+	m_nodes[nodeIndex].m_firstChildOrPrimitive = leftChild;
+	m_nodes[nodeIndex].m_numPrimitives = 0;
+
+	int numLeft = numPrimitives / 2;
+	BuildNode(leftChild, firstPrimitive, numLeft, centroids);
+	BuildNode(leftChild + 1, firstPrimitive + numLeft, numPrimitives - numLeft, centroids);
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+#include "Engine/Math/AABB3.hpp"
+#include <vector>
+
+//----------------------------------------------------------------------------------------------
+// Static bounding volume hierarchy over a list of AABB3s, built by splitting at the median
+// centroid along the axis with the widest centroid spread. Leaves hold up to MAX_PRIMITIVES_PER_LEAF boxes.
+// Rebuild when the boxes move; there is no refit.
+//
+struct AABB3TreeNode
+{
+	AABB3	m_bounds;
+	int		m_firstChildOrPrimitive = 0;	// index of the left child (right is +1), or first entry in m_primitiveIndices for leaves
+	int		m_numPrimitives = 0;			// 0 for interior nodes
+
+	bool IsLeaf() const { return m_numPrimitives > 0; }
+};
+
+class AABB3Tree
+{
+public:
+	static constexpr int MAX_PRIMITIVES_PER_LEAF = 8;
+
+	void Build(std::vector<AABB3> const& boxes);
+	void Clear();
+
+	bool IsEmpty() const { return m_nodes.empty(); }
+	std::vector<AABB3TreeNode> const& GetNodes() const { return m_nodes; }
+	std::vector<int> const& GetPrimitiveIndices() const { return m_primitiveIndices; }
+	std::vector<AABB3> const& GetPrimitiveBounds() const { return m_primitiveBounds; }
+
+private:
+	void BuildNode(int nodeIndex, int firstPrimitive, int numPrimitives, std::vector<Vec3> const& centroids);
+
+private:
+	std::vector<AABB3TreeNode>	m_nodes;				// m_nodes[0] is the root
+	std::vector<int>			m_primitiveIndices;		// leaf ranges point into this, values index the original boxes
+	std::vector<AABB3>			m_primitiveBounds;		// copy of the original boxes
+};
\ No newline at end of file
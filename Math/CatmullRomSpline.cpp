@@ -11,6 +11,8 @@ void CatmullRomSpline::SetPositions(std::vector<Vec2> const& points)
 {
 	m_positions = points;
 	m_velocities.resize(m_positions.size());
+	m_sections.clear();
+	m_arcLengthTable.Clear();
 	if (m_positions.empty())
 	{
 		return;
@@ -27,6 +29,29 @@ void CatmullRomSpline::SetPositions(std::vector<Vec2> const& points)
 		Vec2 disOutof = nextPos - thisPos;
 		m_velocities[i] = (dispInto + disOutof) * 0.5f;
 	}
+
+	std::vector<CubicPolynomial3D> sections3D;
+	m_sections.reserve(m_positions.size());
+	sections3D.reserve(m_positions.size());
+	for (int i = 0; i < (int)m_positions.size() - 1; ++i)
+	{
+		CubicPolynomial2D section = CubicPolynomial2D::MakeFromHermite(m_positions[i], m_velocities[i], m_positions[i + 1], m_velocities[i + 1]);
+		m_sections.push_back(section);
+
+		CubicPolynomial3D section3D;
+		section3D.m_a = Vec3(section.m_a.x, section.m_a.y, 0.f);
+		section3D.m_b = Vec3(section.m_b.x, section.m_b.y, 0.f);
+		section3D.m_c = Vec3(section.m_c.x, section.m_c.y, 0.f);
+		section3D.m_d = Vec3(section.m_d.x, section.m_d.y, 0.f);
+		sections3D.push_back(section3D);
+	}
+	m_arcLengthTable.Build(sections3D, ARC_LENGTH_TABLE_SUBDIVISIONS);
+}
+
+bool CatmullRomSpline::IsArcLengthTableUsable(int numSubdivisions) const
+{
+	return numSubdivisions == m_arcLengthTable.GetSubdivisionsPerSegment()
+		&& m_arcLengthTable.GetNumSegments() == (int)m_positions.size() - 1;
 }
 
 Vec2 CatmullRomSpline::EvaluateAtParametric(float parametricZeroToNumCurveSections, int segmentIndex) const
@@ -34,6 +59,10 @@ Vec2 CatmullRomSpline::EvaluateAtParametric(float parametricZeroToNumCurveSectio
 	if (m_positions.size() < 2) return Vec2();
 
 	float localT = parametricZeroToNumCurveSections - segmentIndex;
+	if ((int)m_sections.size() == (int)m_positions.size() - 1)
+	{
+		return m_sections[segmentIndex].Evaluate(localT);
+	}
 
 	Vec2 p0 = m_positions[segmentIndex];
 	Vec2 p1 = m_positions[segmentIndex + 1];
@@ -46,6 +75,7 @@ Vec2 CatmullRomSpline::EvaluateAtParametric(float parametricZeroToNumCurveSectio
 float CatmullRomSpline::GetApproximateLength(int numSubdivisions /*= 64*/) const
 {
 	if ((int)m_positions.size() < 2) return 0.0f;
+	if (IsArcLengthTableUsable(numSubdivisions)) return m_arcLengthTable.GetTotalLength();
 
 	float totalLength = 0.0f;
 	for (int i = 0; i < (int)m_positions.size() - 1; ++i) {
@@ -63,6 +93,7 @@ float CatmullRomSpline::GetApproximateLength(int numSubdivisions /*= 64*/) const
 Vec2 CatmullRomSpline::EvaluateAtApproximateDistance(float distance, int numSubdivisions /*= 64*/) const
 {
 	if ((int)m_positions.size() < 2) return Vec2();
+	if (IsArcLengthTableUsable(numSubdivisions)) return m_arcLengthTable.EvaluateAtDistance(distance);
 
 	float totalLength = 0.0f;
 	Vec2 pointOnCurve;
@@ -84,6 +115,19 @@ Vec2 CatmullRomSpline::EvaluateAtApproximateDistance(float distance, int numSubd
 	return m_positions.back();
 }
 
+void CatmullRomSpline::EvaluateAtApproximateDistances(float const* distancesAlongCurve, Vec2* out_positions, int count) const
+{
+	if (IsArcLengthTableUsable(ARC_LENGTH_TABLE_SUBDIVISIONS))
+	{
+		m_arcLengthTable.EvaluateAtDistances(distancesAlongCurve, out_positions, count);
+		return;
+	}
+	for (int i = 0; i < count; ++i)
+	{
+		out_positions[i] = EvaluateAtApproximateDistance(distancesAlongCurve[i]);
+	}
+}
+
 //CatmullRomSpline::CatmullRomSpline(const std::vector<Vec2>& points)
 //	:m_positions(points)
 //{
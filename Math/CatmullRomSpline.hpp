@@ -1,10 +1,18 @@
 #pragma once
 #include <vector>
 #include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/CurveArcLengthTable.hpp"
+#include "Engine/Math/CubicPolynomial.hpp"
 
+//----------------------------------------------------------------------------------------------
+// SetPositions converts every section to a CubicPolynomial2D once and builds an arc-length table (64 subdivisions
+// per segment), which GetApproximateLength and EvaluateAtApproximateDistance use whenever they are called with that
+// subdivision count. Call SetPositions again after editing m_positions directly, or evaluation and the distance
+// queries keep answering for the old curve.
+//
 class CatmullRomSpline {
 public:
-	
+	static constexpr int ARC_LENGTH_TABLE_SUBDIVISIONS = 64;
 
 	CatmullRomSpline() = default;
 	CatmullRomSpline(const std::vector<Vec2>& points);
@@ -12,10 +20,19 @@ public:
 	Vec2 EvaluateAtParametric(float parametricZeroToNumCurveSections, int segmentIndex) const;
 	float GetApproximateLength(int numSubdivisions = 64) const;
 	Vec2 EvaluateAtApproximateDistance(float distanceAlongCurve, int numSubdivisions = 64) const;
-	
+	void EvaluateAtApproximateDistances(float const* distancesAlongCurve, Vec2* out_positions, int count) const;
+	CurveArcLengthTable const& GetArcLengthTable() const { return m_arcLengthTable; }
+
+private:
+	bool IsArcLengthTableUsable(int numSubdivisions) const;
+
 public:
 	std::vector<Vec2> m_positions;
 	std::vector<Vec2> m_velocities;
+
+private:
+	std::vector<CubicPolynomial2D> m_sections;
+	CurveArcLengthTable m_arcLengthTable;
 };
 
 
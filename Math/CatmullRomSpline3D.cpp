@@ -0,0 +1,198 @@
+#include "Engine/Math/CatmullRomSpline3D.hpp"
+#include "Engine/Math/SimdMath.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include <cmath>
+
+namespace
+{
+	// Evaluates SIMD_WIDTH consecutive samples of one section: lane i is at parametric (firstSample + i) * step
+	void EvaluateSectionSamples(CubicPolynomial3D const& section, int firstSample, float step, Vec3* out_positions, Vec3* out_velocities)
+	{
+		alignas(32) float laneOffsets[SIMD_WIDTH];
+		for (int lane = 0; lane < SIMD_WIDTH; ++lane)
+		{
+			laneOffsets[lane] = (float)(firstSample + lane);
+		}
+		SimdFloat t = SimdMul(SimdLoad(laneOffsets), SimdSplat(step));
+
+		float const coefficients[3][4] =
+		{
+			{ section.m_a.x, section.m_b.x, section.m_c.x, section.m_d.x },
+			{ section.m_a.y, section.m_b.y, section.m_c.y, section.m_d.y },
+			{ section.m_a.z, section.m_b.z, section.m_c.z, section.m_d.z },
+		};
+		alignas(32) float positions[3][SIMD_WIDTH];
+		alignas(32) float velocities[3][SIMD_WIDTH];
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			SimdFloat a = SimdSplat(coefficients[axis][0]);
+			SimdFloat b = SimdSplat(coefficients[axis][1]);
+			SimdFloat c = SimdSplat(coefficients[axis][2]);
+			SimdFloat d = SimdSplat(coefficients[axis][3]);
+			SimdFloat position = SimdAdd(SimdMul(SimdAdd(SimdMul(SimdAdd(SimdMul(a, t), b), t), c), t), d);
+			SimdStore(positions[axis], position);
+			if (out_velocities != nullptr)
+			{
+				SimdFloat threeA = SimdMul(a, SimdSplat(3.f));
+				SimdFloat twoB = SimdMul(b, SimdSplat(2.f));
+				SimdStore(velocities[axis], SimdAdd(SimdMul(SimdAdd(SimdMul(threeA, t), twoB), t), c));
+			}
+		}
+
+		// Component stores: Vec3's constructor and assignment live in Vec3.cpp and would cost a call per sample
+		for (int lane = 0; lane < SIMD_WIDTH; ++lane)
+		{
+			out_positions[lane].x = positions[0][lane];
+			out_positions[lane].y = positions[1][lane];
+			out_positions[lane].z = positions[2][lane];
+		}
+		if (out_velocities != nullptr)
+		{
+			for (int lane = 0; lane < SIMD_WIDTH; ++lane)
+			{
+				out_velocities[lane].x = velocities[0][lane];
+				out_velocities[lane].y = velocities[1][lane];
+				out_velocities[lane].z = velocities[2][lane];
+			}
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+CatmullRomSpline3D::CatmullRomSpline3D(std::vector<Vec3> const& points)
+{
+	SetPositions(points);
+}
+
+void CatmullRomSpline3D::SetPositions(std::vector<Vec3> const& points)
+{
+	m_positions = points;
+	m_velocities.resize(m_positions.size());
+	m_sections.clear();
+	m_arcLengthTable.Clear();
+	if (m_positions.empty())
+	{
+		return;
+	}
+	m_velocities[0] = Vec3();
+	m_velocities.back() = Vec3();
+
+	int numPoints = (int)m_positions.size();
+	for (int i = 1; i < numPoints - 1; ++i)
+	{
+		m_velocities[i] = (m_positions[i + 1] - m_positions[i - 1]) * 0.5f;
+	}
+
+	m_sections.reserve(numPoints - 1);
+	for (int i = 0; i < numPoints - 1; ++i)
+	{
+		m_sections.push_back(CubicPolynomial3D::MakeFromHermite(m_positions[i], m_velocities[i], m_positions[i + 1], m_velocities[i + 1]));
+	}
+	m_arcLengthTable.Build(m_sections, ARC_LENGTH_TABLE_SUBDIVISIONS);
+}
+
+//----------------------------------------------------------------------------------------------
+void CatmullRomSpline3D::GetSectionAndLocalParametric(float parametricZeroToNumSections, int& out_sectionIndex, float& out_localParametric) const
+{
+	int numSections = GetNumSections();
+	float clampedParametric = fmaxf(0.f, fminf(parametricZeroToNumSections, (float)numSections));
+	out_sectionIndex = (int)clampedParametric;
+	if (out_sectionIndex >= numSections)
+	{
+		out_sectionIndex = numSections - 1;
+	}
+	out_localParametric = clampedParametric - (float)out_sectionIndex;
+}
+
+Vec3 CatmullRomSpline3D::EvaluateAtParametric(float parametricZeroToNumSections) const
+{
+	if (m_sections.empty())
+	{
+		return m_positions.empty() ? Vec3() : m_positions[0];
+	}
+	int sectionIndex = 0;
+	float localParametric = 0.f;
+	GetSectionAndLocalParametric(parametricZeroToNumSections, sectionIndex, localParametric);
+	return m_sections[sectionIndex].Evaluate(localParametric);
+}
+
+Vec3 CatmullRomSpline3D::EvaluateVelocityAtParametric(float parametricZeroToNumSections) const
+{
+	if (m_sections.empty())
+	{
+		return Vec3();
+	}
+	int sectionIndex = 0;
+	float localParametric = 0.f;
+	GetSectionAndLocalParametric(parametricZeroToNumSections, sectionIndex, localParametric);
+	return m_sections[sectionIndex].EvaluateVelocity(localParametric);
+}
+
+int CatmullRomSpline3D::GetNumUniformSamples(int samplesPerSection) const
+{
+	return m_sections.empty() ? 0 : GetNumSections() * samplesPerSection + 1;
+}
+
+void CatmullRomSpline3D::EvaluateUniformSamples(int samplesPerSection, Vec3* out_positions, Vec3* out_velocities) const
+{
+	GUARANTEE_OR_DIE(samplesPerSection > 0, "EvaluateUniformSamples needs at least one sample per section");
+	float step = 1.f / (float)samplesPerSection;
+	int sampleIndex = 0;
+	for (CubicPolynomial3D const& section : m_sections)
+	{
+		int sample = 0;
+		for (; sample + SIMD_WIDTH <= samplesPerSection; sample += SIMD_WIDTH)
+		{
+			EvaluateSectionSamples(section, sample, step, out_positions + sampleIndex, out_velocities ? out_velocities + sampleIndex : nullptr);
+			sampleIndex += SIMD_WIDTH;
+		}
+		for (; sample < samplesPerSection; ++sample)
+		{
+			float t = step * (float)sample;
+			out_positions[sampleIndex] = section.Evaluate(t);
+			if (out_velocities != nullptr)
+			{
+				out_velocities[sampleIndex] = section.EvaluateVelocity(t);
+			}
+			++sampleIndex;
+		}
+	}
+
+	// The shared end point of the last section
+	if (!m_sections.empty())
+	{
+		out_positions[sampleIndex] = m_sections.back().Evaluate(1.f);
+		if (out_velocities != nullptr)
+		{
+			out_velocities[sampleIndex] = m_sections.back().EvaluateVelocity(1.f);
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+float CatmullRomSpline3D::GetApproximateLength() const
+{
+	return m_arcLengthTable.GetTotalLength();
+}
+
+Vec3 CatmullRomSpline3D::EvaluateAtApproximateDistance(float distanceAlongCurve) const
+{
+	if (m_sections.empty())
+	{
+		return m_positions.empty() ? Vec3() : m_positions[0];
+	}
+	return m_arcLengthTable.EvaluateAtDistance3D(distanceAlongCurve);
+}
+
+void CatmullRomSpline3D::EvaluateAtApproximateDistances(float const* distancesAlongCurve, Vec3* out_positions, int count) const
+{
+	if (m_sections.empty())
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			out_positions[i] = EvaluateAtApproximateDistance(distancesAlongCurve[i]);
+		}
+		return;
+	}
+	m_arcLengthTable.EvaluateAtDistances(distancesAlongCurve, out_positions, count);
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/CubicPolynomial.hpp"
+#include "Engine/Math/CurveArcLengthTable.hpp"
+#include <vector>
+
+//----------------------------------------------------------------------------------------------
+// 3D Catmull-Rom spline for camera paths, projectile trails and the like. Same velocities as CatmullRomSpline
+// (average of the neighboring displacements, zero at both ends). SetPositions converts every section to a
+// CubicPolynomial3D once and builds the arc-length table, so all evaluation afterwards is Horner math.
+//
+// EvaluateUniformSamples fills evenly spaced parametric samples SIMD_WIDTH at a time; the spline mesh builders in
+// VertexUtils tessellate from it.
+//
+class CatmullRomSpline3D
+{
+public:
+	static constexpr int ARC_LENGTH_TABLE_SUBDIVISIONS = 64;
+
+	CatmullRomSpline3D() = default;
+	explicit CatmullRomSpline3D(std::vector<Vec3> const& points);
+	void SetPositions(std::vector<Vec3> const& points);
+
+	int GetNumSections() const										{ return (int)m_sections.size(); }
+	std::vector<Vec3> const& GetPositions() const					{ return m_positions; }
+	std::vector<Vec3> const& GetVelocities() const					{ return m_velocities; }
+	std::vector<CubicPolynomial3D> const& GetSections() const		{ return m_sections; }
+	CurveArcLengthTable const& GetArcLengthTable() const			{ return m_arcLengthTable; }
+
+	// Parametric runs from 0 at the first point to GetNumSections() at the last, and is clamped to that range
+	Vec3 EvaluateAtParametric(float parametricZeroToNumSections) const;
+	Vec3 EvaluateVelocityAtParametric(float parametricZeroToNumSections) const;
+	// GetNumUniformSamples(samplesPerSection) samples at parametric i / samplesPerSection; out_velocities may be null
+	int GetNumUniformSamples(int samplesPerSection) const;
+	void EvaluateUniformSamples(int samplesPerSection, Vec3* out_positions, Vec3* out_velocities = nullptr) const;
+
+	float GetApproximateLength() const;
+	Vec3 EvaluateAtApproximateDistance(float distanceAlongCurve) const;
+	void EvaluateAtApproximateDistances(float const* distancesAlongCurve, Vec3* out_positions, int count) const;
+
+private:
+	void GetSectionAndLocalParametric(float parametricZeroToNumSections, int& out_sectionIndex, float& out_localParametric) const;
+
+private:
+	std::vector<Vec3>				m_positions;
+	std::vector<Vec3>				m_velocities;
+	std::vector<CubicPolynomial3D>	m_sections;
+	CurveArcLengthTable				m_arcLengthTable;
+};
\ No newline at end of file
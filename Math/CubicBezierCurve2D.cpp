@@ -33,6 +33,10 @@ Vec2 CubicBezierCurve2D::EvaluateAtParametric(float parametricZeroToOne) const
 
 float CubicBezierCurve2D::GetApproximateLength(int numSubdivisions /*= 64*/) const
 {
+	if (m_arcLengthTable.IsBuilt() && numSubdivisions == m_arcLengthTable.GetSubdivisionsPerSegment())
+	{
+		return m_arcLengthTable.GetTotalLength();
+	}
 	float tperStep = 1.f / float(numSubdivisions);
 	float curveLength = 0.0f;
 	Vec2 endPos;
@@ -48,6 +52,10 @@ float CubicBezierCurve2D::GetApproximateLength(int numSubdivisions /*= 64*/) con
 
 Vec2 CubicBezierCurve2D::EvaluateAtApproximateDistance(float distanceAlongCurve, int numSubdivisions /*= 64*/) const
 {
+	if (m_arcLengthTable.IsBuilt() && numSubdivisions == m_arcLengthTable.GetSubdivisionsPerSegment())
+	{
+		return m_arcLengthTable.EvaluateAtDistance(distanceAlongCurve);
+	}
 	float tperStep = 1.f / float(numSubdivisions);
 	Vec2 startPos = m_startPos;
 	Vec2 endPos = m_startPos;
@@ -68,3 +76,20 @@ Vec2 CubicBezierCurve2D::EvaluateAtApproximateDistance(float distanceAlongCurve,
 	return Vec2();
 }
 
+void CubicBezierCurve2D::EvaluateAtApproximateDistances(float const* distancesAlongCurve, Vec2* out_positions, int count) const
+{
+	if (m_arcLengthTable.IsBuilt())
+	{
+		m_arcLengthTable.EvaluateAtDistances(distancesAlongCurve, out_positions, count);
+		return;
+	}
+	for (int i = 0; i < count; i++)
+	{
+		out_positions[i] = EvaluateAtApproximateDistance(distancesAlongCurve[i]);
+	}
+}
+
+void CubicBezierCurve2D::BuildArcLengthTable(int numSubdivisions /*= 64*/)
+{
+	m_arcLengthTable.Build({ m_startPos, m_guidePos1, m_guidePos2, m_endPos }, numSubdivisions);
+}
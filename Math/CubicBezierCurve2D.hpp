@@ -1,6 +1,7 @@
 #pragma once
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/CubicHermiteCurve.hpp"
+#include "Engine/Math/CurveArcLengthTable.hpp"
 
 class CubicBezierCurve2D
 {
@@ -10,10 +11,18 @@ public:
 	Vec2 EvaluateAtParametric(float parametricZeroToOne) const;
 	float GetApproximateLength(int numSubdivisions = 64) const;
 	Vec2 EvaluateAtApproximateDistance(float distanceAlongCurve, int numSubdivisions = 64) const;
+	void EvaluateAtApproximateDistances(float const* distancesAlongCurve, Vec2* out_positions, int count) const;
+
+	// Optional cache for curves queried many times; the two functions above use it when numSubdivisions matches.
+	// Rebuild after moving any of the four points.
+	void BuildArcLengthTable(int numSubdivisions = 64);
 
 public:
 	Vec2 m_startPos;
 	Vec2 m_guidePos1;
 	Vec2 m_guidePos2;
 	Vec2 m_endPos;
+
+private:
+	CurveArcLengthTable m_arcLengthTable;
 };
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "Engine/Math/CubicBezierCurve3D.hpp"
+#include "Engine/Math/CubicHermiteCurve.hpp"
+#include "Engine/Math/CubicPolynomial.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+CubicBezierCurve3D::CubicBezierCurve3D(Vec3 startPos, Vec3 guidePos1, Vec3 guidePos2, Vec3 endPos)
+	: m_startPos(startPos)
+	, m_guidePos1(guidePos1)
+	, m_guidePos2(guidePos2)
+	, m_endPos(endPos)
+{
+}
+
+CubicBezierCurve3D::CubicBezierCurve3D(CubicHermiteCurve3D const& fromHermite)
+	: m_startPos(fromHermite.m_startPos)
+	, m_endPos(fromHermite.m_endPos)
+{
+	m_guidePos1 = fromHermite.m_startPos + fromHermite.m_startVel / 3.0f;
+	m_guidePos2 = fromHermite.m_endPos - fromHermite.m_endVel / 3.0f;
+}
+
+Vec3 CubicBezierCurve3D::EvaluateAtParametric(float parametricZeroToOne) const
+{
+	return CubicPolynomial3D::MakeFromBezier(m_startPos, m_guidePos1, m_guidePos2, m_endPos).Evaluate(parametricZeroToOne);
+}
+
+Vec3 CubicBezierCurve3D::EvaluateVelocityAtParametric(float parametricZeroToOne) const
+{
+	return CubicPolynomial3D::MakeFromBezier(m_startPos, m_guidePos1, m_guidePos2, m_endPos).EvaluateVelocity(parametricZeroToOne);
+}
+
+float CubicBezierCurve3D::GetApproximateLength(int numSubdivisions /*= 64*/) const
+{
+	CubicPolynomial3D polynomial = CubicPolynomial3D::MakeFromBezier(m_startPos, m_guidePos1, m_guidePos2, m_endPos);
+	float tPerStep = 1.f / float(numSubdivisions);
+	float curveLength = 0.0f;
+	Vec3 startPos = m_startPos;
+	for (int i = 1; i <= numSubdivisions; i++)
+	{
+		Vec3 endPos = polynomial.Evaluate(tPerStep * float(i));
+		curveLength += GetDistance3D(endPos, startPos);
+		startPos = endPos;
+	}
+	return curveLength;
+}
+
+Vec3 CubicBezierCurve3D::EvaluateAtApproximateDistance(float distanceAlongCurve, int numSubdivisions /*= 64*/) const
+{
+	if (distanceAlongCurve <= 0.f)
+	{
+		return m_startPos;
+	}
+
+	CubicPolynomial3D polynomial = CubicPolynomial3D::MakeFromBezier(m_startPos, m_guidePos1, m_guidePos2, m_endPos);
+	float tPerStep = 1.f / float(numSubdivisions);
+	Vec3 startPos = m_startPos;
+	float distanceTravelled = 0.0f;
+	for (int i = 1; i <= numSubdivisions; i++)
+	{
+		Vec3 endPos = polynomial.Evaluate(tPerStep * (float)i);
+		float subdivLength = GetDistance3D(endPos, startPos);
+		if (distanceTravelled + subdivLength > distanceAlongCurve)
+		{
+			float lengthFraction = (distanceAlongCurve - distanceTravelled) / subdivLength;
+			return startPos + (endPos - startPos) * lengthFraction;
+		}
+		startPos = endPos;
+		distanceTravelled += subdivLength;
+	}
+	return m_endPos;
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+#include "Engine/Math/Vec3.hpp"
+
+class CubicHermiteCurve3D;
+
+class CubicBezierCurve3D
+{
+public:
+	CubicBezierCurve3D(Vec3 startPos, Vec3 guidePos1, Vec3 guidePos2, Vec3 endPos);
+	explicit CubicBezierCurve3D(CubicHermiteCurve3D const& fromHermite);
+	Vec3 EvaluateAtParametric(float parametricZeroToOne) const;
+	Vec3 EvaluateVelocityAtParametric(float parametricZeroToOne) const;
+	float GetApproximateLength(int numSubdivisions = 64) const;
+	// Clamped to the end points outside [0, length]
+	Vec3 EvaluateAtApproximateDistance(float distanceAlongCurve, int numSubdivisions = 64) const;
+
+public:
+	Vec3 m_startPos;
+	Vec3 m_guidePos1;
+	Vec3 m_guidePos2;
+	Vec3 m_endPos;
+};
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "Engine/Math/CubicHermiteCurve.hpp"
 #include "Engine/Math/CubicBezierCurve2D.hpp"
+#include "Engine/Math/CubicBezierCurve3D.hpp"
+#include "Engine/Math/CubicPolynomial.hpp"
 
 CubicHermiteCurve2D::CubicHermiteCurve2D(Vec2 startPos, Vec2 startVel, Vec2 endPos, Vec2 endVel)
 	: m_startPos(startPos)
@@ -19,9 +21,7 @@ CubicHermiteCurve2D::CubicHermiteCurve2D(CubicBezierCurve2D const& fromBezier)
 
 Vec2 CubicHermiteCurve2D::EvaluateAtParametric(float parametricZeroToOne) const
 {
-	CubicHermiteCurve2D local = CubicHermiteCurve2D(m_startPos, m_startVel, m_endPos, m_endVel);
-	CubicBezierCurve2D bezier = CubicBezierCurve2D(local);
-	return bezier.EvaluateAtParametric(parametricZeroToOne);
+	return CubicPolynomial2D::MakeFromHermite(m_startPos, m_startVel, m_endPos, m_endVel).Evaluate(parametricZeroToOne);
 }
 
 float CubicHermiteCurve2D::GetApproximateLength(int numSubdivisions /*= 64*/) const
@@ -38,3 +38,39 @@ Vec2 CubicHermiteCurve2D::EvaluateAtApproximateDistance(float distanceAlongCurve
 	return bezier.EvaluateAtApproximateDistance(distanceAlongCurve, numSubdivisions);
 }
 
+//----------------------------------------------------------------------------------------------
+CubicHermiteCurve3D::CubicHermiteCurve3D(Vec3 startPos, Vec3 startVel, Vec3 endPos, Vec3 endVel)
+	: m_startPos(startPos)
+	, m_startVel(startVel)
+	, m_endPos(endPos)
+	, m_endVel(endVel)
+{
+}
+
+CubicHermiteCurve3D::CubicHermiteCurve3D(CubicBezierCurve3D const& fromBezier)
+{
+	m_startPos = fromBezier.m_startPos;
+	m_startVel = 3.f * (fromBezier.m_guidePos1 - fromBezier.m_startPos);
+	m_endPos = fromBezier.m_endPos;
+	m_endVel = 3.f * (fromBezier.m_endPos - fromBezier.m_guidePos2);
+}
+
+Vec3 CubicHermiteCurve3D::EvaluateAtParametric(float parametricZeroToOne) const
+{
+	return CubicPolynomial3D::MakeFromHermite(m_startPos, m_startVel, m_endPos, m_endVel).Evaluate(parametricZeroToOne);
+}
+
+Vec3 CubicHermiteCurve3D::EvaluateVelocityAtParametric(float parametricZeroToOne) const
+{
+	return CubicPolynomial3D::MakeFromHermite(m_startPos, m_startVel, m_endPos, m_endVel).EvaluateVelocity(parametricZeroToOne);
+}
+
+float CubicHermiteCurve3D::GetApproximateLength(int numSubdivisions /*= 64*/) const
+{
+	return CubicBezierCurve3D(*this).GetApproximateLength(numSubdivisions);
+}
+
+Vec3 CubicHermiteCurve3D::EvaluateAtApproximateDistance(float distanceAlongCurve, int numSubdivisions /*= 64*/) const
+{
+	return CubicBezierCurve3D(*this).EvaluateAtApproximateDistance(distanceAlongCurve, numSubdivisions);
+}
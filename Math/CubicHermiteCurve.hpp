@@ -1,7 +1,9 @@
 #pragma once
 #include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
 
 class CubicBezierCurve2D;
+class CubicBezierCurve3D;
 
 class CubicHermiteCurve2D
 {
@@ -17,4 +19,21 @@ public:
 	Vec2 m_startVel;
 	Vec2 m_endPos;
 	Vec2 m_endVel;
+};
+
+class CubicHermiteCurve3D
+{
+public:
+	CubicHermiteCurve3D(Vec3 startPos, Vec3 startVel, Vec3 endPos, Vec3 endVel);
+	explicit CubicHermiteCurve3D(CubicBezierCurve3D const& fromBezier);
+	Vec3 EvaluateAtParametric(float parametricZeroToOne) const;
+	Vec3 EvaluateVelocityAtParametric(float parametricZeroToOne) const;
+	float GetApproximateLength(int numSubdivisions = 64) const;
+	Vec3 EvaluateAtApproximateDistance(float distanceAlongCurve, int numSubdivisions = 64) const;
+
+public:
+	Vec3 m_startPos;
+	Vec3 m_startVel;
+	Vec3 m_endPos;
+	Vec3 m_endVel;
 };
\ No newline at end of file
@@ -0,0 +1,123 @@
+#pragma once
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include <cmath>
+
+//----------------------------------------------------------------------------------------------
+// One cubic curve section in power basis, position(t) = ((a*t + b)*t + c)*t + d for t in [0,1], evaluated with
+// Horner's rule. Splines convert their sections once when the points change, so an evaluation is three multiply-adds
+// per component instead of building Hermite and Bezier temporaries every call. Everything is plain float math on
+// the components, which keeps loops over many t values easy to vectorize.
+//
+struct CubicPolynomial2D
+{
+	Vec2 m_a;
+	Vec2 m_b;
+	Vec2 m_c;
+	Vec2 m_d;
+
+	static CubicPolynomial2D MakeFromBezier(Vec2 const& startPos, Vec2 const& guidePos1, Vec2 const& guidePos2, Vec2 const& endPos);
+	static CubicPolynomial2D MakeFromHermite(Vec2 const& startPos, Vec2 const& startVel, Vec2 const& endPos, Vec2 const& endVel);
+
+	Vec2 Evaluate(float t) const;
+	Vec2 EvaluateVelocity(float t) const;
+};
+
+struct CubicPolynomial3D
+{
+	Vec3 m_a;
+	Vec3 m_b;
+	Vec3 m_c;
+	Vec3 m_d;
+
+	static CubicPolynomial3D MakeFromBezier(Vec3 const& startPos, Vec3 const& guidePos1, Vec3 const& guidePos2, Vec3 const& endPos);
+	static CubicPolynomial3D MakeFromHermite(Vec3 const& startPos, Vec3 const& startVel, Vec3 const& endPos, Vec3 const& endVel);
+
+	Vec3 Evaluate(float t) const;
+	Vec3 EvaluateVelocity(float t) const;
+	float EvaluateSpeed(float t) const;
+};
+
+//----------------------------------------------------------------------------------------------
+inline CubicPolynomial2D CubicPolynomial2D::MakeFromBezier(Vec2 const& startPos, Vec2 const& guidePos1, Vec2 const& guidePos2, Vec2 const& endPos)
+{
+	CubicPolynomial2D polynomial;
+	polynomial.m_a = Vec2(endPos.x - startPos.x + 3.f * (guidePos1.x - guidePos2.x), endPos.y - startPos.y + 3.f * (guidePos1.y - guidePos2.y));
+	polynomial.m_b = Vec2(3.f * (guidePos2.x - 2.f * guidePos1.x + startPos.x), 3.f * (guidePos2.y - 2.f * guidePos1.y + startPos.y));
+	polynomial.m_c = Vec2(3.f * (guidePos1.x - startPos.x), 3.f * (guidePos1.y - startPos.y));
+	polynomial.m_d = startPos;
+	return polynomial;
+}
+
+inline CubicPolynomial2D CubicPolynomial2D::MakeFromHermite(Vec2 const& startPos, Vec2 const& startVel, Vec2 const& endPos, Vec2 const& endVel)
+{
+	CubicPolynomial2D polynomial;
+	polynomial.m_a = Vec2(2.f * (startPos.x - endPos.x) + startVel.x + endVel.x, 2.f * (startPos.y - endPos.y) + startVel.y + endVel.y);
+	polynomial.m_b = Vec2(3.f * (endPos.x - startPos.x) - 2.f * startVel.x - endVel.x, 3.f * (endPos.y - startPos.y) - 2.f * startVel.y - endVel.y);
+	polynomial.m_c = startVel;
+	polynomial.m_d = startPos;
+	return polynomial;
+}
+
+inline Vec2 CubicPolynomial2D::Evaluate(float t) const
+{
+	return Vec2(((m_a.x * t + m_b.x) * t + m_c.x) * t + m_d.x,
+		((m_a.y * t + m_b.y) * t + m_c.y) * t + m_d.y);
+}
+
+inline Vec2 CubicPolynomial2D::EvaluateVelocity(float t) const
+{
+	return Vec2((3.f * m_a.x * t + 2.f * m_b.x) * t + m_c.x,
+		(3.f * m_a.y * t + 2.f * m_b.y) * t + m_c.y);
+}
+
+//----------------------------------------------------------------------------------------------
+inline CubicPolynomial3D CubicPolynomial3D::MakeFromBezier(Vec3 const& startPos, Vec3 const& guidePos1, Vec3 const& guidePos2, Vec3 const& endPos)
+{
+	CubicPolynomial3D polynomial;
+	polynomial.m_a = Vec3(endPos.x - startPos.x + 3.f * (guidePos1.x - guidePos2.x),
+		endPos.y - startPos.y + 3.f * (guidePos1.y - guidePos2.y),
+		endPos.z - startPos.z + 3.f * (guidePos1.z - guidePos2.z));
+	polynomial.m_b = Vec3(3.f * (guidePos2.x - 2.f * guidePos1.x + startPos.x),
+		3.f * (guidePos2.y - 2.f * guidePos1.y + startPos.y),
+		3.f * (guidePos2.z - 2.f * guidePos1.z + startPos.z));
+	polynomial.m_c = Vec3(3.f * (guidePos1.x - startPos.x), 3.f * (guidePos1.y - startPos.y), 3.f * (guidePos1.z - startPos.z));
+	polynomial.m_d = startPos;
+	return polynomial;
+}
+
+inline CubicPolynomial3D CubicPolynomial3D::MakeFromHermite(Vec3 const& startPos, Vec3 const& startVel, Vec3 const& endPos, Vec3 const& endVel)
+{
+	CubicPolynomial3D polynomial;
+	polynomial.m_a = Vec3(2.f * (startPos.x - endPos.x) + startVel.x + endVel.x,
+		2.f * (startPos.y - endPos.y) + startVel.y + endVel.y,
+		2.f * (startPos.z - endPos.z) + startVel.z + endVel.z);
+	polynomial.m_b = Vec3(3.f * (endPos.x - startPos.x) - 2.f * startVel.x - endVel.x,
+		3.f * (endPos.y - startPos.y) - 2.f * startVel.y - endVel.y,
+		3.f * (endPos.z - startPos.z) - 2.f * startVel.z - endVel.z);
+	polynomial.m_c = startVel;
+	polynomial.m_d = startPos;
+	return polynomial;
+}
+
+inline Vec3 CubicPolynomial3D::Evaluate(float t) const
+{
+	return Vec3(((m_a.x * t + m_b.x) * t + m_c.x) * t + m_d.x,
+		((m_a.y * t + m_b.y) * t + m_c.y) * t + m_d.y,
+		((m_a.z * t + m_b.z) * t + m_c.z) * t + m_d.z);
+}
+
+inline Vec3 CubicPolynomial3D::EvaluateVelocity(float t) const
+{
+	return Vec3((3.f * m_a.x * t + 2.f * m_b.x) * t + m_c.x,
+		(3.f * m_a.y * t + 2.f * m_b.y) * t + m_c.y,
+		(3.f * m_a.z * t + 2.f * m_b.z) * t + m_c.z);
+}
+
+inline float CubicPolynomial3D::EvaluateSpeed(float t) const
+{
+	float velocityX = (3.f * m_a.x * t + 2.f * m_b.x) * t + m_c.x;
+	float velocityY = (3.f * m_a.y * t + 2.f * m_b.y) * t + m_c.y;
+	float velocityZ = (3.f * m_a.z * t + 2.f * m_b.z) * t + m_c.z;
+	return sqrtf(velocityX * velocityX + velocityY * velocityY + velocityZ * velocityZ);
+}
\ No newline at end of file
@@ -0,0 +1,212 @@
+#include "Engine/Math/CurveArcLengthTable.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	constexpr int MAX_NEWTON_ITERATIONS = 2;
+	constexpr int MAX_FORWARD_STEPS_FROM_HINT = 4;
+	constexpr float GAUSS_NODE = 0.774596669f; // sqrt(3/5)
+	constexpr float GAUSS_OUTER_WEIGHT = 5.f / 9.f;
+	constexpr float GAUSS_CENTER_WEIGHT = 8.f / 9.f;
+}
+
+//----------------------------------------------------------------------------------------------
+void CurveArcLengthTable::Build(std::vector<Vec2> const& bezierControlPoints, int subdivisionsPerSegment)
+{
+	std::vector<Vec3> bezierControlPoints3D;
+	bezierControlPoints3D.reserve(bezierControlPoints.size());
+	for (Vec2 const& point : bezierControlPoints)
+	{
+		bezierControlPoints3D.push_back(Vec3(point.x, point.y, 0.f));
+	}
+	Build(bezierControlPoints3D, subdivisionsPerSegment);
+}
+
+void CurveArcLengthTable::Build(std::vector<Vec3> const& bezierControlPoints, int subdivisionsPerSegment)
+{
+	int numPoints = (int)bezierControlPoints.size();
+	if (numPoints < 4)
+	{
+		Clear();
+		return;
+	}
+	GUARANTEE_OR_DIE((numPoints - 1) % 3 == 0, "CurveArcLengthTable needs 3 * numSegments + 1 control points");
+
+	std::vector<CubicPolynomial3D> segments;
+	segments.reserve((numPoints - 1) / 3);
+	for (int firstPoint = 0; firstPoint + 3 < numPoints; firstPoint += 3)
+	{
+		segments.push_back(CubicPolynomial3D::MakeFromBezier(bezierControlPoints[firstPoint], bezierControlPoints[firstPoint + 1],
+			bezierControlPoints[firstPoint + 2], bezierControlPoints[firstPoint + 3]));
+	}
+	Build(segments, subdivisionsPerSegment);
+}
+
+void CurveArcLengthTable::Build(std::vector<CubicPolynomial3D> const& segments, int subdivisionsPerSegment)
+{
+	Clear();
+	GUARANTEE_OR_DIE(subdivisionsPerSegment > 0, "CurveArcLengthTable needs at least one subdivision per segment");
+	if (segments.empty())
+	{
+		return;
+	}
+
+	int numSegments = (int)segments.size();
+	m_segments = segments;
+	m_subdivisionsPerSegment = subdivisionsPerSegment;
+	m_stepSize = 1.f / (float)subdivisionsPerSegment;
+	m_cumulativeLengths.resize(numSegments * subdivisionsPerSegment + 1);
+	m_cumulativeLengths[0] = 0.f;
+
+	// Summed in double: thousands of float additions would drift by more than the integration error
+	double totalLength = 0.0;
+	for (int segmentIndex = 0; segmentIndex < numSegments; ++segmentIndex)
+	{
+		for (int subdivision = 0; subdivision < subdivisionsPerSegment; ++subdivision)
+		{
+			float tStart = m_stepSize * (float)subdivision;
+			float tEnd = (subdivision == subdivisionsPerSegment - 1) ? 1.f : m_stepSize * (float)(subdivision + 1);
+			totalLength += GetLengthOfInterval(m_segments[segmentIndex], tStart, tEnd);
+			m_cumulativeLengths[segmentIndex * subdivisionsPerSegment + subdivision + 1] = (float)totalLength;
+		}
+	}
+}
+
+void CurveArcLengthTable::Clear()
+{
+	m_segments.clear();
+	m_cumulativeLengths.clear();
+	m_subdivisionsPerSegment = 0;
+	m_stepSize = 0.f;
+}
+
+//----------------------------------------------------------------------------------------------
+void CurveArcLengthTable::GetParametricAtDistance(float distanceAlongCurve, int& out_segmentIndex, float& out_parametricZeroToOne) const
+{
+	out_segmentIndex = 0;
+	out_parametricZeroToOne = 0.f;
+	if (!IsBuilt())
+	{
+		return;
+	}
+	int step = FindStepAtDistance(distanceAlongCurve, -1);
+	out_segmentIndex = step / m_subdivisionsPerSegment;
+	out_parametricZeroToOne = GetParametricInStep(step, distanceAlongCurve);
+}
+
+Vec2 CurveArcLengthTable::EvaluateAtDistance(float distanceAlongCurve) const
+{
+	Vec3 position = EvaluateAtDistance3D(distanceAlongCurve);
+	return Vec2(position.x, position.y);
+}
+
+Vec3 CurveArcLengthTable::EvaluateAtDistance3D(float distanceAlongCurve) const
+{
+	if (!IsBuilt())
+	{
+		return Vec3();
+	}
+	return EvaluateStepAtDistance(FindStepAtDistance(distanceAlongCurve, -1), distanceAlongCurve);
+}
+
+void CurveArcLengthTable::EvaluateAtDistances(float const* distancesAlongCurve, Vec2* out_positions, int count) const
+{
+	int step = -1;
+	for (int index = 0; index < count; ++index)
+	{
+		Vec3 position;
+		if (IsBuilt())
+		{
+			step = FindStepAtDistance(distancesAlongCurve[index], step);
+			position = EvaluateStepAtDistance(step, distancesAlongCurve[index]);
+		}
+		out_positions[index] = Vec2(position.x, position.y);
+	}
+}
+
+void CurveArcLengthTable::EvaluateAtDistances(float const* distancesAlongCurve, Vec3* out_positions, int count) const
+{
+	int step = -1;
+	for (int index = 0; index < count; ++index)
+	{
+		Vec3 position;
+		if (IsBuilt())
+		{
+			step = FindStepAtDistance(distancesAlongCurve[index], step);
+			position = EvaluateStepAtDistance(step, distancesAlongCurve[index]);
+		}
+		out_positions[index] = position;
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+// Last step whose start distance is <= distance; a hint (the previous query's step) is checked first
+int CurveArcLengthTable::FindStepAtDistance(float distance, int hintStep) const
+{
+	int numSteps = (int)m_cumulativeLengths.size() - 1;
+	if (hintStep >= 0 && m_cumulativeLengths[hintStep] <= distance)
+	{
+		int lastStepToTry = std::min(hintStep + MAX_FORWARD_STEPS_FROM_HINT, numSteps - 1);
+		for (int step = hintStep; step <= lastStepToTry; ++step)
+		{
+			if (step == numSteps - 1 || distance < m_cumulativeLengths[step + 1])
+			{
+				return step;
+			}
+		}
+	}
+
+	int step = (int)(std::upper_bound(m_cumulativeLengths.begin(), m_cumulativeLengths.end(), distance) - m_cumulativeLengths.begin()) - 1;
+	return std::max(0, std::min(step, numSteps - 1));
+}
+
+float CurveArcLengthTable::GetParametricInStep(int step, float distance) const
+{
+	CubicPolynomial3D const& segment = m_segments[step / m_subdivisionsPerSegment];
+	int subdivision = step % m_subdivisionsPerSegment;
+	float tStart = m_stepSize * (float)subdivision;
+	float tEnd = (subdivision == m_subdivisionsPerSegment - 1) ? 1.f : m_stepSize * (float)(subdivision + 1);
+
+	float lengthAtStart = m_cumulativeLengths[step];
+	float stepLength = m_cumulativeLengths[step + 1] - lengthAtStart;
+	float targetLength = distance - lengthAtStart;
+	if (targetLength <= 0.f || stepLength <= 0.f)
+	{
+		return tStart;
+	}
+	if (targetLength >= stepLength)
+	{
+		return tEnd;
+	}
+
+	// Speed barely changes across one step, so the linear guess is already close; Newton removes the rest
+	float t = tStart + (tEnd - tStart) * (targetLength / stepLength);
+	for (int iteration = 0; iteration < MAX_NEWTON_ITERATIONS; ++iteration)
+	{
+		float error = GetLengthOfInterval(segment, tStart, t) - targetLength;
+		float speed = segment.EvaluateSpeed(t);
+		if (speed <= 0.f)
+		{
+			break;
+		}
+		t = std::max(tStart, std::min(t - error / speed, tEnd));
+	}
+	return t;
+}
+
+float CurveArcLengthTable::GetLengthOfInterval(CubicPolynomial3D const& segment, float tStart, float tEnd) const
+{
+	float halfWidth = 0.5f * (tEnd - tStart);
+	float center = 0.5f * (tStart + tEnd);
+	float offset = halfWidth * GAUSS_NODE;
+	float weightedSpeeds = GAUSS_OUTER_WEIGHT * (segment.EvaluateSpeed(center - offset) + segment.EvaluateSpeed(center + offset))
+		+ GAUSS_CENTER_WEIGHT * segment.EvaluateSpeed(center);
+	return halfWidth * weightedSpeeds;
+}
+
+Vec3 CurveArcLengthTable::EvaluateStepAtDistance(int step, float distance) const
+{
+	return m_segments[step / m_subdivisionsPerSegment].Evaluate(GetParametricInStep(step, distance));
+}
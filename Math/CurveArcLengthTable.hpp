@@ -0,0 +1,46 @@
+#pragma once
+#include "Engine/Math/CubicPolynomial.hpp"
+#include <vector>
+
+//----------------------------------------------------------------------------------------------
+// Cached arc length of a composite cubic Bezier curve, so distance queries stop resampling the curve every call.
+// Each segment is split into subdivisionsPerSegment equal parametric steps and the table keeps the arc length up
+// to every step (3-point Gauss-Legendre on the speed). A distance query binary searches the steps, then refines the
+// parametric with Newton's method on that step's arc-length integral, so the point lies on the curve, not on a chord.
+//
+// The table keeps its own copy of the curve; rebuild it when the control points change. 2D curves are stored with z = 0.
+//
+class CurveArcLengthTable
+{
+public:
+	// 3 * numSegments + 1 control points; the last point of each segment is the first point of the next
+	void Build(std::vector<Vec2> const& bezierControlPoints, int subdivisionsPerSegment = 64);
+	void Build(std::vector<Vec3> const& bezierControlPoints, int subdivisionsPerSegment = 64);
+	void Build(std::vector<CubicPolynomial3D> const& segments, int subdivisionsPerSegment = 64);
+	void Clear();
+
+	bool IsBuilt() const						{ return !m_segments.empty(); }
+	int GetNumSegments() const					{ return (int)m_segments.size(); }
+	int GetSubdivisionsPerSegment() const		{ return m_subdivisionsPerSegment; }
+	float GetTotalLength() const				{ return m_cumulativeLengths.empty() ? 0.f : m_cumulativeLengths.back(); }
+
+	// Distances are clamped to [0, GetTotalLength()]
+	void GetParametricAtDistance(float distanceAlongCurve, int& out_segmentIndex, float& out_parametricZeroToOne) const;
+	Vec2 EvaluateAtDistance(float distanceAlongCurve) const;
+	Vec3 EvaluateAtDistance3D(float distanceAlongCurve) const;
+	// Any order works; ascending distances (entities walking a path) continue from the previous step instead of searching
+	void EvaluateAtDistances(float const* distancesAlongCurve, Vec2* out_positions, int count) const;
+	void EvaluateAtDistances(float const* distancesAlongCurve, Vec3* out_positions, int count) const;
+
+private:
+	int FindStepAtDistance(float distance, int hintStep) const;
+	float GetParametricInStep(int step, float distance) const;
+	float GetLengthOfInterval(CubicPolynomial3D const& segment, float tStart, float tEnd) const;
+	Vec3 EvaluateStepAtDistance(int step, float distance) const;
+
+private:
+	std::vector<CubicPolynomial3D>	m_segments;
+	std::vector<float>				m_cumulativeLengths; // numSegments * subdivisionsPerSegment + 1 entries, first is 0
+	int								m_subdivisionsPerSegment = 0;
+	float							m_stepSize = 0.f;
+};
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "Engine/Math/EulerAngles.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/FastTrig.hpp"
 #include <cmath>
 
 
@@ -23,21 +24,22 @@ EulerAngles::EulerAngles(float yaw, float pitch, float roll)
 
 void EulerAngles::GetAsVectors_XFwd_YLeft_ZUp(Vec3& iForwardBasis, Vec3& jLeftBasis, Vec3& kUpBasis) const 
 {
-	float yawRad = m_yaw * PI / 180.0f;
-	float pitchRad = m_pitch * PI / 180.0f;
-	float rollRad = m_roll * PI / 180.0f;
-
-	iForwardBasis.x = cos(pitchRad) * cos(yawRad);
-	iForwardBasis.y = cos(pitchRad) * sin(yawRad);
-	iForwardBasis.z = -sin(pitchRad);
-
-	jLeftBasis.x = -cos(rollRad) * sin(yawRad) + sin(rollRad) * sin(pitchRad) * cos(yawRad);
-	jLeftBasis.y = cos(rollRad) * cos(yawRad) + sin(rollRad) * sin(pitchRad) * sin(yawRad);
-	jLeftBasis.z = sin(rollRad) * cos(pitchRad);
-
-	kUpBasis.x = sin(rollRad) * sin(yawRad) + cos(rollRad) * sin(pitchRad) * cos(yawRad);
-	kUpBasis.y = -sin(rollRad) * cos(yawRad) + cos(rollRad) * sin(pitchRad) * sin(yawRad);
-	kUpBasis.z = cos(rollRad) * cos(pitchRad);
+	float sinYaw, cosYaw, sinPitch, cosPitch, sinRoll, cosRoll;
+	FastSinCosDegrees(m_yaw, sinYaw, cosYaw);
+	FastSinCosDegrees(m_pitch, sinPitch, cosPitch);
+	FastSinCosDegrees(m_roll, sinRoll, cosRoll);
+
+	iForwardBasis.x = cosPitch * cosYaw;
+	iForwardBasis.y = cosPitch * sinYaw;
+	iForwardBasis.z = -sinPitch;
+
+	jLeftBasis.x = -cosRoll * sinYaw + sinRoll * sinPitch * cosYaw;
+	jLeftBasis.y = cosRoll * cosYaw + sinRoll * sinPitch * sinYaw;
+	jLeftBasis.z = sinRoll * cosPitch;
+
+	kUpBasis.x = sinRoll * sinYaw + cosRoll * sinPitch * cosYaw;
+	kUpBasis.y = -sinRoll * cosYaw + cosRoll * sinPitch * sinYaw;
+	kUpBasis.z = cosRoll * cosPitch;
 }
 
 Mat44 EulerAngles::GetAsMatrix_XFwd_YLeft_ZUp() const
@@ -56,20 +58,22 @@ Mat44 EulerAngles::GetAsMatrix_XFwd_YLeft_ZUp() const
 }
 
 Vec3 EulerAngles::GetForwardVector() const {
-	float yawRadians = m_yaw * (PI / 180.0f);
-	float pitchRadians = -m_pitch * (PI / 180.0f);
+	float sinYaw, cosYaw, sinPitch, cosPitch;
+	FastSinCosDegrees(m_yaw, sinYaw, cosYaw);
+	FastSinCosDegrees(-m_pitch, sinPitch, cosPitch);
 
 	Vec3 forward;
-	forward.x = cos(pitchRadians) * cos(yawRadians);
-	forward.y = cos(pitchRadians) * sin(yawRadians);
-	forward.z = sin(pitchRadians);
+	forward.x = cosPitch * cosYaw;
+	forward.y = cosPitch * sinYaw;
+	forward.z = sinPitch;
 
 	return forward;
 }
 
 Vec3 EulerAngles::GetLeftVector() const {
-	float yawRadians = m_yaw * (PI / 180.0f);
-	return Vec3(-sin(yawRadians), cos(yawRadians), 0.0f);
+	float sinYaw, cosYaw;
+	FastSinCosDegrees(m_yaw, sinYaw, cosYaw);
+	return Vec3(-sinYaw, cosYaw, 0.0f);
 }
 
 Vec3 EulerAngles::GetWorldUpVector() const
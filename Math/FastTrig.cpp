@@ -0,0 +1,236 @@
+#include "Engine/Math/FastTrig.hpp"
+#include <cmath>
+
+constexpr float ONE_OVER_NINETY = 1.f / 90.f;
+constexpr float DEGREES_TO_RADIANS = 3.14159265358979323846f / 180.f;
+constexpr float RADIANS_TO_DEGREES = 180.f / 3.14159265358979323846f;
+
+// sin(x) ~ x + x^3 * (S1 + x^2 * (S2 + x^2 * S3)) on [-pi/4, pi/4]
+constexpr float SIN_COEFF_1 = -1.6666654611e-1f;
+constexpr float SIN_COEFF_2 = 8.3321608736e-3f;
+constexpr float SIN_COEFF_3 = -1.9515295891e-4f;
+
+// cos(x) ~ 1 - x^2/2 + x^4 * (C1 + x^2 * (C2 + x^2 * C3)) on [-pi/4, pi/4]
+constexpr float COS_COEFF_1 = 4.166664568298827e-2f;
+constexpr float COS_COEFF_2 = -1.388731625493765e-3f;
+constexpr float COS_COEFF_3 = 2.443315711809948e-5f;
+
+// atan(a) ~ a * (A0 + s * (A1 + ... + s * A6)) with s = a^2, a in [0, 1]
+constexpr float ATAN_COEFF_0 = 0.9999961256980896f;
+constexpr float ATAN_COEFF_1 = -0.3331736624240875f;
+constexpr float ATAN_COEFF_2 = 0.19807811081409454f;
+constexpr float ATAN_COEFF_3 = -0.13233321905136108f;
+constexpr float ATAN_COEFF_4 = 0.07962330430746078f;
+constexpr float ATAN_COEFF_5 = -0.03360389545559883f;
+constexpr float ATAN_COEFF_6 = 0.006811683531850576f;
+
+//----------------------------------------------------------------------------------------------
+void FastSinCosDegrees(float degrees, float& out_sin, float& out_cos)
+{
+	// Round-to-nearest-even through cvtss2si so the SIMD versions pick the same quadrant
+	int quadrant = _mm_cvtss_si32(_mm_set_ss(degrees * ONE_OVER_NINETY));
+	float x = (degrees - (float)quadrant * 90.f) * DEGREES_TO_RADIANS;
+	float x2 = x * x;
+	float sinPoly = x + (x * x2) * (SIN_COEFF_1 + x2 * (SIN_COEFF_2 + x2 * SIN_COEFF_3));
+	float cosPoly = (1.f - 0.5f * x2) + (x2 * x2) * (COS_COEFF_1 + x2 * (COS_COEFF_2 + x2 * COS_COEFF_3));
+
+	switch (quadrant & 3)
+	{
+		case 0: out_sin = sinPoly;	out_cos = cosPoly;	break;
+		case 1: out_sin = cosPoly;	out_cos = -sinPoly;	break;
+		case 2: out_sin = -sinPoly;	out_cos = -cosPoly;	break;
+		default: out_sin = -cosPoly; out_cos = sinPoly;	break;
+	}
+}
+
+float FastSinDegrees(float degrees)
+{
+	float sinValue;
+	float cosValue;
+	FastSinCosDegrees(degrees, sinValue, cosValue);
+	return sinValue;
+}
+
+float FastCosDegrees(float degrees)
+{
+	float sinValue;
+	float cosValue;
+	FastSinCosDegrees(degrees, sinValue, cosValue);
+	return cosValue;
+}
+
+float FastAtan2Degrees(float y, float x)
+{
+	float absX = fabsf(x);
+	float absY = fabsf(y);
+	float maxXY = absX > absY ? absX : absY;
+	float minXY = absX > absY ? absY : absX;
+	float a = maxXY > 0.f ? minXY / maxXY : 0.f;
+	float s = a * a;
+	float poly = ATAN_COEFF_0 + s * (ATAN_COEFF_1 + s * (ATAN_COEFF_2 + s * (ATAN_COEFF_3 + s * (ATAN_COEFF_4 + s * (ATAN_COEFF_5 + s * ATAN_COEFF_6)))));
+	float degrees = (a * poly) * RADIANS_TO_DEGREES;
+
+	if (absY > absX) degrees = 90.f - degrees;
+	if (x < 0.f) degrees = 180.f - degrees;
+	if (y < 0.f) degrees = -degrees;
+	return degrees;
+}
+
+//----------------------------------------------------------------------------------------------
+static inline __m128 Select4(__m128 mask, __m128 ifTrue, __m128 ifFalse)
+{
+	return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse));
+}
+
+void FastSinCosDegrees4(__m128 degrees, __m128& out_sines, __m128& out_cosines)
+{
+	__m128i quadrant = _mm_cvtps_epi32(_mm_mul_ps(degrees, _mm_set1_ps(ONE_OVER_NINETY)));
+	__m128 x = _mm_mul_ps(_mm_sub_ps(degrees, _mm_mul_ps(_mm_cvtepi32_ps(quadrant), _mm_set1_ps(90.f))), _mm_set1_ps(DEGREES_TO_RADIANS));
+	__m128 x2 = _mm_mul_ps(x, x);
+
+	__m128 sinPoly = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(SIN_COEFF_3), x2), _mm_set1_ps(SIN_COEFF_2));
+	sinPoly = _mm_add_ps(_mm_mul_ps(x2, sinPoly), _mm_set1_ps(SIN_COEFF_1));
+	sinPoly = _mm_add_ps(x, _mm_mul_ps(_mm_mul_ps(x, x2), sinPoly));
+
+	__m128 cosPoly = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(COS_COEFF_3), x2), _mm_set1_ps(COS_COEFF_2));
+	cosPoly = _mm_add_ps(_mm_mul_ps(x2, cosPoly), _mm_set1_ps(COS_COEFF_1));
+	cosPoly = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.f), _mm_mul_ps(_mm_set1_ps(0.5f), x2)), _mm_mul_ps(_mm_mul_ps(x2, x2), cosPoly));
+
+	// Odd quadrants swap sin/cos; bit 1 of the quadrant negates sin, bit 1 of quadrant+1 negates cos
+	__m128 swapMask = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+	__m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(2)), 30));
+	__m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+	out_sines = _mm_xor_ps(Select4(swapMask, cosPoly, sinPoly), sinSign);
+	out_cosines = _mm_xor_ps(Select4(swapMask, sinPoly, cosPoly), cosSign);
+}
+
+__m128 FastAtan2Degrees4(__m128 y, __m128 x)
+{
+	__m128 signBit = _mm_set1_ps(-0.f);
+	__m128 absX = _mm_andnot_ps(signBit, x);
+	__m128 absY = _mm_andnot_ps(signBit, y);
+	__m128 yIsLarger = _mm_cmpgt_ps(absY, absX);
+	__m128 maxXY = Select4(yIsLarger, absY, absX);
+	__m128 minXY = Select4(yIsLarger, absX, absY);
+	__m128 a = _mm_and_ps(_mm_div_ps(minXY, maxXY), _mm_cmpgt_ps(maxXY, _mm_setzero_ps()));
+	__m128 s = _mm_mul_ps(a, a);
+
+	__m128 poly = _mm_add_ps(_mm_mul_ps(s, _mm_set1_ps(ATAN_COEFF_6)), _mm_set1_ps(ATAN_COEFF_5));
+	poly = _mm_add_ps(_mm_mul_ps(s, poly), _mm_set1_ps(ATAN_COEFF_4));
+	poly = _mm_add_ps(_mm_mul_ps(s, poly), _mm_set1_ps(ATAN_COEFF_3));
+	poly = _mm_add_ps(_mm_mul_ps(s, poly), _mm_set1_ps(ATAN_COEFF_2));
+	poly = _mm_add_ps(_mm_mul_ps(s, poly), _mm_set1_ps(ATAN_COEFF_1));
+	poly = _mm_add_ps(_mm_mul_ps(s, poly), _mm_set1_ps(ATAN_COEFF_0));
+	__m128 degrees = _mm_mul_ps(_mm_mul_ps(a, poly), _mm_set1_ps(RADIANS_TO_DEGREES));
+
+	degrees = Select4(yIsLarger, _mm_sub_ps(_mm_set1_ps(90.f), degrees), degrees);
+	degrees = Select4(_mm_cmplt_ps(x, _mm_setzero_ps()), _mm_sub_ps(_mm_set1_ps(180.f), degrees), degrees);
+	return _mm_xor_ps(degrees, _mm_and_ps(_mm_cmplt_ps(y, _mm_setzero_ps()), signBit));
+}
+
+#if defined(__AVX__)
+static inline __m256 Select8(__m256 mask, __m256 ifTrue, __m256 ifFalse)
+{
+	return _mm256_blendv_ps(ifFalse, ifTrue, mask);
+}
+
+void FastSinCosDegrees8(__m256 degrees, __m256& out_sines, __m256& out_cosines)
+{
+	// AVX1 has no 256-bit integer ops, so the quadrant stays in float; rounding matches cvtps2dq (nearest even)
+	__m256 quadrant = _mm256_round_ps(_mm256_mul_ps(degrees, _mm256_set1_ps(ONE_OVER_NINETY)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+	__m256 x = _mm256_mul_ps(_mm256_sub_ps(degrees, _mm256_mul_ps(quadrant, _mm256_set1_ps(90.f))), _mm256_set1_ps(DEGREES_TO_RADIANS));
+	__m256 x2 = _mm256_mul_ps(x, x);
+
+	__m256 sinPoly = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(SIN_COEFF_3), x2), _mm256_set1_ps(SIN_COEFF_2));
+	sinPoly = _mm256_add_ps(_mm256_mul_ps(x2, sinPoly), _mm256_set1_ps(SIN_COEFF_1));
+	sinPoly = _mm256_add_ps(x, _mm256_mul_ps(_mm256_mul_ps(x, x2), sinPoly));
+
+	__m256 cosPoly = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(COS_COEFF_3), x2), _mm256_set1_ps(COS_COEFF_2));
+	cosPoly = _mm256_add_ps(_mm256_mul_ps(x2, cosPoly), _mm256_set1_ps(COS_COEFF_1));
+	cosPoly = _mm256_add_ps(_mm256_sub_ps(_mm256_set1_ps(1.f), _mm256_mul_ps(_mm256_set1_ps(0.5f), x2)), _mm256_mul_ps(_mm256_mul_ps(x2, x2), cosPoly));
+
+	// quadrant mod 4 in [0, 3]
+	__m256 quadrantMod4 = _mm256_sub_ps(quadrant, _mm256_mul_ps(_mm256_set1_ps(4.f), _mm256_floor_ps(_mm256_mul_ps(quadrant, _mm256_set1_ps(0.25f)))));
+	__m256 isOne = _mm256_cmp_ps(quadrantMod4, _mm256_set1_ps(1.f), _CMP_EQ_OQ);
+	__m256 isTwo = _mm256_cmp_ps(quadrantMod4, _mm256_set1_ps(2.f), _CMP_EQ_OQ);
+	__m256 isThree = _mm256_cmp_ps(quadrantMod4, _mm256_set1_ps(3.f), _CMP_EQ_OQ);
+	__m256 signBit = _mm256_set1_ps(-0.f);
+	__m256 swapMask = _mm256_or_ps(isOne, isThree);
+	__m256 sinSign = _mm256_and_ps(_mm256_or_ps(isTwo, isThree), signBit);
+	__m256 cosSign = _mm256_and_ps(_mm256_or_ps(isOne, isTwo), signBit);
+	out_sines = _mm256_xor_ps(Select8(swapMask, cosPoly, sinPoly), sinSign);
+	out_cosines = _mm256_xor_ps(Select8(swapMask, sinPoly, cosPoly), cosSign);
+}
+
+__m256 FastAtan2Degrees8(__m256 y, __m256 x)
+{
+	__m256 signBit = _mm256_set1_ps(-0.f);
+	__m256 zero = _mm256_setzero_ps();
+	__m256 absX = _mm256_andnot_ps(signBit, x);
+	__m256 absY = _mm256_andnot_ps(signBit, y);
+	__m256 yIsLarger = _mm256_cmp_ps(absY, absX, _CMP_GT_OQ);
+	__m256 maxXY = Select8(yIsLarger, absY, absX);
+	__m256 minXY = Select8(yIsLarger, absX, absY);
+	__m256 a = _mm256_and_ps(_mm256_div_ps(minXY, maxXY), _mm256_cmp_ps(maxXY, zero, _CMP_GT_OQ));
+	__m256 s = _mm256_mul_ps(a, a);
+
+	__m256 poly = _mm256_add_ps(_mm256_mul_ps(s, _mm256_set1_ps(ATAN_COEFF_6)), _mm256_set1_ps(ATAN_COEFF_5));
+	poly = _mm256_add_ps(_mm256_mul_ps(s, poly), _mm256_set1_ps(ATAN_COEFF_4));
+	poly = _mm256_add_ps(_mm256_mul_ps(s, poly), _mm256_set1_ps(ATAN_COEFF_3));
+	poly = _mm256_add_ps(_mm256_mul_ps(s, poly), _mm256_set1_ps(ATAN_COEFF_2));
+	poly = _mm256_add_ps(_mm256_mul_ps(s, poly), _mm256_set1_ps(ATAN_COEFF_1));
+	poly = _mm256_add_ps(_mm256_mul_ps(s, poly), _mm256_set1_ps(ATAN_COEFF_0));
+	__m256 degrees = _mm256_mul_ps(_mm256_mul_ps(a, poly), _mm256_set1_ps(RADIANS_TO_DEGREES));
+
+	degrees = Select8(yIsLarger, _mm256_sub_ps(_mm256_set1_ps(90.f), degrees), degrees);
+	degrees = Select8(_mm256_cmp_ps(x, zero, _CMP_LT_OQ), _mm256_sub_ps(_mm256_set1_ps(180.f), degrees), degrees);
+	return _mm256_xor_ps(degrees, _mm256_and_ps(_mm256_cmp_ps(y, zero, _CMP_LT_OQ), signBit));
+}
+#endif
+
+//----------------------------------------------------------------------------------------------
+void FastSinCosDegreesArray(float const* degrees, int count, float* out_sines, float* out_cosines)
+{
+	int index = 0;
+#if defined(__AVX__)
+	for (; index + 8 <= count; index += 8)
+	{
+		__m256 sines;
+		__m256 cosines;
+		FastSinCosDegrees8(_mm256_loadu_ps(degrees + index), sines, cosines);
+		_mm256_storeu_ps(out_sines + index, sines);
+		_mm256_storeu_ps(out_cosines + index, cosines);
+	}
+#endif
+	for (; index + 4 <= count; index += 4)
+	{
+		__m128 sines;
+		__m128 cosines;
+		FastSinCosDegrees4(_mm_loadu_ps(degrees + index), sines, cosines);
+		_mm_storeu_ps(out_sines + index, sines);
+		_mm_storeu_ps(out_cosines + index, cosines);
+	}
+	for (; index < count; ++index)
+	{
+		FastSinCosDegrees(degrees[index], out_sines[index], out_cosines[index]);
+	}
+}
+
+void FastAtan2DegreesArray(float const* y, float const* x, int count, float* out_degrees)
+{
+	int index = 0;
+#if defined(__AVX__)
+	for (; index + 8 <= count; index += 8)
+	{
+		_mm256_storeu_ps(out_degrees + index, FastAtan2Degrees8(_mm256_loadu_ps(y + index), _mm256_loadu_ps(x + index)));
+	}
+#endif
+	for (; index + 4 <= count; index += 4)
+	{
+		_mm_storeu_ps(out_degrees + index, FastAtan2Degrees4(_mm_loadu_ps(y + index), _mm_loadu_ps(x + index)));
+	}
+	for (; index < count; ++index)
+	{
+		out_degrees[index] = FastAtan2Degrees(y[index], x[index]);
+	}
+}
\ No newline at end of file
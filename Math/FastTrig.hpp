@@ -0,0 +1,31 @@
+#pragma once
+#include <immintrin.h>
+
+//----------------------------------------------------------------------------------------------
+// Fast-math tier for hot loops (mesh generation, turning, batch transforms). Degrees in, no libm.
+//
+// Sin/cos reduce the angle to [-45, 45] degrees around the nearest multiple of 90 and evaluate
+// minimax polynomials (degree 7 sin, degree 8 cos) on [-pi/4, pi/4]. Atan2 evaluates a degree-13
+// odd minimax polynomial for atan on [0, 1] and unfolds the octant.
+//
+// Measured maximum absolute error against double-precision libm (on the exact float input):
+//   FastSinDegrees / FastCosDegrees		<= 1e-7 for |degrees| <= 36000
+//   FastAtan2Degrees						<= 3e-5 degrees for any finite x/y; (0,0) returns 0
+// Results of the 4/8-wide versions are bit-identical to the scalar versions.
+// Angles must satisfy |degrees| < 1.5e11 so the quadrant index fits in an int.
+//
+float FastSinDegrees(float degrees);
+float FastCosDegrees(float degrees);
+void  FastSinCosDegrees(float degrees, float& out_sin, float& out_cos);
+float FastAtan2Degrees(float y, float x);
+
+void   FastSinCosDegrees4(__m128 degrees, __m128& out_sines, __m128& out_cosines);
+__m128 FastAtan2Degrees4(__m128 y, __m128 x);
+#if defined(__AVX__)
+void   FastSinCosDegrees8(__m256 degrees, __m256& out_sines, __m256& out_cosines);
+__m256 FastAtan2Degrees8(__m256 y, __m256 x);
+#endif
+
+// Array versions use the widest kernel the build supports; outputs may not alias inputs
+void FastSinCosDegreesArray(float const* degrees, int count, float* out_sines, float* out_cosines);
+void FastAtan2DegreesArray(float const* y, float const* x, int count, float* out_degrees);
\ No newline at end of file
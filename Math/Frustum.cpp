@@ -0,0 +1,283 @@
+#include "Engine/Math/Frustum.hpp"
+#include "Engine/Math/AABB3Tree.hpp"
+#include "Engine/Math/OverlapBatch3D.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/SimdMath.hpp"
+
+//----------------------------------------------------------------------------------------------
+// Gribb-Hartmann extraction: with clip = M * p, each plane is a sum/difference of rows of M.
+// Mat44 is basis-major, so row r of M is (m[r], m[4+r], m[8+r], m[12+r]).
+//
+static Plane3D MakeNormalizedPlane(float a, float b, float c, float d)
+{
+	Vec3 normal(a, b, c);
+	float length = normal.GetLength();
+	float oneOverLength = length > 0.f ? 1.f / length : 0.f;
+	// ax + by + cz + d >= 0  <=>  dot(n, p) - (-d) >= 0
+	return Plane3D(normal * oneOverLength, -d * oneOverLength);
+}
+
+Frustum::Frustum(Mat44 const& viewProjection)
+{
+	float const* m = viewProjection.m_values;
+	float const row0[4] = { m[0], m[4], m[8],  m[12] };
+	float const row1[4] = { m[1], m[5], m[9],  m[13] };
+	float const row2[4] = { m[2], m[6], m[10], m[14] };
+	float const row3[4] = { m[3], m[7], m[11], m[15] };
+
+	m_planes[FRUSTUM_PLANE_LEFT]	= MakeNormalizedPlane(row3[0] + row0[0], row3[1] + row0[1], row3[2] + row0[2], row3[3] + row0[3]);
+	m_planes[FRUSTUM_PLANE_RIGHT]	= MakeNormalizedPlane(row3[0] - row0[0], row3[1] - row0[1], row3[2] - row0[2], row3[3] - row0[3]);
+	m_planes[FRUSTUM_PLANE_BOTTOM]	= MakeNormalizedPlane(row3[0] + row1[0], row3[1] + row1[1], row3[2] + row1[2], row3[3] + row1[3]);
+	m_planes[FRUSTUM_PLANE_TOP]		= MakeNormalizedPlane(row3[0] - row1[0], row3[1] - row1[1], row3[2] - row1[2], row3[3] - row1[3]);
+	m_planes[FRUSTUM_PLANE_NEAR]	= MakeNormalizedPlane(row2[0], row2[1], row2[2], row2[3]);
+	m_planes[FRUSTUM_PLANE_FAR]		= MakeNormalizedPlane(row3[0] - row2[0], row3[1] - row2[1], row3[2] - row2[2], row3[3] - row2[3]);
+}
+
+bool Frustum::IsPointInside(Vec3 const& point) const
+{
+	for (int planeIndex = 0; planeIndex < NUM_FRUSTUM_PLANES; ++planeIndex)
+	{
+		if (m_planes[planeIndex].GetDistance(point) < 0.f)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool Frustum::IsSphereVisible(Vec3 const& sphereCenter, float sphereRadius) const
+{
+	for (int planeIndex = 0; planeIndex < NUM_FRUSTUM_PLANES; ++planeIndex)
+	{
+		Plane3D const& plane = m_planes[planeIndex];
+		float distance = (plane.normal.x * sphereCenter.x + plane.normal.y * sphereCenter.y) + plane.normal.z * sphereCenter.z;
+		if (distance + sphereRadius < plane.distanceFromOriginAlongNormal)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// Distance term of the box corner furthest along the plane normal (the "positive vertex")
+static float GetPositiveVertexDot(Plane3D const& plane, AABB3 const& box)
+{
+	float x = plane.normal.x >= 0.f ? box.m_maxs.x : box.m_mins.x;
+	float y = plane.normal.y >= 0.f ? box.m_maxs.y : box.m_mins.y;
+	float z = plane.normal.z >= 0.f ? box.m_maxs.z : box.m_mins.z;
+	return (plane.normal.x * x + plane.normal.y * y) + plane.normal.z * z;
+}
+
+static float GetNegativeVertexDot(Plane3D const& plane, AABB3 const& box)
+{
+	float x = plane.normal.x >= 0.f ? box.m_mins.x : box.m_maxs.x;
+	float y = plane.normal.y >= 0.f ? box.m_mins.y : box.m_maxs.y;
+	float z = plane.normal.z >= 0.f ? box.m_mins.z : box.m_maxs.z;
+	return (plane.normal.x * x + plane.normal.y * y) + plane.normal.z * z;
+}
+
+bool Frustum::IsAABBVisible(AABB3 const& box) const
+{
+	for (int planeIndex = 0; planeIndex < NUM_FRUSTUM_PLANES; ++planeIndex)
+	{
+		if (GetPositiveVertexDot(m_planes[planeIndex], box) < m_planes[planeIndex].distanceFromOriginAlongNormal)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------
+static void AppendLaneIndices(unsigned int laneBits, int firstIndex, std::vector<int>& out_indices)
+{
+	while (laneBits != 0)
+	{
+		int lane = 0;
+		while ((laneBits & (1u << lane)) == 0)
+		{
+			++lane;
+		}
+		out_indices.push_back(firstIndex + lane);
+		laneBits &= laneBits - 1;
+	}
+}
+
+int Frustum::CullAABBs(AABB3SoA const& boxes, std::vector<int>& out_visibleIndices) const
+{
+	out_visibleIndices.clear();
+	int numBoxes = boxes.GetCount();
+	unsigned int const allLanes = (1u << SIMD_WIDTH) - 1u;
+
+	// The positive vertex only depends on the sign of the normal, so choose the source arrays once per plane
+	float const* positiveX[NUM_FRUSTUM_PLANES];
+	float const* positiveY[NUM_FRUSTUM_PLANES];
+	float const* positiveZ[NUM_FRUSTUM_PLANES];
+	for (int planeIndex = 0; planeIndex < NUM_FRUSTUM_PLANES; ++planeIndex)
+	{
+		Vec3 const& normal = m_planes[planeIndex].normal;
+		positiveX[planeIndex] = normal.x >= 0.f ? boxes.m_maxX.data() : boxes.m_minX.data();
+		positiveY[planeIndex] = normal.y >= 0.f ? boxes.m_maxY.data() : boxes.m_minY.data();
+		positiveZ[planeIndex] = normal.z >= 0.f ? boxes.m_maxZ.data() : boxes.m_minZ.data();
+	}
+
+	int boxIndex = 0;
+	for (; boxIndex + SIMD_WIDTH <= numBoxes; boxIndex += SIMD_WIDTH)
+	{
+		unsigned int visibleLanes = allLanes;
+		for (int planeIndex = 0; planeIndex < NUM_FRUSTUM_PLANES && visibleLanes != 0; ++planeIndex)
+		{
+			Plane3D const& plane = m_planes[planeIndex];
+			SimdFloat dot = SimdAdd(SimdAdd(
+				SimdMul(SimdSplat(plane.normal.x), SimdLoad(positiveX[planeIndex] + boxIndex)),
+				SimdMul(SimdSplat(plane.normal.y), SimdLoad(positiveY[planeIndex] + boxIndex))),
+				SimdMul(SimdSplat(plane.normal.z), SimdLoad(positiveZ[planeIndex] + boxIndex)));
+			visibleLanes &= SimdMoveMask(SimdLessEqual(SimdSplat(plane.distanceFromOriginAlongNormal), dot));
+		}
+		AppendLaneIndices(visibleLanes, boxIndex, out_visibleIndices);
+	}
+	for (; boxIndex < numBoxes; ++boxIndex)
+	{
+		if (IsAABBVisible(boxes.Get(boxIndex)))
+		{
+			out_visibleIndices.push_back(boxIndex);
+		}
+	}
+	return (int)out_visibleIndices.size();
+}
+
+int Frustum::CullSpheres(SphereSoA const& spheres, std::vector<int>& out_visibleIndices) const
+{
+	out_visibleIndices.clear();
+	int numSpheres = spheres.GetCount();
+	unsigned int const allLanes = (1u << SIMD_WIDTH) - 1u;
+
+	int sphereIndex = 0;
+	for (; sphereIndex + SIMD_WIDTH <= numSpheres; sphereIndex += SIMD_WIDTH)
+	{
+		SimdFloat centerX = SimdLoad(&spheres.m_centerX[sphereIndex]);
+		SimdFloat centerY = SimdLoad(&spheres.m_centerY[sphereIndex]);
+		SimdFloat centerZ = SimdLoad(&spheres.m_centerZ[sphereIndex]);
+		SimdFloat radius = SimdLoad(&spheres.m_radius[sphereIndex]);
+		unsigned int visibleLanes = allLanes;
+		for (int planeIndex = 0; planeIndex < NUM_FRUSTUM_PLANES && visibleLanes != 0; ++planeIndex)
+		{
+			Plane3D const& plane = m_planes[planeIndex];
+			SimdFloat dot = SimdAdd(SimdAdd(
+				SimdMul(SimdSplat(plane.normal.x), centerX),
+				SimdMul(SimdSplat(plane.normal.y), centerY)),
+				SimdMul(SimdSplat(plane.normal.z), centerZ));
+			visibleLanes &= SimdMoveMask(SimdLessEqual(SimdSplat(plane.distanceFromOriginAlongNormal), SimdAdd(dot, radius)));
+		}
+		AppendLaneIndices(visibleLanes, sphereIndex, out_visibleIndices);
+	}
+	for (; sphereIndex < numSpheres; ++sphereIndex)
+	{
+		Vec3 center(spheres.m_centerX[sphereIndex], spheres.m_centerY[sphereIndex], spheres.m_centerZ[sphereIndex]);
+		if (IsSphereVisible(center, spheres.m_radius[sphereIndex]))
+		{
+			out_visibleIndices.push_back(sphereIndex);
+		}
+	}
+	return (int)out_visibleIndices.size();
+}
+
+//----------------------------------------------------------------------------------------------
+static void AppendAllPrimitivesInSubtree(AABB3Tree const& tree, int nodeIndex, std::vector<int>& out_indices)
+{
+	std::vector<AABB3TreeNode> const& nodes = tree.GetNodes();
+	std::vector<int> const& primitiveIndices = tree.GetPrimitiveIndices();
+	AABB3TreeNode const& node = nodes[nodeIndex];
+	if (node.IsLeaf())
+	{
+		for (int i = 0; i < node.m_numPrimitives; ++i)
+		{
+			out_indices.push_back(primitiveIndices[node.m_firstChildOrPrimitive + i]);
+		}
+		return;
+	}
+	AppendAllPrimitivesInSubtree(tree, node.m_firstChildOrPrimitive, out_indices);
+	AppendAllPrimitivesInSubtree(tree, node.m_firstChildOrPrimitive + 1, out_indices);
+}
+
+int Frustum::CullAABBTree(AABB3Tree const& tree, std::vector<int>& out_visibleIndices) const
+{
+	out_visibleIndices.clear();
+	if (tree.IsEmpty())
+	{
+		return 0;
+	}
+
+	struct PendingNode
+	{
+		int m_nodeIndex;
+		unsigned int m_planeMask;	// planes the node still straddles; planes it is fully inside are dropped
+	};
+	constexpr unsigned int ALL_PLANES = (1u << NUM_FRUSTUM_PLANES) - 1u;
+
+	std::vector<AABB3TreeNode> const& nodes = tree.GetNodes();
+	std::vector<int> const& primitiveIndices = tree.GetPrimitiveIndices();
+	std::vector<AABB3> const& primitiveBounds = tree.GetPrimitiveBounds();
+	std::vector<PendingNode> pendingNodes;
+	pendingNodes.push_back({ 0, ALL_PLANES });
+	while (!pendingNodes.empty())
+	{
+		PendingNode pending = pendingNodes.back();
+		pendingNodes.pop_back();
+		AABB3TreeNode const& node = nodes[pending.m_nodeIndex];
+
+		bool isOutside = false;
+		unsigned int planeMask = pending.m_planeMask;
+		for (int planeIndex = 0; planeIndex < NUM_FRUSTUM_PLANES; ++planeIndex)
+		{
+			if ((planeMask & (1u << planeIndex)) == 0)
+			{
+				continue;
+			}
+			Plane3D const& plane = m_planes[planeIndex];
+			if (GetPositiveVertexDot(plane, node.m_bounds) < plane.distanceFromOriginAlongNormal)
+			{
+				isOutside = true;
+				break;
+			}
+			if (GetNegativeVertexDot(plane, node.m_bounds) >= plane.distanceFromOriginAlongNormal)
+			{
+				planeMask &= ~(1u << planeIndex);
+			}
+		}
+		if (isOutside)
+		{
+			continue;
+		}
+		if (planeMask == 0)
+		{
+			AppendAllPrimitivesInSubtree(tree, pending.m_nodeIndex, out_visibleIndices);
+			continue;
+		}
+		if (!node.IsLeaf())
+		{
+			pendingNodes.push_back({ node.m_firstChildOrPrimitive + 1, planeMask });
+			pendingNodes.push_back({ node.m_firstChildOrPrimitive, planeMask });
+			continue;
+		}
+
+		for (int i = 0; i < node.m_numPrimitives; ++i)
+		{
+			int primitiveIndex = primitiveIndices[node.m_firstChildOrPrimitive + i];
+			AABB3 const& box = primitiveBounds[primitiveIndex];
+			bool isVisible = true;
+			for (int planeIndex = 0; planeIndex < NUM_FRUSTUM_PLANES && isVisible; ++planeIndex)
+			{
+				if ((planeMask & (1u << planeIndex)) != 0 && GetPositiveVertexDot(m_planes[planeIndex], box) < m_planes[planeIndex].distanceFromOriginAlongNormal)
+				{
+					isVisible = false;
+				}
+			}
+			if (isVisible)
+			{
+				out_visibleIndices.push_back(primitiveIndex);
+			}
+		}
+	}
+	return (int)out_visibleIndices.size();
+}
\ No newline at end of file
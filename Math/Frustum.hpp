@@ -0,0 +1,48 @@
+#pragma once
+#include "Engine/Math/Plane3.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include <vector>
+
+struct AABB3SoA;
+struct SphereSoA;
+class AABB3Tree;
+
+enum FrustumPlane
+{
+	FRUSTUM_PLANE_LEFT,
+	FRUSTUM_PLANE_RIGHT,
+	FRUSTUM_PLANE_BOTTOM,
+	FRUSTUM_PLANE_TOP,
+	FRUSTUM_PLANE_NEAR,
+	FRUSTUM_PLANE_FAR,
+	NUM_FRUSTUM_PLANES
+};
+
+//----------------------------------------------------------------------------------------------
+// Six inward-facing planes extracted from a view-projection matrix (D3D clip space, 0 <= z <= w).
+// A point is inside when its distance to every plane is >= 0. Box and sphere tests are
+// conservative: shapes near a frustum corner may be reported visible even when they are not,
+// but a visible shape is never culled.
+//
+struct Frustum
+{
+public:
+	Plane3D m_planes[NUM_FRUSTUM_PLANES];
+
+public:
+	Frustum() {}
+	explicit Frustum(Mat44 const& viewProjection);
+
+	bool IsPointInside(Vec3 const& point) const;
+	bool IsSphereVisible(Vec3 const& sphereCenter, float sphereRadius) const;
+	bool IsAABBVisible(AABB3 const& box) const;
+
+	// Batch tests; out_visibleIndices is cleared and filled in ascending order. Return the visible count.
+	int CullAABBs(AABB3SoA const& boxes, std::vector<int>& out_visibleIndices) const;
+	int CullSpheres(SphereSoA const& spheres, std::vector<int>& out_visibleIndices) const;
+
+	// Hierarchical test; whole subtrees are accepted or rejected once a node is fully inside or outside.
+	// Indices refer to the boxes the tree was built from and are not sorted.
+	int CullAABBTree(AABB3Tree const& tree, std::vector<int>& out_visibleIndices) const;
+};
\ No newline at end of file
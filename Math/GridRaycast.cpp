@@ -0,0 +1,282 @@
+#include "Engine/Math/GridRaycast.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+RaycastResult2D RaycastVsGrid2D(Vec2 const& rayStart, Vec2 const& rayFwdNormal, float rayMaxDist, IsTileSolidCallback const& isTileSolid)
+{
+	RaycastResult2D result;
+	result.m_rayStartPos = rayStart;
+	result.m_rayFwdNormal = rayFwdNormal;
+	result.m_rayMaxLength = rayMaxDist;
+
+	IntVec2 tileCoords(RoundDownToInt(rayStart.x), RoundDownToInt(rayStart.y));
+	if (isTileSolid(tileCoords))
+	{
+		result.m_didImpact = true;
+		result.m_impactDist = 0.f;
+		result.m_impactPos = rayStart;
+		result.m_impactNormal = -rayFwdNormal;
+		result.m_AABB2 = AABB2(Vec2((float)tileCoords.x, (float)tileCoords.y), Vec2((float)tileCoords.x + 1.f, (float)tileCoords.y + 1.f));
+		return result;
+	}
+
+	// A zero direction never leaves the start cell, and with an infinite rayMaxDist the walk below would never end
+	if (rayFwdNormal.x == 0.f && rayFwdNormal.y == 0.f)
+	{
+		return result;
+	}
+
+	constexpr float INFINITE_DIST = std::numeric_limits<float>::infinity();
+	int stepX = rayFwdNormal.x < 0.f ? -1 : 1;
+	int stepY = rayFwdNormal.y < 0.f ? -1 : 1;
+
+	// Distance along the ray needed to cross one whole cell on each axis
+	float distPerCellX = rayFwdNormal.x != 0.f ? 1.f / fabsf(rayFwdNormal.x) : INFINITE_DIST;
+	float distPerCellY = rayFwdNormal.y != 0.f ? 1.f / fabsf(rayFwdNormal.y) : INFINITE_DIST;
+
+	// Distance along the ray to the first cell boundary on each axis
+	float firstBoundaryX = stepX > 0 ? (float)(tileCoords.x + 1) - rayStart.x : rayStart.x - (float)tileCoords.x;
+	float firstBoundaryY = stepY > 0 ? (float)(tileCoords.y + 1) - rayStart.y : rayStart.y - (float)tileCoords.y;
+	float nextCrossingX = rayFwdNormal.x != 0.f ? firstBoundaryX * distPerCellX : INFINITE_DIST;
+	float nextCrossingY = rayFwdNormal.y != 0.f ? firstBoundaryY * distPerCellY : INFINITE_DIST;
+
+	for (;;)
+	{
+		float crossingDist;
+		Vec2 impactNormal;
+		if (nextCrossingX < nextCrossingY)
+		{
+			crossingDist = nextCrossingX;
+			tileCoords.x += stepX;
+			nextCrossingX += distPerCellX;
+			impactNormal = Vec2((float)-stepX, 0.f);
+		}
+		else
+		{
+			crossingDist = nextCrossingY;
+			tileCoords.y += stepY;
+			nextCrossingY += distPerCellY;
+			impactNormal = Vec2(0.f, (float)-stepY);
+		}
+
+		if (crossingDist > rayMaxDist)
+		{
+			return result;
+		}
+
+		if (isTileSolid(tileCoords))
+		{
+			result.m_didImpact = true;
+			result.m_impactDist = crossingDist;
+			result.m_impactPos = rayStart + rayFwdNormal * crossingDist;
+			result.m_impactNormal = impactNormal;
+			result.m_AABB2 = AABB2(Vec2((float)tileCoords.x, (float)tileCoords.y), Vec2((float)tileCoords.x + 1.f, (float)tileCoords.y + 1.f));
+			return result;
+		}
+	}
+}
+
+RaycastResult3D RaycastVsGrid3D(Vec3 const& rayStart, Vec3 const& rayFwdNormal, float rayMaxDist, IsCellSolidCallback const& isCellSolid)
+{
+	RaycastResult3D result;
+	result.m_rayStartPosition = rayStart;
+	result.m_rayDirection = rayFwdNormal;
+	result.m_rayLength = rayMaxDist;
+
+	IntVec3 cellCoords(RoundDownToInt(rayStart.x), RoundDownToInt(rayStart.y), RoundDownToInt(rayStart.z));
+	if (isCellSolid(cellCoords))
+	{
+		result.m_didImpact = true;
+		result.m_impactDist = 0.f;
+		result.m_impactPos = rayStart;
+		result.m_impactNormal = rayFwdNormal * -1.f;
+		result.m_shape = Shape::BOX;
+		result.m_box = AABB3((float)cellCoords.x, (float)cellCoords.y, (float)cellCoords.z, (float)cellCoords.x + 1.f, (float)cellCoords.y + 1.f, (float)cellCoords.z + 1.f);
+		return result;
+	}
+
+	if (rayFwdNormal.x == 0.f && rayFwdNormal.y == 0.f && rayFwdNormal.z == 0.f)
+	{
+		return result;
+	}
+
+	constexpr float INFINITE_DIST = std::numeric_limits<float>::infinity();
+	float const start[3] = { rayStart.x, rayStart.y, rayStart.z };
+	float const fwd[3] = { rayFwdNormal.x, rayFwdNormal.y, rayFwdNormal.z };
+	int cell[3] = { cellCoords.x, cellCoords.y, cellCoords.z };
+	int step[3];
+	float distPerCell[3];
+	float nextCrossing[3];
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		step[axis] = fwd[axis] < 0.f ? -1 : 1;
+		if (fwd[axis] == 0.f)
+		{
+			distPerCell[axis] = INFINITE_DIST;
+			nextCrossing[axis] = INFINITE_DIST;
+			continue;
+		}
+		distPerCell[axis] = 1.f / fabsf(fwd[axis]);
+		float firstBoundary = step[axis] > 0 ? (float)(cell[axis] + 1) - start[axis] : start[axis] - (float)cell[axis];
+		nextCrossing[axis] = firstBoundary * distPerCell[axis];
+	}
+
+	for (;;)
+	{
+		int axis = 0;
+		if (nextCrossing[1] < nextCrossing[axis]) axis = 1;
+		if (nextCrossing[2] < nextCrossing[axis]) axis = 2;
+
+		float crossingDist = nextCrossing[axis];
+		if (crossingDist > rayMaxDist)
+		{
+			return result;
+		}
+		cell[axis] += step[axis];
+		nextCrossing[axis] += distPerCell[axis];
+
+		cellCoords = IntVec3(cell[0], cell[1], cell[2]);
+		if (isCellSolid(cellCoords))
+		{
+			Vec3 impactNormal;
+			if (axis == 0) impactNormal.x = (float)-step[0];
+			if (axis == 1) impactNormal.y = (float)-step[1];
+			if (axis == 2) impactNormal.z = (float)-step[2];
+
+			result.m_didImpact = true;
+			result.m_impactDist = crossingDist;
+			result.m_impactPos = rayStart + rayFwdNormal * crossingDist;
+			result.m_impactNormal = impactNormal;
+			result.m_shape = Shape::BOX;
+			result.m_box = AABB3((float)cell[0], (float)cell[1], (float)cell[2], (float)cell[0] + 1.f, (float)cell[1] + 1.f, (float)cell[2] + 1.f);
+			return result;
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+class GridRaycast2DJob : public Job
+{
+public:
+	GridRaycast2DJob(GridRay2D const* rays, RaycastResult2D* results, int numRays, IsTileSolidCallback const& isTileSolid)
+		: m_rays(rays)
+		, m_results(results)
+		, m_numRays(numRays)
+		, m_isTileSolid(isTileSolid)
+	{
+	}
+
+	virtual void Execute() override
+	{
+		for (int rayIndex = 0; rayIndex < m_numRays; ++rayIndex)
+		{
+			GridRay2D const& ray = m_rays[rayIndex];
+			m_results[rayIndex] = RaycastVsGrid2D(ray.m_startPos, ray.m_fwdNormal, ray.m_maxDist, m_isTileSolid);
+		}
+	}
+
+private:
+	GridRay2D const*			m_rays = nullptr;
+	RaycastResult2D*			m_results = nullptr;
+	int							m_numRays = 0;
+	IsTileSolidCallback const&	m_isTileSolid;
+};
+
+class GridRaycast3DJob : public Job
+{
+public:
+	GridRaycast3DJob(GridRay3D const* rays, RaycastResult3D* results, int numRays, IsCellSolidCallback const& isCellSolid)
+		: m_rays(rays)
+		, m_results(results)
+		, m_numRays(numRays)
+		, m_isCellSolid(isCellSolid)
+	{
+	}
+
+	virtual void Execute() override
+	{
+		for (int rayIndex = 0; rayIndex < m_numRays; ++rayIndex)
+		{
+			GridRay3D const& ray = m_rays[rayIndex];
+			m_results[rayIndex] = RaycastVsGrid3D(ray.m_startPos, ray.m_fwdNormal, ray.m_maxDist, m_isCellSolid);
+		}
+	}
+
+private:
+	GridRay3D const*			m_rays = nullptr;
+	RaycastResult3D*			m_results = nullptr;
+	int							m_numRays = 0;
+	IsCellSolidCallback const&	m_isCellSolid;
+};
+
+void RaycastVsGrid2DBatch(JobSystem* jobSystem, std::vector<GridRay2D> const& rays, std::vector<RaycastResult2D>& outResults, IsTileSolidCallback const& isTileSolid, int raysPerJob)
+{
+	int numRays = (int)rays.size();
+	outResults.resize(numRays);
+	if (numRays == 0)
+	{
+		return;
+	}
+	if (raysPerJob < 1)
+	{
+		raysPerJob = 1;
+	}
+
+	if (jobSystem == nullptr || numRays <= raysPerJob)
+	{
+		GridRaycast2DJob inlineJob(rays.data(), outResults.data(), numRays, isTileSolid);
+		inlineJob.Execute();
+		return;
+	}
+
+	std::vector<Job*> jobs;
+	for (int firstRay = 0; firstRay < numRays; firstRay += raysPerJob)
+	{
+		int numRaysInJob = std::min(raysPerJob, numRays - firstRay);
+		Job* job = new GridRaycast2DJob(rays.data() + firstRay, outResults.data() + firstRay, numRaysInJob, isTileSolid);
+		jobs.push_back(job);
+		jobSystem->QueueJob(job);
+	}
+	jobSystem->WaitUntilJobsCompleted(jobs);
+	for (Job* job : jobs)
+	{
+		delete job;
+	}
+}
+
+void RaycastVsGrid3DBatch(JobSystem* jobSystem, std::vector<GridRay3D> const& rays, std::vector<RaycastResult3D>& outResults, IsCellSolidCallback const& isCellSolid, int raysPerJob)
+{
+	int numRays = (int)rays.size();
+	outResults.resize(numRays);
+	if (numRays == 0)
+	{
+		return;
+	}
+	if (raysPerJob < 1)
+	{
+		raysPerJob = 1;
+	}
+
+	if (jobSystem == nullptr || numRays <= raysPerJob)
+	{
+		GridRaycast3DJob inlineJob(rays.data(), outResults.data(), numRays, isCellSolid);
+		inlineJob.Execute();
+		return;
+	}
+
+	std::vector<Job*> jobs;
+	for (int firstRay = 0; firstRay < numRays; firstRay += raysPerJob)
+	{
+		int numRaysInJob = std::min(raysPerJob, numRays - firstRay);
+		Job* job = new GridRaycast3DJob(rays.data() + firstRay, outResults.data() + firstRay, numRaysInJob, isCellSolid);
+		jobs.push_back(job);
+		jobSystem->QueueJob(job);
+	}
+	jobSystem->WaitUntilJobsCompleted(jobs);
+	for (Job* job : jobs)
+	{
+		delete job;
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/IntVec3.hpp"
+#include <functional>
+#include <vector>
+
+class JobSystem;
+
+//----------------------------------------------------------------------------------------------
+// Amanatides-Woo fast voxel traversal through unit-sized grid cells; cell (x,y[,z]) covers
+// [x,x+1) x [y,y+1) [x [z,z+1)]. The ray visits every cell it touches exactly once, in order,
+// and stops at the first cell the callback reports as solid.
+//
+// On impact, m_AABB2 (2D) or m_box (3D) holds the bounds of the solid cell that was hit.
+// A ray that starts inside a solid cell impacts at distance 0 with normal -rayFwdNormal; otherwise a zero
+// rayFwdNormal misses.
+// Callbacks used by the batch functions are called from worker threads and must be read-only.
+//
+typedef std::function<bool(IntVec2 const& tileCoords)> IsTileSolidCallback;
+typedef std::function<bool(IntVec3 const& cellCoords)> IsCellSolidCallback;
+
+struct GridRay2D
+{
+	Vec2	m_startPos;
+	Vec2	m_fwdNormal;
+	float	m_maxDist = 1.f;
+};
+
+struct GridRay3D
+{
+	Vec3	m_startPos;
+	Vec3	m_fwdNormal;
+	float	m_maxDist = 1.f;
+};
+
+RaycastResult2D RaycastVsGrid2D(Vec2 const& rayStart, Vec2 const& rayFwdNormal, float rayMaxDist, IsTileSolidCallback const& isTileSolid);
+RaycastResult3D RaycastVsGrid3D(Vec3 const& rayStart, Vec3 const& rayFwdNormal, float rayMaxDist, IsCellSolidCallback const& isCellSolid);
+
+// Splits the rays into jobs of raysPerJob and blocks until all are done; runs inline if jobSystem is null
+void RaycastVsGrid2DBatch(JobSystem* jobSystem, std::vector<GridRay2D> const& rays, std::vector<RaycastResult2D>& outResults, IsTileSolidCallback const& isTileSolid, int raysPerJob = 256);
+void RaycastVsGrid3DBatch(JobSystem* jobSystem, std::vector<GridRay3D> const& rays, std::vector<RaycastResult3D>& outResults, IsCellSolidCallback const& isCellSolid, int raysPerJob = 256);
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "Engine/Math/Mat44.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/FastTrig.hpp"
 #include <cmath>
 constexpr float PI = 3.14159265358979323846f;
 
@@ -75,27 +76,27 @@ Mat44 const Mat44::CreateNonUniformScale3D(Vec3 const& nonUniformScaleXYZ)
 
 Mat44 const Mat44::CreateZRotationDegrees(float rotationDegreesAboutZ)
  {
-	float radians = rotationDegreesAboutZ * (PI / 180.f);
-	float cosTheta = cosf(radians);
-	float sinTheta = sinf(radians);
+	float cosTheta;
+	float sinTheta;
+	FastSinCosDegrees(rotationDegreesAboutZ, sinTheta, cosTheta);
 
 	return Mat44(Vec2(cosTheta, sinTheta), Vec2(-sinTheta, cosTheta), Vec2(0.f, 0.f));
  }
 
 Mat44 const Mat44::CreateYRotationDegrees(float rotationDegreesAboutY)
  {
-	float radians = rotationDegreesAboutY * (PI / 180.f);
-	float cosTheta = cosf(radians);
-	float sinTheta = sinf(radians);
+	float cosTheta;
+	float sinTheta;
+	FastSinCosDegrees(rotationDegreesAboutY, sinTheta, cosTheta);
 
 	return Mat44(Vec3(cosTheta, 0.f, -sinTheta), Vec3(0.f, 1.f, 0.f), Vec3(sinTheta, 0.f, cosTheta), Vec3(0.f, 0.f, 0.f));
  }
 
 Mat44 const Mat44::CreateXRotationDegrees(float rotationDegreesAboutX)
  {
-	float radians = rotationDegreesAboutX * (PI / 180.f);
-	float cosTheta = cosf(radians);
-	float sinTheta = sinf(radians);
+	float cosTheta;
+	float sinTheta;
+	FastSinCosDegrees(rotationDegreesAboutX, sinTheta, cosTheta);
 
 	return Mat44(Vec3(1.f, 0.f, 0.f), Vec3(0.f, cosTheta, sinTheta), Vec3(0.f, -sinTheta, cosTheta), Vec3(0.f, 0.f, 0.f));
 
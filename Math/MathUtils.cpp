@@ -7,6 +7,7 @@
 #include "Engine/Math/OBB2.hpp"
 #include "Engine/Math/OBB3.hpp"
 #include "Engine/Math/Plane3.hpp"
+#include "Engine/Math/FastTrig.hpp"
 #include <cmath>
 
 constexpr float PI = 3.14159265358979323846f;
@@ -234,7 +235,7 @@ RaycastResult2D RaycastVsAABB2D(Vec2 rayStart, Vec2 rayEnd, Vec2 rayFwdNormal, f
 	}
 }
 
-RaycastResult3D RaycastVsAABB3D(Vec3 rayStart, Vec3 rayForwardNormal, float rayLength, AABB3 box)
+RaycastResult3D RaycastVsAABB3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, AABB3 const& box)
 {
 	RaycastResult3D result;
 
@@ -293,7 +294,7 @@ RaycastResult3D RaycastVsAABB3D(Vec3 rayStart, Vec3 rayForwardNormal, float rayL
 	return result;
 }
 
-RaycastResult3D RaycastVsOBB3D(Vec3 rayStart, Vec3 rayForwardNormal, float rayLength, OBB3 obb)
+RaycastResult3D RaycastVsOBB3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, OBB3 const& obb)
 {
 	RaycastResult3D result;
 
@@ -335,7 +336,7 @@ RaycastResult3D RaycastVsOBB3D(Vec3 rayStart, Vec3 rayForwardNormal, float rayLe
 	return result;
 }
 
-RaycastResult3D RaycastVsSphere3D(Vec3 rayStart, Vec3 rayForwardNormal, float rayLength, Vec3 sphereCenter, float sphereRadius)
+RaycastResult3D RaycastVsSphere3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, Vec3 const& sphereCenter, float sphereRadius)
 {
 	RaycastResult3D result;
 
@@ -383,7 +384,7 @@ RaycastResult3D RaycastVsSphere3D(Vec3 rayStart, Vec3 rayForwardNormal, float ra
 	return result;
 }
 
-RaycastResult3D RaycastVsCylinderZ3D(Vec3 rayStart, Vec3 rayForwardNormal, float rayLength, Vec2 const& centerXY, FloatRange const& minMaxZ, float radiusXY)
+RaycastResult3D RaycastVsCylinderZ3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, Vec2 const& centerXY, FloatRange const& minMaxZ, float radiusXY)
 {
 	RaycastResult3D result;
 
@@ -447,7 +448,7 @@ RaycastResult3D RaycastVsCylinderZ3D(Vec3 rayStart, Vec3 rayForwardNormal, float
 	return result;
 }
 
-RaycastResult3D RaycastVsPlane3D(Vec3 rayStart, Vec3 rayForwardNormal, float rayLength, Plane3D plane)
+RaycastResult3D RaycastVsPlane3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, Plane3D const& plane)
 {
 	RaycastResult3D result;
 	float rayDirDotPlaneNormal = DotProduct3D(rayForwardNormal, plane.normal);
@@ -473,6 +474,278 @@ RaycastResult3D RaycastVsPlane3D(Vec3 rayStart, Vec3 rayForwardNormal, float ray
 	return result;
 }
 
+//----------------------------------------------------------------------------------------------
+// Slab test shared by the hit-only and closest-hit AABB queries. out_entryAxis is -1 when the
+// ray starts inside the box.
+static bool GetRayEntryVsAABB3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, AABB3 const& box, float& out_entryDist, int& out_entryAxis)
+{
+	float const start[3] = { rayStart.x, rayStart.y, rayStart.z };
+	float const direction[3] = { rayForwardNormal.x, rayForwardNormal.y, rayForwardNormal.z };
+	float const mins[3] = { box.m_mins.x, box.m_mins.y, box.m_mins.z };
+	float const maxs[3] = { box.m_maxs.x, box.m_maxs.y, box.m_maxs.z };
+
+	float entryDist = 0.f;
+	float exitDist = rayLength;
+	int entryAxis = -1;
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		if (direction[axis] == 0.f)
+		{
+			if (start[axis] < mins[axis] || start[axis] > maxs[axis])
+			{
+				return false;
+			}
+			continue;
+		}
+		float oneOverDirection = 1.f / direction[axis];
+		float slabEnter = (mins[axis] - start[axis]) * oneOverDirection;
+		float slabExit = (maxs[axis] - start[axis]) * oneOverDirection;
+		if (slabEnter > slabExit)
+		{
+			std::swap(slabEnter, slabExit);
+		}
+		if (slabEnter > entryDist)
+		{
+			entryDist = slabEnter;
+			entryAxis = axis;
+		}
+		if (slabExit < exitDist)
+		{
+			exitDist = slabExit;
+		}
+		if (entryDist > exitDist)
+		{
+			return false;
+		}
+	}
+	out_entryDist = entryDist;
+	out_entryAxis = entryAxis;
+	return true;
+}
+
+static Vec3 GetAABB3DEntryNormal(Vec3 const& rayForwardNormal, int entryAxis)
+{
+	Vec3 normal;
+	if (entryAxis == 0) normal.x = rayForwardNormal.x < 0.f ? 1.f : -1.f;
+	else if (entryAxis == 1) normal.y = rayForwardNormal.y < 0.f ? 1.f : -1.f;
+	else if (entryAxis == 2) normal.z = rayForwardNormal.z < 0.f ? 1.f : -1.f;
+	else normal = rayForwardNormal * -1.f;
+	return normal;
+}
+
+// Returns the entry distance of a ray against a sphere, or false if it misses within rayLength
+static bool GetRayEntryVsSphere3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, Vec3 const& sphereCenter, float sphereRadius, float& out_entryDist)
+{
+	Vec3 startToCenter = sphereCenter - rayStart;
+	float startToCenterLengthSquared = startToCenter.GetLengthSquared();
+	float radiusSquared = sphereRadius * sphereRadius;
+	if (startToCenterLengthSquared <= radiusSquared)
+	{
+		out_entryDist = 0.f;
+		return true;
+	}
+	float projectedLength = DotProduct3D(startToCenter, rayForwardNormal);
+	if (projectedLength <= 0.f || projectedLength - sphereRadius > rayLength)
+	{
+		return false;
+	}
+	float halfChordSquared = radiusSquared - (startToCenterLengthSquared - projectedLength * projectedLength);
+	if (halfChordSquared < 0.f)
+	{
+		return false;
+	}
+	float entryDist = projectedLength - sqrtf(halfChordSquared);
+	if (entryDist > rayLength)
+	{
+		return false;
+	}
+	out_entryDist = entryDist;
+	return true;
+}
+
+bool DoesRayHitAABB3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, AABB3 const& box)
+{
+	float entryDist;
+	int entryAxis;
+	return GetRayEntryVsAABB3D(rayStart, rayForwardNormal, rayLength, box, entryDist, entryAxis);
+}
+
+bool DoesRayHitOBB3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, OBB3 const& box)
+{
+	Vec3 iBasis = box.iBasis.GetNormalized();
+	Vec3 jBasis = box.jBasis.GetNormalized();
+	Vec3 kBasis = CrossProduct3D(iBasis, jBasis);
+
+	Vec3 startFromCenter = rayStart - box.center;
+	Vec3 localStart(DotProduct3D(startFromCenter, iBasis), DotProduct3D(startFromCenter, jBasis), DotProduct3D(startFromCenter, kBasis));
+	Vec3 localDirection(DotProduct3D(rayForwardNormal, iBasis), DotProduct3D(rayForwardNormal, jBasis), DotProduct3D(rayForwardNormal, kBasis));
+	AABB3 localBox(box.halfDimensions * -1.f, box.halfDimensions);
+	return DoesRayHitAABB3D(localStart, localDirection, rayLength, localBox);
+}
+
+bool DoesRayHitSphere3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, Vec3 const& sphereCenter, float sphereRadius)
+{
+	Vec3 startToCenter = sphereCenter - rayStart;
+	float startToCenterLengthSquared = startToCenter.GetLengthSquared();
+	float radiusSquared = sphereRadius * sphereRadius;
+	if (startToCenterLengthSquared <= radiusSquared)
+	{
+		return true;
+	}
+	float projectedLength = DotProduct3D(startToCenter, rayForwardNormal);
+	if (projectedLength <= 0.f || projectedLength - sphereRadius > rayLength)
+	{
+		return false;
+	}
+	float halfChordSquared = radiusSquared - (startToCenterLengthSquared - projectedLength * projectedLength);
+	if (halfChordSquared < 0.f)
+	{
+		return false;
+	}
+	// Entry is projectedLength - sqrt(halfChordSquared); compare squared to skip the sqrt
+	float overshoot = projectedLength - rayLength;
+	return overshoot <= 0.f || overshoot * overshoot <= halfChordSquared;
+}
+
+bool DoesRayHitCylinderZ3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, Vec2 const& centerXY, FloatRange const& minMaxZ, float radiusXY)
+{
+	float entryDist = 0.f;
+	float exitDist = rayLength;
+
+	// Clip against the z slab first, it is the cheapest rejection
+	if (rayForwardNormal.z == 0.f)
+	{
+		if (rayStart.z < minMaxZ.m_min || rayStart.z > minMaxZ.m_max)
+		{
+			return false;
+		}
+	}
+	else
+	{
+		float oneOverDirectionZ = 1.f / rayForwardNormal.z;
+		float slabEnter = (minMaxZ.m_min - rayStart.z) * oneOverDirectionZ;
+		float slabExit = (minMaxZ.m_max - rayStart.z) * oneOverDirectionZ;
+		if (slabEnter > slabExit)
+		{
+			std::swap(slabEnter, slabExit);
+		}
+		entryDist = std::max(entryDist, slabEnter);
+		exitDist = std::min(exitDist, slabExit);
+		if (entryDist > exitDist)
+		{
+			return false;
+		}
+	}
+
+	// Then against the infinite cylinder in xy: |startXY + t*dirXY - centerXY|^2 = r^2
+	float startOffsetX = rayStart.x - centerXY.x;
+	float startOffsetY = rayStart.y - centerXY.y;
+	float a = rayForwardNormal.x * rayForwardNormal.x + rayForwardNormal.y * rayForwardNormal.y;
+	float halfB = startOffsetX * rayForwardNormal.x + startOffsetY * rayForwardNormal.y;
+	float c = startOffsetX * startOffsetX + startOffsetY * startOffsetY - radiusXY * radiusXY;
+	if (a == 0.f)
+	{
+		return c <= 0.f;
+	}
+	float discriminant = halfB * halfB - a * c;
+	if (discriminant < 0.f)
+	{
+		return false;
+	}
+	float rootOfDiscriminant = sqrtf(discriminant);
+	float circleEnter = (-halfB - rootOfDiscriminant) / a;
+	float circleExit = (-halfB + rootOfDiscriminant) / a;
+	return std::max(entryDist, circleEnter) <= std::min(exitDist, circleExit);
+}
+
+bool DoesRayHitPlane3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, Plane3D const& plane)
+{
+	float startAltitude = DotProduct3D(rayStart, plane.normal) - plane.distanceFromOriginAlongNormal;
+	float endAltitude = startAltitude + DotProduct3D(rayForwardNormal, plane.normal) * rayLength;
+	return startAltitude * endAltitude <= 0.f;
+}
+
+bool IsRayOccludedByAABBs3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, AABB3 const* boxes, int numBoxes)
+{
+	for (int boxIndex = 0; boxIndex < numBoxes; ++boxIndex)
+	{
+		if (DoesRayHitAABB3D(rayStart, rayForwardNormal, rayLength, boxes[boxIndex]))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool IsRayOccludedBySpheres3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, Vec3 const* sphereCenters, float const* sphereRadii, int numSpheres)
+{
+	for (int sphereIndex = 0; sphereIndex < numSpheres; ++sphereIndex)
+	{
+		if (DoesRayHitSphere3D(rayStart, rayForwardNormal, rayLength, sphereCenters[sphereIndex], sphereRadii[sphereIndex]))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool RaycastClosestVsAABBs3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, AABB3 const* boxes, int numBoxes, RaycastHit3D& out_hit)
+{
+	float closestDist = rayLength;
+	int closestIndex = -1;
+	int closestEntryAxis = -1;
+	for (int boxIndex = 0; boxIndex < numBoxes; ++boxIndex)
+	{
+		float entryDist;
+		int entryAxis;
+		if (GetRayEntryVsAABB3D(rayStart, rayForwardNormal, closestDist, boxes[boxIndex], entryDist, entryAxis))
+		{
+			closestDist = entryDist;
+			closestIndex = boxIndex;
+			closestEntryAxis = entryAxis;
+		}
+	}
+	if (closestIndex < 0)
+	{
+		return false;
+	}
+	out_hit.m_impactDist = closestDist;
+	out_hit.m_impactNormal = GetAABB3DEntryNormal(rayForwardNormal, closestEntryAxis);
+	out_hit.m_primitiveIndex = closestIndex;
+	return true;
+}
+
+bool RaycastClosestVsSpheres3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, Vec3 const* sphereCenters, float const* sphereRadii, int numSpheres, RaycastHit3D& out_hit)
+{
+	float closestDist = rayLength;
+	int closestIndex = -1;
+	for (int sphereIndex = 0; sphereIndex < numSpheres; ++sphereIndex)
+	{
+		float entryDist;
+		if (GetRayEntryVsSphere3D(rayStart, rayForwardNormal, closestDist, sphereCenters[sphereIndex], sphereRadii[sphereIndex], entryDist))
+		{
+			closestDist = entryDist;
+			closestIndex = sphereIndex;
+		}
+	}
+	if (closestIndex < 0)
+	{
+		return false;
+	}
+	out_hit.m_impactDist = closestDist;
+	if (closestDist == 0.f)
+	{
+		out_hit.m_impactNormal = rayForwardNormal * -1.f;
+	}
+	else
+	{
+		Vec3 impactPos = rayStart + rayForwardNormal * closestDist;
+		out_hit.m_impactNormal = (impactPos - sphereCenters[closestIndex]).GetNormalized();
+	}
+	out_hit.m_primitiveIndex = closestIndex;
+	return true;
+}
+
 // Clamp and Lerp Functions
 float Clamp(float value, float minValue, float maxValue) {
 	if (value < minValue) return minValue;
@@ -538,14 +811,20 @@ float SinDegrees(float degrees) {
 	return std::sin(ConvertDegreesToRadians(degrees));
 }
 
+void SinCosDegrees(float degrees, float& out_sin, float& out_cos) {
+	float radians = ConvertDegreesToRadians(degrees);
+	out_sin = std::sin(radians);
+	out_cos = std::cos(radians);
+}
+
 float Atan2Degrees(float y, float x) {
 	return ConvertRadiansToDegrees(std::atan2(y, x));
 }
 
 float GetShortestAngularDispDegrees(float startDegrees, float endDegrees) {
-	float delta = endDegrees - startDegrees;
-	while (delta > 180.0f) delta -= 360.0f;
-	while (delta < -180.0f) delta += 360.0f;
+	float delta = fmodf(endDegrees - startDegrees, 360.0f); // (-360, 360), no loop for large inputs
+	if (delta > 180.0f) delta -= 360.0f;
+	else if (delta < -180.0f) delta += 360.0f;
 	return delta;
 }
 
@@ -745,7 +1024,7 @@ bool DoSpheresOverlap3D(const Vec3& centerA, float radiusA, const Vec3& centerB,
 	return GetDistanceSquared3D(centerA, centerB) <= (radiusA + radiusB) * (radiusA + radiusB);
 }
 
-bool DoZCylindersOverlap3D(Vec2 cylinder1CenterXY, float cylinder1Radius, FloatRange cylinder1MinMaxZ, Vec2 cylinder2CenterXY, float cylinder2Radius, FloatRange cylinder2MinMaxZ)
+bool DoZCylindersOverlap3D(Vec2 const& cylinder1CenterXY, float cylinder1Radius, FloatRange const& cylinder1MinMaxZ, Vec2 const& cylinder2CenterXY, float cylinder2Radius, FloatRange const& cylinder2MinMaxZ)
 {
 	float dx = cylinder1CenterXY.x - cylinder2CenterXY.x;
 	float dy = cylinder1CenterXY.y - cylinder2CenterXY.y;
@@ -757,7 +1036,7 @@ bool DoZCylindersOverlap3D(Vec2 cylinder1CenterXY, float cylinder1Radius, FloatR
 	return overlapInXY && overlapInZ;
 }
 
-bool DoSphereAndAABBOverlap3D(Vec3 sphereCenter, float spherRadius, AABB3 box)
+bool DoSphereAndAABBOverlap3D(Vec3 const& sphereCenter, float spherRadius, AABB3 const& box)
 {
 	float nearestX = std::max(box.m_mins.x, std::min(sphereCenter.x, box.m_maxs.x));
 	float nearestY = std::max(box.m_mins.y, std::min(sphereCenter.y, box.m_maxs.y));
@@ -771,7 +1050,7 @@ bool DoSphereAndAABBOverlap3D(Vec3 sphereCenter, float spherRadius, AABB3 box)
 	return distanceSquared <= (spherRadius * spherRadius);
 }
 
-bool DoZCylinderAndAABBOverlap3D(Vec2 cylinderCenterXY, float cylinderRadius, FloatRange cylinderMinMaxZ, AABB3 box)
+bool DoZCylinderAndAABBOverlap3D(Vec2 const& cylinderCenterXY, float cylinderRadius, FloatRange const& cylinderMinMaxZ, AABB3 const& box)
 {
 	float nearestX = std::max(box.m_mins.x, std::min(cylinderCenterXY.x, box.m_maxs.x));
 	float nearestY = std::max(box.m_mins.y, std::min(cylinderCenterXY.y, box.m_maxs.y));
@@ -784,7 +1063,7 @@ bool DoZCylinderAndAABBOverlap3D(Vec2 cylinderCenterXY, float cylinderRadius, Fl
 	return overlapInXY && overlapInZ;
 }
 
-bool DoZCylinderAndSphereOverlap3D(Vec2 cylinderCenterXY, float cylinderRadius, FloatRange cylinderMinMaxZ, Vec3 sphereCenter, float sphereRadius)
+bool DoZCylinderAndSphereOverlap3D(Vec2 const& cylinderCenterXY, float cylinderRadius, FloatRange const& cylinderMinMaxZ, Vec3 const& sphereCenter, float sphereRadius)
 {
 	float dx = cylinderCenterXY.x - sphereCenter.x;
 	float dy = cylinderCenterXY.y - sphereCenter.y;
@@ -938,19 +1217,255 @@ bool PushDiscOutOfFixedAABB2D(Vec2& mobileDiscCenter, float discRadius, AABB2 co
 	return false;
 }
 
+//----------------------------------------------------------------------------------------------
+// Picks the shallower of the z overlaps, used by the Z-cylinder contacts
+static void GetZSlabPenetration(FloatRange const& mobileMinMaxZ, float fixedMinZ, float fixedMaxZ, float& out_depth, float& out_normalZ)
+{
+	float pushUpDepth = fixedMaxZ - mobileMinMaxZ.m_min;
+	float pushDownDepth = mobileMinMaxZ.m_max - fixedMinZ;
+	if (pushUpDepth <= pushDownDepth)
+	{
+		out_depth = pushUpDepth;
+		out_normalZ = 1.f;
+	}
+	else
+	{
+		out_depth = pushDownDepth;
+		out_normalZ = -1.f;
+	}
+}
+
+bool GetContactSphereVsSphere3D(Vec3 const& centerA, float radiusA, Vec3 const& centerB, float radiusB, Contact3D& out_contact)
+{
+	float combinedRadii = radiusA + radiusB;
+	Vec3 centerToCenter = centerA - centerB;
+	float distanceSquared = centerToCenter.GetLengthSquared();
+	if (distanceSquared >= combinedRadii * combinedRadii)
+	{
+		return false;
+	}
+	float distance = std::sqrt(distanceSquared);
+	out_contact.m_normal = distance > 0.f ? centerToCenter * (1.f / distance) : Vec3(0.f, 0.f, 1.f);
+	out_contact.m_penetrationDepth = combinedRadii - distance;
+	return true;
+}
+
+bool GetContactSphereVsAABB3D(Vec3 const& sphereCenter, float sphereRadius, AABB3 const& box, Contact3D& out_contact)
+{
+	Vec3 nearestPoint(Clamp(sphereCenter.x, box.m_mins.x, box.m_maxs.x), Clamp(sphereCenter.y, box.m_mins.y, box.m_maxs.y), Clamp(sphereCenter.z, box.m_mins.z, box.m_maxs.z));
+	Vec3 boxToCenter = sphereCenter - nearestPoint;
+	float distanceSquared = boxToCenter.GetLengthSquared();
+	if (distanceSquared > 0.f)
+	{
+		if (distanceSquared >= sphereRadius * sphereRadius)
+		{
+			return false;
+		}
+		float distance = std::sqrt(distanceSquared);
+		out_contact.m_normal = boxToCenter * (1.f / distance);
+		out_contact.m_penetrationDepth = sphereRadius - distance;
+		return true;
+	}
+
+	// Center is inside the box, push out through the nearest face
+	float const faceDistances[6] = {
+		sphereCenter.x - box.m_mins.x, box.m_maxs.x - sphereCenter.x,
+		sphereCenter.y - box.m_mins.y, box.m_maxs.y - sphereCenter.y,
+		sphereCenter.z - box.m_mins.z, box.m_maxs.z - sphereCenter.z };
+	Vec3 const faceNormals[6] = {
+		Vec3(-1.f, 0.f, 0.f), Vec3(1.f, 0.f, 0.f),
+		Vec3(0.f, -1.f, 0.f), Vec3(0.f, 1.f, 0.f),
+		Vec3(0.f, 0.f, -1.f), Vec3(0.f, 0.f, 1.f) };
+	int nearestFace = 0;
+	for (int faceIndex = 1; faceIndex < 6; ++faceIndex)
+	{
+		if (faceDistances[faceIndex] < faceDistances[nearestFace])
+		{
+			nearestFace = faceIndex;
+		}
+	}
+	out_contact.m_normal = faceNormals[nearestFace];
+	out_contact.m_penetrationDepth = sphereRadius + faceDistances[nearestFace];
+	return true;
+}
+
+bool GetContactZCylinderVsZCylinder3D(Vec2 const& centerXYA, float radiusA, FloatRange const& minMaxZA, Vec2 const& centerXYB, float radiusB, FloatRange const& minMaxZB, Contact3D& out_contact)
+{
+	if (!minMaxZA.IsOverlappingWith(minMaxZB))
+	{
+		return false;
+	}
+	float combinedRadii = radiusA + radiusB;
+	Vec2 centerToCenter = centerXYA - centerXYB;
+	float distanceSquared = centerToCenter.GetLengthSquared();
+	if (distanceSquared >= combinedRadii * combinedRadii)
+	{
+		return false;
+	}
+	float distance = std::sqrt(distanceSquared);
+	float depthXY = combinedRadii - distance;
+
+	float depthZ;
+	float normalZ;
+	GetZSlabPenetration(minMaxZA, minMaxZB.m_min, minMaxZB.m_max, depthZ, normalZ);
+	if (depthZ < depthXY)
+	{
+		out_contact.m_normal = Vec3(0.f, 0.f, normalZ);
+		out_contact.m_penetrationDepth = depthZ;
+		return true;
+	}
+	Vec2 normalXY = distance > 0.f ? centerToCenter * (1.f / distance) : Vec2(1.f, 0.f);
+	out_contact.m_normal = Vec3(normalXY.x, normalXY.y, 0.f);
+	out_contact.m_penetrationDepth = depthXY;
+	return true;
+}
+
+bool GetContactZCylinderVsAABB3D(Vec2 const& cylinderCenterXY, float cylinderRadius, FloatRange const& cylinderMinMaxZ, AABB3 const& box, Contact3D& out_contact)
+{
+	if (cylinderMinMaxZ.m_min > box.m_maxs.z || cylinderMinMaxZ.m_max < box.m_mins.z)
+	{
+		return false;
+	}
+	Vec2 nearestPoint(Clamp(cylinderCenterXY.x, box.m_mins.x, box.m_maxs.x), Clamp(cylinderCenterXY.y, box.m_mins.y, box.m_maxs.y));
+	Vec2 boxToCenter = cylinderCenterXY - nearestPoint;
+	float distanceSquared = boxToCenter.GetLengthSquared();
+	float depthXY;
+	Vec2 normalXY;
+	if (distanceSquared > 0.f)
+	{
+		if (distanceSquared >= cylinderRadius * cylinderRadius)
+		{
+			return false;
+		}
+		float distance = std::sqrt(distanceSquared);
+		depthXY = cylinderRadius - distance;
+		normalXY = boxToCenter * (1.f / distance);
+	}
+	else
+	{
+		// Axis is inside the box footprint, push out through the nearest side
+		float const sideDistances[4] = {
+			cylinderCenterXY.x - box.m_mins.x, box.m_maxs.x - cylinderCenterXY.x,
+			cylinderCenterXY.y - box.m_mins.y, box.m_maxs.y - cylinderCenterXY.y };
+		Vec2 const sideNormals[4] = { Vec2(-1.f, 0.f), Vec2(1.f, 0.f), Vec2(0.f, -1.f), Vec2(0.f, 1.f) };
+		int nearestSide = 0;
+		for (int sideIndex = 1; sideIndex < 4; ++sideIndex)
+		{
+			if (sideDistances[sideIndex] < sideDistances[nearestSide])
+			{
+				nearestSide = sideIndex;
+			}
+		}
+		depthXY = cylinderRadius + sideDistances[nearestSide];
+		normalXY = sideNormals[nearestSide];
+	}
+
+	float depthZ;
+	float normalZ;
+	GetZSlabPenetration(cylinderMinMaxZ, box.m_mins.z, box.m_maxs.z, depthZ, normalZ);
+	if (depthZ < depthXY)
+	{
+		out_contact.m_normal = Vec3(0.f, 0.f, normalZ);
+		out_contact.m_penetrationDepth = depthZ;
+		return true;
+	}
+	out_contact.m_normal = Vec3(normalXY.x, normalXY.y, 0.f);
+	out_contact.m_penetrationDepth = depthXY;
+	return true;
+}
+
+bool PushSphereOutOfFixedSphere3D(Vec3& mobileSphereCenter, float mobileSphereRadius, Vec3 const& fixedSphereCenter, float fixedSphereRadius)
+{
+	Contact3D contact;
+	if (!GetContactSphereVsSphere3D(mobileSphereCenter, mobileSphereRadius, fixedSphereCenter, fixedSphereRadius, contact))
+	{
+		return false;
+	}
+	mobileSphereCenter += contact.m_normal * contact.m_penetrationDepth;
+	return true;
+}
+
+bool PushSpheresOutOfEachOther3D(Vec3& aCenter, float aRadius, Vec3& bCenter, float bRadius)
+{
+	Contact3D contact;
+	if (!GetContactSphereVsSphere3D(aCenter, aRadius, bCenter, bRadius, contact))
+	{
+		return false;
+	}
+	Vec3 halfCorrection = contact.m_normal * (contact.m_penetrationDepth * 0.5f);
+	aCenter += halfCorrection;
+	bCenter -= halfCorrection;
+	return true;
+}
+
+bool PushSphereOutOfFixedAABB3D(Vec3& mobileSphereCenter, float sphereRadius, AABB3 const& fixedBox)
+{
+	Contact3D contact;
+	if (!GetContactSphereVsAABB3D(mobileSphereCenter, sphereRadius, fixedBox, contact))
+	{
+		return false;
+	}
+	mobileSphereCenter += contact.m_normal * contact.m_penetrationDepth;
+	return true;
+}
+
+// Moves a Z cylinder given as centerXY + z range along a contact normal
+static void TranslateZCylinder(Vec2& centerXY, FloatRange& minMaxZ, Vec3 const& translation)
+{
+	centerXY += Vec2(translation.x, translation.y);
+	minMaxZ.m_min += translation.z;
+	minMaxZ.m_max += translation.z;
+}
+
+bool PushZCylinderOutOfFixedZCylinder3D(Vec2& mobileCenterXY, FloatRange& mobileMinMaxZ, float mobileRadius, Vec2 const& fixedCenterXY, FloatRange const& fixedMinMaxZ, float fixedRadius)
+{
+	Contact3D contact;
+	if (!GetContactZCylinderVsZCylinder3D(mobileCenterXY, mobileRadius, mobileMinMaxZ, fixedCenterXY, fixedRadius, fixedMinMaxZ, contact))
+	{
+		return false;
+	}
+	TranslateZCylinder(mobileCenterXY, mobileMinMaxZ, contact.m_normal * contact.m_penetrationDepth);
+	return true;
+}
+
+bool PushZCylindersOutOfEachOther3D(Vec2& aCenterXY, FloatRange& aMinMaxZ, float aRadius, Vec2& bCenterXY, FloatRange& bMinMaxZ, float bRadius)
+{
+	Contact3D contact;
+	if (!GetContactZCylinderVsZCylinder3D(aCenterXY, aRadius, aMinMaxZ, bCenterXY, bRadius, bMinMaxZ, contact))
+	{
+		return false;
+	}
+	Vec3 halfCorrection = contact.m_normal * (contact.m_penetrationDepth * 0.5f);
+	TranslateZCylinder(aCenterXY, aMinMaxZ, halfCorrection);
+	TranslateZCylinder(bCenterXY, bMinMaxZ, halfCorrection * -1.f);
+	return true;
+}
+
+bool PushZCylinderOutOfFixedAABB3D(Vec2& mobileCenterXY, FloatRange& mobileMinMaxZ, float cylinderRadius, AABB3 const& fixedBox)
+{
+	Contact3D contact;
+	if (!GetContactZCylinderVsAABB3D(mobileCenterXY, cylinderRadius, mobileMinMaxZ, fixedBox, contact))
+	{
+		return false;
+	}
+	TranslateZCylinder(mobileCenterXY, mobileMinMaxZ, contact.m_normal * contact.m_penetrationDepth);
+	return true;
+}
+
+
 // Transform utilities
 void TransformPosition2D(Vec2& posToTransform, float uniformScale, float rotationDegrees, const Vec2& translation) {
 	// Scale
 	posToTransform.x *= uniformScale;
 	posToTransform.y *= uniformScale;
 
-	float distance = std::sqrt(posToTransform.x * posToTransform.x + posToTransform.y * posToTransform.y);
-	float currentAngleRadians = std::atan2(posToTransform.y, posToTransform.x);
-	float rotationRadians = ConvertDegreesToRadians(rotationDegrees);
-	float newAngleRadians = currentAngleRadians + rotationRadians;
-
-	posToTransform.x = distance * std::cos(newAngleRadians);
-	posToTransform.y = distance * std::sin(newAngleRadians);
+	// Rotate
+	float sine;
+	float cosine;
+	FastSinCosDegrees(rotationDegrees, sine, cosine);
+	float rotatedX = posToTransform.x * cosine - posToTransform.y * sine;
+	posToTransform.y = posToTransform.x * sine + posToTransform.y * cosine;
+	posToTransform.x = rotatedX;
 
 	// Translate
 	posToTransform.x += translation.x;
@@ -973,13 +1488,13 @@ void TransformPositionXY3D(Vec3& positionToTransform, float scaleXY, float zRota
 	positionToTransform.x *= scaleXY;
 	positionToTransform.y *= scaleXY;
 
-	float distance = std::sqrt(positionToTransform.x * positionToTransform.x + positionToTransform.y *positionToTransform.y);
-	float currentAngleRadians = std::atan2(positionToTransform.y,positionToTransform.x);
-	float rotationRadians = ConvertDegreesToRadians(zRotationDegrees);
-	float newAngleRadians = currentAngleRadians + rotationRadians;
-	
-	positionToTransform.x = distance * std::cos(newAngleRadians);
-	positionToTransform.y = distance * std::sin(newAngleRadians);
+	// Rotate
+	float sine;
+	float cosine;
+	FastSinCosDegrees(zRotationDegrees, sine, cosine);
+	float rotatedX = positionToTransform.x * cosine - positionToTransform.y * sine;
+	positionToTransform.y = positionToTransform.x * sine + positionToTransform.y * cosine;
+	positionToTransform.x = rotatedX;
 	// Translate
 	positionToTransform.x += translationXY.x;
 	positionToTransform.y += translationXY.y;
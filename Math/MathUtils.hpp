@@ -144,6 +144,21 @@ struct RaycastResult3D
 	Actor* m_touchedActor = nullptr;
 };
 
+// Compact hit record for batch/closest-hit queries; m_primitiveIndex indexes the array that was cast against
+struct RaycastHit3D
+{
+	float	m_impactDist = 0.f;
+	Vec3	m_impactNormal;
+	int		m_primitiveIndex = -1;
+};
+
+// Penetration between two solids; moving the first shape by m_normal * m_penetrationDepth separates them
+struct Contact3D
+{
+	Vec3	m_normal;
+	float	m_penetrationDepth = 0.f;
+};
+
 enum class BillboardType
 {
 	NONE = -1,
@@ -159,11 +174,29 @@ Mat44 GetBillboardMatrix(BillboardType billboardType, Mat44 const& cameraMatrix,
 RaycastResult2D RaycastVsDisc2D( Vec2 startPos, Vec2 fwdNormal, float maxDist, Vec2 discCenter, float discRadius );
 RaycastResult2D RaycastVsLineSegment2D(Vec2 rayStart, Vec2 rayFwdNormal, float rayMaxDist, Vec2 LineSegStart, Vec2 LineSegEnd);
 RaycastResult2D RaycastVsAABB2D(Vec2 rayStart, Vec2 rayEnd,  Vec2 rayFwdNormal, float rayMaxDist, AABB2 bound);
-RaycastResult3D RaycastVsAABB3D(Vec3 rayStart, Vec3 rayForwardNormal, float rayLength, AABB3 box);
-RaycastResult3D RaycastVsOBB3D(Vec3 rayStart, Vec3 rayForwardNormal, float rayLength, OBB3 box);
-RaycastResult3D RaycastVsSphere3D(Vec3 rayStart, Vec3 rayForwardNormal, float rayLength, Vec3 sphereCenter, float sphereRadius);
-RaycastResult3D RaycastVsCylinderZ3D(Vec3 rayStart, Vec3 rayForwardNormal, float rayLength, Vec2 const& centerXY, FloatRange const& minMaxZ, float radiusXY);
-RaycastResult3D RaycastVsPlane3D(Vec3 rayStart, Vec3 rayForwardNormal, float rayLength, Plane3D plane);
+RaycastResult3D RaycastVsAABB3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, AABB3 const& box);
+RaycastResult3D RaycastVsOBB3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, OBB3 const& box);
+RaycastResult3D RaycastVsSphere3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, Vec3 const& sphereCenter, float sphereRadius);
+RaycastResult3D RaycastVsCylinderZ3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, Vec2 const& centerXY, FloatRange const& minMaxZ, float radiusXY);
+RaycastResult3D RaycastVsPlane3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, Plane3D const& plane);
+
+//----------------------------------------------------------------------------------------------
+// Hit-only raycasts for line-of-sight checks; they return as soon as the answer is known and
+// never build a RaycastResult3D. A ray that starts inside a solid counts as a hit.
+//
+bool DoesRayHitAABB3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, AABB3 const& box);
+bool DoesRayHitOBB3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, OBB3 const& box);
+bool DoesRayHitSphere3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, Vec3 const& sphereCenter, float sphereRadius);
+bool DoesRayHitCylinderZ3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, Vec2 const& centerXY, FloatRange const& minMaxZ, float radiusXY);
+bool DoesRayHitPlane3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, Plane3D const& plane);
+
+// Any-hit over arrays of primitives; stops at the first primitive that blocks the ray
+bool IsRayOccludedByAABBs3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, AABB3 const* boxes, int numBoxes);
+bool IsRayOccludedBySpheres3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, Vec3 const* sphereCenters, float const* sphereRadii, int numSpheres);
+
+// Closest-hit over arrays of primitives; the ray is shortened after every hit so later primitives reject early
+bool RaycastClosestVsAABBs3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, AABB3 const* boxes, int numBoxes, RaycastHit3D& out_hit);
+bool RaycastClosestVsSpheres3D(Vec3 const& rayStart, Vec3 const& rayForwardNormal, float rayLength, Vec3 const* sphereCenters, float const* sphereRadii, int numSpheres, RaycastHit3D& out_hit);
 
 //----------------------------------------------------------------------------------------------
 // Clamp and lerp
@@ -183,6 +216,7 @@ float ConvertDegreesToRadians( float degrees );
 float ConvertRadiansToDegrees( float radians );
 float CosDegrees( float degrees );
 float SinDegrees( float degrees );
+void  SinCosDegrees( float degrees, float& out_sin, float& out_cos );
 float Atan2Degrees( float y, float x);
 float GetShortestAngularDispDegrees( float startDegrees, float endDegrees );
 float GetTurnedTowardDegrees( float currentDegrees, float goalDegrees, float maxDeltaDegrees );
@@ -228,10 +262,10 @@ bool DoDiscsOverlapOBB22D(Vec2 const& referencePos, OBB2 const& orientedBox, flo
 bool DoDiscsOverlapCapsule2D(Vec2 const& referencePos, Capsule2 const& capsule, float radiusB);
 bool DoSpheresOverlap3D( Vec3 const& centerA, float radiusA, Vec3 const& centerB, float radiusB);
 bool DoAABBsOverlap3D(AABB3 const& first, AABB3 const& second);
-bool DoZCylindersOverlap3D(Vec2 cylinder1CenterXY, float cylinder1Radius, FloatRange cylinder1MinMaxZ, Vec2 cylinder2CenterXY, float cylinder2Radius, FloatRange cylinder2MinMaxZ);
-bool DoSphereAndAABBOverlap3D(Vec3 sphereCenter, float sphereRadius, AABB3 box);
-bool DoZCylinderAndAABBOverlap3D(Vec2 cylinderCenterXY, float cylinderRadius, FloatRange cylinderMinMaxZ, AABB3 box);
-bool DoZCylinderAndSphereOverlap3D(Vec2 cylinderCenterXY, float cylinderRadius, FloatRange cylinderMinMaxZ, Vec3 sphereCenter, float sphereRadius);
+bool DoZCylindersOverlap3D(Vec2 const& cylinder1CenterXY, float cylinder1Radius, FloatRange const& cylinder1MinMaxZ, Vec2 const& cylinder2CenterXY, float cylinder2Radius, FloatRange const& cylinder2MinMaxZ);
+bool DoSphereAndAABBOverlap3D(Vec3 const& sphereCenter, float sphereRadius, AABB3 const& box);
+bool DoZCylinderAndAABBOverlap3D(Vec2 const& cylinderCenterXY, float cylinderRadius, FloatRange const& cylinderMinMaxZ, AABB3 const& box);
+bool DoZCylinderAndSphereOverlap3D(Vec2 const& cylinderCenterXY, float cylinderRadius, FloatRange const& cylinderMinMaxZ, Vec3 const& sphereCenter, float sphereRadius);
 
 
 Vec2 const GetNearestPointOnDisc2D( Vec2 const& referencePosition, Vec2 const& discCenter, float discRadius );
@@ -248,6 +282,18 @@ bool PushDiscOutOfFixedPoint2D(Vec2& mobileDiscCenter, float discRadius, Vec2 co
 bool PushDiscOutOfFixedDisc2D(Vec2& mobileDiscCenter, float mobileDiscRadius, Vec2 const& fixedDiscCenter, float fixedDiscRadius);
 bool PushDiscsOutOfEachOther2D(Vec2& aCenter, float aRadius, Vec2& bCenter, float bRadius);
 bool PushDiscOutOfFixedAABB2D(Vec2& mobileDiscCenter, float discRadius, AABB2 const& fixedBox);
+
+bool GetContactSphereVsSphere3D(Vec3 const& centerA, float radiusA, Vec3 const& centerB, float radiusB, Contact3D& out_contact);
+bool GetContactSphereVsAABB3D(Vec3 const& sphereCenter, float sphereRadius, AABB3 const& box, Contact3D& out_contact);
+bool GetContactZCylinderVsZCylinder3D(Vec2 const& centerXYA, float radiusA, FloatRange const& minMaxZA, Vec2 const& centerXYB, float radiusB, FloatRange const& minMaxZB, Contact3D& out_contact);
+bool GetContactZCylinderVsAABB3D(Vec2 const& cylinderCenterXY, float cylinderRadius, FloatRange const& cylinderMinMaxZ, AABB3 const& box, Contact3D& out_contact);
+
+bool PushSphereOutOfFixedSphere3D(Vec3& mobileSphereCenter, float mobileSphereRadius, Vec3 const& fixedSphereCenter, float fixedSphereRadius);
+bool PushSpheresOutOfEachOther3D(Vec3& aCenter, float aRadius, Vec3& bCenter, float bRadius);
+bool PushSphereOutOfFixedAABB3D(Vec3& mobileSphereCenter, float sphereRadius, AABB3 const& fixedBox);
+bool PushZCylinderOutOfFixedZCylinder3D(Vec2& mobileCenterXY, FloatRange& mobileMinMaxZ, float mobileRadius, Vec2 const& fixedCenterXY, FloatRange const& fixedMinMaxZ, float fixedRadius);
+bool PushZCylindersOutOfEachOther3D(Vec2& aCenterXY, FloatRange& aMinMaxZ, float aRadius, Vec2& bCenterXY, FloatRange& bMinMaxZ, float bRadius);
+bool PushZCylinderOutOfFixedAABB3D(Vec2& mobileCenterXY, FloatRange& mobileMinMaxZ, float cylinderRadius, AABB3 const& fixedBox);
 //----------------------------------------------------------------------------------------------
 // Transform utilities
 //
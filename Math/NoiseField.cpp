@@ -0,0 +1,622 @@
+#include "Engine/Math/NoiseField.hpp"
+#include "Engine/Math/RawNoise.hpp"
+#include "Engine/Math/RawNoiseSimd.hpp"
+#include <cmath>
+
+//----------------------------------------------------------------------------------------------
+// Every scalar function below has a SIMD twin that performs the same float operations in the same order, which is
+// what keeps the grid functions bit-identical to the scalar ones. Change them together.
+//
+namespace
+{
+	constexpr float PERLIN_2D_SCALE = 1.f;
+	constexpr float PERLIN_3D_SCALE = 1.f;
+	constexpr float SIMPLEX_2D_SCALE = 70.f;
+	constexpr float SIMPLEX_3D_SCALE = 32.f;
+	constexpr float SIMPLEX_2D_SKEW = 0.366025403784f;		// (sqrt(3) - 1) / 2
+	constexpr float SIMPLEX_2D_UNSKEW = 0.211324865405f;	// (3 - sqrt(3)) / 6
+	constexpr float SIMPLEX_3D_SKEW = 1.f / 3.f;
+	constexpr float SIMPLEX_3D_UNSKEW = 1.f / 6.f;
+	constexpr unsigned int WARP_SEED_X = 0x5bd1e995;
+	constexpr unsigned int WARP_SEED_Y = 0x1b873593;
+	constexpr unsigned int WARP_SEED_Z = 0xcc9e2d51;
+
+	//------------------------------------------------------------------------------------------
+	// Scalar
+	//------------------------------------------------------------------------------------------
+	int FloorToInt(float value)
+	{
+		int truncated = (int)value;
+		return (float)truncated > value ? truncated - 1 : truncated;
+	}
+
+	float Fade(float t)
+	{
+		return t * t * t * (t * (t * 6.f - 15.f) + 10.f);
+	}
+
+	float Lerp(float a, float b, float t)
+	{
+		return a + (b - a) * t;
+	}
+
+	// Dot product with one of eight gradients picked by the low 3 bits: the four diagonals, then the four axes
+	float GetGradientDot2D(unsigned int hash, float x, float y)
+	{
+		float signedX = (hash & 1) ? -x : x;
+		if (hash & 4)
+		{
+			return (hash & 2) ? ((hash & 1) ? -y : y) : signedX;
+		}
+		float signedY = (hash & 2) ? -y : y;
+		return signedX + signedY;
+	}
+
+	// Ken Perlin's improved-noise gradients: the twelve cube edge midpoints, four of them twice
+	float GetGradientDot3D(unsigned int hash, float x, float y, float z)
+	{
+		unsigned int h = hash & 15;
+		float u = h < 8 ? x : y;
+		float v = h < 4 ? y : ((h == 12 || h == 14) ? x : z);
+		return ((h & 1) ? -u : u) + ((h & 2) ? -v : v);
+	}
+
+	float GetSimplexCorner2D(unsigned int hash, float x, float y)
+	{
+		float t = 0.5f - x * x - y * y;
+		if (t < 0.f)
+		{
+			return 0.f;
+		}
+		t *= t;
+		return t * t * GetGradientDot2D(hash, x, y);
+	}
+
+	float GetSimplexCorner3D(unsigned int hash, float x, float y, float z)
+	{
+		float t = 0.6f - x * x - y * y - z * z;
+		if (t < 0.f)
+		{
+			return 0.f;
+		}
+		t *= t;
+		return t * t * GetGradientDot3D(hash, x, y, z);
+	}
+
+	float ComputeBasis2D(NoiseBasis basis, float x, float y, unsigned int seed)
+	{
+		return basis == NoiseBasis::SIMPLEX ? ComputeSimplexNoise2D(x, y, seed) : ComputePerlinNoise2D(x, y, seed);
+	}
+
+	float ComputeBasis3D(NoiseBasis basis, float x, float y, float z, unsigned int seed)
+	{
+		return basis == NoiseBasis::SIMPLEX ? ComputeSimplexNoise3D(x, y, z, seed) : ComputePerlinNoise3D(x, y, z, seed);
+	}
+
+	float GetTotalAmplitude(NoiseSettings const& settings, int numOctaves)
+	{
+		float totalAmplitude = 0.f;
+		float amplitude = 1.f;
+		for (int octave = 0; octave < numOctaves; ++octave)
+		{
+			totalAmplitude += amplitude;
+			amplitude *= settings.m_persistence;
+		}
+		return totalAmplitude;
+	}
+
+	int GetNumOctaves(NoiseFractal fractal, NoiseSettings const& settings)
+	{
+		return fractal == NoiseFractal::SINGLE || settings.m_numOctaves < 1 ? 1 : settings.m_numOctaves;
+	}
+
+	float ComputeFractal2D(float x, float y, NoiseSettings const& settings, NoiseFractal fractal, unsigned int seed)
+	{
+		int numOctaves = GetNumOctaves(fractal, settings);
+		float frequency = 1.f / settings.m_scale;
+		float amplitude = 1.f;
+		float total = 0.f;
+		for (int octave = 0; octave < numOctaves; ++octave)
+		{
+			float value = ComputeBasis2D(settings.m_basis, x * frequency, y * frequency, seed + (unsigned int)octave);
+			if (fractal == NoiseFractal::RIDGED)
+			{
+				value = 1.f - fabsf(value);
+				value *= value;
+			}
+			total += value * amplitude;
+			amplitude *= settings.m_persistence;
+			frequency *= settings.m_lacunarity;
+		}
+		return total * (1.f / GetTotalAmplitude(settings, numOctaves));
+	}
+
+	float ComputeFractal3D(float x, float y, float z, NoiseSettings const& settings, NoiseFractal fractal, unsigned int seed)
+	{
+		int numOctaves = GetNumOctaves(fractal, settings);
+		float frequency = 1.f / settings.m_scale;
+		float amplitude = 1.f;
+		float total = 0.f;
+		for (int octave = 0; octave < numOctaves; ++octave)
+		{
+			float value = ComputeBasis3D(settings.m_basis, x * frequency, y * frequency, z * frequency, seed + (unsigned int)octave);
+			if (fractal == NoiseFractal::RIDGED)
+			{
+				value = 1.f - fabsf(value);
+				value *= value;
+			}
+			total += value * amplitude;
+			amplitude *= settings.m_persistence;
+			frequency *= settings.m_lacunarity;
+		}
+		return total * (1.f / GetTotalAmplitude(settings, numOctaves));
+	}
+
+	//------------------------------------------------------------------------------------------
+	// SIMD twins
+	//------------------------------------------------------------------------------------------
+	SimdInt SimdFloorToInt(SimdFloat value)
+	{
+		SimdInt truncated = SimdFloatToIntTruncate(value);
+		SimdInt isAboveValue = SimdCastFloatToInt(SimdLess(value, SimdIntToFloat(truncated)));	// -1 where truncation rounded up
+		return SimdIntAdd(truncated, isAboveValue);
+	}
+
+	SimdFloat SimdFade(SimdFloat t)
+	{
+		SimdFloat inner = SimdAdd(SimdMul(t, SimdSub(SimdMul(t, SimdSplat(6.f)), SimdSplat(15.f))), SimdSplat(10.f));
+		return SimdMul(SimdMul(SimdMul(t, t), t), inner);
+	}
+
+	SimdFloat SimdLerp(SimdFloat a, SimdFloat b, SimdFloat t)
+	{
+		return SimdAdd(a, SimdMul(SimdSub(b, a), t));
+	}
+
+	// Flips the sign of each lane whose hash has signBit set, exactly like scalar negation
+	SimdFloat SimdNegateWhere(SimdFloat value, SimdInt hash, int signBit)
+	{
+		SimdInt signMask = SimdIntShiftLeft(SimdIntAnd(hash, SimdIntSplat(signBit)), signBit == 1 ? 31 : 30);
+		return SimdCastIntToFloat(SimdIntXor(SimdCastFloatToInt(value), signMask));
+	}
+
+	SimdFloat SimdGetGradientDot2D(SimdInt hash, SimdFloat x, SimdFloat y)
+	{
+		SimdFloat signedX = SimdNegateWhere(x, hash, 1);
+		SimdFloat signedY = SimdNegateWhere(y, hash, 2);
+		SimdFloat diagonal = SimdAdd(signedX, signedY);
+		SimdFloat useY = SimdCastIntToFloat(SimdIntEqual(SimdIntAnd(hash, SimdIntSplat(2)), SimdIntSplat(2)));
+		SimdFloat axis = SimdSelect(useY, SimdNegateWhere(y, hash, 1), signedX);
+		SimdFloat isAxis = SimdCastIntToFloat(SimdIntEqual(SimdIntAnd(hash, SimdIntSplat(4)), SimdIntSplat(4)));
+		return SimdSelect(isAxis, axis, diagonal);
+	}
+
+	SimdFloat SimdGetGradientDot3D(SimdInt hash, SimdFloat x, SimdFloat y, SimdFloat z)
+	{
+		SimdInt h = SimdIntAnd(hash, SimdIntSplat(15));
+		SimdFloat isBelow8 = SimdCastIntToFloat(SimdIntGreater(SimdIntSplat(8), h));
+		SimdFloat isBelow4 = SimdCastIntToFloat(SimdIntGreater(SimdIntSplat(4), h));
+		SimdFloat is12Or14 = SimdCastIntToFloat(SimdIntOr(SimdIntEqual(h, SimdIntSplat(12)), SimdIntEqual(h, SimdIntSplat(14))));
+		SimdFloat u = SimdSelect(isBelow8, x, y);
+		SimdFloat v = SimdSelect(isBelow4, y, SimdSelect(is12Or14, x, z));
+		return SimdAdd(SimdNegateWhere(u, h, 1), SimdNegateWhere(v, h, 2));
+	}
+
+	SimdFloat SimdGetSimplexCorner2D(SimdInt hash, SimdFloat x, SimdFloat y)
+	{
+		SimdFloat t = SimdSub(SimdSub(SimdSplat(0.5f), SimdMul(x, x)), SimdMul(y, y));
+		SimdFloat isOutside = SimdLess(t, SimdSplat(0.f));
+		t = SimdMul(t, t);
+		SimdFloat value = SimdMul(SimdMul(t, t), SimdGetGradientDot2D(hash, x, y));
+		return SimdSelect(isOutside, SimdSplat(0.f), value);
+	}
+
+	SimdFloat SimdGetSimplexCorner3D(SimdInt hash, SimdFloat x, SimdFloat y, SimdFloat z)
+	{
+		SimdFloat t = SimdSub(SimdSub(SimdSub(SimdSplat(0.6f), SimdMul(x, x)), SimdMul(y, y)), SimdMul(z, z));
+		SimdFloat isOutside = SimdLess(t, SimdSplat(0.f));
+		t = SimdMul(t, t);
+		SimdFloat value = SimdMul(SimdMul(t, t), SimdGetGradientDot3D(hash, x, y, z));
+		return SimdSelect(isOutside, SimdSplat(0.f), value);
+	}
+
+	SimdFloat SimdComputePerlinNoise2D(SimdFloat x, SimdFloat y, unsigned int seed)
+	{
+		SimdInt one = SimdIntSplat(1);
+		SimdInt cellX = SimdFloorToInt(x);
+		SimdInt cellY = SimdFloorToInt(y);
+		SimdFloat fractionX = SimdSub(x, SimdIntToFloat(cellX));
+		SimdFloat fractionY = SimdSub(y, SimdIntToFloat(cellY));
+		SimdFloat fractionXMinusOne = SimdSub(fractionX, SimdSplat(1.f));
+		SimdFloat fractionYMinusOne = SimdSub(fractionY, SimdSplat(1.f));
+		SimdInt nextCellX = SimdIntAdd(cellX, one);
+		SimdInt nextCellY = SimdIntAdd(cellY, one);
+
+		SimdFloat dot00 = SimdGetGradientDot2D(SimdGet2dNoiseUint(cellX, cellY, seed), fractionX, fractionY);
+		SimdFloat dot10 = SimdGetGradientDot2D(SimdGet2dNoiseUint(nextCellX, cellY, seed), fractionXMinusOne, fractionY);
+		SimdFloat dot01 = SimdGetGradientDot2D(SimdGet2dNoiseUint(cellX, nextCellY, seed), fractionX, fractionYMinusOne);
+		SimdFloat dot11 = SimdGetGradientDot2D(SimdGet2dNoiseUint(nextCellX, nextCellY, seed), fractionXMinusOne, fractionYMinusOne);
+
+		SimdFloat u = SimdFade(fractionX);
+		SimdFloat v = SimdFade(fractionY);
+		SimdFloat bottom = SimdLerp(dot00, dot10, u);
+		SimdFloat top = SimdLerp(dot01, dot11, u);
+		return SimdMul(SimdLerp(bottom, top, v), SimdSplat(PERLIN_2D_SCALE));
+	}
+
+	SimdFloat SimdComputePerlinNoise3D(SimdFloat x, SimdFloat y, SimdFloat z, unsigned int seed)
+	{
+		SimdInt one = SimdIntSplat(1);
+		SimdInt cellX = SimdFloorToInt(x);
+		SimdInt cellY = SimdFloorToInt(y);
+		SimdInt cellZ = SimdFloorToInt(z);
+		SimdFloat fractionX = SimdSub(x, SimdIntToFloat(cellX));
+		SimdFloat fractionY = SimdSub(y, SimdIntToFloat(cellY));
+		SimdFloat fractionZ = SimdSub(z, SimdIntToFloat(cellZ));
+		SimdFloat fractionXMinusOne = SimdSub(fractionX, SimdSplat(1.f));
+		SimdFloat fractionYMinusOne = SimdSub(fractionY, SimdSplat(1.f));
+		SimdFloat fractionZMinusOne = SimdSub(fractionZ, SimdSplat(1.f));
+		SimdInt nextCellX = SimdIntAdd(cellX, one);
+		SimdInt nextCellY = SimdIntAdd(cellY, one);
+		SimdInt nextCellZ = SimdIntAdd(cellZ, one);
+
+		SimdFloat dot000 = SimdGetGradientDot3D(SimdGet3dNoiseUint(cellX, cellY, cellZ, seed), fractionX, fractionY, fractionZ);
+		SimdFloat dot100 = SimdGetGradientDot3D(SimdGet3dNoiseUint(nextCellX, cellY, cellZ, seed), fractionXMinusOne, fractionY, fractionZ);
+		SimdFloat dot010 = SimdGetGradientDot3D(SimdGet3dNoiseUint(cellX, nextCellY, cellZ, seed), fractionX, fractionYMinusOne, fractionZ);
+		SimdFloat dot110 = SimdGetGradientDot3D(SimdGet3dNoiseUint(nextCellX, nextCellY, cellZ, seed), fractionXMinusOne, fractionYMinusOne, fractionZ);
+		SimdFloat dot001 = SimdGetGradientDot3D(SimdGet3dNoiseUint(cellX, cellY, nextCellZ, seed), fractionX, fractionY, fractionZMinusOne);
+		SimdFloat dot101 = SimdGetGradientDot3D(SimdGet3dNoiseUint(nextCellX, cellY, nextCellZ, seed), fractionXMinusOne, fractionY, fractionZMinusOne);
+		SimdFloat dot011 = SimdGetGradientDot3D(SimdGet3dNoiseUint(cellX, nextCellY, nextCellZ, seed), fractionX, fractionYMinusOne, fractionZMinusOne);
+		SimdFloat dot111 = SimdGetGradientDot3D(SimdGet3dNoiseUint(nextCellX, nextCellY, nextCellZ, seed), fractionXMinusOne, fractionYMinusOne, fractionZMinusOne);
+
+		SimdFloat u = SimdFade(fractionX);
+		SimdFloat v = SimdFade(fractionY);
+		SimdFloat w = SimdFade(fractionZ);
+		SimdFloat lowerLayer = SimdLerp(SimdLerp(dot000, dot100, u), SimdLerp(dot010, dot110, u), v);
+		SimdFloat upperLayer = SimdLerp(SimdLerp(dot001, dot101, u), SimdLerp(dot011, dot111, u), v);
+		return SimdMul(SimdLerp(lowerLayer, upperLayer, w), SimdSplat(PERLIN_3D_SCALE));
+	}
+
+	SimdFloat SimdComputeSimplexNoise2D(SimdFloat x, SimdFloat y, unsigned int seed)
+	{
+		SimdInt one = SimdIntSplat(1);
+		SimdFloat skew = SimdMul(SimdAdd(x, y), SimdSplat(SIMPLEX_2D_SKEW));
+		SimdInt cellX = SimdFloorToInt(SimdAdd(x, skew));
+		SimdInt cellY = SimdFloorToInt(SimdAdd(y, skew));
+		SimdFloat unskew = SimdMul(SimdIntToFloat(SimdIntAdd(cellX, cellY)), SimdSplat(SIMPLEX_2D_UNSKEW));
+		SimdFloat x0 = SimdSub(x, SimdSub(SimdIntToFloat(cellX), unskew));
+		SimdFloat y0 = SimdSub(y, SimdSub(SimdIntToFloat(cellY), unskew));
+
+		// Lower triangle (step x first) where x0 > y0, upper triangle otherwise
+		SimdInt isLower = SimdCastFloatToInt(SimdLess(y0, x0));
+		SimdInt stepX = SimdIntAnd(isLower, one);
+		SimdInt stepY = SimdIntSub(one, stepX);
+		SimdFloat x1 = SimdAdd(SimdSub(x0, SimdIntToFloat(stepX)), SimdSplat(SIMPLEX_2D_UNSKEW));
+		SimdFloat y1 = SimdAdd(SimdSub(y0, SimdIntToFloat(stepY)), SimdSplat(SIMPLEX_2D_UNSKEW));
+		SimdFloat x2 = SimdAdd(SimdSub(x0, SimdSplat(1.f)), SimdSplat(2.f * SIMPLEX_2D_UNSKEW));
+		SimdFloat y2 = SimdAdd(SimdSub(y0, SimdSplat(1.f)), SimdSplat(2.f * SIMPLEX_2D_UNSKEW));
+
+		SimdFloat corner0 = SimdGetSimplexCorner2D(SimdGet2dNoiseUint(cellX, cellY, seed), x0, y0);
+		SimdFloat corner1 = SimdGetSimplexCorner2D(SimdGet2dNoiseUint(SimdIntAdd(cellX, stepX), SimdIntAdd(cellY, stepY), seed), x1, y1);
+		SimdFloat corner2 = SimdGetSimplexCorner2D(SimdGet2dNoiseUint(SimdIntAdd(cellX, one), SimdIntAdd(cellY, one), seed), x2, y2);
+		return SimdMul(SimdAdd(SimdAdd(corner0, corner1), corner2), SimdSplat(SIMPLEX_2D_SCALE));
+	}
+
+	SimdFloat SimdComputeSimplexNoise3D(SimdFloat x, SimdFloat y, SimdFloat z, unsigned int seed)
+	{
+		SimdInt one = SimdIntSplat(1);
+		SimdFloat skew = SimdMul(SimdAdd(SimdAdd(x, y), z), SimdSplat(SIMPLEX_3D_SKEW));
+		SimdInt cellX = SimdFloorToInt(SimdAdd(x, skew));
+		SimdInt cellY = SimdFloorToInt(SimdAdd(y, skew));
+		SimdInt cellZ = SimdFloorToInt(SimdAdd(z, skew));
+		SimdFloat unskew = SimdMul(SimdIntToFloat(SimdIntAdd(SimdIntAdd(cellX, cellY), cellZ)), SimdSplat(SIMPLEX_3D_UNSKEW));
+		SimdFloat x0 = SimdSub(x, SimdSub(SimdIntToFloat(cellX), unskew));
+		SimdFloat y0 = SimdSub(y, SimdSub(SimdIntToFloat(cellY), unskew));
+		SimdFloat z0 = SimdSub(z, SimdSub(SimdIntToFloat(cellZ), unskew));
+
+		// Rank the offsets: the largest steps first, the middle second. Ties break the same way as the scalar version.
+		SimdInt xAboveY = SimdCastFloatToInt(SimdLess(y0, x0));
+		SimdInt xAboveZ = SimdCastFloatToInt(SimdLess(z0, x0));
+		SimdInt yAboveZ = SimdCastFloatToInt(SimdLess(z0, y0));
+		SimdInt allBits = SimdIntSplat(-1);
+		SimdInt rankX = SimdIntSub(SimdIntSplat(0), SimdIntAdd(xAboveY, xAboveZ));
+		SimdInt rankY = SimdIntSub(SimdIntSplat(0), SimdIntAdd(SimdIntXor(xAboveY, allBits), yAboveZ));
+		SimdInt rankZ = SimdIntSub(SimdIntSplat(0), SimdIntAdd(SimdIntXor(xAboveZ, allBits), SimdIntXor(yAboveZ, allBits)));
+		SimdInt firstX = SimdIntAnd(SimdIntEqual(rankX, SimdIntSplat(2)), one);
+		SimdInt firstY = SimdIntAnd(SimdIntEqual(rankY, SimdIntSplat(2)), one);
+		SimdInt firstZ = SimdIntAnd(SimdIntEqual(rankZ, SimdIntSplat(2)), one);
+		SimdInt secondX = SimdIntAnd(SimdIntGreater(rankX, SimdIntSplat(0)), one);
+		SimdInt secondY = SimdIntAnd(SimdIntGreater(rankY, SimdIntSplat(0)), one);
+		SimdInt secondZ = SimdIntAnd(SimdIntGreater(rankZ, SimdIntSplat(0)), one);
+
+		SimdFloat unskew1 = SimdSplat(SIMPLEX_3D_UNSKEW);
+		SimdFloat unskew2 = SimdSplat(2.f * SIMPLEX_3D_UNSKEW);
+		SimdFloat unskew3 = SimdSplat(3.f * SIMPLEX_3D_UNSKEW);
+		SimdFloat x1 = SimdAdd(SimdSub(x0, SimdIntToFloat(firstX)), unskew1);
+		SimdFloat y1 = SimdAdd(SimdSub(y0, SimdIntToFloat(firstY)), unskew1);
+		SimdFloat z1 = SimdAdd(SimdSub(z0, SimdIntToFloat(firstZ)), unskew1);
+		SimdFloat x2 = SimdAdd(SimdSub(x0, SimdIntToFloat(secondX)), unskew2);
+		SimdFloat y2 = SimdAdd(SimdSub(y0, SimdIntToFloat(secondY)), unskew2);
+		SimdFloat z2 = SimdAdd(SimdSub(z0, SimdIntToFloat(secondZ)), unskew2);
+		SimdFloat x3 = SimdAdd(SimdSub(x0, SimdSplat(1.f)), unskew3);
+		SimdFloat y3 = SimdAdd(SimdSub(y0, SimdSplat(1.f)), unskew3);
+		SimdFloat z3 = SimdAdd(SimdSub(z0, SimdSplat(1.f)), unskew3);
+
+		SimdFloat corner0 = SimdGetSimplexCorner3D(SimdGet3dNoiseUint(cellX, cellY, cellZ, seed), x0, y0, z0);
+		SimdFloat corner1 = SimdGetSimplexCorner3D(SimdGet3dNoiseUint(SimdIntAdd(cellX, firstX), SimdIntAdd(cellY, firstY), SimdIntAdd(cellZ, firstZ), seed), x1, y1, z1);
+		SimdFloat corner2 = SimdGetSimplexCorner3D(SimdGet3dNoiseUint(SimdIntAdd(cellX, secondX), SimdIntAdd(cellY, secondY), SimdIntAdd(cellZ, secondZ), seed), x2, y2, z2);
+		SimdFloat corner3 = SimdGetSimplexCorner3D(SimdGet3dNoiseUint(SimdIntAdd(cellX, one), SimdIntAdd(cellY, one), SimdIntAdd(cellZ, one), seed), x3, y3, z3);
+		return SimdMul(SimdAdd(SimdAdd(SimdAdd(corner0, corner1), corner2), corner3), SimdSplat(SIMPLEX_3D_SCALE));
+	}
+
+	SimdFloat SimdComputeFractal2D(SimdFloat x, SimdFloat y, NoiseSettings const& settings, NoiseFractal fractal, unsigned int seed)
+	{
+		int numOctaves = GetNumOctaves(fractal, settings);
+		SimdFloat absMask = SimdCastIntToFloat(SimdIntSplat(0x7fffffff));
+		float frequency = 1.f / settings.m_scale;
+		float amplitude = 1.f;
+		SimdFloat total = SimdSplat(0.f);
+		for (int octave = 0; octave < numOctaves; ++octave)
+		{
+			SimdFloat sampleX = SimdMul(x, SimdSplat(frequency));
+			SimdFloat sampleY = SimdMul(y, SimdSplat(frequency));
+			unsigned int octaveSeed = seed + (unsigned int)octave;
+			SimdFloat value = settings.m_basis == NoiseBasis::SIMPLEX ? SimdComputeSimplexNoise2D(sampleX, sampleY, octaveSeed) : SimdComputePerlinNoise2D(sampleX, sampleY, octaveSeed);
+			if (fractal == NoiseFractal::RIDGED)
+			{
+				value = SimdSub(SimdSplat(1.f), SimdAnd(value, absMask));
+				value = SimdMul(value, value);
+			}
+			total = SimdAdd(total, SimdMul(value, SimdSplat(amplitude)));
+			amplitude *= settings.m_persistence;
+			frequency *= settings.m_lacunarity;
+		}
+		return SimdMul(total, SimdSplat(1.f / GetTotalAmplitude(settings, numOctaves)));
+	}
+
+	SimdFloat SimdComputeFractal3D(SimdFloat x, SimdFloat y, SimdFloat z, NoiseSettings const& settings, NoiseFractal fractal, unsigned int seed)
+	{
+		int numOctaves = GetNumOctaves(fractal, settings);
+		SimdFloat absMask = SimdCastIntToFloat(SimdIntSplat(0x7fffffff));
+		float frequency = 1.f / settings.m_scale;
+		float amplitude = 1.f;
+		SimdFloat total = SimdSplat(0.f);
+		for (int octave = 0; octave < numOctaves; ++octave)
+		{
+			SimdFloat sampleX = SimdMul(x, SimdSplat(frequency));
+			SimdFloat sampleY = SimdMul(y, SimdSplat(frequency));
+			SimdFloat sampleZ = SimdMul(z, SimdSplat(frequency));
+			unsigned int octaveSeed = seed + (unsigned int)octave;
+			SimdFloat value = settings.m_basis == NoiseBasis::SIMPLEX ? SimdComputeSimplexNoise3D(sampleX, sampleY, sampleZ, octaveSeed) : SimdComputePerlinNoise3D(sampleX, sampleY, sampleZ, octaveSeed);
+			if (fractal == NoiseFractal::RIDGED)
+			{
+				value = SimdSub(SimdSplat(1.f), SimdAnd(value, absMask));
+				value = SimdMul(value, value);
+			}
+			total = SimdAdd(total, SimdMul(value, SimdSplat(amplitude)));
+			amplitude *= settings.m_persistence;
+			frequency *= settings.m_lacunarity;
+		}
+		return SimdMul(total, SimdSplat(1.f / GetTotalAmplitude(settings, numOctaves)));
+	}
+
+	SimdFloat SimdComputeNoise2D(SimdFloat x, SimdFloat y, NoiseSettings const& settings)
+	{
+		if (settings.m_warpStrength > 0.f)
+		{
+			SimdFloat strength = SimdSplat(settings.m_warpStrength);
+			SimdFloat warpX = SimdComputeFractal2D(x, y, settings, NoiseFractal::FBM, settings.m_seed + WARP_SEED_X);
+			SimdFloat warpY = SimdComputeFractal2D(x, y, settings, NoiseFractal::FBM, settings.m_seed + WARP_SEED_Y);
+			x = SimdAdd(x, SimdMul(warpX, strength));
+			y = SimdAdd(y, SimdMul(warpY, strength));
+		}
+		return SimdComputeFractal2D(x, y, settings, settings.m_fractal, settings.m_seed);
+	}
+
+	SimdFloat SimdComputeNoise3D(SimdFloat x, SimdFloat y, SimdFloat z, NoiseSettings const& settings)
+	{
+		if (settings.m_warpStrength > 0.f)
+		{
+			SimdFloat strength = SimdSplat(settings.m_warpStrength);
+			SimdFloat warpX = SimdComputeFractal3D(x, y, z, settings, NoiseFractal::FBM, settings.m_seed + WARP_SEED_X);
+			SimdFloat warpY = SimdComputeFractal3D(x, y, z, settings, NoiseFractal::FBM, settings.m_seed + WARP_SEED_Y);
+			SimdFloat warpZ = SimdComputeFractal3D(x, y, z, settings, NoiseFractal::FBM, settings.m_seed + WARP_SEED_Z);
+			x = SimdAdd(x, SimdMul(warpX, strength));
+			y = SimdAdd(y, SimdMul(warpY, strength));
+			z = SimdAdd(z, SimdMul(warpZ, strength));
+		}
+		return SimdComputeFractal3D(x, y, z, settings, settings.m_fractal, settings.m_seed);
+	}
+
+	// World positions origin + (startIndex + lane) * cellSize, computed the way the scalar tail computes them
+	SimdFloat SimdGetGridPositions(float origin, int startIndex, float cellSize)
+	{
+		SimdFloat indices = SimdIntToFloat(SimdIntAdd(SimdIntSplat(startIndex), SimdIntLaneIndices()));
+		return SimdAdd(SimdSplat(origin), SimdMul(indices, SimdSplat(cellSize)));
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+float ComputePerlinNoise2D(float x, float y, unsigned int seed)
+{
+	int cellX = FloorToInt(x);
+	int cellY = FloorToInt(y);
+	float fractionX = x - (float)cellX;
+	float fractionY = y - (float)cellY;
+
+	float dot00 = GetGradientDot2D(Get2dNoiseUint(cellX, cellY, seed), fractionX, fractionY);
+	float dot10 = GetGradientDot2D(Get2dNoiseUint(cellX + 1, cellY, seed), fractionX - 1.f, fractionY);
+	float dot01 = GetGradientDot2D(Get2dNoiseUint(cellX, cellY + 1, seed), fractionX, fractionY - 1.f);
+	float dot11 = GetGradientDot2D(Get2dNoiseUint(cellX + 1, cellY + 1, seed), fractionX - 1.f, fractionY - 1.f);
+
+	float u = Fade(fractionX);
+	float v = Fade(fractionY);
+	return Lerp(Lerp(dot00, dot10, u), Lerp(dot01, dot11, u), v) * PERLIN_2D_SCALE;
+}
+
+float ComputePerlinNoise3D(float x, float y, float z, unsigned int seed)
+{
+	int cellX = FloorToInt(x);
+	int cellY = FloorToInt(y);
+	int cellZ = FloorToInt(z);
+	float fractionX = x - (float)cellX;
+	float fractionY = y - (float)cellY;
+	float fractionZ = z - (float)cellZ;
+
+	float dot000 = GetGradientDot3D(Get3dNoiseUint(cellX, cellY, cellZ, seed), fractionX, fractionY, fractionZ);
+	float dot100 = GetGradientDot3D(Get3dNoiseUint(cellX + 1, cellY, cellZ, seed), fractionX - 1.f, fractionY, fractionZ);
+	float dot010 = GetGradientDot3D(Get3dNoiseUint(cellX, cellY + 1, cellZ, seed), fractionX, fractionY - 1.f, fractionZ);
+	float dot110 = GetGradientDot3D(Get3dNoiseUint(cellX + 1, cellY + 1, cellZ, seed), fractionX - 1.f, fractionY - 1.f, fractionZ);
+	float dot001 = GetGradientDot3D(Get3dNoiseUint(cellX, cellY, cellZ + 1, seed), fractionX, fractionY, fractionZ - 1.f);
+	float dot101 = GetGradientDot3D(Get3dNoiseUint(cellX + 1, cellY, cellZ + 1, seed), fractionX - 1.f, fractionY, fractionZ - 1.f);
+	float dot011 = GetGradientDot3D(Get3dNoiseUint(cellX, cellY + 1, cellZ + 1, seed), fractionX, fractionY - 1.f, fractionZ - 1.f);
+	float dot111 = GetGradientDot3D(Get3dNoiseUint(cellX + 1, cellY + 1, cellZ + 1, seed), fractionX - 1.f, fractionY - 1.f, fractionZ - 1.f);
+
+	float u = Fade(fractionX);
+	float v = Fade(fractionY);
+	float w = Fade(fractionZ);
+	float lowerLayer = Lerp(Lerp(dot000, dot100, u), Lerp(dot010, dot110, u), v);
+	float upperLayer = Lerp(Lerp(dot001, dot101, u), Lerp(dot011, dot111, u), v);
+	return Lerp(lowerLayer, upperLayer, w) * PERLIN_3D_SCALE;
+}
+
+float ComputeSimplexNoise2D(float x, float y, unsigned int seed)
+{
+	float skew = (x + y) * SIMPLEX_2D_SKEW;
+	int cellX = FloorToInt(x + skew);
+	int cellY = FloorToInt(y + skew);
+	float unskew = (float)(cellX + cellY) * SIMPLEX_2D_UNSKEW;
+	float x0 = x - ((float)cellX - unskew);
+	float y0 = y - ((float)cellY - unskew);
+
+	// Lower triangle (step x first) where x0 > y0, upper triangle otherwise
+	int stepX = y0 < x0 ? 1 : 0;
+	int stepY = 1 - stepX;
+	float x1 = (x0 - (float)stepX) + SIMPLEX_2D_UNSKEW;
+	float y1 = (y0 - (float)stepY) + SIMPLEX_2D_UNSKEW;
+	float x2 = (x0 - 1.f) + 2.f * SIMPLEX_2D_UNSKEW;
+	float y2 = (y0 - 1.f) + 2.f * SIMPLEX_2D_UNSKEW;
+
+	float corner0 = GetSimplexCorner2D(Get2dNoiseUint(cellX, cellY, seed), x0, y0);
+	float corner1 = GetSimplexCorner2D(Get2dNoiseUint(cellX + stepX, cellY + stepY, seed), x1, y1);
+	float corner2 = GetSimplexCorner2D(Get2dNoiseUint(cellX + 1, cellY + 1, seed), x2, y2);
+	return (corner0 + corner1 + corner2) * SIMPLEX_2D_SCALE;
+}
+
+float ComputeSimplexNoise3D(float x, float y, float z, unsigned int seed)
+{
+	float skew = (x + y + z) * SIMPLEX_3D_SKEW;
+	int cellX = FloorToInt(x + skew);
+	int cellY = FloorToInt(y + skew);
+	int cellZ = FloorToInt(z + skew);
+	float unskew = (float)(cellX + cellY + cellZ) * SIMPLEX_3D_UNSKEW;
+	float x0 = x - ((float)cellX - unskew);
+	float y0 = y - ((float)cellY - unskew);
+	float z0 = z - ((float)cellZ - unskew);
+
+	// Rank the offsets: the simplex steps along the largest first, then the middle one
+	int xAboveY = y0 < x0 ? 1 : 0;
+	int xAboveZ = z0 < x0 ? 1 : 0;
+	int yAboveZ = z0 < y0 ? 1 : 0;
+	int rankX = xAboveY + xAboveZ;
+	int rankY = (1 - xAboveY) + yAboveZ;
+	int rankZ = (1 - xAboveZ) + (1 - yAboveZ);
+	int firstX = rankX == 2 ? 1 : 0;
+	int firstY = rankY == 2 ? 1 : 0;
+	int firstZ = rankZ == 2 ? 1 : 0;
+	int secondX = rankX > 0 ? 1 : 0;
+	int secondY = rankY > 0 ? 1 : 0;
+	int secondZ = rankZ > 0 ? 1 : 0;
+
+	float x1 = (x0 - (float)firstX) + SIMPLEX_3D_UNSKEW;
+	float y1 = (y0 - (float)firstY) + SIMPLEX_3D_UNSKEW;
+	float z1 = (z0 - (float)firstZ) + SIMPLEX_3D_UNSKEW;
+	float x2 = (x0 - (float)secondX) + 2.f * SIMPLEX_3D_UNSKEW;
+	float y2 = (y0 - (float)secondY) + 2.f * SIMPLEX_3D_UNSKEW;
+	float z2 = (z0 - (float)secondZ) + 2.f * SIMPLEX_3D_UNSKEW;
+	float x3 = (x0 - 1.f) + 3.f * SIMPLEX_3D_UNSKEW;
+	float y3 = (y0 - 1.f) + 3.f * SIMPLEX_3D_UNSKEW;
+	float z3 = (z0 - 1.f) + 3.f * SIMPLEX_3D_UNSKEW;
+
+	float corner0 = GetSimplexCorner3D(Get3dNoiseUint(cellX, cellY, cellZ, seed), x0, y0, z0);
+	float corner1 = GetSimplexCorner3D(Get3dNoiseUint(cellX + firstX, cellY + firstY, cellZ + firstZ, seed), x1, y1, z1);
+	float corner2 = GetSimplexCorner3D(Get3dNoiseUint(cellX + secondX, cellY + secondY, cellZ + secondZ, seed), x2, y2, z2);
+	float corner3 = GetSimplexCorner3D(Get3dNoiseUint(cellX + 1, cellY + 1, cellZ + 1, seed), x3, y3, z3);
+	return (corner0 + corner1 + corner2 + corner3) * SIMPLEX_3D_SCALE;
+}
+
+//----------------------------------------------------------------------------------------------
+float ComputeNoise2D(Vec2 const& position, NoiseSettings const& settings)
+{
+	float x = position.x;
+	float y = position.y;
+	if (settings.m_warpStrength > 0.f)
+	{
+		float warpX = ComputeFractal2D(x, y, settings, NoiseFractal::FBM, settings.m_seed + WARP_SEED_X);
+		float warpY = ComputeFractal2D(x, y, settings, NoiseFractal::FBM, settings.m_seed + WARP_SEED_Y);
+		x = x + warpX * settings.m_warpStrength;
+		y = y + warpY * settings.m_warpStrength;
+	}
+	return ComputeFractal2D(x, y, settings, settings.m_fractal, settings.m_seed);
+}
+
+float ComputeNoise3D(Vec3 const& position, NoiseSettings const& settings)
+{
+	float x = position.x;
+	float y = position.y;
+	float z = position.z;
+	if (settings.m_warpStrength > 0.f)
+	{
+		float warpX = ComputeFractal3D(x, y, z, settings, NoiseFractal::FBM, settings.m_seed + WARP_SEED_X);
+		float warpY = ComputeFractal3D(x, y, z, settings, NoiseFractal::FBM, settings.m_seed + WARP_SEED_Y);
+		float warpZ = ComputeFractal3D(x, y, z, settings, NoiseFractal::FBM, settings.m_seed + WARP_SEED_Z);
+		x = x + warpX * settings.m_warpStrength;
+		y = y + warpY * settings.m_warpStrength;
+		z = z + warpZ * settings.m_warpStrength;
+	}
+	return ComputeFractal3D(x, y, z, settings, settings.m_fractal, settings.m_seed);
+}
+
+//----------------------------------------------------------------------------------------------
+void ComputeNoiseGrid2D(float* out_values, IntVec2 const& dims, Vec2 const& origin, float cellSize, NoiseSettings const& settings)
+{
+	for (int indexY = 0; indexY < dims.y; ++indexY)
+	{
+		float y = origin.y + (float)indexY * cellSize;
+		SimdFloat ys = SimdSplat(y);
+		float* row = out_values + indexY * dims.x;
+		int indexX = 0;
+		for (; indexX + SIMD_WIDTH <= dims.x; indexX += SIMD_WIDTH)
+		{
+			SimdStore(row + indexX, SimdComputeNoise2D(SimdGetGridPositions(origin.x, indexX, cellSize), ys, settings));
+		}
+		for (; indexX < dims.x; ++indexX)
+		{
+			row[indexX] = ComputeNoise2D(Vec2(origin.x + (float)indexX * cellSize, y), settings);
+		}
+	}
+}
+
+void ComputeNoiseGrid3D(float* out_values, IntVec3 const& dims, Vec3 const& origin, float cellSize, NoiseSettings const& settings)
+{
+	for (int indexZ = 0; indexZ < dims.z; ++indexZ)
+	{
+		float z = origin.z + (float)indexZ * cellSize;
+		SimdFloat zs = SimdSplat(z);
+		for (int indexY = 0; indexY < dims.y; ++indexY)
+		{
+			float y = origin.y + (float)indexY * cellSize;
+			SimdFloat ys = SimdSplat(y);
+			float* row = out_values + (indexZ * dims.y + indexY) * dims.x;
+			int indexX = 0;
+			for (; indexX + SIMD_WIDTH <= dims.x; indexX += SIMD_WIDTH)
+			{
+				SimdStore(row + indexX, SimdComputeNoise3D(SimdGetGridPositions(origin.x, indexX, cellSize), ys, zs, settings));
+			}
+			for (; indexX < dims.x; ++indexX)
+			{
+				row[indexX] = ComputeNoise3D(Vec3(origin.x + (float)indexX * cellSize, y, z), settings);
+			}
+		}
+	}
+}
\ No newline at end of file
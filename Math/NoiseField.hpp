@@ -0,0 +1,68 @@
+#pragma once
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/IntVec3.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+//----------------------------------------------------------------------------------------------
+// Noise fields for terrain and volume generation, built on the RawNoise lattice hashes.
+//
+// Squirrel's Compute*dPerlinNoise / Compute*dFractalNoise (ThirdParty/Squirrel/SmoothNoise.hpp) stay the per-sample
+// API. This module does not wrap them because its grid functions need a basis with a SIMD twin that does the same
+// float operations in the same order, and Squirrel's octave loop (per-octave offsets, table gradients, SmoothStep3
+// renormalization) has none. Its bases therefore differ from Squirrel's: a different gradient set and a quintic fade,
+// so the same seed does not give the same field. It also adds what Squirrel lacks: simplex noise, ridged octaves and
+// domain warping.
+//
+// The single-octave bases take coordinates in lattice cells and return roughly [-1,1]:
+//	Perlin	gradient noise on the square/cube lattice with a quintic fade
+//	Simplex	gradient noise on the simplex lattice: 3 corners per 2D sample and 4 per 3D sample instead of 4 and 8
+//
+// NoiseSettings layers octaves over a basis; each octave has m_lacunarity times the frequency and m_persistence
+// times the amplitude of the one before it, and a seed of its own:
+//	SINGLE	one octave
+//	FBM		sum of octaves divided by the total amplitude, [-1,1]
+//	RIDGED	sum of (1 - |octave|)^2 divided by the total amplitude, [0,1] with sharp crests
+// A positive m_warpStrength first displaces the sample position by two (three in 3D) FBM fields of the same
+// settings and different seeds, scaled to world units: domain warping.
+//
+// The grid functions evaluate SIMD_WIDTH samples per step, hashing every lane's lattice corners with one instruction
+// sequence (RawNoiseSimd.hpp). Each value they write is bit-identical to ComputeNoise2D/3D at the same position, as
+// long as the compiler does not contract scalar float math into FMAs (MSVC does not by default).
+//
+enum class NoiseBasis
+{
+	PERLIN,
+	SIMPLEX
+};
+
+enum class NoiseFractal
+{
+	SINGLE,
+	FBM,
+	RIDGED
+};
+
+struct NoiseSettings
+{
+	NoiseBasis		m_basis = NoiseBasis::PERLIN;
+	NoiseFractal	m_fractal = NoiseFractal::FBM;
+	float			m_scale = 64.f;				// world units per lattice cell of the first octave
+	int				m_numOctaves = 4;
+	float			m_persistence = 0.5f;
+	float			m_lacunarity = 2.f;
+	float			m_warpStrength = 0.f;		// world units; 0 disables domain warping
+	unsigned int	m_seed = 0;
+};
+
+float	ComputePerlinNoise2D(float x, float y, unsigned int seed = 0);
+float	ComputePerlinNoise3D(float x, float y, float z, unsigned int seed = 0);
+float	ComputeSimplexNoise2D(float x, float y, unsigned int seed = 0);
+float	ComputeSimplexNoise3D(float x, float y, float z, unsigned int seed = 0);
+
+float	ComputeNoise2D(Vec2 const& position, NoiseSettings const& settings);
+float	ComputeNoise3D(Vec3 const& position, NoiseSettings const& settings);
+
+// Fills dims.x * dims.y (* dims.z) values, x fastest, then y; sample (i,j,k) is taken at origin + (i,j,k) * cellSize
+void	ComputeNoiseGrid2D(float* out_values, IntVec2 const& dims, Vec2 const& origin, float cellSize, NoiseSettings const& settings);
+void	ComputeNoiseGrid3D(float* out_values, IntVec3 const& dims, Vec3 const& origin, float cellSize, NoiseSettings const& settings);
\ No newline at end of file
@@ -0,0 +1,376 @@
+#include "Engine/Math/OverlapBatch3D.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/SimdMath.hpp"
+
+static inline int CountSetBits(unsigned int bits)
+{
+	int count = 0;
+	while (bits != 0)
+	{
+		bits &= bits - 1;
+		++count;
+	}
+	return count;
+}
+
+// Runs simdTest over full SIMD blocks and scalarTest over the remainder, packing results into the mask.
+// SIMD_WIDTH divides 32, so a block's lanes never straddle two mask words.
+template <typename SimdTest, typename ScalarTest>
+static int FillOverlapMask(int numShapes, std::vector<unsigned int>& out_overlapMask, SimdTest const& simdTest, ScalarTest const& scalarTest)
+{
+	out_overlapMask.assign((numShapes + 31) / 32, 0u);
+	int numOverlaps = 0;
+	int shapeIndex = 0;
+	for (; shapeIndex + SIMD_WIDTH <= numShapes; shapeIndex += SIMD_WIDTH)
+	{
+		unsigned int laneBits = SimdMoveMask(simdTest(shapeIndex));
+		out_overlapMask[shapeIndex >> 5] |= laneBits << (shapeIndex & 31);
+		numOverlaps += CountSetBits(laneBits);
+	}
+	for (; shapeIndex < numShapes; ++shapeIndex)
+	{
+		if (scalarTest(shapeIndex))
+		{
+			out_overlapMask[shapeIndex >> 5] |= 1u << (shapeIndex & 31);
+			++numOverlaps;
+		}
+	}
+	return numOverlaps;
+}
+
+//----------------------------------------------------------------------------------------------
+void AABB3SoA::Reserve(int numBoxes)
+{
+	m_minX.reserve(numBoxes);
+	m_minY.reserve(numBoxes);
+	m_minZ.reserve(numBoxes);
+	m_maxX.reserve(numBoxes);
+	m_maxY.reserve(numBoxes);
+	m_maxZ.reserve(numBoxes);
+}
+
+void AABB3SoA::Clear()
+{
+	m_minX.clear();
+	m_minY.clear();
+	m_minZ.clear();
+	m_maxX.clear();
+	m_maxY.clear();
+	m_maxZ.clear();
+}
+
+int AABB3SoA::Add(AABB3 const& box)
+{
+	m_minX.push_back(box.m_mins.x);
+	m_minY.push_back(box.m_mins.y);
+	m_minZ.push_back(box.m_mins.z);
+	m_maxX.push_back(box.m_maxs.x);
+	m_maxY.push_back(box.m_maxs.y);
+	m_maxZ.push_back(box.m_maxs.z);
+	return GetCount() - 1;
+}
+
+AABB3 AABB3SoA::Get(int index) const
+{
+	return AABB3(m_minX[index], m_minY[index], m_minZ[index], m_maxX[index], m_maxY[index], m_maxZ[index]);
+}
+
+void SphereSoA::Reserve(int numSpheres)
+{
+	m_centerX.reserve(numSpheres);
+	m_centerY.reserve(numSpheres);
+	m_centerZ.reserve(numSpheres);
+	m_radius.reserve(numSpheres);
+}
+
+void SphereSoA::Clear()
+{
+	m_centerX.clear();
+	m_centerY.clear();
+	m_centerZ.clear();
+	m_radius.clear();
+}
+
+int SphereSoA::Add(Vec3 const& center, float radius)
+{
+	m_centerX.push_back(center.x);
+	m_centerY.push_back(center.y);
+	m_centerZ.push_back(center.z);
+	m_radius.push_back(radius);
+	return GetCount() - 1;
+}
+
+void ZCylinderSoA::Reserve(int numCylinders)
+{
+	m_centerX.reserve(numCylinders);
+	m_centerY.reserve(numCylinders);
+	m_radius.reserve(numCylinders);
+	m_minZ.reserve(numCylinders);
+	m_maxZ.reserve(numCylinders);
+}
+
+void ZCylinderSoA::Clear()
+{
+	m_centerX.clear();
+	m_centerY.clear();
+	m_radius.clear();
+	m_minZ.clear();
+	m_maxZ.clear();
+}
+
+int ZCylinderSoA::Add(Vec2 const& centerXY, float radius, FloatRange const& minMaxZ)
+{
+	m_centerX.push_back(centerXY.x);
+	m_centerY.push_back(centerXY.y);
+	m_radius.push_back(radius);
+	m_minZ.push_back(minMaxZ.m_min);
+	m_maxZ.push_back(minMaxZ.m_max);
+	return GetCount() - 1;
+}
+
+//----------------------------------------------------------------------------------------------
+int DoSphereAndSpheresOverlap3D(Vec3 const& sphereCenter, float sphereRadius, SphereSoA const& spheres, std::vector<unsigned int>& out_overlapMask)
+{
+	SimdFloat centerX = SimdSplat(sphereCenter.x);
+	SimdFloat centerY = SimdSplat(sphereCenter.y);
+	SimdFloat centerZ = SimdSplat(sphereCenter.z);
+	SimdFloat radius = SimdSplat(sphereRadius);
+	return FillOverlapMask(spheres.GetCount(), out_overlapMask,
+		[&](int index)
+		{
+			SimdFloat dx = SimdSub(SimdLoad(&spheres.m_centerX[index]), centerX);
+			SimdFloat dy = SimdSub(SimdLoad(&spheres.m_centerY[index]), centerY);
+			SimdFloat dz = SimdSub(SimdLoad(&spheres.m_centerZ[index]), centerZ);
+			SimdFloat distanceSquared = SimdAdd(SimdAdd(SimdMul(dx, dx), SimdMul(dy, dy)), SimdMul(dz, dz));
+			SimdFloat radiusSum = SimdAdd(radius, SimdLoad(&spheres.m_radius[index]));
+			return SimdLessEqual(distanceSquared, SimdMul(radiusSum, radiusSum));
+		},
+		[&](int index)
+		{
+			return DoSpheresOverlap3D(sphereCenter, sphereRadius, Vec3(spheres.m_centerX[index], spheres.m_centerY[index], spheres.m_centerZ[index]), spheres.m_radius[index]);
+		});
+}
+
+int DoSphereAndAABBsOverlap3D(Vec3 const& sphereCenter, float sphereRadius, AABB3SoA const& boxes, std::vector<unsigned int>& out_overlapMask)
+{
+	SimdFloat centerX = SimdSplat(sphereCenter.x);
+	SimdFloat centerY = SimdSplat(sphereCenter.y);
+	SimdFloat centerZ = SimdSplat(sphereCenter.z);
+	SimdFloat radiusSquared = SimdSplat(sphereRadius * sphereRadius);
+	return FillOverlapMask(boxes.GetCount(), out_overlapMask,
+		[&](int index)
+		{
+			SimdFloat dx = SimdSub(SimdMax(SimdLoad(&boxes.m_minX[index]), SimdMin(centerX, SimdLoad(&boxes.m_maxX[index]))), centerX);
+			SimdFloat dy = SimdSub(SimdMax(SimdLoad(&boxes.m_minY[index]), SimdMin(centerY, SimdLoad(&boxes.m_maxY[index]))), centerY);
+			SimdFloat dz = SimdSub(SimdMax(SimdLoad(&boxes.m_minZ[index]), SimdMin(centerZ, SimdLoad(&boxes.m_maxZ[index]))), centerZ);
+			SimdFloat distanceSquared = SimdAdd(SimdAdd(SimdMul(dx, dx), SimdMul(dy, dy)), SimdMul(dz, dz));
+			return SimdLessEqual(distanceSquared, radiusSquared);
+		},
+		[&](int index)
+		{
+			return DoSphereAndAABBOverlap3D(sphereCenter, sphereRadius, boxes.Get(index));
+		});
+}
+
+int DoSphereAndZCylindersOverlap3D(Vec3 const& sphereCenter, float sphereRadius, ZCylinderSoA const& cylinders, std::vector<unsigned int>& out_overlapMask)
+{
+	SimdFloat centerX = SimdSplat(sphereCenter.x);
+	SimdFloat centerY = SimdSplat(sphereCenter.y);
+	SimdFloat radius = SimdSplat(sphereRadius);
+	SimdFloat sphereTop = SimdSplat(sphereCenter.z + sphereRadius);
+	SimdFloat sphereBottom = SimdSplat(sphereCenter.z - sphereRadius);
+	return FillOverlapMask(cylinders.GetCount(), out_overlapMask,
+		[&](int index)
+		{
+			SimdFloat dx = SimdSub(SimdLoad(&cylinders.m_centerX[index]), centerX);
+			SimdFloat dy = SimdSub(SimdLoad(&cylinders.m_centerY[index]), centerY);
+			SimdFloat radiusSum = SimdAdd(SimdLoad(&cylinders.m_radius[index]), radius);
+			SimdFloat overlapXY = SimdLessEqual(SimdAdd(SimdMul(dx, dx), SimdMul(dy, dy)), SimdMul(radiusSum, radiusSum));
+			SimdFloat overlapZ = SimdAnd(SimdLessEqual(SimdLoad(&cylinders.m_minZ[index]), sphereTop), SimdLessEqual(sphereBottom, SimdLoad(&cylinders.m_maxZ[index])));
+			return SimdAnd(overlapXY, overlapZ);
+		},
+		[&](int index)
+		{
+			return DoZCylinderAndSphereOverlap3D(Vec2(cylinders.m_centerX[index], cylinders.m_centerY[index]), cylinders.m_radius[index],
+				FloatRange(cylinders.m_minZ[index], cylinders.m_maxZ[index]), sphereCenter, sphereRadius);
+		});
+}
+
+int DoAABBAndAABBsOverlap3D(AABB3 const& box, AABB3SoA const& boxes, std::vector<unsigned int>& out_overlapMask)
+{
+	SimdFloat minX = SimdSplat(box.m_mins.x);
+	SimdFloat minY = SimdSplat(box.m_mins.y);
+	SimdFloat minZ = SimdSplat(box.m_mins.z);
+	SimdFloat maxX = SimdSplat(box.m_maxs.x);
+	SimdFloat maxY = SimdSplat(box.m_maxs.y);
+	SimdFloat maxZ = SimdSplat(box.m_maxs.z);
+	return FillOverlapMask(boxes.GetCount(), out_overlapMask,
+		[&](int index)
+		{
+			SimdFloat overlapX = SimdAnd(SimdLessEqual(SimdLoad(&boxes.m_minX[index]), maxX), SimdLessEqual(minX, SimdLoad(&boxes.m_maxX[index])));
+			SimdFloat overlapY = SimdAnd(SimdLessEqual(SimdLoad(&boxes.m_minY[index]), maxY), SimdLessEqual(minY, SimdLoad(&boxes.m_maxY[index])));
+			SimdFloat overlapZ = SimdAnd(SimdLessEqual(SimdLoad(&boxes.m_minZ[index]), maxZ), SimdLessEqual(minZ, SimdLoad(&boxes.m_maxZ[index])));
+			return SimdAnd(SimdAnd(overlapX, overlapY), overlapZ);
+		},
+		[&](int index)
+		{
+			return DoAABBsOverlap3D(box, boxes.Get(index));
+		});
+}
+
+int DoAABBAndSpheresOverlap3D(AABB3 const& box, SphereSoA const& spheres, std::vector<unsigned int>& out_overlapMask)
+{
+	SimdFloat minX = SimdSplat(box.m_mins.x);
+	SimdFloat minY = SimdSplat(box.m_mins.y);
+	SimdFloat minZ = SimdSplat(box.m_mins.z);
+	SimdFloat maxX = SimdSplat(box.m_maxs.x);
+	SimdFloat maxY = SimdSplat(box.m_maxs.y);
+	SimdFloat maxZ = SimdSplat(box.m_maxs.z);
+	return FillOverlapMask(spheres.GetCount(), out_overlapMask,
+		[&](int index)
+		{
+			SimdFloat centerX = SimdLoad(&spheres.m_centerX[index]);
+			SimdFloat centerY = SimdLoad(&spheres.m_centerY[index]);
+			SimdFloat centerZ = SimdLoad(&spheres.m_centerZ[index]);
+			SimdFloat radius = SimdLoad(&spheres.m_radius[index]);
+			SimdFloat dx = SimdSub(SimdMax(minX, SimdMin(centerX, maxX)), centerX);
+			SimdFloat dy = SimdSub(SimdMax(minY, SimdMin(centerY, maxY)), centerY);
+			SimdFloat dz = SimdSub(SimdMax(minZ, SimdMin(centerZ, maxZ)), centerZ);
+			SimdFloat distanceSquared = SimdAdd(SimdAdd(SimdMul(dx, dx), SimdMul(dy, dy)), SimdMul(dz, dz));
+			return SimdLessEqual(distanceSquared, SimdMul(radius, radius));
+		},
+		[&](int index)
+		{
+			return DoSphereAndAABBOverlap3D(Vec3(spheres.m_centerX[index], spheres.m_centerY[index], spheres.m_centerZ[index]), spheres.m_radius[index], box);
+		});
+}
+
+int DoAABBAndZCylindersOverlap3D(AABB3 const& box, ZCylinderSoA const& cylinders, std::vector<unsigned int>& out_overlapMask)
+{
+	SimdFloat minX = SimdSplat(box.m_mins.x);
+	SimdFloat minY = SimdSplat(box.m_mins.y);
+	SimdFloat minZ = SimdSplat(box.m_mins.z);
+	SimdFloat maxX = SimdSplat(box.m_maxs.x);
+	SimdFloat maxY = SimdSplat(box.m_maxs.y);
+	SimdFloat maxZ = SimdSplat(box.m_maxs.z);
+	return FillOverlapMask(cylinders.GetCount(), out_overlapMask,
+		[&](int index)
+		{
+			SimdFloat centerX = SimdLoad(&cylinders.m_centerX[index]);
+			SimdFloat centerY = SimdLoad(&cylinders.m_centerY[index]);
+			SimdFloat radius = SimdLoad(&cylinders.m_radius[index]);
+			SimdFloat dx = SimdSub(SimdMax(minX, SimdMin(centerX, maxX)), centerX);
+			SimdFloat dy = SimdSub(SimdMax(minY, SimdMin(centerY, maxY)), centerY);
+			SimdFloat overlapXY = SimdLessEqual(SimdAdd(SimdMul(dx, dx), SimdMul(dy, dy)), SimdMul(radius, radius));
+			SimdFloat overlapZ = SimdAnd(SimdLessEqual(SimdLoad(&cylinders.m_minZ[index]), maxZ), SimdLessEqual(minZ, SimdLoad(&cylinders.m_maxZ[index])));
+			return SimdAnd(overlapXY, overlapZ);
+		},
+		[&](int index)
+		{
+			return DoZCylinderAndAABBOverlap3D(Vec2(cylinders.m_centerX[index], cylinders.m_centerY[index]), cylinders.m_radius[index],
+				FloatRange(cylinders.m_minZ[index], cylinders.m_maxZ[index]), box);
+		});
+}
+
+int DoZCylinderAndZCylindersOverlap3D(Vec2 const& cylinderCenterXY, float cylinderRadius, FloatRange const& cylinderMinMaxZ, ZCylinderSoA const& cylinders, std::vector<unsigned int>& out_overlapMask)
+{
+	SimdFloat centerX = SimdSplat(cylinderCenterXY.x);
+	SimdFloat centerY = SimdSplat(cylinderCenterXY.y);
+	SimdFloat radius = SimdSplat(cylinderRadius);
+	SimdFloat minZ = SimdSplat(cylinderMinMaxZ.m_min);
+	SimdFloat maxZ = SimdSplat(cylinderMinMaxZ.m_max);
+	return FillOverlapMask(cylinders.GetCount(), out_overlapMask,
+		[&](int index)
+		{
+			SimdFloat dx = SimdSub(centerX, SimdLoad(&cylinders.m_centerX[index]));
+			SimdFloat dy = SimdSub(centerY, SimdLoad(&cylinders.m_centerY[index]));
+			SimdFloat radiusSum = SimdAdd(radius, SimdLoad(&cylinders.m_radius[index]));
+			SimdFloat overlapXY = SimdLessEqual(SimdAdd(SimdMul(dx, dx), SimdMul(dy, dy)), SimdMul(radiusSum, radiusSum));
+			SimdFloat overlapZ = SimdAnd(SimdLessEqual(minZ, SimdLoad(&cylinders.m_maxZ[index])), SimdLessEqual(SimdLoad(&cylinders.m_minZ[index]), maxZ));
+			return SimdAnd(overlapXY, overlapZ);
+		},
+		[&](int index)
+		{
+			return DoZCylindersOverlap3D(cylinderCenterXY, cylinderRadius, cylinderMinMaxZ, Vec2(cylinders.m_centerX[index], cylinders.m_centerY[index]),
+				cylinders.m_radius[index], FloatRange(cylinders.m_minZ[index], cylinders.m_maxZ[index]));
+		});
+}
+
+int DoZCylinderAndAABBsOverlap3D(Vec2 const& cylinderCenterXY, float cylinderRadius, FloatRange const& cylinderMinMaxZ, AABB3SoA const& boxes, std::vector<unsigned int>& out_overlapMask)
+{
+	SimdFloat centerX = SimdSplat(cylinderCenterXY.x);
+	SimdFloat centerY = SimdSplat(cylinderCenterXY.y);
+	SimdFloat radiusSquared = SimdSplat(cylinderRadius * cylinderRadius);
+	SimdFloat minZ = SimdSplat(cylinderMinMaxZ.m_min);
+	SimdFloat maxZ = SimdSplat(cylinderMinMaxZ.m_max);
+	return FillOverlapMask(boxes.GetCount(), out_overlapMask,
+		[&](int index)
+		{
+			SimdFloat dx = SimdSub(SimdMax(SimdLoad(&boxes.m_minX[index]), SimdMin(centerX, SimdLoad(&boxes.m_maxX[index]))), centerX);
+			SimdFloat dy = SimdSub(SimdMax(SimdLoad(&boxes.m_minY[index]), SimdMin(centerY, SimdLoad(&boxes.m_maxY[index]))), centerY);
+			SimdFloat overlapXY = SimdLessEqual(SimdAdd(SimdMul(dx, dx), SimdMul(dy, dy)), radiusSquared);
+			SimdFloat overlapZ = SimdAnd(SimdLessEqual(minZ, SimdLoad(&boxes.m_maxZ[index])), SimdLessEqual(SimdLoad(&boxes.m_minZ[index]), maxZ));
+			return SimdAnd(overlapXY, overlapZ);
+		},
+		[&](int index)
+		{
+			return DoZCylinderAndAABBOverlap3D(cylinderCenterXY, cylinderRadius, cylinderMinMaxZ, boxes.Get(index));
+		});
+}
+
+int DoZCylinderAndSpheresOverlap3D(Vec2 const& cylinderCenterXY, float cylinderRadius, FloatRange const& cylinderMinMaxZ, SphereSoA const& spheres, std::vector<unsigned int>& out_overlapMask)
+{
+	SimdFloat centerX = SimdSplat(cylinderCenterXY.x);
+	SimdFloat centerY = SimdSplat(cylinderCenterXY.y);
+	SimdFloat radius = SimdSplat(cylinderRadius);
+	SimdFloat minZ = SimdSplat(cylinderMinMaxZ.m_min);
+	SimdFloat maxZ = SimdSplat(cylinderMinMaxZ.m_max);
+	return FillOverlapMask(spheres.GetCount(), out_overlapMask,
+		[&](int index)
+		{
+			SimdFloat sphereZ = SimdLoad(&spheres.m_centerZ[index]);
+			SimdFloat sphereRadius = SimdLoad(&spheres.m_radius[index]);
+			SimdFloat dx = SimdSub(centerX, SimdLoad(&spheres.m_centerX[index]));
+			SimdFloat dy = SimdSub(centerY, SimdLoad(&spheres.m_centerY[index]));
+			SimdFloat radiusSum = SimdAdd(radius, sphereRadius);
+			SimdFloat overlapXY = SimdLessEqual(SimdAdd(SimdMul(dx, dx), SimdMul(dy, dy)), SimdMul(radiusSum, radiusSum));
+			SimdFloat overlapZ = SimdAnd(SimdLessEqual(minZ, SimdAdd(sphereZ, sphereRadius)), SimdLessEqual(SimdSub(sphereZ, sphereRadius), maxZ));
+			return SimdAnd(overlapXY, overlapZ);
+		},
+		[&](int index)
+		{
+			return DoZCylinderAndSphereOverlap3D(cylinderCenterXY, cylinderRadius, cylinderMinMaxZ,
+				Vec3(spheres.m_centerX[index], spheres.m_centerY[index], spheres.m_centerZ[index]), spheres.m_radius[index]);
+		});
+}
+
+//----------------------------------------------------------------------------------------------
+bool IsOverlapMaskBitSet(std::vector<unsigned int> const& overlapMask, int index)
+{
+	return (overlapMask[index >> 5] & (1u << (index & 31))) != 0;
+}
+
+void GetOverlapIndicesFromMask(std::vector<unsigned int> const& overlapMask, int numShapes, std::vector<int>& out_indices)
+{
+	out_indices.clear();
+	int numWords = (int)overlapMask.size();
+	for (int wordIndex = 0; wordIndex < numWords; ++wordIndex)
+	{
+		unsigned int bits = overlapMask[wordIndex];
+		while (bits != 0)
+		{
+			int bitIndex = 0;
+			while ((bits & (1u << bitIndex)) == 0)
+			{
+				++bitIndex;
+			}
+			int shapeIndex = wordIndex * 32 + bitIndex;
+			if (shapeIndex >= numShapes)
+			{
+				return;
+			}
+			out_indices.push_back(shapeIndex);
+			bits &= bits - 1;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/FloatRange.hpp"
+#include <vector>
+
+//----------------------------------------------------------------------------------------------
+// Structure-of-arrays shape sets for testing one shape against many. Each component lives in its
+// own array so the batch overlap functions can load 4 (SSE) or 8 (AVX) shapes per instruction.
+//
+struct AABB3SoA
+{
+public:
+	std::vector<float> m_minX;
+	std::vector<float> m_minY;
+	std::vector<float> m_minZ;
+	std::vector<float> m_maxX;
+	std::vector<float> m_maxY;
+	std::vector<float> m_maxZ;
+
+public:
+	void	Reserve(int numBoxes);
+	void	Clear();
+	int		Add(AABB3 const& box);
+	int		GetCount() const { return (int)m_minX.size(); }
+	AABB3	Get(int index) const;
+};
+
+struct SphereSoA
+{
+public:
+	std::vector<float> m_centerX;
+	std::vector<float> m_centerY;
+	std::vector<float> m_centerZ;
+	std::vector<float> m_radius;
+
+public:
+	void	Reserve(int numSpheres);
+	void	Clear();
+	int		Add(Vec3 const& center, float radius);
+	int		GetCount() const { return (int)m_centerX.size(); }
+};
+
+struct ZCylinderSoA
+{
+public:
+	std::vector<float> m_centerX;
+	std::vector<float> m_centerY;
+	std::vector<float> m_radius;
+	std::vector<float> m_minZ;
+	std::vector<float> m_maxZ;
+
+public:
+	void	Reserve(int numCylinders);
+	void	Clear();
+	int		Add(Vec2 const& centerXY, float radius, FloatRange const& minMaxZ);
+	int		GetCount() const { return (int)m_centerX.size(); }
+};
+
+//----------------------------------------------------------------------------------------------
+// Batch overlap tests. Bit i of out_overlapMask (word i/32, bit i%32) is set when the query shape
+// overlaps shape i of the set; the mask is resized to fit the set. Each returns the number of
+// overlaps. Results match the single-pair Do*Overlap3D functions in MathUtils exactly.
+//
+int DoSphereAndSpheresOverlap3D(Vec3 const& sphereCenter, float sphereRadius, SphereSoA const& spheres, std::vector<unsigned int>& out_overlapMask);
+int DoSphereAndAABBsOverlap3D(Vec3 const& sphereCenter, float sphereRadius, AABB3SoA const& boxes, std::vector<unsigned int>& out_overlapMask);
+int DoSphereAndZCylindersOverlap3D(Vec3 const& sphereCenter, float sphereRadius, ZCylinderSoA const& cylinders, std::vector<unsigned int>& out_overlapMask);
+int DoAABBAndAABBsOverlap3D(AABB3 const& box, AABB3SoA const& boxes, std::vector<unsigned int>& out_overlapMask);
+int DoAABBAndSpheresOverlap3D(AABB3 const& box, SphereSoA const& spheres, std::vector<unsigned int>& out_overlapMask);
+int DoAABBAndZCylindersOverlap3D(AABB3 const& box, ZCylinderSoA const& cylinders, std::vector<unsigned int>& out_overlapMask);
+int DoZCylinderAndZCylindersOverlap3D(Vec2 const& cylinderCenterXY, float cylinderRadius, FloatRange const& cylinderMinMaxZ, ZCylinderSoA const& cylinders, std::vector<unsigned int>& out_overlapMask);
+int DoZCylinderAndAABBsOverlap3D(Vec2 const& cylinderCenterXY, float cylinderRadius, FloatRange const& cylinderMinMaxZ, AABB3SoA const& boxes, std::vector<unsigned int>& out_overlapMask);
+int DoZCylinderAndSpheresOverlap3D(Vec2 const& cylinderCenterXY, float cylinderRadius, FloatRange const& cylinderMinMaxZ, SphereSoA const& spheres, std::vector<unsigned int>& out_overlapMask);
+
+bool IsOverlapMaskBitSet(std::vector<unsigned int> const& overlapMask, int index);
+void GetOverlapIndicesFromMask(std::vector<unsigned int> const& overlapMask, int numShapes, std::vector<int>& out_indices);
\ No newline at end of file
@@ -7,6 +7,12 @@ Plane3D::Plane3D(Vec3 const& normal, Vec3 const& pointOnPlane)
 {
 }
 
+Plane3D::Plane3D(Vec3 const& n, float distanceFromOrigin)
+	: normal(n)
+	, distanceFromOriginAlongNormal(distanceFromOrigin)
+{
+}
+
 float Plane3D::GetDistance(Vec3 const& point) const
 {
 	return GetProjectedLength3D(point, normal) - distanceFromOriginAlongNormal;
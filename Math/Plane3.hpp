@@ -9,7 +9,9 @@ public:
 	float distanceFromOriginAlongNormal = 0.f;
 
 public:
+	Plane3D() {}
 	Plane3D(Vec3 const& n, Vec3 const& pointOnPlane);
+	explicit Plane3D(Vec3 const& n, float distanceFromOrigin);
 
 	float GetDistance(Vec3 const& point) const;
 	bool IsPointInFront(Vec3 const& point) const;
@@ -1,21 +1,78 @@
 #include "RandomNumberGenerator.hpp"
-#include <cstdlib> // For rand() and RAND_MAX
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Math/RawNoise.hpp"
+#include "Engine/Math/RawNoiseSimd.hpp"
+#include <cstdint>
 
 RandomNumberGenerator* g_rng;
 
+namespace
+{
+	constexpr unsigned int STREAM_SEED_SALT = 0x68e31da4;
+	constexpr float ONE_OVER_MAX_24_BITS = 1.f / 16777215.f;
+
+	// A single hash round only mixes position and seed linearly before scrambling, which would make every seed a
+	// shifted copy of one 2^32-long sequence and let streams overlap; the second round keyed by the seed breaks that
+	unsigned int GetRandomBits( unsigned int position, unsigned int seed )
+	{
+		return Get1dNoiseUint( (int)Get1dNoiseUint( (int)position, seed ), seed );
+	}
+
+	SimdInt SimdGetRandomBits( SimdInt positions, unsigned int seed )
+	{
+		return SimdGet1dNoiseUint( SimdGet1dNoiseUint( positions, seed ), seed );
+	}
+
+	// Top 24 bits over 2^24 - 1: [0,1] inclusive, every value exactly representable
+	float GetZeroToOneFromBits( unsigned int bits )
+	{
+		return (float)(int)(bits >> 8) * ONE_OVER_MAX_24_BITS;
+	}
+}
+
+RandomNumberGenerator::RandomNumberGenerator( unsigned int seed, unsigned int position )
+	: m_seed( seed )
+	, m_position( position )
+{
+}
+
+unsigned int RandomNumberGenerator::RollRandomUint()
+{
+	return GetRandomBits( m_position++, m_seed );
+}
+
 int RandomNumberGenerator::RollRandomIntLessThan(int maxNotInclusive)
 {
-	return rand() % maxNotInclusive; // Returns a random number between 0 (inclusive) and maxNotInclusive (exclusive).
+	ASSERT_OR_DIE( maxNotInclusive > 0, "RollRandomIntLessThan needs a positive bound" );
+	return RollRandomIntInRange( 0, maxNotInclusive - 1 );
 }
 
 int RandomNumberGenerator::RollRandomIntInRange(int minInclusive, int maxInclusive)
 {
-	return minInclusive + rand() % (maxInclusive - minInclusive + 1); // Returns a random number between minInclusive and maxInclusive.
+	unsigned int range = (unsigned int)maxInclusive - (unsigned int)minInclusive + 1u;
+	if (range == 0)
+	{
+		return (int)RollRandomUint(); // the full 32-bit range
+	}
+
+	// Lemire: the high word of bits * range is uniform once the few low words below 2^32 mod range are rejected
+	uint64_t product = (uint64_t)RollRandomUint() * range;
+	unsigned int lowWord = (unsigned int)product;
+	if (lowWord < range)
+	{
+		unsigned int threshold = (0u - range) % range;
+		while (lowWord < threshold)
+		{
+			product = (uint64_t)RollRandomUint() * range;
+			lowWord = (unsigned int)product;
+		}
+	}
+	return (int)((unsigned int)minInclusive + (unsigned int)(product >> 32));
 }
 
 float RandomNumberGenerator::RollRandomFloatZeroToOne()
 {
-	return static_cast<float>(rand()) / static_cast<float>(RAND_MAX); // Returns a float value between 0.0 and 1.0
+	return GetZeroToOneFromBits( RollRandomUint() );
 }
 
 float RandomNumberGenerator::RollRandomFloatInRange(float minInclusive, float maxInclusive)
@@ -24,5 +81,66 @@ float RandomNumberGenerator::RollRandomFloatInRange(float minInclusive, float ma
 	return minInclusive + (zeroToOne * (maxInclusive - minInclusive)); // Scale and shift to desired range
 }
 
+//----------------------------------------------------------------------------------------------
+void RandomNumberGenerator::RollRandomUints( unsigned int* out_values, int count )
+{
+	int index = 0;
+	for (; index + SIMD_WIDTH <= count; index += SIMD_WIDTH)
+	{
+		SimdInt positions = SimdIntAdd( SimdIntSplat( (int)(m_position + (unsigned int)index) ), SimdIntLaneIndices() );
+		SimdIntStore( (int*)(out_values + index), SimdGetRandomBits( positions, m_seed ) );
+	}
+	for (; index < count; ++index)
+	{
+		out_values[index] = GetRandomBits( m_position + (unsigned int)index, m_seed );
+	}
+	m_position += (unsigned int)count;
+}
 
+void RandomNumberGenerator::RollRandomFloatsZeroToOne( float* out_values, int count )
+{
+	SimdFloat scale = SimdSplat( ONE_OVER_MAX_24_BITS );
+	int index = 0;
+	for (; index + SIMD_WIDTH <= count; index += SIMD_WIDTH)
+	{
+		SimdInt positions = SimdIntAdd( SimdIntSplat( (int)(m_position + (unsigned int)index) ), SimdIntLaneIndices() );
+		SimdInt topBits = SimdIntShiftRight( SimdGetRandomBits( positions, m_seed ), 8 );
+		SimdStore( out_values + index, SimdMul( SimdIntToFloat( topBits ), scale ) );
+	}
+	for (; index < count; ++index)
+	{
+		out_values[index] = GetZeroToOneFromBits( GetRandomBits( m_position + (unsigned int)index, m_seed ) );
+	}
+	m_position += (unsigned int)count;
+}
+
+void RandomNumberGenerator::RollRandomFloatsInRange( float* out_values, int count, float minInclusive, float maxInclusive )
+{
+	RollRandomFloatsZeroToOne( out_values, count );
+	float rangeSize = maxInclusive - minInclusive;
+	for (int index = 0; index < count; ++index)
+	{
+		out_values[index] = minInclusive + (out_values[index] * rangeSize);
+	}
+}
+
+void RandomNumberGenerator::RollRandomIntsInRange( int* out_values, int count, int minInclusive, int maxInclusive )
+{
+	// Rejections consume extra rolls, so this stays sequential to match single rolls exactly
+	for (int index = 0; index < count; ++index)
+	{
+		out_values[index] = RollRandomIntInRange( minInclusive, maxInclusive );
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+RandomNumberGenerator RandomNumberGenerator::GetStream( unsigned int streamIndex ) const
+{
+	return RandomNumberGenerator( Get2dNoiseUint( (int)streamIndex, (int)m_seed, STREAM_SEED_SALT ) );
+}
+
+RandomNumberGenerator RandomNumberGenerator::Split()
+{
+	return RandomNumberGenerator( RollRandomUint() );
+}
 
@@ -1,17 +1,44 @@
 #pragma once
+
+//----------------------------------------------------------------------------------------------
+// Counter-based generator: roll N of a seed is a pure function of (m_seed, N), built from two rounds of
+// Get1dNoiseUint. There is no hidden or global state, so a generator is a plain value: copy it, jump it, or hand
+// each job its own stream with GetStream/Split and let every JobSystem worker roll in parallel without locks.
+// A single instance must not be shared between threads.
+//
+// The position is unsigned and wraps after 2^32 rolls, so each seed is one 2^32-long cycle.
+//
+// Integer ranges use Lemire's multiply-shift reduction with rejection, so every value is equally likely.
+// Batch rolls produce exactly what the same number of single rolls would.
+//
 class RandomNumberGenerator
 {
 public:
+	RandomNumberGenerator() = default;
+	explicit RandomNumberGenerator( unsigned int seed, unsigned int position = 0 );
+
 	int RollRandomIntLessThan( int maxNotInclusive );
 	int RollRandomIntInRange( int minInclusive, int maxInclusive );
 	float RollRandomFloatZeroToOne();
 	float RollRandomFloatInRange( float minInclusive, float maxInclusive );
+	unsigned int RollRandomUint();
 
-	unsigned int  m_seed = 0;     // we will use this later on...
+	void RollRandomUints( unsigned int* out_values, int count );
+	void RollRandomFloatsZeroToOne( float* out_values, int count );
+	void RollRandomFloatsInRange( float* out_values, int count, float minInclusive, float maxInclusive );
+	void RollRandomIntsInRange( int* out_values, int count, int minInclusive, int maxInclusive );
 
-private:
-	 int          m_position = 0; //...when we replace rand() with noise
-};
+	// Independent generator for stream streamIndex of this seed; does not advance this generator
+	RandomNumberGenerator GetStream( unsigned int streamIndex ) const;
+	// Rolls a seed from this generator for a new independent one
+	RandomNumberGenerator Split();
 
+	void Jump( unsigned int numRolls )					{ m_position += numRolls; }
+	void SetPosition( unsigned int position )			{ m_position = position; }
+	unsigned int GetPosition() const					{ return m_position; }
 
+	unsigned int  m_seed = 0;
 
+private:
+	unsigned int  m_position = 0;
+};
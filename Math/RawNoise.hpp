@@ -77,19 +77,24 @@ constexpr float Get4dNoiseNegOneToOne( int indexX, int indexY, int indexZ, int i
 //
 // I call this particular approach SquirrelNoise (version 4).
 //
+// The constants are shared with the SIMD versions in RawNoiseSimd.hpp, which must stay bit-identical.
+//
+constexpr unsigned int SQUIRREL4_BIT_NOISE1 = 0xd2a80a23;
+constexpr unsigned int SQUIRREL4_BIT_NOISE2 = 0xa884f197;
+constexpr unsigned int SQUIRREL4_BIT_NOISE3 = 0x1b56c4e9;
+constexpr int SQUIRREL4_PRIME1 = 198491317; // Large prime number with non-boring bits
+constexpr int SQUIRREL4_PRIME2 = 6542989; // Large prime number with distinct and non-boring bits
+constexpr int SQUIRREL4_PRIME3 = 357239; // Large prime number with distinct and non-boring bits
+
 constexpr unsigned int Get1dNoiseUint( int positionX, unsigned int seed )
 {
-	constexpr unsigned int BIT_NOISE1 = 0xd2a80a23;
-	constexpr unsigned int BIT_NOISE2 = 0xa884f197;
-	constexpr unsigned int BIT_NOISE3 = 0x1b56c4e9;
-
 	unsigned int mangledBits = (unsigned int) positionX;
-	mangledBits *= BIT_NOISE1;
+	mangledBits *= SQUIRREL4_BIT_NOISE1;
 	mangledBits += seed;
 	mangledBits ^= (mangledBits >> 7);
-	mangledBits += BIT_NOISE2;
+	mangledBits += SQUIRREL4_BIT_NOISE2;
 	mangledBits ^= (mangledBits >> 8);
-	mangledBits *= BIT_NOISE3;
+	mangledBits *= SQUIRREL4_BIT_NOISE3;
 	mangledBits ^= (mangledBits >> 11);
 	return mangledBits;
 }
@@ -98,25 +103,19 @@ constexpr unsigned int Get1dNoiseUint( int positionX, unsigned int seed )
 //-----------------------------------------------------------------------------------------------
 constexpr unsigned int Get2dNoiseUint( int indexX, int indexY, unsigned int seed )
 {
-	constexpr int PRIME_NUMBER = 198491317; // Large prime number with non-boring bits
-	return Get1dNoiseUint( indexX + (PRIME_NUMBER * indexY), seed );
+	return Get1dNoiseUint( indexX + (SQUIRREL4_PRIME1 * indexY), seed );
 }
 
 //-----------------------------------------------------------------------------------------------
 constexpr unsigned int Get3dNoiseUint( int indexX, int indexY, int indexZ, unsigned int seed )
 {
-	constexpr int PRIME1 = 198491317; // Large prime number with non-boring bits
-	constexpr int PRIME2 = 6542989; // Large prime number with distinct and non-boring bits
-	return Get1dNoiseUint( indexX + (PRIME1 * indexY) + (PRIME2 * indexZ), seed );
+	return Get1dNoiseUint( indexX + (SQUIRREL4_PRIME1 * indexY) + (SQUIRREL4_PRIME2 * indexZ), seed );
 }
 
 //-----------------------------------------------------------------------------------------------
 constexpr unsigned int Get4dNoiseUint( int indexX, int indexY, int indexZ, int indexT, unsigned int seed )
 {
-	constexpr int PRIME1 = 198491317; // Large prime number with non-boring bits
-	constexpr int PRIME2 = 6542989; // Large prime number with distinct and non-boring bits
-	constexpr int PRIME3 = 357239; // Large prime number with distinct and non-boring bits
-	return Get1dNoiseUint( indexX + (PRIME1 * indexY) + (PRIME2 * indexZ) + (PRIME3 * indexT), seed );
+	return Get1dNoiseUint( indexX + (SQUIRREL4_PRIME1 * indexY) + (SQUIRREL4_PRIME2 * indexZ) + (SQUIRREL4_PRIME3 * indexT), seed );
 }
 
 //-----------------------------------------------------------------------------------------------
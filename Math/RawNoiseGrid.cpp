@@ -0,0 +1,213 @@
+#include "Engine/Math/RawNoiseGrid.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Math/RawNoise.hpp"
+#include "Engine/Math/RawNoiseSimd.hpp"
+#include <algorithm>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------
+// A 2D grid is filled as dims.y rows, a 3D grid as dims.y * dims.z rows; row r covers y = r % dims.y, z = r / dims.y
+struct NoiseGridRows
+{
+	float*			m_values = nullptr;
+	IntVec3			m_dims;
+	IntVec3			m_firstIndex;
+	unsigned int	m_seed = 0;
+	NoiseGridRange	m_range = NoiseGridRange::ZERO_TO_ONE;
+	bool			m_is3D = false;
+};
+
+namespace
+{
+	float GetScalarNoise(NoiseGridRows const& grid, int indexX, int indexY, int indexZ)
+	{
+		if (grid.m_is3D)
+		{
+			return grid.m_range == NoiseGridRange::ZERO_TO_ONE ? Get3dNoiseZeroToOne(indexX, indexY, indexZ, grid.m_seed) : Get3dNoiseNegOneToOne(indexX, indexY, indexZ, grid.m_seed);
+		}
+		return grid.m_range == NoiseGridRange::ZERO_TO_ONE ? Get2dNoiseZeroToOne(indexX, indexY, grid.m_seed) : Get2dNoiseNegOneToOne(indexX, indexY, grid.m_seed);
+	}
+
+	// The hashes add PRIME1 * y (+ PRIME2 * z) to x, so that part is computed once per row, wrapping like the scalar math
+	unsigned int GetRowPosition(NoiseGridRows const& grid, int indexY, int indexZ)
+	{
+		unsigned int rowOffset = (unsigned int)SQUIRREL4_PRIME1 * (unsigned int)indexY;
+		if (grid.m_is3D)
+		{
+			rowOffset += (unsigned int)SQUIRREL4_PRIME2 * (unsigned int)indexZ;
+		}
+		return rowOffset + (unsigned int)grid.m_firstIndex.x;
+	}
+
+	// Widths that are a whole number of SIMD steps: the band is one run of steps that jumps to the next row's position
+	// at the end of each row, so 16-cell chunk rows pay no per-row setup
+	void FillNoiseGridRowRun(NoiseGridRows const& grid, int firstRow, int numRows)
+	{
+		int indexY = grid.m_firstIndex.y + firstRow % grid.m_dims.y;
+		int indexZ = grid.m_firstIndex.z + firstRow / grid.m_dims.y;
+		int lastIndexY = grid.m_firstIndex.y + grid.m_dims.y - 1;
+		SimdInt positions = SimdIntAdd(SimdIntLaneIndices(), SimdIntSplat((int)GetRowPosition(grid, indexY, indexZ)));
+		SimdInt positionStep = SimdIntSplat(SIMD_WIDTH);
+		SimdInt nextRowStep = SimdIntSplat((int)((unsigned int)SQUIRREL4_PRIME1 - (unsigned int)grid.m_dims.x + (unsigned int)SIMD_WIDTH));
+		bool isZeroToOne = grid.m_range == NoiseGridRange::ZERO_TO_ONE;
+
+		float* values = grid.m_values + firstRow * grid.m_dims.x;
+		float* valuesEnd = values + numRows * grid.m_dims.x;
+		int cellX = 0;
+		for (; values < valuesEnd; values += SIMD_WIDTH)
+		{
+			SimdInt hashes = SimdGet1dNoiseUint(positions, grid.m_seed);
+			SimdStore(values, isZeroToOne ? SimdGetNoiseZeroToOne(hashes) : SimdGetNoiseNegOneToOne(hashes));
+
+			cellX += SIMD_WIDTH;
+			if (cellX < grid.m_dims.x)
+			{
+				positions = SimdIntAdd(positions, positionStep);
+			}
+			else if (indexY < lastIndexY)
+			{
+				cellX = 0;
+				++indexY;
+				positions = SimdIntAdd(positions, nextRowStep);
+			}
+			else
+			{
+				cellX = 0;
+				indexY = grid.m_firstIndex.y;
+				++indexZ;
+				positions = SimdIntAdd(SimdIntLaneIndices(), SimdIntSplat((int)GetRowPosition(grid, indexY, indexZ)));
+			}
+		}
+	}
+
+	// Any other width: SIMD steps along each row, then the last dims.x % SIMD_WIDTH cells (all of a row narrower than
+	// SIMD_WIDTH) through the scalar functions
+	void FillNoiseGridRowByRow(NoiseGridRows const& grid, int firstRow, int numRows)
+	{
+		int indexY = grid.m_firstIndex.y + firstRow % grid.m_dims.y;
+		int indexZ = grid.m_firstIndex.z + firstRow / grid.m_dims.y;
+		int lastIndexY = grid.m_firstIndex.y + grid.m_dims.y - 1;
+		for (int row = firstRow; row < firstRow + numRows; ++row)
+		{
+			SimdInt positions = SimdIntAdd(SimdIntLaneIndices(), SimdIntSplat((int)GetRowPosition(grid, indexY, indexZ)));
+			SimdInt positionStep = SimdIntSplat(SIMD_WIDTH);
+
+			float* rowValues = grid.m_values + row * grid.m_dims.x;
+			int numSimdCells = grid.m_dims.x - grid.m_dims.x % SIMD_WIDTH;
+			int cellX = 0;
+			if (grid.m_range == NoiseGridRange::ZERO_TO_ONE)
+			{
+				for (; cellX < numSimdCells; cellX += SIMD_WIDTH)
+				{
+					SimdStore(rowValues + cellX, SimdGetNoiseZeroToOne(SimdGet1dNoiseUint(positions, grid.m_seed)));
+					positions = SimdIntAdd(positions, positionStep);
+				}
+			}
+			else
+			{
+				for (; cellX < numSimdCells; cellX += SIMD_WIDTH)
+				{
+					SimdStore(rowValues + cellX, SimdGetNoiseNegOneToOne(SimdGet1dNoiseUint(positions, grid.m_seed)));
+					positions = SimdIntAdd(positions, positionStep);
+				}
+			}
+			for (; cellX < grid.m_dims.x; ++cellX)
+			{
+				rowValues[cellX] = GetScalarNoise(grid, grid.m_firstIndex.x + cellX, indexY, indexZ);
+			}
+
+			indexZ += indexY == lastIndexY ? 1 : 0;
+			indexY = indexY == lastIndexY ? grid.m_firstIndex.y : indexY + 1;
+		}
+	}
+
+	void FillNoiseGridRows(NoiseGridRows const& grid, int firstRow, int numRows)
+	{
+		if (grid.m_dims.x % SIMD_WIDTH == 0)
+		{
+			FillNoiseGridRowRun(grid, firstRow, numRows);
+		}
+		else
+		{
+			FillNoiseGridRowByRow(grid, firstRow, numRows);
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+class NoiseGridJob : public Job
+{
+public:
+	NoiseGridJob(NoiseGridRows const& grid, int firstRow, int numRows)
+		: m_grid(grid)
+		, m_firstRow(firstRow)
+		, m_numRows(numRows)
+	{
+	}
+
+	virtual void Execute() override
+	{
+		FillNoiseGridRows(m_grid, m_firstRow, m_numRows);
+	}
+
+private:
+	NoiseGridRows const&	m_grid;
+	int						m_firstRow = 0;
+	int						m_numRows = 0;
+};
+
+namespace
+{
+	void FillNoiseGrid(NoiseGridRows const& grid, JobSystem* jobSystem, int minCellsPerJob)
+	{
+		int numRows = grid.m_dims.y * grid.m_dims.z;
+		if (grid.m_dims.x <= 0 || numRows <= 0)
+		{
+			return;
+		}
+		int rowsPerJob = std::max(1, minCellsPerJob / grid.m_dims.x);
+		if (jobSystem == nullptr || numRows <= rowsPerJob)
+		{
+			FillNoiseGridRows(grid, 0, numRows);
+			return;
+		}
+
+		std::vector<Job*> jobs;
+		for (int firstRow = 0; firstRow < numRows; firstRow += rowsPerJob)
+		{
+			Job* job = new NoiseGridJob(grid, firstRow, std::min(rowsPerJob, numRows - firstRow));
+			jobs.push_back(job);
+			jobSystem->QueueJob(job);
+		}
+		jobSystem->WaitUntilJobsCompleted(jobs);
+		for (Job* job : jobs)
+		{
+			delete job;
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+void FillNoiseGrid2D(float* out_values, IntVec2 const& dims, IntVec2 const& firstIndex, unsigned int seed, NoiseGridRange range, JobSystem* jobSystem, int minCellsPerJob)
+{
+	NoiseGridRows grid;
+	grid.m_values = out_values;
+	grid.m_dims = IntVec3(dims.x, dims.y, 1);
+	grid.m_firstIndex = IntVec3(firstIndex.x, firstIndex.y, 0);
+	grid.m_seed = seed;
+	grid.m_range = range;
+	grid.m_is3D = false;
+	FillNoiseGrid(grid, jobSystem, minCellsPerJob);
+}
+
+void FillNoiseGrid3D(float* out_values, IntVec3 const& dims, IntVec3 const& firstIndex, unsigned int seed, NoiseGridRange range, JobSystem* jobSystem, int minCellsPerJob)
+{
+	NoiseGridRows grid;
+	grid.m_values = out_values;
+	grid.m_dims = dims;
+	grid.m_firstIndex = firstIndex;
+	grid.m_seed = seed;
+	grid.m_range = range;
+	grid.m_is3D = true;
+	FillNoiseGrid(grid, jobSystem, minCellsPerJob);
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/IntVec3.hpp"
+
+class JobSystem;
+
+//----------------------------------------------------------------------------------------------
+// Fill a caller's buffer (heat map values, chunk density arrays, ...) with raw lattice noise, SIMD_WIDTH cells per
+// step. Cell (x,y[,z]) of the buffer, x fastest, gets Get2dNoiseZeroToOne(firstIndex.x + x, firstIndex.y + y, seed)
+// (or the 3D / NegOneToOne form), bit for bit.
+//
+// With a JobSystem, grids larger than minCellsPerJob are split into row bands that workers fill in parallel; the call
+// blocks until they are done.
+//
+enum class NoiseGridRange
+{
+	ZERO_TO_ONE,
+	NEG_ONE_TO_ONE
+};
+
+void FillNoiseGrid2D(float* out_values, IntVec2 const& dims, IntVec2 const& firstIndex, unsigned int seed = 0,
+	NoiseGridRange range = NoiseGridRange::ZERO_TO_ONE, JobSystem* jobSystem = nullptr, int minCellsPerJob = 16384);
+void FillNoiseGrid3D(float* out_values, IntVec3 const& dims, IntVec3 const& firstIndex, unsigned int seed = 0,
+	NoiseGridRange range = NoiseGridRange::ZERO_TO_ONE, JobSystem* jobSystem = nullptr, int minCellsPerJob = 16384);
\ No newline at end of file
@@ -0,0 +1,53 @@
+//-----------------------------------------------------------------------------------------------
+// RawNoiseSimd.hpp
+//
+#pragma once
+#include "Engine/Math/RawNoise.hpp"
+#include "Engine/Math/SimdMath.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+// SIMD_WIDTH lanes of the RawNoise hashes at once. Each lane is bit-identical to the scalar
+//	Get*dNoiseUint of the same inputs (wrapping 32-bit arithmetic, same constants and shifts).
+//
+inline SimdInt SimdGet1dNoiseUint( SimdInt positionX, unsigned int seed=0 )
+{
+	SimdInt mangledBits = SimdIntMul( positionX, SimdIntSplat( (int) SQUIRREL4_BIT_NOISE1 ) );
+	mangledBits = SimdIntAdd( mangledBits, SimdIntSplat( (int) seed ) );
+	mangledBits = SimdIntXor( mangledBits, SimdIntShiftRight( mangledBits, 7 ) );
+	mangledBits = SimdIntAdd( mangledBits, SimdIntSplat( (int) SQUIRREL4_BIT_NOISE2 ) );
+	mangledBits = SimdIntXor( mangledBits, SimdIntShiftRight( mangledBits, 8 ) );
+	mangledBits = SimdIntMul( mangledBits, SimdIntSplat( (int) SQUIRREL4_BIT_NOISE3 ) );
+	mangledBits = SimdIntXor( mangledBits, SimdIntShiftRight( mangledBits, 11 ) );
+	return mangledBits;
+}
+
+//-----------------------------------------------------------------------------------------------
+inline SimdInt SimdGet2dNoiseUint( SimdInt indexX, SimdInt indexY, unsigned int seed=0 )
+{
+	SimdInt index = SimdIntAdd( indexX, SimdIntMul( indexY, SimdIntSplat( SQUIRREL4_PRIME1 ) ) );
+	return SimdGet1dNoiseUint( index, seed );
+}
+
+//-----------------------------------------------------------------------------------------------
+inline SimdInt SimdGet3dNoiseUint( SimdInt indexX, SimdInt indexY, SimdInt indexZ, unsigned int seed=0 )
+{
+	SimdInt index = SimdIntAdd( indexX, SimdIntMul( indexY, SimdIntSplat( SQUIRREL4_PRIME1 ) ) );
+	index = SimdIntAdd( index, SimdIntMul( indexZ, SimdIntSplat( SQUIRREL4_PRIME2 ) ) );
+	return SimdGet1dNoiseUint( index, seed );
+}
+
+//-----------------------------------------------------------------------------------------------
+// Hash lanes mapped to floats, bit-identical to Get*dNoiseZeroToOne / Get*dNoiseNegOneToOne
+//	(which convert through a double multiply).
+//
+inline SimdFloat SimdGetNoiseZeroToOne( SimdInt noiseBits )
+{
+	return SimdIntToFloatScaledByDouble( noiseBits, 1.0 / (double) 0xFFFFFFFF, true );
+}
+
+//-----------------------------------------------------------------------------------------------
+inline SimdFloat SimdGetNoiseNegOneToOne( SimdInt noiseBits )
+{
+	return SimdIntToFloatScaledByDouble( noiseBits, 1.0 / (double) 0x7FFFFFFF, false );
+}
\ No newline at end of file
@@ -0,0 +1,162 @@
+#pragma once
+#include <immintrin.h>
+
+//----------------------------------------------------------------------------------------------
+// Thin wrappers over SSE/AVX so batch kernels are written once. AVX builds (/arch:AVX) process
+// SIMD_WIDTH = 8 floats per step, everything else falls back to SSE and 4 floats per step.
+// Comparisons return all-ones lanes for true; SimdMoveMask packs one bit per lane.
+// SimdInt holds SIMD_WIDTH 32-bit integers with wrapping arithmetic. AVX2 builds use native 256-bit integer ops;
+// AVX-only builds split them into two SSE halves; SSE2 builds emulate the 32-bit low multiply.
+//
+#if defined(__AVX__)
+typedef __m256 SimdFloat;
+constexpr int SIMD_WIDTH = 8;
+inline SimdFloat SimdLoad(float const* values)					{ return _mm256_loadu_ps(values); }
+inline void SimdStore(float* out_values, SimdFloat a)			{ _mm256_storeu_ps(out_values, a); }
+inline SimdFloat SimdSplat(float value)							{ return _mm256_set1_ps(value); }
+inline SimdFloat SimdAdd(SimdFloat a, SimdFloat b)				{ return _mm256_add_ps(a, b); }
+inline SimdFloat SimdSub(SimdFloat a, SimdFloat b)				{ return _mm256_sub_ps(a, b); }
+inline SimdFloat SimdMul(SimdFloat a, SimdFloat b)				{ return _mm256_mul_ps(a, b); }
+inline SimdFloat SimdMin(SimdFloat a, SimdFloat b)				{ return _mm256_min_ps(a, b); }
+inline SimdFloat SimdMax(SimdFloat a, SimdFloat b)				{ return _mm256_max_ps(a, b); }
+inline SimdFloat SimdAnd(SimdFloat a, SimdFloat b)				{ return _mm256_and_ps(a, b); }
+inline SimdFloat SimdOr(SimdFloat a, SimdFloat b)				{ return _mm256_or_ps(a, b); }
+inline SimdFloat SimdLessEqual(SimdFloat a, SimdFloat b)		{ return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+inline SimdFloat SimdLess(SimdFloat a, SimdFloat b)				{ return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+inline unsigned int SimdMoveMask(SimdFloat a)					{ return (unsigned int)_mm256_movemask_ps(a); }
+#else
+typedef __m128 SimdFloat;
+constexpr int SIMD_WIDTH = 4;
+inline SimdFloat SimdLoad(float const* values)					{ return _mm_loadu_ps(values); }
+inline void SimdStore(float* out_values, SimdFloat a)			{ _mm_storeu_ps(out_values, a); }
+inline SimdFloat SimdSplat(float value)							{ return _mm_set1_ps(value); }
+inline SimdFloat SimdAdd(SimdFloat a, SimdFloat b)				{ return _mm_add_ps(a, b); }
+inline SimdFloat SimdSub(SimdFloat a, SimdFloat b)				{ return _mm_sub_ps(a, b); }
+inline SimdFloat SimdMul(SimdFloat a, SimdFloat b)				{ return _mm_mul_ps(a, b); }
+inline SimdFloat SimdMin(SimdFloat a, SimdFloat b)				{ return _mm_min_ps(a, b); }
+inline SimdFloat SimdMax(SimdFloat a, SimdFloat b)				{ return _mm_max_ps(a, b); }
+inline SimdFloat SimdAnd(SimdFloat a, SimdFloat b)				{ return _mm_and_ps(a, b); }
+inline SimdFloat SimdOr(SimdFloat a, SimdFloat b)				{ return _mm_or_ps(a, b); }
+inline SimdFloat SimdLessEqual(SimdFloat a, SimdFloat b)		{ return _mm_cmple_ps(a, b); }
+inline SimdFloat SimdLess(SimdFloat a, SimdFloat b)				{ return _mm_cmplt_ps(a, b); }
+inline unsigned int SimdMoveMask(SimdFloat a)					{ return (unsigned int)_mm_movemask_ps(a); }
+#endif
+
+//----------------------------------------------------------------------------------------------
+#if defined(__AVX2__)
+typedef __m256i SimdInt;
+inline SimdInt SimdIntSplat(int value)							{ return _mm256_set1_epi32(value); }
+inline SimdInt SimdIntLaneIndices()								{ return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7); }
+inline SimdInt SimdIntLoad(int const* values)					{ return _mm256_loadu_si256((__m256i const*)values); }
+inline void SimdIntStore(int* out_values, SimdInt a)			{ _mm256_storeu_si256((__m256i*)out_values, a); }
+inline SimdInt SimdIntAdd(SimdInt a, SimdInt b)					{ return _mm256_add_epi32(a, b); }
+inline SimdInt SimdIntSub(SimdInt a, SimdInt b)					{ return _mm256_sub_epi32(a, b); }
+inline SimdInt SimdIntMul(SimdInt a, SimdInt b)					{ return _mm256_mullo_epi32(a, b); }
+inline SimdInt SimdIntAnd(SimdInt a, SimdInt b)					{ return _mm256_and_si256(a, b); }
+inline SimdInt SimdIntOr(SimdInt a, SimdInt b)					{ return _mm256_or_si256(a, b); }
+inline SimdInt SimdIntXor(SimdInt a, SimdInt b)					{ return _mm256_xor_si256(a, b); }
+inline SimdInt SimdIntShiftLeft(SimdInt a, int count)			{ return _mm256_sll_epi32(a, _mm_cvtsi32_si128(count)); }
+inline SimdInt SimdIntShiftRight(SimdInt a, int count)			{ return _mm256_srl_epi32(a, _mm_cvtsi32_si128(count)); }	// logical
+inline SimdInt SimdIntEqual(SimdInt a, SimdInt b)				{ return _mm256_cmpeq_epi32(a, b); }
+inline SimdInt SimdIntGreater(SimdInt a, SimdInt b)				{ return _mm256_cmpgt_epi32(a, b); }	// signed
+#elif defined(__AVX__)
+typedef __m256i SimdInt;
+inline __m128i SimdIntLow(SimdInt a)							{ return _mm256_castsi256_si128(a); }
+inline __m128i SimdIntHigh(SimdInt a)							{ return _mm256_extractf128_si256(a, 1); }
+inline SimdInt SimdIntCombine(__m128i low, __m128i high)		{ return _mm256_insertf128_si256(_mm256_castsi128_si256(low), high, 1); }
+inline SimdInt SimdIntSplat(int value)							{ return _mm256_set1_epi32(value); }
+inline SimdInt SimdIntLaneIndices()								{ return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7); }
+inline SimdInt SimdIntLoad(int const* values)					{ return _mm256_loadu_si256((__m256i const*)values); }
+inline void SimdIntStore(int* out_values, SimdInt a)			{ _mm256_storeu_si256((__m256i*)out_values, a); }
+inline SimdInt SimdIntAdd(SimdInt a, SimdInt b)					{ return SimdIntCombine(_mm_add_epi32(SimdIntLow(a), SimdIntLow(b)), _mm_add_epi32(SimdIntHigh(a), SimdIntHigh(b))); }
+inline SimdInt SimdIntSub(SimdInt a, SimdInt b)					{ return SimdIntCombine(_mm_sub_epi32(SimdIntLow(a), SimdIntLow(b)), _mm_sub_epi32(SimdIntHigh(a), SimdIntHigh(b))); }
+inline SimdInt SimdIntMul(SimdInt a, SimdInt b)					{ return SimdIntCombine(_mm_mullo_epi32(SimdIntLow(a), SimdIntLow(b)), _mm_mullo_epi32(SimdIntHigh(a), SimdIntHigh(b))); }
+inline SimdInt SimdIntAnd(SimdInt a, SimdInt b)					{ return _mm256_castps_si256(_mm256_and_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b))); }
+inline SimdInt SimdIntOr(SimdInt a, SimdInt b)					{ return _mm256_castps_si256(_mm256_or_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b))); }
+inline SimdInt SimdIntXor(SimdInt a, SimdInt b)					{ return _mm256_castps_si256(_mm256_xor_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b))); }
+inline SimdInt SimdIntShiftLeft(SimdInt a, int count)			{ __m128i c = _mm_cvtsi32_si128(count); return SimdIntCombine(_mm_sll_epi32(SimdIntLow(a), c), _mm_sll_epi32(SimdIntHigh(a), c)); }
+inline SimdInt SimdIntShiftRight(SimdInt a, int count)			{ __m128i c = _mm_cvtsi32_si128(count); return SimdIntCombine(_mm_srl_epi32(SimdIntLow(a), c), _mm_srl_epi32(SimdIntHigh(a), c)); }
+inline SimdInt SimdIntEqual(SimdInt a, SimdInt b)				{ return SimdIntCombine(_mm_cmpeq_epi32(SimdIntLow(a), SimdIntLow(b)), _mm_cmpeq_epi32(SimdIntHigh(a), SimdIntHigh(b))); }
+inline SimdInt SimdIntGreater(SimdInt a, SimdInt b)				{ return SimdIntCombine(_mm_cmpgt_epi32(SimdIntLow(a), SimdIntLow(b)), _mm_cmpgt_epi32(SimdIntHigh(a), SimdIntHigh(b))); }
+#else
+typedef __m128i SimdInt;
+inline SimdInt SimdIntSplat(int value)							{ return _mm_set1_epi32(value); }
+inline SimdInt SimdIntLaneIndices()								{ return _mm_setr_epi32(0, 1, 2, 3); }
+inline SimdInt SimdIntLoad(int const* values)					{ return _mm_loadu_si128((__m128i const*)values); }
+inline void SimdIntStore(int* out_values, SimdInt a)			{ _mm_storeu_si128((__m128i*)out_values, a); }
+inline SimdInt SimdIntAdd(SimdInt a, SimdInt b)					{ return _mm_add_epi32(a, b); }
+inline SimdInt SimdIntSub(SimdInt a, SimdInt b)					{ return _mm_sub_epi32(a, b); }
+inline SimdInt SimdIntMul(SimdInt a, SimdInt b)
+{
+	// SSE2 has no 32-bit low multiply: multiply the even and odd lanes as 64-bit products and keep the low halves
+	__m128i evenProducts = _mm_mul_epu32(a, b);
+	__m128i oddProducts = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(evenProducts, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(oddProducts, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+inline SimdInt SimdIntAnd(SimdInt a, SimdInt b)					{ return _mm_and_si128(a, b); }
+inline SimdInt SimdIntOr(SimdInt a, SimdInt b)					{ return _mm_or_si128(a, b); }
+inline SimdInt SimdIntXor(SimdInt a, SimdInt b)					{ return _mm_xor_si128(a, b); }
+inline SimdInt SimdIntShiftLeft(SimdInt a, int count)			{ return _mm_sll_epi32(a, _mm_cvtsi32_si128(count)); }
+inline SimdInt SimdIntShiftRight(SimdInt a, int count)			{ return _mm_srl_epi32(a, _mm_cvtsi32_si128(count)); }	// logical
+inline SimdInt SimdIntEqual(SimdInt a, SimdInt b)				{ return _mm_cmpeq_epi32(a, b); }
+inline SimdInt SimdIntGreater(SimdInt a, SimdInt b)				{ return _mm_cmpgt_epi32(a, b); }	// signed
+#endif
+
+//----------------------------------------------------------------------------------------------
+// Conversions and lane selects shared by every width
+#if defined(__AVX__)
+inline SimdFloat SimdIntToFloat(SimdInt a)						{ return _mm256_cvtepi32_ps(a); }
+inline SimdInt SimdFloatToIntTruncate(SimdFloat a)				{ return _mm256_cvttps_epi32(a); }
+inline SimdFloat SimdCastIntToFloat(SimdInt a)					{ return _mm256_castsi256_ps(a); }
+inline SimdInt SimdCastFloatToInt(SimdFloat a)					{ return _mm256_castps_si256(a); }
+inline SimdFloat SimdSelect(SimdFloat mask, SimdFloat ifTrue, SimdFloat ifFalse)	{ return _mm256_blendv_ps(ifFalse, ifTrue, mask); }
+#else
+inline SimdFloat SimdIntToFloat(SimdInt a)						{ return _mm_cvtepi32_ps(a); }
+inline SimdInt SimdFloatToIntTruncate(SimdFloat a)				{ return _mm_cvttps_epi32(a); }
+inline SimdFloat SimdCastIntToFloat(SimdInt a)					{ return _mm_castsi128_ps(a); }
+inline SimdInt SimdCastFloatToInt(SimdFloat a)					{ return _mm_castps_si128(a); }
+inline SimdFloat SimdSelect(SimdFloat mask, SimdFloat ifTrue, SimdFloat ifFalse)	{ return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse)); }
+#endif
+inline SimdInt SimdIntSelect(SimdInt mask, SimdInt ifTrue, SimdInt ifFalse)
+{
+	return SimdCastFloatToInt(SimdSelect(SimdCastIntToFloat(mask), SimdCastIntToFloat(ifTrue), SimdCastIntToFloat(ifFalse)));
+}
+
+//----------------------------------------------------------------------------------------------
+// (float)(scale * (double)lane) per lane, lanes read as unsigned when asked; rounds twice exactly like that scalar
+// expression, so results match it bit for bit
+#if defined(__AVX__)
+inline __m128 SimdIntHalfToFloatScaledByDouble(__m128i half, double scale, bool isUnsigned)
+{
+	__m256d values = _mm256_cvtepi32_pd(half);
+	if (isUnsigned)
+	{
+		__m256d isNegative = _mm256_cmp_pd(values, _mm256_setzero_pd(), _CMP_LT_OQ);
+		values = _mm256_add_pd(values, _mm256_and_pd(isNegative, _mm256_set1_pd(4294967296.0)));
+	}
+	return _mm256_cvtpd_ps(_mm256_mul_pd(_mm256_set1_pd(scale), values));
+}
+inline SimdFloat SimdIntToFloatScaledByDouble(SimdInt a, double scale, bool isUnsigned)
+{
+	__m128 low = SimdIntHalfToFloatScaledByDouble(_mm256_castsi256_si128(a), scale, isUnsigned);
+	__m128 high = SimdIntHalfToFloatScaledByDouble(_mm256_extractf128_si256(a, 1), scale, isUnsigned);
+	return _mm256_insertf128_ps(_mm256_castps128_ps256(low), high, 1);
+}
+#else
+inline __m128 SimdIntPairToFloatScaledByDouble(__m128i pair, double scale, bool isUnsigned)
+{
+	__m128d values = _mm_cvtepi32_pd(pair);
+	if (isUnsigned)
+	{
+		__m128d isNegative = _mm_cmplt_pd(values, _mm_setzero_pd());
+		values = _mm_add_pd(values, _mm_and_pd(isNegative, _mm_set1_pd(4294967296.0)));
+	}
+	return _mm_cvtpd_ps(_mm_mul_pd(_mm_set1_pd(scale), values));
+}
+inline SimdFloat SimdIntToFloatScaledByDouble(SimdInt a, double scale, bool isUnsigned)
+{
+	__m128 low = SimdIntPairToFloatScaledByDouble(a, scale, isUnsigned);
+	__m128 high = SimdIntPairToFloatScaledByDouble(_mm_shuffle_epi32(a, _MM_SHUFFLE(1, 0, 3, 2)), scale, isUnsigned);
+	return _mm_movelh_ps(low, high);
+}
+#endif
\ No newline at end of file
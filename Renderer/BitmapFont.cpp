@@ -1,5 +1,6 @@
 #include "Engine/Renderer/BitmapFont.hpp"
 #include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Core/VertexWriter.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 
 BitmapFont::BitmapFont(char const* fontFilePathNameWithNoExtension, Texture& fontTexture)
@@ -15,6 +16,12 @@ Texture& BitmapFont::GetTexture()
 }
 
 void BitmapFont::AddVertsForText2D(std::vector<Vertex_PCU>& vertexArray, Vec2 const& textMins, float cellHeight, std::string const& text, Rgba8 const& tint /*= Rgba8::WHITE*/, float cellAspect /*= 1.f*/)
+{
+	VertexWriter writer(vertexArray, GetNumVertsForText2D(text));
+	AddVertsForText2D(writer, textMins, cellHeight, text, tint, cellAspect);
+}
+
+void BitmapFont::AddVertsForText2D(VertexWriter& writer, Vec2 const& textMins, float cellHeight, std::string const& text, Rgba8 const& tint /*= Rgba8::WHITE*/, float cellAspect /*= 1.f*/)
 {
 	Vec2 cursor = textMins;
 
@@ -24,11 +31,16 @@ void BitmapFont::AddVertsForText2D(std::vector<Vertex_PCU>& vertexArray, Vec2 co
 		SpriteDefKKK.GetUVs(uvMins, uvMaxs);
 		float glyphWidth = cellHeight * GetGlyphAspect(c) * cellAspect;
 		AABB2 bounds(Vec2(cursor.x, cursor.y), Vec2(cursor.x + glyphWidth, cursor.y + cellHeight));
-		AddVertsForAABB2D(vertexArray, bounds, tint, uvMins, uvMaxs);
+		AddVertsForAABB2D(writer, bounds, tint, uvMins, uvMaxs);
 		cursor.x += glyphWidth;
 	}
 }
 
+int BitmapFont::GetNumVertsForText2D(std::string const& text) const
+{
+	return static_cast<int>(text.size()) * GetNumVertsForAABB2D();
+}
+
 float BitmapFont::GetTextWidth(float cellHeight, std::string const& text, float cellAspect /*= 1.f*/)
 {
 	float totalWidth = 0.0f;
@@ -79,7 +91,8 @@ void BitmapFont::AddVertsForTextInBox2D(std::vector<Vertex_PCU>& vertexArray, AA
 	Vec2 textOffsetFromMins = extraSpace * alignment;
 	Vec2 textMins = box.m_mins + textOffsetFromMins;
 
-	// Print each line
+	// Print each line, growing the vertex array once for every glyph that can be drawn
+	vertexArray.reserve(vertexArray.size() + std::min(static_cast<size_t>(maxGlyphsToDraw), text.size()) * GetNumVertsForAABB2D());
 	int totalGlyphsDrawn = 0;
 	for (int lineIndex = 0; lineIndex < numLines && totalGlyphsDrawn < maxGlyphsToDraw; ++lineIndex) {
 		std::string lineToDraw = textLines[lineIndex];
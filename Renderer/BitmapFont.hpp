@@ -4,6 +4,8 @@
 #include "Engine/Renderer/SpriteSheet.hpp"
 #include <vector>
 
+class VertexWriter;
+
 enum TextBoxMode
 {
 	SHRINK,
@@ -21,6 +23,8 @@ public:
 	Texture& GetTexture();
 
 	void AddVertsForText2D(std::vector<Vertex_PCU>& vertexArray, Vec2 const& textMins, float cellHeight, std::string const& text, Rgba8 const& tint = Rgba8::WHITE, float cellAspect = 1.f);
+	void AddVertsForText2D(VertexWriter& writer, Vec2 const& textMins, float cellHeight, std::string const& text, Rgba8 const& tint = Rgba8::WHITE, float cellAspect = 1.f);
+	int GetNumVertsForText2D(std::string const& text) const;
 	float GetTextWidth(float cellHeight, std::string const& text, float cellAspect = 1.f);
 	void AddVertsForTextInBox2D(std::vector<Vertex_PCU>& vertexArray, AABB2 const& box, float cellHeight,
 		std::string const& text, Rgba8 const& tint = Rgba8::WHITE, float cellAspect = 1.f,
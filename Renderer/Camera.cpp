@@ -103,6 +103,13 @@ Mat44 Camera::GetViewMatrix() const
 	return viewMatrix.GetOrthonormalInverse();
 }
 
+Frustum Camera::GetFrustum() const
+{
+	Mat44 viewProjection = GetProjectionMatrix();
+	viewProjection.Append(GetViewMatrix());
+	return Frustum(viewProjection);
+}
+
 Mat44 Camera::GetModelMatrix() const
 {
 	Mat44 modelMatrix;
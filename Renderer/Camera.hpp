@@ -3,6 +3,7 @@
 #include "Engine/Math/Mat44.hpp"
 #include "Engine/Math/EulerAngles.hpp"
 #include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/Frustum.hpp"
 
 class Camera
 {
@@ -34,6 +35,7 @@ public:
 	Mat44 GetOrthographicMatrix() const;
 	Mat44 GetPerspectiveMatrix() const;
 	Mat44 GetProjectionMatrix() const;
+	Frustum GetFrustum() const; // world-space frustum from projection * view
 
 	void SetViewport(Vec2 const& min, Vec2 const& max);
 
@@ -1,8 +1,11 @@
 #include "Engine/Renderer/ConstantBuffer.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Game/EngineBuildPreferences.hpp"
+#if !defined( ENGINE_NULL_RENDERER )
 #include <d3d11.h>
 #include <d3dcompiler.h>
 #include <dxgi.h>
-#include "Engine/Renderer/Renderer.hpp"
+#endif
 
 ConstantBuffer::ConstantBuffer(size_t size)
 	:m_size(size)
@@ -12,6 +15,8 @@ ConstantBuffer::ConstantBuffer(size_t size)
 
 ConstantBuffer::~ConstantBuffer()
 {
+#if !defined( ENGINE_NULL_RENDERER )
 	DX_SAFE_RELEASE(m_buffer);
+#endif
 }
 
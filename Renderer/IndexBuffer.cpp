@@ -1,8 +1,11 @@
 #include "Engine/Renderer/IndexBuffer.hpp"
 #include "Engine/Renderer/Renderer.hpp"
+#include "Game/EngineBuildPreferences.hpp"
+#if !defined( ENGINE_NULL_RENDERER )
 #include <d3d11.h>
 #include <d3dcompiler.h>
 #include <dxgi.h>
+#endif
 
 IndexBuffer::IndexBuffer(unsigned int size)
 	:m_size(size)
@@ -12,7 +15,9 @@ IndexBuffer::IndexBuffer(unsigned int size)
 
 IndexBuffer::~IndexBuffer()
 {
+#if !defined( ENGINE_NULL_RENDERER )
 	DX_SAFE_RELEASE(m_buffer);
+#endif
 }
 
 unsigned int IndexBuffer::GetSize()
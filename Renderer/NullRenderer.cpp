@@ -0,0 +1,456 @@
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include <algorithm>
+
+//-----------------------------------------------------------------------------------------------
+// The null backend: every Renderer call is accepted and does no more than book-keeping, so the simulation,
+//	DebugRenderer and DevConsole run with no GPU, window or graphics API (dedicated servers, CI on Linux).
+//	Turn it on by #defining ENGINE_NULL_RENDERER in your game's Code/Game/EngineBuildPreferences.hpp file.
+//
+// Draws, uploads, binds and state switches are counted in RenderStats exactly as the D3D11 backend counts them,
+//	so headless benchmarks and soak tests see the same draw load. Textures, shaders and buffers are real objects
+//	with names and sizes but own no GPU memory; nothing touches the disk, so a server needs no art or shader files.
+//
+#include "Game/EngineBuildPreferences.hpp"
+#if defined( ENGINE_NULL_RENDERER )
+
+
+Renderer::Renderer(RenderConfig const& config)
+	:m_config( config )
+{
+
+}
+
+Renderer::~Renderer()
+{
+
+}
+
+void Renderer::Startup()
+{
+	m_currentShader = CreateShader("Default", "");
+	m_defaultShader = m_currentShader;
+	BindShader(m_currentShader);
+
+	m_immediateVBO = CreateVertexBuffer(sizeof(Vertex_PCU));
+	m_immediateVBO_VertexPCUTBN = CreateVertexBuffer(sizeof(Vertex_PCUTBN));
+	m_immediateIBO = CreateIndexBuffer(sizeof(16));
+	m_cameraCBO = CreateConstantBuffer(sizeof(CameraConstants));
+	m_modelCBO = CreateConstantBuffer(sizeof(ModelConstants));
+	m_lightCBO = CreateConstantBuffer(sizeof(LightConstants));
+
+	Image defaultImage(IntVec2(2, 2), Rgba8::WHITE);
+	Texture* whiteTexture = CreateTextureFromImage(defaultImage);
+	whiteTexture->m_name = "Default";
+	m_defaultTexture = whiteTexture;
+	BindTexture(m_defaultTexture);
+
+	SetModelConstants();
+}
+
+void Renderer::BeginFrame()
+{
+}
+
+void Renderer::EndFrame()
+{
+	FinishFrameStats();
+}
+
+void Renderer::Shutdown()
+{
+	for (Shader* shader : m_loadedShaders)
+	{
+		delete shader;
+	}
+	m_loadedShaders.clear();
+
+	for (Texture* texture : m_loadedTextures)
+	{
+		delete texture;
+	}
+	m_loadedTextures.clear();
+
+	for (BitmapFont* bitmapFont : m_loadedFonts)
+	{
+		delete bitmapFont;
+	}
+	m_loadedFonts.clear();
+
+	delete m_immediateVBO;
+	m_immediateVBO = nullptr;
+	delete m_immediateVBO_VertexPCUTBN;
+	m_immediateVBO_VertexPCUTBN = nullptr;
+	delete m_immediateIBO;
+	m_immediateIBO = nullptr;
+	delete m_commandVBO;
+	m_commandVBO = nullptr;
+	delete m_commandVBO_VertexPCUTBN;
+	m_commandVBO_VertexPCUTBN = nullptr;
+	delete m_cameraCBO;
+	m_cameraCBO = nullptr;
+	delete m_modelCBO;
+	m_modelCBO = nullptr;
+	delete m_lightCBO;
+	m_lightCBO = nullptr;
+	m_mappedScratch.clear();
+	m_mappedScratch.shrink_to_fit();
+}
+
+void Renderer::ClearScreen(const Rgba8 clearColor)
+{
+	UNUSED(clearColor);
+}
+
+void Renderer::BeginCamera(Camera& camera)
+{
+	UNUSED(camera);
+	m_frameStats.m_numBytesUploaded += sizeof(CameraConstants);
+	++m_frameStats.m_numCameras;
+}
+
+void Renderer::EndCamera(const Camera& camera)
+{
+	UNUSED(camera);
+}
+
+//-----------------------------------------------------------------------------------------------
+void Renderer::DrawVertexArray(int numVertexes, const Vertex_PCU* Vertexes)
+{
+	CopyCPUToGPU(Vertexes, numVertexes * sizeof(Vertex_PCU), m_immediateVBO);
+	SetStatesIfChanges();
+	DrawVertexBuffer(m_immediateVBO, numVertexes, VertexType::Vertex_PCU);
+}
+
+void Renderer::DrawVertexArray(int numVertexes, const Vertex_PCU* Vertexes, int numIndices, const unsigned int* indices)
+{
+	CopyCPUToGPU(Vertexes, numVertexes * sizeof(Vertex_PCU), m_immediateVBO);
+	CopyCPUToGPU(indices, numIndices * sizeof(unsigned int), m_immediateIBO);
+	SetStatesIfChanges();
+	DrawIndexBuffer(m_immediateIBO, numIndices, VertexType::Vertex_PCU, m_immediateVBO);
+}
+
+void Renderer::DrawVertexArray(int numVertexes, const Vertex_PCUTBN* Vertexes, int numIndices, const unsigned int* indices)
+{
+	CopyCPUToGPU(Vertexes, numVertexes * sizeof(Vertex_PCUTBN), m_immediateVBO);
+	CopyCPUToGPU(indices, numIndices * sizeof(unsigned int), m_immediateIBO);
+	SetStatesIfChanges();
+	DrawIndexBuffer(m_immediateIBO, numIndices, VertexType::Vertex_PCUTBN, m_immediateVBO);
+}
+
+void Renderer::DrawVertexArray(int numVertexes, Vertex_PCUTBN const* vertexes)
+{
+	CopyCPUToGPU(vertexes, (size_t)numVertexes * sizeof(Vertex_PCUTBN), m_immediateVBO_VertexPCUTBN);
+	SetStatesIfChanges();
+	DrawVertexBuffer(m_immediateVBO_VertexPCUTBN, numVertexes, VertexType::Vertex_PCUTBN);
+}
+
+//-----------------------------------------------------------------------------------------------
+Texture* Renderer::GetTextureForFileName(char const* imageFilePath)
+{
+	for (Texture* texture : m_loadedTextures)
+	{
+		if (texture != nullptr && texture->m_name == imageFilePath)
+		{
+			return texture;
+		}
+	}
+	return nullptr;
+}
+
+Texture* Renderer::CreateOrGetTextureFromFile(char const* imageFilePath)
+{
+	Texture* existingTexture = GetTextureForFileName(imageFilePath);
+	if (existingTexture)
+	{
+		return existingTexture;
+	}
+	return CreateTextureFromFile(imageFilePath);
+}
+
+// The file is not read, so its dimensions are unknown and left at zero
+Texture* Renderer::CreateTextureFromFile(char const* imageFilePath)
+{
+	Texture* newTexture = new Texture();
+	newTexture->m_name = imageFilePath;
+	m_loadedTextures.push_back(newTexture);
+	return newTexture;
+}
+
+Texture* Renderer::CreateTextureFromImage(const Image& image)
+{
+	Texture* existingTexture = GetTextureForFileName(image.GetImageFilePath().c_str());
+	if (existingTexture) {
+		return existingTexture;
+	}
+
+	Texture* newTexture = new Texture();
+	newTexture->m_name = image.GetImageFilePath();
+	newTexture->m_dimensions = image.GetDimensions();
+	m_loadedTextures.push_back(newTexture);
+	return newTexture;
+}
+
+Texture* Renderer::CreateTextureFromData(char const* name, IntVec2 dimensions, int bytesPerTexel, uint8_t* texelData)
+{
+	GUARANTEE_OR_DIE(texelData, Stringf("CreateTextureFromData failed for \"%s\" - texelData was null!", name));
+	GUARANTEE_OR_DIE(bytesPerTexel >= 3 && bytesPerTexel <= 4, Stringf("CreateTextureFromData failed for \"%s\" - unsupported BPP=%i (must be 3 or 4)", name, bytesPerTexel));
+	GUARANTEE_OR_DIE(dimensions.x > 0 && dimensions.y > 0, Stringf("CreateTextureFromData failed for \"%s\" - illegal texture dimensions (%i x %i)", name, dimensions.x, dimensions.y));
+
+	Texture* newTexture = new Texture();
+	newTexture->m_name = name;
+	newTexture->m_dimensions = dimensions;
+	m_loadedTextures.push_back(newTexture);
+	return newTexture;
+}
+
+Texture* Renderer::CreateDynamicTexture(char const* name, IntVec2 dimensions)
+{
+	GUARANTEE_OR_DIE(dimensions.x > 0 && dimensions.y > 0, Stringf("CreateDynamicTexture failed for \"%s\" - illegal texture dimensions (%i x %i)", name, dimensions.x, dimensions.y));
+
+	Texture* newTexture = new Texture();
+	newTexture->m_name = name;
+	newTexture->m_dimensions = dimensions;
+	m_loadedTextures.push_back(newTexture);
+	return newTexture;
+}
+
+void Renderer::UpdateTextureTexels(Texture* texture, Rgba8 const* texels, int firstRow, int numRows)
+{
+	UNUSED(texels);
+	IntVec2 dimensions = texture->GetDimensions();
+	GUARANTEE_OR_DIE(firstRow >= 0 && numRows >= 0 && firstRow + numRows <= dimensions.y, Stringf("UpdateTextureTexels rows %i..%i are outside \"%s\"", firstRow, firstRow + numRows - 1, texture->m_name.c_str()));
+	m_frameStats.m_numBytesUploaded += (size_t)dimensions.x * sizeof(Rgba8) * numRows;
+}
+
+void Renderer::DestroyTexture(Texture* texture)
+{
+	auto found = std::find(m_loadedTextures.begin(), m_loadedTextures.end(), texture);
+	if (found != m_loadedTextures.end())
+	{
+		m_loadedTextures.erase(found);
+		delete texture;
+	}
+}
+
+BitmapFont* Renderer::CreateOrGetBitmapFont(const char* bitmapFontFilePathWithNoExtension)
+{
+	for (BitmapFont* font : m_loadedFonts)
+	{
+		if (font != nullptr && font->m_fontFilePathNameWithNoExtension == bitmapFontFilePathWithNoExtension)
+		{
+			return font;
+		}
+	}
+
+	BitmapFont* newFont = CreateBitmapFontFromFile(bitmapFontFilePathWithNoExtension);
+	m_loadedFonts.push_back(newFont);
+	return newFont;
+}
+
+BitmapFont* Renderer::CreateBitmapFontFromFile(const char* bitmapFontFilePathWithNoExtension)
+{
+	std::string fontTexturePath = std::string(bitmapFontFilePathWithNoExtension) + ".png";
+	Texture* fontTexture = CreateOrGetTextureFromFile(fontTexturePath.c_str());
+	return new BitmapFont(bitmapFontFilePathWithNoExtension, *fontTexture);
+}
+
+void Renderer::BindTexture(const Texture* texture)
+{
+	UNUSED(texture);
+	++m_frameStats.m_numTextureBinds;
+}
+
+//-----------------------------------------------------------------------------------------------
+Shader* Renderer::CreateShader(char const* shaderName, char const* shaderSource, VertexType type /*= VertexType::Vertex_PCU*/)
+{
+	UNUSED(shaderSource);
+	UNUSED(type);
+	ShaderConfig shaderConfig;
+	shaderConfig.m_name = shaderName;
+	Shader* shader = new Shader(shaderConfig);
+	m_loadedShaders.push_back(shader);
+	return shader;
+}
+
+Shader* Renderer::CreateShader(char const* shaderName, VertexType type)
+{
+	return CreateShader(shaderName, "", type);
+}
+
+bool Renderer::CompileShaderToByteCode(std::vector<unsigned char>& outByteCode, char const* name, char const* source, char const* entryPoint, char const* target)
+{
+	UNUSED(name);
+	UNUSED(source);
+	UNUSED(entryPoint);
+	UNUSED(target);
+	outByteCode.clear();
+	return true;
+}
+
+void Renderer::BindShader(Shader* shader)
+{
+	++m_frameStats.m_numShaderBinds;
+	m_currentShader = shader != nullptr ? shader : m_defaultShader;
+}
+
+//-----------------------------------------------------------------------------------------------
+VertexBuffer* Renderer::CreateVertexBuffer(const size_t size)
+{
+	return new VertexBuffer(size);
+}
+
+void Renderer::CopyCPUToGPU(const void* data, size_t size, VertexBuffer*& vbo)
+{
+	UNUSED(data);
+	MapVertexBuffer(vbo, size);
+	UnmapVertexBuffer(vbo);
+}
+
+// Callers build straight into the returned memory, so it has to be real; all buffers share it and it is never read
+void* Renderer::MapVertexBuffer(VertexBuffer*& vbo, size_t size)
+{
+	if (vbo->m_size < size)
+	{
+		delete vbo;
+		vbo = CreateVertexBuffer(size);
+	}
+	if (m_mappedScratch.size() < size)
+	{
+		m_mappedScratch.resize(size);
+	}
+	m_frameStats.m_numBytesUploaded += size;
+	return m_mappedScratch.data();
+}
+
+void Renderer::UnmapVertexBuffer(VertexBuffer* vbo)
+{
+	UNUSED(vbo);
+}
+
+void Renderer::BindVertexBuffer(VertexBuffer* vbo, VertexType type)
+{
+	UNUSED(vbo);
+	UNUSED(type);
+}
+
+void Renderer::DrawVertexBuffer(VertexBuffer* vbo, int vertexCount, VertexType type, int vertexOffset /*= 0*/)
+{
+	UNUSED(vbo);
+	UNUSED(type);
+	UNUSED(vertexOffset);
+	++m_frameStats.m_numDrawCalls;
+	m_frameStats.m_numVertexesDrawn += vertexCount;
+}
+
+IndexBuffer* Renderer::CreateIndexBuffer(const size_t size)
+{
+	return new IndexBuffer((unsigned int)size);
+}
+
+void Renderer::CopyCPUToGPU(const void* data, size_t size, IndexBuffer*& ibo)
+{
+	UNUSED(data);
+	if (ibo->m_size < size)
+	{
+		delete ibo;
+		ibo = CreateIndexBuffer(size);
+	}
+	m_frameStats.m_numBytesUploaded += size;
+}
+
+void Renderer::BindIndexBuffer(IndexBuffer* ibo)
+{
+	UNUSED(ibo);
+}
+
+void Renderer::DrawIndexBuffer(IndexBuffer* ibo, int indexCount, VertexType type, VertexBuffer* vbo)
+{
+	UNUSED(ibo);
+	UNUSED(type);
+	UNUSED(vbo);
+	++m_frameStats.m_numDrawCalls;
+	m_frameStats.m_numIndexesDrawn += indexCount;
+}
+
+ConstantBuffer* Renderer::CreateConstantBuffer(const size_t size)
+{
+	return new ConstantBuffer(size);
+}
+
+void Renderer::CopyCPUToGPU(const void* data, size_t size, ConstantBuffer*& cbo)
+{
+	UNUSED(data);
+	UNUSED(cbo);
+	m_frameStats.m_numBytesUploaded += size;
+}
+
+void Renderer::BindConstantBuffer(int slot, ConstantBuffer* cbo)
+{
+	UNUSED(slot);
+	UNUSED(cbo);
+}
+
+//-----------------------------------------------------------------------------------------------
+void Renderer::SetStatesIfChanges()
+{
+	if (m_appliedBlendMode != m_desiredBlendMode)
+	{
+		m_appliedBlendMode = m_desiredBlendMode;
+		++m_frameStats.m_numStateChanges;
+	}
+	if (m_appliedSamplerMode != m_desiredSamplerMode)
+	{
+		m_appliedSamplerMode = m_desiredSamplerMode;
+		++m_frameStats.m_numStateChanges;
+	}
+	if (m_appliedRasterizerMode != m_desiredRasterizerMode)
+	{
+		m_appliedRasterizerMode = m_desiredRasterizerMode;
+		++m_frameStats.m_numStateChanges;
+	}
+	if (m_appliedDepthMode != m_desiredDepthMode)
+	{
+		m_appliedDepthMode = m_desiredDepthMode;
+		++m_frameStats.m_numStateChanges;
+	}
+}
+
+void Renderer::SetBlendMode(BlendMode blendMode)
+{
+	m_desiredBlendMode = blendMode;
+}
+
+void Renderer::SetSamplerMode(SamplerMode samplerMode)
+{
+	m_desiredSamplerMode = samplerMode;
+}
+
+void Renderer::SetRasterizerMode(RasterizerMode mode)
+{
+	m_desiredRasterizerMode = mode;
+}
+
+void Renderer::SetDepthMode(DepthMode mode)
+{
+	m_desiredDepthMode = mode;
+}
+
+void Renderer::SetModelConstants(const Mat44& modelMatrix /*= Mat44()*/, const Rgba8& modelColor /*= Rgba8::WHITE*/)
+{
+	UNUSED(modelMatrix);
+	UNUSED(modelColor);
+	m_frameStats.m_numBytesUploaded += m_modelCBO->m_size;
+}
+
+void Renderer::SetLightConstants(Vec3 sunDirection /*= Vec3(2, 1, -1)*/, float sunIntensity /*= 0.85f*/, float ambientIntensity /*= 0.35f*/)
+{
+	UNUSED(sunDirection);
+	UNUSED(sunIntensity);
+	UNUSED(ambientIntensity);
+	m_frameStats.m_numBytesUploaded += m_lightCBO->m_size;
+}
+
+#endif // defined( ENGINE_NULL_RENDERER )
\ No newline at end of file
@@ -0,0 +1,340 @@
+#include "Engine/Renderer/RenderCommandBuffer.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include <algorithm>
+#include <cstring>
+
+//----------------------------------------------------------------------------------------------
+RenderCommandBuffer::RenderCommandBuffer(uint64_t sortKey)
+	: m_sortKey(sortKey)
+{
+}
+
+void RenderCommandBuffer::Reset()
+{
+	m_commands.clear();
+	m_vertexes.clear();
+	m_vertexesPCUTBN.clear();
+	m_indexedVertexes.clear();
+	m_indexedVertexesPCUTBN.clear();
+	m_indexes.clear();
+	m_modelConstants.clear();
+	m_recordedTexture = nullptr;
+	m_recordedShader = nullptr;
+	m_recordedBlendMode = BlendMode::ALPHA;
+	m_recordedSamplerMode = SamplerMode::POINT_CLAMP;
+	m_recordedRasterizerMode = RasterizerMode::SOLID_CULL_BACK;
+	m_recordedDepthMode = DepthMode::DISABLED;
+}
+
+size_t RenderCommandBuffer::GetNumBytesRecorded() const
+{
+	return m_commands.size() * sizeof(RenderCommand)
+		+ (m_vertexes.size() + m_indexedVertexes.size()) * sizeof(Vertex_PCU)
+		+ (m_vertexesPCUTBN.size() + m_indexedVertexesPCUTBN.size()) * sizeof(Vertex_PCUTBN)
+		+ m_indexes.size() * sizeof(unsigned int)
+		+ m_modelConstants.size() * sizeof(RecordedModelConstants);
+}
+
+//----------------------------------------------------------------------------------------------
+void RenderCommandBuffer::AddStateCommand(RenderCommandType type, uint8_t mode, void const* resource)
+{
+	RenderCommand command;
+	command.m_type = type;
+	command.m_mode = mode;
+	command.m_resource = resource;
+	m_commands.push_back(command);
+}
+
+void RenderCommandBuffer::BindTexture(Texture const* texture)
+{
+	if (texture == m_recordedTexture)
+	{
+		return;
+	}
+	m_recordedTexture = texture;
+	AddStateCommand(RenderCommandType::BIND_TEXTURE, 0, texture);
+}
+
+void RenderCommandBuffer::BindShader(Shader* shader)
+{
+	if (shader == m_recordedShader)
+	{
+		return;
+	}
+	m_recordedShader = shader;
+	AddStateCommand(RenderCommandType::BIND_SHADER, 0, shader);
+}
+
+void RenderCommandBuffer::SetBlendMode(BlendMode blendMode)
+{
+	if (blendMode == m_recordedBlendMode)
+	{
+		return;
+	}
+	m_recordedBlendMode = blendMode;
+	AddStateCommand(RenderCommandType::SET_BLEND_MODE, (uint8_t)blendMode);
+}
+
+void RenderCommandBuffer::SetSamplerMode(SamplerMode samplerMode)
+{
+	if (samplerMode == m_recordedSamplerMode)
+	{
+		return;
+	}
+	m_recordedSamplerMode = samplerMode;
+	AddStateCommand(RenderCommandType::SET_SAMPLER_MODE, (uint8_t)samplerMode);
+}
+
+void RenderCommandBuffer::SetRasterizerMode(RasterizerMode mode)
+{
+	if (mode == m_recordedRasterizerMode)
+	{
+		return;
+	}
+	m_recordedRasterizerMode = mode;
+	AddStateCommand(RenderCommandType::SET_RASTERIZER_MODE, (uint8_t)mode);
+}
+
+void RenderCommandBuffer::SetDepthMode(DepthMode mode)
+{
+	if (mode == m_recordedDepthMode)
+	{
+		return;
+	}
+	m_recordedDepthMode = mode;
+	AddStateCommand(RenderCommandType::SET_DEPTH_MODE, (uint8_t)mode);
+}
+
+void RenderCommandBuffer::SetModelConstants(Mat44 const& modelMatrix, Rgba8 const& modelColor)
+{
+	RenderCommand command;
+	command.m_type = RenderCommandType::SET_MODEL_CONSTANTS;
+	command.m_firstIndex = (int)m_modelConstants.size();
+	m_commands.push_back(command);
+	m_modelConstants.push_back(RecordedModelConstants{ modelMatrix, modelColor });
+}
+
+//----------------------------------------------------------------------------------------------
+void RenderCommandBuffer::DrawVertexArray(int numVertexes, Vertex_PCU const* vertexes)
+{
+	if (numVertexes <= 0)
+	{
+		return;
+	}
+	RenderCommand command;
+	command.m_type = RenderCommandType::DRAW_VERTEXES;
+	command.m_firstVertex = (int)m_vertexes.size();
+	command.m_numVertexes = numVertexes;
+	m_commands.push_back(command);
+	m_vertexes.insert(m_vertexes.end(), vertexes, vertexes + numVertexes);
+}
+
+void RenderCommandBuffer::DrawVertexArray(int numVertexes, Vertex_PCU const* vertexes, int numIndexes, unsigned int const* indexes)
+{
+	if (numVertexes <= 0 || numIndexes <= 0)
+	{
+		return;
+	}
+	RenderCommand command;
+	command.m_type = RenderCommandType::DRAW_INDEXED_VERTEXES;
+	command.m_firstVertex = (int)m_indexedVertexes.size();
+	command.m_numVertexes = numVertexes;
+	command.m_firstIndex = (int)m_indexes.size();
+	command.m_numIndexes = numIndexes;
+	m_commands.push_back(command);
+	m_indexedVertexes.insert(m_indexedVertexes.end(), vertexes, vertexes + numVertexes);
+	m_indexes.insert(m_indexes.end(), indexes, indexes + numIndexes);
+}
+
+void RenderCommandBuffer::DrawVertexArray(int numVertexes, Vertex_PCUTBN const* vertexes)
+{
+	if (numVertexes <= 0)
+	{
+		return;
+	}
+	RenderCommand command;
+	command.m_type = RenderCommandType::DRAW_VERTEXES_PCUTBN;
+	command.m_firstVertex = (int)m_vertexesPCUTBN.size();
+	command.m_numVertexes = numVertexes;
+	m_commands.push_back(command);
+	m_vertexesPCUTBN.insert(m_vertexesPCUTBN.end(), vertexes, vertexes + numVertexes);
+}
+
+void RenderCommandBuffer::DrawVertexArray(int numVertexes, Vertex_PCUTBN const* vertexes, int numIndexes, unsigned int const* indexes)
+{
+	if (numVertexes <= 0 || numIndexes <= 0)
+	{
+		return;
+	}
+	RenderCommand command;
+	command.m_type = RenderCommandType::DRAW_INDEXED_VERTEXES_PCUTBN;
+	command.m_firstVertex = (int)m_indexedVertexesPCUTBN.size();
+	command.m_numVertexes = numVertexes;
+	command.m_firstIndex = (int)m_indexes.size();
+	command.m_numIndexes = numIndexes;
+	m_commands.push_back(command);
+	m_indexedVertexesPCUTBN.insert(m_indexedVertexesPCUTBN.end(), vertexes, vertexes + numVertexes);
+	m_indexes.insert(m_indexes.end(), indexes, indexes + numIndexes);
+}
+
+void RenderCommandBuffer::DrawVertexBuffer(VertexBuffer* vbo, int vertexCount, VertexType type, int vertexOffset)
+{
+	GUARANTEE_OR_DIE(vbo != nullptr, "RenderCommandBuffer::DrawVertexBuffer needs a vertex buffer");
+	RenderCommand command;
+	command.m_type = RenderCommandType::DRAW_VERTEX_BUFFER;
+	command.m_mode = (uint8_t)type;
+	command.m_firstVertex = vertexOffset;
+	command.m_numVertexes = vertexCount;
+	command.m_resource = vbo;
+	m_commands.push_back(command);
+}
+
+void RenderCommandBuffer::DrawIndexBuffer(IndexBuffer* ibo, int indexCount, VertexType type, VertexBuffer* vbo)
+{
+	GUARANTEE_OR_DIE(ibo != nullptr && vbo != nullptr, "RenderCommandBuffer::DrawIndexBuffer needs an index and a vertex buffer");
+	RenderCommand command;
+	command.m_type = RenderCommandType::DRAW_INDEX_BUFFER;
+	command.m_mode = (uint8_t)type;
+	command.m_numIndexes = indexCount;
+	command.m_resource = ibo;
+	command.m_indexedVertexBuffer = vbo;
+	m_commands.push_back(command);
+}
+
+//----------------------------------------------------------------------------------------------
+// Defined here rather than in Renderer.cpp because it only calls the public Renderer API, so the D3D11 backend and
+// NullRenderer.cpp share it.
+//
+void Renderer::SubmitCommandBuffers(std::vector<RenderCommandBuffer*> const& commandBuffers)
+{
+	m_sortedCommandBuffers.clear();
+	size_t numVertexes = 0;
+	size_t numVertexesPCUTBN = 0;
+	for (RenderCommandBuffer* commandBuffer : commandBuffers)
+	{
+		if (commandBuffer == nullptr || commandBuffer->IsEmpty())
+		{
+			continue;
+		}
+		m_sortedCommandBuffers.push_back(commandBuffer);
+		numVertexes += commandBuffer->m_vertexes.size();
+		numVertexesPCUTBN += commandBuffer->m_vertexesPCUTBN.size();
+	}
+	std::stable_sort(m_sortedCommandBuffers.begin(), m_sortedCommandBuffers.end(),
+		[](RenderCommandBuffer const* a, RenderCommandBuffer const* b) { return a->m_sortKey < b->m_sortKey; });
+
+	// One map per vertex type for every buffer's plain vertex arrays, instead of one per draw
+	if (numVertexes > 0)
+	{
+		if (m_commandVBO == nullptr)
+		{
+			m_commandVBO = CreateVertexBuffer(numVertexes * sizeof(Vertex_PCU));
+		}
+		unsigned char* mappedVertexes = (unsigned char*)MapVertexBuffer(m_commandVBO, numVertexes * sizeof(Vertex_PCU));
+		for (RenderCommandBuffer const* commandBuffer : m_sortedCommandBuffers)
+		{
+			size_t numBytes = commandBuffer->m_vertexes.size() * sizeof(Vertex_PCU);
+			if (numBytes > 0)
+			{
+				memcpy(mappedVertexes, commandBuffer->m_vertexes.data(), numBytes);
+				mappedVertexes += numBytes;
+			}
+		}
+		UnmapVertexBuffer(m_commandVBO);
+	}
+	if (numVertexesPCUTBN > 0)
+	{
+		if (m_commandVBO_VertexPCUTBN == nullptr)
+		{
+			m_commandVBO_VertexPCUTBN = CreateVertexBuffer(numVertexesPCUTBN * sizeof(Vertex_PCUTBN));
+		}
+		unsigned char* mappedVertexes = (unsigned char*)MapVertexBuffer(m_commandVBO_VertexPCUTBN, numVertexesPCUTBN * sizeof(Vertex_PCUTBN));
+		for (RenderCommandBuffer const* commandBuffer : m_sortedCommandBuffers)
+		{
+			size_t numBytes = commandBuffer->m_vertexesPCUTBN.size() * sizeof(Vertex_PCUTBN);
+			if (numBytes > 0)
+			{
+				memcpy(mappedVertexes, commandBuffer->m_vertexesPCUTBN.data(), numBytes);
+				mappedVertexes += numBytes;
+			}
+		}
+		UnmapVertexBuffer(m_commandVBO_VertexPCUTBN);
+	}
+
+	int firstVertex = 0;
+	int firstVertexPCUTBN = 0;
+	for (RenderCommandBuffer const* commandBuffer : m_sortedCommandBuffers)
+	{
+		ExecuteCommandBuffer(*commandBuffer, firstVertex, firstVertexPCUTBN);
+		firstVertex += (int)commandBuffer->m_vertexes.size();
+		firstVertexPCUTBN += (int)commandBuffer->m_vertexesPCUTBN.size();
+	}
+	m_sortedCommandBuffers.clear();
+}
+
+void Renderer::ExecuteCommandBuffer(RenderCommandBuffer const& commandBuffer, int firstVertex, int firstVertexPCUTBN)
+{
+	// The state every buffer was recorded against
+	BindShader(nullptr);
+	BindTexture(nullptr);
+	SetBlendMode(BlendMode::ALPHA);
+	SetSamplerMode(SamplerMode::POINT_CLAMP);
+	SetRasterizerMode(RasterizerMode::SOLID_CULL_BACK);
+	SetDepthMode(DepthMode::DISABLED);
+	SetModelConstants();
+
+	for (RenderCommandBuffer::RenderCommand const& command : commandBuffer.m_commands)
+	{
+		switch (command.m_type)
+		{
+		case RenderCommandType::BIND_TEXTURE:
+			BindTexture((Texture const*)command.m_resource);
+			break;
+		case RenderCommandType::BIND_SHADER:
+			BindShader((Shader*)command.m_resource);
+			break;
+		case RenderCommandType::SET_BLEND_MODE:
+			SetBlendMode((BlendMode)command.m_mode);
+			break;
+		case RenderCommandType::SET_SAMPLER_MODE:
+			SetSamplerMode((SamplerMode)command.m_mode);
+			break;
+		case RenderCommandType::SET_RASTERIZER_MODE:
+			SetRasterizerMode((RasterizerMode)command.m_mode);
+			break;
+		case RenderCommandType::SET_DEPTH_MODE:
+			SetDepthMode((DepthMode)command.m_mode);
+			break;
+		case RenderCommandType::SET_MODEL_CONSTANTS:
+		{
+			RenderCommandBuffer::RecordedModelConstants const& constants = commandBuffer.m_modelConstants[command.m_firstIndex];
+			SetModelConstants(constants.m_modelMatrix, constants.m_modelColor);
+			break;
+		}
+		case RenderCommandType::DRAW_VERTEXES:
+			SetStatesIfChanges();
+			DrawVertexBuffer(m_commandVBO, command.m_numVertexes, VertexType::Vertex_PCU, firstVertex + command.m_firstVertex);
+			break;
+		case RenderCommandType::DRAW_VERTEXES_PCUTBN:
+			SetStatesIfChanges();
+			DrawVertexBuffer(m_commandVBO_VertexPCUTBN, command.m_numVertexes, VertexType::Vertex_PCUTBN, firstVertexPCUTBN + command.m_firstVertex);
+			break;
+		case RenderCommandType::DRAW_INDEXED_VERTEXES:
+			DrawVertexArray(command.m_numVertexes, commandBuffer.m_indexedVertexes.data() + command.m_firstVertex,
+				command.m_numIndexes, commandBuffer.m_indexes.data() + command.m_firstIndex);
+			break;
+		case RenderCommandType::DRAW_INDEXED_VERTEXES_PCUTBN:
+			DrawVertexArray(command.m_numVertexes, commandBuffer.m_indexedVertexesPCUTBN.data() + command.m_firstVertex,
+				command.m_numIndexes, commandBuffer.m_indexes.data() + command.m_firstIndex);
+			break;
+		case RenderCommandType::DRAW_VERTEX_BUFFER:
+			SetStatesIfChanges();
+			DrawVertexBuffer((VertexBuffer*)command.m_resource, command.m_numVertexes, (VertexType)command.m_mode, command.m_firstVertex);
+			break;
+		case RenderCommandType::DRAW_INDEX_BUFFER:
+			SetStatesIfChanges();
+			DrawIndexBuffer((IndexBuffer*)command.m_resource, command.m_numIndexes, (VertexType)command.m_mode, command.m_indexedVertexBuffer);
+			break;
+		}
+	}
+}
\ No newline at end of file
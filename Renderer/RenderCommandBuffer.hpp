@@ -0,0 +1,105 @@
+#pragma once
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include <cstdint>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------
+enum class RenderCommandType : uint8_t
+{
+	BIND_TEXTURE,
+	BIND_SHADER,
+	SET_BLEND_MODE,
+	SET_SAMPLER_MODE,
+	SET_RASTERIZER_MODE,
+	SET_DEPTH_MODE,
+	SET_MODEL_CONSTANTS,
+	DRAW_VERTEXES,					// recorded Vertex_PCU, batched into one upload per submit
+	DRAW_VERTEXES_PCUTBN,			// recorded Vertex_PCUTBN, batched the same way
+	DRAW_INDEXED_VERTEXES,			// recorded Vertex_PCU and indexes, drawn through the immediate buffers
+	DRAW_INDEXED_VERTEXES_PCUTBN,
+	DRAW_VERTEX_BUFFER,
+	DRAW_INDEX_BUFFER,
+};
+
+//----------------------------------------------------------------------------------------------
+// A list of Renderer calls recorded now and replayed later by Renderer::SubmitCommandBuffers. Recording never
+// touches the Renderer or the graphics API, so JobSystem workers can each fill their own buffer in parallel (one
+// buffer per job; a buffer is not safe to record into from two threads at once), and the recording side runs the
+// same on the D3D11 and null backends.
+//
+// Every buffer starts from the Renderer defaults: default shader and texture, ALPHA blend, POINT_CLAMP sampler,
+// SOLID_CULL_BACK, depth DISABLED and identity model constants. It cannot see what another buffer left bound, so
+// record every state it relies on; recording a state that is already current is dropped. Vertex arrays are copied
+// into the buffer; textures, shaders and GPU buffers are referenced and must outlive the submit. Reset() between
+// frames keeps the memory.
+//
+class RenderCommandBuffer
+{
+	friend class Renderer;
+
+public:
+	explicit RenderCommandBuffer(uint64_t sortKey = 0);
+
+	void		Reset();							// drops every command; the sort key stays
+	void		SetSortKey(uint64_t sortKey)		{ m_sortKey = sortKey; }
+	uint64_t	GetSortKey() const					{ return m_sortKey; }
+	int			GetNumCommands() const				{ return (int)m_commands.size(); }
+	bool		IsEmpty() const						{ return m_commands.empty(); }
+	size_t		GetNumBytesRecorded() const;
+
+	void BindTexture(Texture const* texture);
+	void BindShader(Shader* shader);
+	void SetBlendMode(BlendMode blendMode);
+	void SetSamplerMode(SamplerMode samplerMode);
+	void SetRasterizerMode(RasterizerMode mode);
+	void SetDepthMode(DepthMode mode);
+	void SetModelConstants(Mat44 const& modelMatrix = Mat44(), Rgba8 const& modelColor = Rgba8::WHITE);
+
+	void DrawVertexArray(int numVertexes, Vertex_PCU const* vertexes);
+	void DrawVertexArray(int numVertexes, Vertex_PCU const* vertexes, int numIndexes, unsigned int const* indexes);
+	void DrawVertexArray(int numVertexes, Vertex_PCUTBN const* vertexes);
+	void DrawVertexArray(int numVertexes, Vertex_PCUTBN const* vertexes, int numIndexes, unsigned int const* indexes);
+	void DrawVertexBuffer(VertexBuffer* vbo, int vertexCount, VertexType type, int vertexOffset = 0);
+	void DrawIndexBuffer(IndexBuffer* ibo, int indexCount, VertexType type, VertexBuffer* vbo);
+
+private:
+	struct RenderCommand
+	{
+		RenderCommandType	m_type = RenderCommandType::DRAW_VERTEXES;
+		uint8_t				m_mode = 0;				// the state's enum value, or the VertexType of a buffer draw
+		int					m_firstVertex = 0;		// into this buffer's vertexes, or the vertexOffset of a buffer draw
+		int					m_numVertexes = 0;
+		int					m_firstIndex = 0;		// into m_indexes, or the model constants index
+		int					m_numIndexes = 0;
+		void const*			m_resource = nullptr;	// Texture, Shader, VertexBuffer or IndexBuffer
+		VertexBuffer*		m_indexedVertexBuffer = nullptr;
+	};
+
+	struct RecordedModelConstants
+	{
+		Mat44	m_modelMatrix;
+		Rgba8	m_modelColor;
+	};
+
+	void AddStateCommand(RenderCommandType type, uint8_t mode, void const* resource = nullptr);
+
+private:
+	uint64_t							m_sortKey = 0;
+	std::vector<RenderCommand>			m_commands;
+	std::vector<Vertex_PCU>				m_vertexes;				// DRAW_VERTEXES, uploaded together at submit
+	std::vector<Vertex_PCUTBN>			m_vertexesPCUTBN;		// DRAW_VERTEXES_PCUTBN, likewise
+	std::vector<Vertex_PCU>				m_indexedVertexes;
+	std::vector<Vertex_PCUTBN>			m_indexedVertexesPCUTBN;
+	std::vector<unsigned int>			m_indexes;
+	std::vector<RecordedModelConstants>	m_modelConstants;
+
+	// What the recorded commands leave bound, to drop repeats
+	Texture const*						m_recordedTexture = nullptr;
+	Shader*								m_recordedShader = nullptr;
+	BlendMode							m_recordedBlendMode = BlendMode::ALPHA;
+	SamplerMode							m_recordedSamplerMode = SamplerMode::POINT_CLAMP;
+	RasterizerMode						m_recordedRasterizerMode = RasterizerMode::SOLID_CULL_BACK;
+	DepthMode							m_recordedDepthMode = DepthMode::DISABLED;
+};
\ No newline at end of file
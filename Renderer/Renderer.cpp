@@ -1,3 +1,11 @@
+//-----------------------------------------------------------------------------------------------
+// The D3D11 backend. To build without any graphics API (dedicated servers, CI on Linux),
+//	#define ENGINE_NULL_RENDERER in your game's Code/Game/EngineBuildPreferences.hpp file;
+//	NullRenderer.cpp then provides every Renderer function instead of this file.
+//
+#include "Game/EngineBuildPreferences.hpp"
+#if !defined( ENGINE_NULL_RENDERER )
+
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
 #include <d3d11.h>
@@ -18,9 +26,9 @@
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/StringUtils.hpp"
-#include "Game/EngineBuildPreferences.hpp"
 #include "Engine/Core/FileUtils.hpp"
 #include "Engine/Renderer/DefaultShader.hpp"
+#include <algorithm>
 
 extern Window*		 g_theWindow;
 
@@ -293,6 +301,7 @@ void Renderer::EndFrame()
 	{
 		ERROR_AND_DIE("Device has been lost, application will now terminate.");
 	}
+	FinishFrameStats();
 }
 
 void Renderer::Shutdown()
@@ -329,6 +338,12 @@ void Renderer::Shutdown()
 	delete m_immediateIBO;
 	m_immediateIBO = nullptr;
 
+	delete m_commandVBO;
+	m_commandVBO = nullptr;
+
+	delete m_commandVBO_VertexPCUTBN;
+	m_commandVBO_VertexPCUTBN = nullptr;
+
 	delete m_cameraCBO;
 	m_cameraCBO = nullptr;
 
@@ -418,6 +433,7 @@ void Renderer::BeginCamera(Camera& camera)
 
 	CopyCPUToGPU(&cameraConstants, sizeof(CameraConstants), m_cameraCBO);
 	BindConstantBuffer(k_cameraConstantsSlot, m_cameraCBO);
+	++m_frameStats.m_numCameras;
 }
 
 void Renderer::EndCamera(const Camera& camera)
@@ -432,6 +448,14 @@ void Renderer::DrawVertexArray(int numVertexes, const Vertex_PCU* Vertexes)
 	DrawVertexBuffer(m_immediateVBO, numVertexes, VertexType::Vertex_PCU);
 }
 
+void Renderer::DrawVertexArray(int numVertexes, const Vertex_PCU* Vertexes, int numIndices, const unsigned int* indices)
+{
+	CopyCPUToGPU(Vertexes, numVertexes * sizeof(Vertex_PCU), m_immediateVBO);
+	CopyCPUToGPU(indices, numIndices * sizeof(unsigned int), m_immediateIBO);
+	SetStatesIfChanges();
+	DrawIndexBuffer(m_immediateIBO, numIndices, VertexType::Vertex_PCU, m_immediateVBO);
+}
+
 void Renderer::DrawVertexArray(int numVertexes, const Vertex_PCUTBN* Vertexes, int numIndices, const unsigned int* indices)
 {
 	CopyCPUToGPU(Vertexes, numVertexes * sizeof(Vertex_PCUTBN), m_immediateVBO);
@@ -538,6 +562,70 @@ Texture* Renderer::CreateTextureFromData(char const* name, IntVec2 dimensions, i
 	return newTexture;
 }
 
+Texture* Renderer::CreateDynamicTexture(char const* name, IntVec2 dimensions)
+{
+	GUARANTEE_OR_DIE(dimensions.x > 0 && dimensions.y > 0, Stringf("CreateDynamicTexture failed for \"%s\" - illegal texture dimensions (%i x %i)", name, dimensions.x, dimensions.y));
+
+	// DEFAULT usage so UpdateSubresource can rewrite a band of rows without touching the rest
+	D3D11_TEXTURE2D_DESC textureDesc = {};
+	textureDesc.Width = dimensions.x;
+	textureDesc.Height = dimensions.y;
+	textureDesc.MipLevels = 1;
+	textureDesc.ArraySize = 1;
+	textureDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	textureDesc.SampleDesc.Count = 1;
+	textureDesc.Usage = D3D11_USAGE_DEFAULT;
+	textureDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+	Texture* newTexture = new Texture();
+	newTexture->m_name = name;
+	newTexture->m_dimensions = dimensions;
+	HRESULT hr = m_device->CreateTexture2D(&textureDesc, nullptr, &newTexture->m_texture);
+	if (!SUCCEEDED(hr)) {
+		ERROR_AND_DIE(Stringf("CreateDynamicTexture failed for \"%s\".", name));
+	}
+
+	hr = m_device->CreateShaderResourceView(newTexture->m_texture, NULL, &newTexture->m_shaderResourceView);
+	if (!SUCCEEDED(hr)) {
+		ERROR_AND_DIE(Stringf("CreateShaderResourceView failed for dynamic texture \"%s\".", name));
+	}
+
+	m_loadedTextures.push_back(newTexture);
+	return newTexture;
+}
+
+// texels holds the whole image, row 0 first; only rows firstRow .. firstRow + numRows - 1 are sent
+void Renderer::UpdateTextureTexels(Texture* texture, Rgba8 const* texels, int firstRow, int numRows)
+{
+	IntVec2 dimensions = texture->GetDimensions();
+	GUARANTEE_OR_DIE(firstRow >= 0 && numRows >= 0 && firstRow + numRows <= dimensions.y, Stringf("UpdateTextureTexels rows %i..%i are outside \"%s\"", firstRow, firstRow + numRows - 1, texture->m_name.c_str()));
+	if (numRows == 0)
+	{
+		return;
+	}
+
+	D3D11_BOX rowBand = {};
+	rowBand.left = 0;
+	rowBand.right = (UINT)dimensions.x;
+	rowBand.top = (UINT)firstRow;
+	rowBand.bottom = (UINT)(firstRow + numRows);
+	rowBand.front = 0;
+	rowBand.back = 1;
+	UINT rowPitch = (UINT)(dimensions.x * sizeof(Rgba8));
+	m_deviceContext->UpdateSubresource(texture->m_texture, 0, &rowBand, texels + (size_t)firstRow * dimensions.x, rowPitch, 0);
+	m_frameStats.m_numBytesUploaded += (size_t)rowPitch * numRows;
+}
+
+void Renderer::DestroyTexture(Texture* texture)
+{
+	auto found = std::find(m_loadedTextures.begin(), m_loadedTextures.end(), texture);
+	if (found != m_loadedTextures.end())
+	{
+		m_loadedTextures.erase(found);
+		delete texture;
+	}
+}
+
 
 BitmapFont* Renderer::CreateOrGetBitmapFont(const char* bitmapFontFilePathWithNoExtension) {
 	// Check if the font has already been loaded
@@ -582,6 +670,7 @@ void Renderer::BindTexture(const Texture* texture)
 	// Bind the texture
 	if (texture && texture->m_shaderResourceView) {
 		m_deviceContext->PSSetShaderResources(0, 1, &texture->m_shaderResourceView);
+		++m_frameStats.m_numTextureBinds;
 	}
 }
 
@@ -645,9 +734,26 @@ Shader* Renderer::CreateShader(char const* shaderName, char const* shader_Source
 	};*/
 
 	std::vector<D3D11_INPUT_ELEMENT_DESC> inputElementDesc;
-	inputElementDesc.push_back({ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 });
-	inputElementDesc.push_back({ "COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 });
-	inputElementDesc.push_back({ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+	if (type == VertexType::Vertex_PCUTBNCompact) {
+		// Shader decodes: NORMAL float2 octahedral, TANGENT float4 (octahedral xy, 0, bitangent sign)
+		inputElementDesc.push_back({ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+		inputElementDesc.push_back({ "COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+		inputElementDesc.push_back({ "TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+		inputElementDesc.push_back({ "NORMAL", 0, DXGI_FORMAT_R16G16_SNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+		inputElementDesc.push_back({ "TANGENT", 0, DXGI_FORMAT_R8G8B8A8_SNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+	}
+	else if (type == VertexType::Vertex_Chunk) {
+		// Shader declares POSITION as int4 and applies CHUNK_VERTEX_POSITION_SCALE plus the chunk origin
+		inputElementDesc.push_back({ "POSITION", 0, DXGI_FORMAT_R16G16B16A16_SINT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+		inputElementDesc.push_back({ "COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+		inputElementDesc.push_back({ "TEXCOORD", 0, DXGI_FORMAT_R16G16_UNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+		inputElementDesc.push_back({ "NORMAL", 0, DXGI_FORMAT_R8G8B8A8_SNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+	}
+	else {
+		inputElementDesc.push_back({ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+		inputElementDesc.push_back({ "COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+		inputElementDesc.push_back({ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+	}
 
 	if (type == VertexType::Vertex_PCUTBN) {
 		inputElementDesc.push_back({ "TANGENT", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 });
@@ -741,6 +847,7 @@ bool Renderer::CompileShaderToByteCode(std::vector<unsigned char>& outByteCode,
 
 void Renderer::BindShader(Shader* shader)
 {
+	++m_frameStats.m_numShaderBinds;
 	if (shader == nullptr)
 	{
 		m_deviceContext->VSSetShader(m_defaultShader->m_vertexShader, nullptr, 0);
@@ -772,6 +879,16 @@ VertexBuffer* Renderer::CreateVertexBuffer(const size_t size)
 }
 
 void Renderer::CopyCPUToGPU(const void* data, size_t size, VertexBuffer*& vbo)
+{
+	// Copy vertices
+	void* mappedVertexes = MapVertexBuffer(vbo, size);
+	memcpy(mappedVertexes, data, size);
+	UnmapVertexBuffer(vbo);
+}
+
+// Grows vbo if needed and maps it write-discard, so callers can build vertexes (e.g. through a VertexWriter)
+// directly in GPU-visible memory instead of building a CPU array and copying it. Pair with UnmapVertexBuffer.
+void* Renderer::MapVertexBuffer(VertexBuffer*& vbo, size_t size)
 {
 	// Check if the vertex buffer is large enough for the new data
 	if (vbo->m_size < size)
@@ -780,10 +897,18 @@ void Renderer::CopyCPUToGPU(const void* data, size_t size, VertexBuffer*& vbo)
 		vbo = CreateVertexBuffer(size);
 	}
 
-	// Copy vertices
 	D3D11_MAPPED_SUBRESOURCE resource;
-	m_deviceContext->Map(vbo->m_buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &resource);
-	memcpy(resource.pData, data, size);
+	HRESULT hr = m_deviceContext->Map(vbo->m_buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &resource);
+	if (!SUCCEEDED(hr))
+	{
+		ERROR_AND_DIE("Could not map vertex buffer.");
+	}
+	m_frameStats.m_numBytesUploaded += size;
+	return resource.pData;
+}
+
+void Renderer::UnmapVertexBuffer(VertexBuffer* vbo)
+{
 	m_deviceContext->Unmap(vbo->m_buffer, 0);
 }
 
@@ -797,6 +922,18 @@ void Renderer::BindVertexBuffer(VertexBuffer* vbo, VertexType type)
 	{
 		stride = sizeof(Vertex_PCUTBN);
 	}
+	else if (type == VertexType::Vertex_PCUTBNCompact)
+	{
+		stride = sizeof(Vertex_PCUTBNCompact);
+	}
+	else if (type == VertexType::Vertex_Chunk)
+	{
+		stride = sizeof(Vertex_Chunk);
+	}
+	else
+	{
+		ERROR_AND_DIE(Stringf("BindVertexBuffer: unknown VertexType %d", (int)type));
+	}
 	UINT startOffset = 0;
 	m_deviceContext->IASetVertexBuffers(0, 1, &vbo->m_buffer, &stride, &startOffset);
 	m_deviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
@@ -807,6 +944,8 @@ void Renderer::DrawVertexBuffer(VertexBuffer* vbo, int vertexCount, VertexType t
 	BindVertexBuffer(vbo, type);
 	// Draw
 	m_deviceContext->Draw(vertexCount, vertexOffset);
+	++m_frameStats.m_numDrawCalls;
+	m_frameStats.m_numVertexesDrawn += vertexCount;
 }
 
 IndexBuffer* Renderer::CreateIndexBuffer(const size_t size)
@@ -840,6 +979,7 @@ void Renderer::CopyCPUToGPU(const void* data, size_t size, IndexBuffer*& ibo)
 	m_deviceContext->Map(ibo->m_buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &resource);
 	memcpy(resource.pData, data, size);
 	m_deviceContext->Unmap(ibo->m_buffer, 0);
+	m_frameStats.m_numBytesUploaded += size;
 }
 
 void Renderer::BindIndexBuffer(IndexBuffer* ibo)
@@ -853,6 +993,8 @@ void Renderer::DrawIndexBuffer(IndexBuffer* ibo, int indexCount, VertexType type
 	BindVertexBuffer(vbo, type);
 	// Draw
 	m_deviceContext->DrawIndexed(indexCount, 0, 0);
+	++m_frameStats.m_numDrawCalls;
+	m_frameStats.m_numIndexesDrawn += indexCount;
 }
 
 ConstantBuffer* Renderer::CreateConstantBuffer(const size_t size)
@@ -879,6 +1021,7 @@ void Renderer::CopyCPUToGPU(const void* data, size_t size, ConstantBuffer*& cbo)
 	m_deviceContext->Map(cbo->m_buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &resource);
 	memcpy(resource.pData, data, size);
 	m_deviceContext->Unmap(cbo->m_buffer, 0);
+	m_frameStats.m_numBytesUploaded += size;
 }
 
 void Renderer::BindConstantBuffer(int slot, ConstantBuffer* cbo)
@@ -895,23 +1038,27 @@ void Renderer::SetStatesIfChanges()
 		float blendFactor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
 		UINT sampleMask = 0xffffffff;
 		m_deviceContext->OMSetBlendState(m_blendState, blendFactor, sampleMask);
+		++m_frameStats.m_numStateChanges;
 	}
 
 	if (m_samplerState != m_samplerStates[(int)(m_desiredSamplerMode)]) {
 		m_samplerState = m_samplerStates[(int)(m_desiredSamplerMode)];
 		m_deviceContext->PSSetSamplers(0, 1, &m_samplerState);
+		++m_frameStats.m_numStateChanges;
 	}
 
 	if (m_rasterizerState != m_rasterizerStates[(int)(m_desiredRasterizerMode)])
 	{
 		m_rasterizerState = m_rasterizerStates[(int)(m_desiredRasterizerMode)];
 		m_deviceContext->RSSetState(m_rasterizerState);
+		++m_frameStats.m_numStateChanges;
 	}
 
 	if (m_depthStencilState != m_depthStencilStates[(int)(m_desiredDepthMode)])
 	{
 		m_depthStencilState = m_depthStencilStates[(int)(m_desiredDepthMode)];
 		m_deviceContext->OMSetDepthStencilState(m_depthStencilState, 0);
+		++m_frameStats.m_numStateChanges;
 	}
 }
 
@@ -949,3 +1096,4 @@ void Renderer::SetLightConstants(Vec3 sunDirection /*= Vec3(2, 1, -1)*/, float s
 	BindConstantBuffer(1, m_lightCBO);
 }
 
+#endif // !defined( ENGINE_NULL_RENDERER )
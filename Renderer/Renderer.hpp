@@ -1,4 +1,5 @@
 #pragma once
+#include "Game/EngineBuildPreferences.hpp"		// ENGINE_NULL_RENDERER changes the members below; every includer must agree
 #include "Engine/Core/Vertex_PCU.hpp"
 #include "Engine/Renderer/Window.hpp"
 #include "Engine/Renderer/Texture.hpp"
@@ -21,6 +22,7 @@ struct ID3D11SamplerState;
 struct ID3D11DepthStencilView;
 struct ID3D11Texture2D;
 struct ID3D11DepthStencilState;
+class RenderCommandBuffer;
 
 enum class SamplerMode
 {
@@ -89,7 +91,9 @@ enum class DepthMode
 
 enum class VertexType {
 	Vertex_PCU,
-	Vertex_PCUTBN
+	Vertex_PCUTBN,
+	Vertex_PCUTBNCompact,
+	Vertex_Chunk
 };
 
 struct RenderConfig
@@ -97,6 +101,36 @@ struct RenderConfig
 	Window* m_window = nullptr;
 };
 
+//----------------------------------------------------------------------------------------------
+// What the game asked the GPU to do, counted by both backends. With ENGINE_NULL_RENDERER (see NullRenderer.cpp)
+// these are all a frame produces, so headless benchmarks and soak tests can still check their draw load.
+//
+struct RenderStats
+{
+	int		m_numFrames = 0;
+	int		m_numDrawCalls = 0;
+	int		m_numVertexesDrawn = 0;		// by non-indexed draws
+	int		m_numIndexesDrawn = 0;		// by indexed draws
+	size_t	m_numBytesUploaded = 0;		// vertex, index and constant buffer writes plus texture updates
+	int		m_numStateChanges = 0;		// blend, sampler, rasterizer and depth states actually switched
+	int		m_numTextureBinds = 0;
+	int		m_numShaderBinds = 0;
+	int		m_numCameras = 0;
+
+	void Add(RenderStats const& stats)
+	{
+		m_numFrames += stats.m_numFrames;
+		m_numDrawCalls += stats.m_numDrawCalls;
+		m_numVertexesDrawn += stats.m_numVertexesDrawn;
+		m_numIndexesDrawn += stats.m_numIndexesDrawn;
+		m_numBytesUploaded += stats.m_numBytesUploaded;
+		m_numStateChanges += stats.m_numStateChanges;
+		m_numTextureBinds += stats.m_numTextureBinds;
+		m_numShaderBinds += stats.m_numShaderBinds;
+		m_numCameras += stats.m_numCameras;
+	}
+};
+
 
 class Renderer
 {
@@ -115,6 +149,7 @@ public:
 	void BeginCamera( Camera& camera );
 	void EndCamera( const Camera& camera );
 	void DrawVertexArray(int numVertexes, const Vertex_PCU* Vertexes);
+	void DrawVertexArray(int numVertexes, const Vertex_PCU* Vertexes, int numIndices, const unsigned int* indices);
 	void DrawVertexArray(int numVertexes, const Vertex_PCUTBN* Vertexes, int numIndices, const unsigned int* indices);
 	void DrawVertexArray(int numVertexes, Vertex_PCUTBN const* vertexes);
 
@@ -124,6 +159,10 @@ public:
 	Texture* CreateTextureFromFile(char const* imageFilePath);
 	Texture* CreateTextureFromImage(const Image& image);
 	Texture* CreateTextureFromData(char const* name, IntVec2 dimensions, int bytesPerTexel, uint8_t* texelData);
+	// RGBA8 texture the CPU rewrites after creation, e.g. a heat map drawn as one quad; upload only the rows that changed
+	Texture* CreateDynamicTexture(char const* name, IntVec2 dimensions);
+	void UpdateTextureTexels(Texture* texture, Rgba8 const* texels, int firstRow, int numRows);
+	void DestroyTexture(Texture* texture);
 	BitmapFont* CreateOrGetBitmapFont(const char* bitmapFontFilePathWithNoExtension);
 	BitmapFont* CreateBitmapFontFromFile(const char* bitmapFontFilePathWithNoExtension);
 	void BindTexture(const Texture* texture);
@@ -135,6 +174,8 @@ public:
 
 	VertexBuffer* CreateVertexBuffer(const size_t size);
 	void CopyCPUToGPU(const void* data, size_t size, VertexBuffer*& vbo);
+	void* MapVertexBuffer(VertexBuffer*& vbo, size_t size);
+	void UnmapVertexBuffer(VertexBuffer* vbo);
 	void BindVertexBuffer(VertexBuffer* vbo, VertexType type);
 	void DrawVertexBuffer(VertexBuffer* vbo, int vertexCount, VertexType type, int vertexOffset = 0);
 
@@ -153,6 +194,14 @@ public:
 	void SetModelConstants(const Mat44& modelMatrix = Mat44(), const Rgba8& modelColor = Rgba8::WHITE);
 	void SetLightConstants(Vec3 sunDirection = Vec3(2, 1, -1), float sunIntensity = 0.85f, float ambientIntensity = 0.35f);
 
+	// Replays buffers recorded on any thread (see RenderCommandBuffer.hpp) in ascending sort key order, buffers with
+	// equal keys in the order given; call between BeginCamera and EndCamera on the render thread
+	void SubmitCommandBuffers(std::vector<RenderCommandBuffer*> const& commandBuffers);
+
+	RenderStats const& GetFrameStats() const		{ return m_frameStats; }		// so far this frame
+	RenderStats const& GetLastFrameStats() const	{ return m_lastFrameStats; }	// the frame finished by the last EndFrame
+	RenderStats const& GetTotalStats() const		{ return m_totalStats; }		// every finished frame since Startup
+
 	Shader*					m_defaultShader = nullptr;
 
 protected:
@@ -194,7 +243,37 @@ protected:
 
 	
 
+	RenderStats				m_frameStats;
+	RenderStats				m_lastFrameStats;
+	RenderStats				m_totalStats;
+
+#if defined( ENGINE_NULL_RENDERER )
+	// The null backend has no state objects to compare, so it remembers the modes it last applied, and
+	// MapVertexBuffer hands out this scratch memory
+	BlendMode					m_appliedBlendMode = BlendMode::COUNT;
+	SamplerMode					m_appliedSamplerMode = SamplerMode::COUNT;
+	RasterizerMode				m_appliedRasterizerMode = RasterizerMode::COUNT;
+	DepthMode					m_appliedDepthMode = DepthMode::COUNT;
+	std::vector<unsigned char>	m_mappedScratch;
+#endif
+
+	VertexBuffer*						m_commandVBO = nullptr;					// every submitted buffer's vertexes, one upload per submit
+	VertexBuffer*						m_commandVBO_VertexPCUTBN = nullptr;
+	std::vector<RenderCommandBuffer*>	m_sortedCommandBuffers;
+
+	void FinishFrameStats();
+	void ExecuteCommandBuffer(RenderCommandBuffer const& commandBuffer, int firstVertex, int firstVertexPCUTBN);
+
 private:
 	std::vector<Texture*> m_loadedTextures;
 	std::vector<BitmapFont*> m_loadedFonts;
 };
+
+//----------------------------------------------------------------------------------------------
+inline void Renderer::FinishFrameStats()
+{
+	m_frameStats.m_numFrames = 1;
+	m_lastFrameStats = m_frameStats;
+	m_totalStats.Add(m_frameStats);
+	m_frameStats = RenderStats();
+}
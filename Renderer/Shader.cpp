@@ -1,11 +1,14 @@
 #include "Engine/Renderer/Shader.hpp"
 #include "Engine/Renderer/Renderer.hpp"
+#include "Game/EngineBuildPreferences.hpp"
+#if !defined( ENGINE_NULL_RENDERER )
 #include <d3d11.h>
 #include <d3dcompiler.h>
 #include <dxgi.h>
 #pragma comment(lib, "d3d11.lib")
 #pragma comment(lib, "dxgi.lib")
 #pragma comment(lib, "d3dcompiler.lib")
+#endif
 
 Shader::Shader(const ShaderConfig& config)
 	:m_config(config)
@@ -15,9 +18,11 @@ Shader::Shader(const ShaderConfig& config)
 
 Shader::~Shader()
 {
+#if !defined( ENGINE_NULL_RENDERER )
 	DX_SAFE_RELEASE(m_vertexShader);
 	DX_SAFE_RELEASE(m_pixelShader);
 	DX_SAFE_RELEASE(m_inputLayout);
+#endif
 }
 
 const std::string& Shader::GetName() const
@@ -1,6 +1,9 @@
 #include "Engine/Renderer/Texture.hpp"
-#include <D3D11.h>
 #include "Engine/Renderer/Renderer.hpp"
+#include "Game/EngineBuildPreferences.hpp"
+#if !defined( ENGINE_NULL_RENDERER )
+#include <D3D11.h>
+#endif
 
 Texture::Texture()
 {
@@ -9,6 +12,8 @@ Texture::Texture()
 
 Texture::~Texture()
 {
+#if !defined( ENGINE_NULL_RENDERER )
 	DX_SAFE_RELEASE(m_texture);
 	DX_SAFE_RELEASE(m_shaderResourceView);
+#endif
 }
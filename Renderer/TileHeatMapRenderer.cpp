@@ -0,0 +1,249 @@
+#include "Engine/Renderer/TileHeatMapRenderer.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Core/VertexWriter.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include <cstring>
+
+//----------------------------------------------------------------------------------------------
+TileHeatMapRenderer::TileHeatMapRenderer(Renderer* renderer, HeatMapDrawMode drawMode)
+	: m_renderer(renderer)
+	, m_drawMode(drawMode)
+{
+	GUARANTEE_OR_DIE(m_renderer != nullptr, "TileHeatMapRenderer needs a Renderer");
+}
+
+TileHeatMapRenderer::~TileHeatMapRenderer()
+{
+	ReleaseGPUData();
+}
+
+void TileHeatMapRenderer::SetDrawMode(HeatMapDrawMode drawMode)
+{
+	if (drawMode == m_drawMode)
+	{
+		return;
+	}
+	ReleaseGPUData();
+	m_drawMode = drawMode;
+	m_isLayoutValid = false;
+	m_tileVerts.clear();
+}
+
+void TileHeatMapRenderer::MarkAllDirty()
+{
+	m_areColorsValid = false;
+}
+
+//----------------------------------------------------------------------------------------------
+void TileHeatMapRenderer::Update(TileHeatMap const& heatMap, AABB2 const& bounds, HeatMapColorLUT const& colors)
+{
+	IntVec2 dimensions = heatMap.GetDimensions();
+	bool isNewLayout = !m_isLayoutValid || dimensions != m_dimensions
+		|| bounds.m_mins.x != m_bounds.m_mins.x || bounds.m_mins.y != m_bounds.m_mins.y
+		|| bounds.m_maxs.x != m_bounds.m_maxs.x || bounds.m_maxs.y != m_bounds.m_maxs.y;
+	if (isNewLayout)
+	{
+		RebuildLayout(dimensions, bounds);
+	}
+
+	bool recolorAll = !m_areColorsValid || colors != m_colors;
+	m_colors = colors;
+	int firstDirtyRow = m_dimensions.y;
+	int lastDirtyRow = -1;
+	RecolorTiles(heatMap.GetValues(), recolorAll, firstDirtyRow, lastDirtyRow);
+	m_areColorsValid = true;
+
+	// Moved quads have to be re-sent even where no color changed; a moved texture quad is built at draw time
+	if (isNewLayout && m_drawMode == HeatMapDrawMode::TILE_QUADS)
+	{
+		firstDirtyRow = 0;
+		lastDirtyRow = m_dimensions.y - 1;
+	}
+	UploadTiles(firstDirtyRow, lastDirtyRow);
+}
+
+void TileHeatMapRenderer::Render() const
+{
+	if (!m_isLayoutValid || m_dimensions.x <= 0 || m_dimensions.y <= 0)
+	{
+		return;
+	}
+
+	if (m_drawMode == HeatMapDrawMode::TILE_QUADS)
+	{
+		if (m_vertexBuffer == nullptr || m_indexBuffer == nullptr)
+		{
+			return;
+		}
+		m_renderer->BindTexture(nullptr);
+		m_renderer->SetStatesIfChanges();
+		m_renderer->DrawIndexBuffer(m_indexBuffer, m_dimensions.x * m_dimensions.y * 6, VertexType::Vertex_PCU, m_vertexBuffer);
+	}
+	else
+	{
+		if (m_texture == nullptr)
+		{
+			return;
+		}
+		// Heat map row y is texel row y, and uv (0,0) is the bottom-left corner, so the plain quad uvs line up
+		Vertex_PCU quadVerts[6];
+		VertexWriter writer(quadVerts, 6);
+		AddVertsForAABB2D(writer, m_bounds, Rgba8::WHITE);
+		m_renderer->BindTexture(m_texture);
+		m_renderer->SetSamplerMode(SamplerMode::POINT_CLAMP);
+		m_renderer->DrawVertexArray(writer.GetNumWritten(), quadVerts);
+	}
+}
+
+//----------------------------------------------------------------------------------------------
+void TileHeatMapRenderer::RebuildLayout(IntVec2 const& dimensions, AABB2 const& bounds)
+{
+	int numTiles = dimensions.x * dimensions.y;
+	if (!m_isLayoutValid || dimensions != m_dimensions)
+	{
+		m_drawnValueBits.assign(numTiles, 0);
+		m_tileColors.assign(numTiles, Rgba8());
+		ReleaseGPUData();
+	}
+	m_dimensions = dimensions;
+	m_bounds = bounds;
+	m_isLayoutValid = true;
+
+	if (m_drawMode != HeatMapDrawMode::TILE_QUADS)
+	{
+		return;
+	}
+
+	// Corners and uvs as AddVertsForAABB2D; the index buffer supplies the two triangles
+	m_tileVerts.resize((size_t)numTiles * 4);
+	float tileWidth = (bounds.m_maxs.x - bounds.m_mins.x) / (float)dimensions.x;
+	float tileHeight = (bounds.m_maxs.y - bounds.m_mins.y) / (float)dimensions.y;
+	Vertex_PCU* out = m_tileVerts.data();
+	for (int y = 0; y < dimensions.y; ++y)
+	{
+		float minY = tileHeight * (float)y + bounds.m_mins.y;
+		float maxY = minY + tileHeight;
+		for (int x = 0; x < dimensions.x; ++x)
+		{
+			float minX = tileWidth * (float)x + bounds.m_mins.x;
+			float maxX = minX + tileWidth;
+			Rgba8 tileColor = m_tileColors[x + y * dimensions.x];
+			out[0] = Vertex_PCU(Vec3(minX, minY, 0.f), tileColor, Vec2(0.f, 0.f));
+			out[1] = Vertex_PCU(Vec3(maxX, minY, 0.f), tileColor, Vec2(1.f, 0.f));
+			out[2] = Vertex_PCU(Vec3(maxX, maxY, 0.f), tileColor, Vec2(1.f, 1.f));
+			out[3] = Vertex_PCU(Vec3(minX, maxY, 0.f), tileColor, Vec2(0.f, 1.f));
+			out += 4;
+		}
+	}
+}
+
+void TileHeatMapRenderer::RecolorTiles(float const* values, bool recolorAll, int& out_firstDirtyRow, int& out_lastDirtyRow)
+{
+	m_numTilesRecolored = 0;
+	int rowLength = m_dimensions.x;
+	bool hasVerts = m_drawMode == HeatMapDrawMode::TILE_QUADS;
+	for (int y = 0; y < m_dimensions.y; ++y)
+	{
+		float const* rowValues = values + y * rowLength;
+		uint32_t* rowDrawnBits = m_drawnValueBits.data() + y * rowLength;
+		if (!recolorAll && memcmp(rowValues, rowDrawnBits, rowLength * sizeof(float)) == 0)
+		{
+			continue;
+		}
+
+		for (int x = 0; x < rowLength; ++x)
+		{
+			uint32_t valueBits;
+			memcpy(&valueBits, &rowValues[x], sizeof(valueBits));
+			if (!recolorAll && valueBits == rowDrawnBits[x])
+			{
+				continue;
+			}
+			rowDrawnBits[x] = valueBits;
+
+			int tileIndex = x + y * rowLength;
+			Rgba8 tileColor = m_colors.GetColorForValue(rowValues[x]);
+			m_tileColors[tileIndex] = tileColor;
+			if (hasVerts)
+			{
+				Vertex_PCU* tileVerts = m_tileVerts.data() + tileIndex * 4;
+				tileVerts[0].m_color = tileColor;
+				tileVerts[1].m_color = tileColor;
+				tileVerts[2].m_color = tileColor;
+				tileVerts[3].m_color = tileColor;
+			}
+			++m_numTilesRecolored;
+		}
+
+		if (out_firstDirtyRow > y)
+		{
+			out_firstDirtyRow = y;
+		}
+		out_lastDirtyRow = y;
+	}
+}
+
+void TileHeatMapRenderer::UploadTiles(int firstDirtyRow, int lastDirtyRow)
+{
+	m_numRowsUploaded = 0;
+	if (lastDirtyRow < firstDirtyRow || m_dimensions.x <= 0)
+	{
+		return;
+	}
+
+	if (m_drawMode == HeatMapDrawMode::TILE_QUADS)
+	{
+		size_t vertexBytes = m_tileVerts.size() * sizeof(Vertex_PCU);
+		if (m_vertexBuffer == nullptr)
+		{
+			m_vertexBuffer = m_renderer->CreateVertexBuffer(vertexBytes);
+		}
+		m_renderer->CopyCPUToGPU(m_tileVerts.data(), vertexBytes, m_vertexBuffer);
+
+		if (m_indexBuffer == nullptr)
+		{
+			int numTiles = m_dimensions.x * m_dimensions.y;
+			std::vector<unsigned int> indexes((size_t)numTiles * 6);
+			for (int tileIndex = 0; tileIndex < numTiles; ++tileIndex)
+			{
+				unsigned int firstVert = (unsigned int)tileIndex * 4;
+				unsigned int* tileIndexes = indexes.data() + (size_t)tileIndex * 6;
+				tileIndexes[0] = firstVert;
+				tileIndexes[1] = firstVert + 1;
+				tileIndexes[2] = firstVert + 2;
+				tileIndexes[3] = firstVert;
+				tileIndexes[4] = firstVert + 2;
+				tileIndexes[5] = firstVert + 3;
+			}
+			size_t indexBytes = indexes.size() * sizeof(unsigned int);
+			m_indexBuffer = m_renderer->CreateIndexBuffer(indexBytes);
+			m_renderer->CopyCPUToGPU(indexes.data(), indexBytes, m_indexBuffer);
+		}
+		m_numRowsUploaded = m_dimensions.y;
+	}
+	else
+	{
+		if (m_texture == nullptr)
+		{
+			m_texture = m_renderer->CreateDynamicTexture("TileHeatMap", m_dimensions);
+		}
+		m_renderer->UpdateTextureTexels(m_texture, m_tileColors.data(), firstDirtyRow, lastDirtyRow - firstDirtyRow + 1);
+		m_numRowsUploaded = lastDirtyRow - firstDirtyRow + 1;
+	}
+}
+
+void TileHeatMapRenderer::ReleaseGPUData()
+{
+	delete m_vertexBuffer;
+	m_vertexBuffer = nullptr;
+	delete m_indexBuffer;
+	m_indexBuffer = nullptr;
+	if (m_texture != nullptr)
+	{
+		m_renderer->DestroyTexture(m_texture);
+		m_texture = nullptr;
+	}
+	// Fresh buffers or textures start out empty, so every tile has to be sent again
+	m_areColorsValid = false;
+}
\ No newline at end of file
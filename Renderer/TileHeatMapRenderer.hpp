@@ -0,0 +1,75 @@
+#pragma once
+#include "Engine/Core/HeatMaps.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include <cstdint>
+#include <vector>
+
+class Renderer;
+class Texture;
+class VertexBuffer;
+class IndexBuffer;
+
+//----------------------------------------------------------------------------------------------
+enum class HeatMapDrawMode
+{
+	TILE_QUADS,		// one indexed quad (4 verts, 6 indices) per tile in a mesh kept between frames
+	TEXTURE,		// one texel per tile on a dynamic texture, drawn point sampled as a single quad
+};
+
+//----------------------------------------------------------------------------------------------
+// Keeps a TileHeatMap's debug draw on the GPU between frames instead of rebuilding six vertexes per tile every frame.
+// Update() compares the map against the values it last drew and recolors only the tiles that changed, through a
+// HeatMapColorLUT; nothing is uploaded when nothing changed. A new color table recolors every tile, and new bounds
+// or dimensions rebuild the layout.
+//
+// TILE_QUADS keeps a CPU copy of the mesh and re-sends it whole when any tile changed (dynamic vertex buffers are
+// written discard), with a static index buffer. TEXTURE re-sends only the band of rows holding changed tiles, which
+// is 4 bytes per tile instead of 96 and the better choice for large or busy maps.
+//
+class TileHeatMapRenderer
+{
+public:
+	explicit TileHeatMapRenderer(Renderer* renderer, HeatMapDrawMode drawMode = HeatMapDrawMode::TILE_QUADS);
+	~TileHeatMapRenderer();
+	TileHeatMapRenderer(TileHeatMapRenderer const& copy) = delete;
+	TileHeatMapRenderer& operator=(TileHeatMapRenderer const& copy) = delete;
+
+	void			SetDrawMode(HeatMapDrawMode drawMode);
+	HeatMapDrawMode	GetDrawMode() const		{ return m_drawMode; }
+
+	void	Update(TileHeatMap const& heatMap, AABB2 const& bounds, HeatMapColorLUT const& colors);
+	void	Render() const;		// between BeginCamera and EndCamera, after an Update
+	void	MarkAllDirty();		// recolors and re-sends every tile on the next Update
+
+	int		GetNumTilesRecolored() const	{ return m_numTilesRecolored; }		// by the last Update
+	int		GetNumRowsUploaded() const		{ return m_numRowsUploaded; }		// by the last Update, 0 when it sent nothing
+
+	// CPU side of the cache, for tools and tests: TILE_QUADS vertexes (4 per tile, x fastest) and tile colors
+	std::vector<Vertex_PCU> const&	GetTileVerts() const	{ return m_tileVerts; }
+	std::vector<Rgba8> const&		GetTileColors() const	{ return m_tileColors; }
+
+private:
+	void	RebuildLayout(IntVec2 const& dimensions, AABB2 const& bounds);
+	void	RecolorTiles(float const* values, bool recolorAll, int& out_firstDirtyRow, int& out_lastDirtyRow);
+	void	UploadTiles(int firstDirtyRow, int lastDirtyRow);
+	void	ReleaseGPUData();
+
+private:
+	Renderer*				m_renderer = nullptr;
+	HeatMapDrawMode			m_drawMode = HeatMapDrawMode::TILE_QUADS;
+	IntVec2					m_dimensions;
+	AABB2					m_bounds;
+	HeatMapColorLUT			m_colors;
+	bool					m_isLayoutValid = false;
+	bool					m_areColorsValid = false;
+	std::vector<uint32_t>	m_drawnValueBits;		// bit patterns, so NaN tiles compare as unchanged
+	std::vector<Rgba8>		m_tileColors;
+	std::vector<Vertex_PCU>	m_tileVerts;			// TILE_QUADS only
+	VertexBuffer*			m_vertexBuffer = nullptr;
+	IndexBuffer*			m_indexBuffer = nullptr;
+	Texture*				m_texture = nullptr;
+	int						m_numTilesRecolored = 0;
+	int						m_numRowsUploaded = 0;
+};
\ No newline at end of file
@@ -1,8 +1,11 @@
 #include "Engine/Renderer/VertexBuffer.hpp"
 #include "Engine/Renderer/Renderer.hpp"
+#include "Game/EngineBuildPreferences.hpp"
+#if !defined( ENGINE_NULL_RENDERER )
 #include <d3d11.h>
 #include <d3dcompiler.h>
 #include <dxgi.h>
+#endif
 
 VertexBuffer::VertexBuffer(size_t size)
 	:m_size(size)
@@ -12,7 +15,9 @@ VertexBuffer::VertexBuffer(size_t size)
 
 VertexBuffer::~VertexBuffer()
 {
+#if !defined( ENGINE_NULL_RENDERER )
 	DX_SAFE_RELEASE(m_buffer);
+#endif
 }
 
 